@@ -146,6 +146,18 @@ class Vertex;
 #define LS_PASSUNDER           0x4 ///< Ray may cross under sector floor height on ray-entry side.
 ///@}
 
+/**
+ * Line of sight query for P_CheckLineSights().
+ */
+typedef struct linesightquery_s {
+    coord_t from[3];        ///< Trace origin coordinates.
+    coord_t to[3];          ///< Trace target coordinates.
+    coord_t bottomSlope;    ///< Lower limit to the Z axis angle/slope range.
+    coord_t topSlope;       ///< Upper limit to the Z axis angle/slope range.
+    int flags;              ///< @ref lineSightFlags
+    dd_bool result;         ///< Set by the engine: @c true if the line of sight is clear.
+} linesightquery_t;
+
 /**
  * Describes the @em sharp coordinates of the opening between sectors which
  * interface at a given map line. The open range is defined as the gap between
@@ -463,6 +475,15 @@ DENG_API_TYPEDEF(Map)
     dd_bool         (*CheckLineSight)(coord_t const from[3], coord_t const to[3],
                                       coord_t bottomSlope, coord_t topSlope, int flags);
 
+    /**
+     * Traces a batch of lines of sight. The queries may be traced concurrently, so
+     * this is faster than calling CheckLineSight() for each of them.
+     *
+     * @param queries  Queries to trace. The @c result of each query is updated.
+     * @param count    Number of queries.
+     */
+    void            (*CheckLineSights)(linesightquery_t *queries, int count);
+
     /**
      * Provides read-only access to the origin in map space for the given @a trace.
      */
@@ -724,6 +745,7 @@ DENG_API_T(Map);
 #define P_PathTraverse                      _api_Map.PathTraverse
 #define P_PathTraverse2                     _api_Map.PathTraverse2
 #define P_CheckLineSight                    _api_Map.CheckLineSight
+#define P_CheckLineSights                   _api_Map.CheckLineSights
 
 #define Interceptor_Origin                  _api_Map.I_Origin
 #define Interceptor_Direction               _api_Map.I_Direction
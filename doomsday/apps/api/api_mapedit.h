@@ -104,6 +104,22 @@ DENG_API_TYPEDEF(MPE)
     int             (*PlaneCreate)(int sector, coord_t height, ddstring_t const *materialUri, float matOffsetX, float matOffsetY, float r, float g, float b, float a, float normalX, float normalY, float normalZ, int archiveIndex);
     int             (*PolyobjCreate)(int const *lines, int linecount, int tag, int sequenceType, coord_t originX, coord_t originY, int archiveIndex);
     dd_bool         (*GameObjProperty)(char const *objName, int idx, char const *propName, valuetype_t type, void *data);
+
+    /**
+     * Set the value of a game object property for a range of consecutive elements.
+     * Names are resolved only once, so this is preferable to many GameObjProperty
+     * calls when transferring a large number of objects.
+     *
+     * @param objName    Name of the game object (entity) type.
+     * @param firstIdx   Element index of the first value.
+     * @param count      Number of values.
+     * @param propName   Name of the property.
+     * @param type       Value type of the source values.
+     * @param data       Address of the first source value.
+     * @param stride     Distance in bytes between consecutive source values
+     *                   (use @c 0 if the values are tightly packed).
+     */
+    dd_bool         (*GameObjPropertyv)(char const *objName, int firstIdx, int count, char const *propName, valuetype_t type, void const *data, int stride);
 }
 DENG_API_T(MPE);
 
@@ -120,6 +136,7 @@ DENG_API_T(MPE);
 #define MPE_PlaneCreate     _api_MPE.PlaneCreate
 #define MPE_PolyobjCreate   _api_MPE.PolyobjCreate
 #define MPE_GameObjProperty _api_MPE.GameObjProperty
+#define MPE_GameObjPropertyv _api_MPE.GameObjPropertyv
 #endif
 
 #ifdef __DOOMSDAY__
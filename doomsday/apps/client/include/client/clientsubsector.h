@@ -34,6 +34,7 @@
 #include "render/ilightsource.h"
 
 //class Shard;
+class RadioShadowCache;
 
 namespace world {
 
@@ -291,6 +292,13 @@ public:
      */
     void markVisPlanesDirty();
 
+    /**
+     * Returns the FakeRadio shadow parameters remembered for the walls and shadow casting
+     * line sides of the subsector. The cache is cleared when the planes of the subsector
+     * or its neighborhood move, or the surfaces of the subsector change.
+     */
+    RadioShadowCache &radioShadowCache() const;
+
 private:
     DENG2_PRIVATE(d)
 };
@@ -0,0 +1,143 @@
+/** @file demofile.h  Demo file format.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef CLIENT_DEMOFILE_H
+#define CLIENT_DEMOFILE_H
+
+#include <de/Block>
+#include <de/Error>
+#include <de/File>
+#include <de/String>
+
+/**
+ * Header of a demo: what is needed for playing it back.
+ */
+struct DemoHeader
+{
+    de::String gameId;
+    de::StringList packages;  ///< Loaded packages, in load order.
+    de::String mapId;         ///< Map where the recording began.
+};
+
+/**
+ * Network packet recorded in a demo.
+ */
+struct DemoPacket
+{
+    de::duint32 tic = 0;      ///< Demo tic when the packet was recorded.
+    de::duint8 type = 0;
+    de::Block data;
+};
+
+/**
+ * Writes a demo file.
+ *
+ * A demo file is a sequence of chunks: a header followed by the recorded network
+ * packets with their demo tics.
+ */
+class DemoWriter
+{
+public:
+    /**
+     * Begins writing a demo. The header is written immediately.
+     *
+     * @param file    Destination file. Must remain valid during the recording.
+     * @param header  Demo header.
+     */
+    DemoWriter(de::File &file, DemoHeader const &header);
+
+    /**
+     * Writes a packet. Packets are buffered and written to the file in batches.
+     */
+    void writePacket(DemoPacket const &packet);
+
+    /**
+     * Writes all buffered packets and flushes the file. No more data can be written
+     * afterwards.
+     */
+    void finish();
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+/**
+ * Reads a demo file written with DemoWriter.
+ *
+ * If the recording was interrupted, the packets up to the last complete chunk can
+ * still be read.
+ */
+class DemoReader
+{
+public:
+    /// The file is not a valid demo. @ingroup errors
+    DENG2_ERROR(FormatError);
+
+public:
+    /**
+     * Reads the demo contents into memory.
+     *
+     * @param file  Source file.
+     */
+    DemoReader(de::File const &file);
+
+    /**
+     * Reads a demo from memory.
+     *
+     * @param data         Contents of a demo file.
+     * @param description  Description of the source, for error messages.
+     */
+    DemoReader(de::Block const &data, de::String const &description);
+
+    DemoHeader const &header() const;
+
+    /**
+     * Demo tic of the last packet.
+     */
+    de::duint32 lengthInTics() const;
+
+    /**
+     * Determines if there are unread packets.
+     */
+    bool hasPacket() const;
+
+    /**
+     * Returns the next unread packet.
+     */
+    DemoPacket const &packet() const;
+
+    /**
+     * Moves on to the next packet.
+     */
+    void nextPacket();
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+/**
+ * Writes a demo with a header and @a packetCount packets of varying size and contents
+ * to @a file and reads it back, checking that the header and packets are unchanged.
+ * Also checks that a truncated copy of the demo can be read up to the last complete
+ * packet.
+ *
+ * @return  @c true if the check passed. The failures are logged.
+ */
+bool DemoFile_CheckRoundTrip(de::File &file, int packetCount);
+
+#endif // CLIENT_DEMOFILE_H
@@ -93,4 +93,18 @@ void            N_AddSentBytes(size_t bytes);
 } // extern "C"
 #endif
 
+#if defined(__cplusplus) && defined(__SERVER__)
+#include <de/Block>
+
+/**
+ * Sends a packet that has already been encoded with de::Socket::encodeMessage().
+ * Unlike N_SendPacket(), the netBuffer is not used.
+ *
+ * @param player      Destination player.
+ * @param encoded     Encoded packet.
+ * @param packetSize  Size of the packet before encoding.
+ */
+void N_SendEncodedPacket(int player, de::Block const &encoded, size_t packetSize);
+#endif
+
 #endif /* LIBDENG_NETWORK_BUFFER_H */
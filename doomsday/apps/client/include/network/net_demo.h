@@ -49,6 +49,7 @@ void            Demo_ReadLocalCamera(void); // PKT_DEMOCAM
 
 dd_bool         Demo_BeginPlayback(const char* filename);
 dd_bool         Demo_ReadPacket(void);
+dd_bool         Demo_Seek(int tic);
 void            Demo_StopPlayback(void);
 
 #ifdef __cplusplus
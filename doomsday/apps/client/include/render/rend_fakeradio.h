@@ -61,6 +61,46 @@ struct edgespan_t
     de::dfloat shift;
 };
 
+/**
+ * FakeRadio shadow parameters of the walls and shadow casting line sides of a subsector,
+ * remembered between frames. Deriving the parameters involves scanning the neighboring
+ * lines and planes, which only needs to be redone when something in the neighborhood
+ * changes (see clear()).
+ *
+ * @ingroup render
+ */
+class RadioShadowCache
+{
+public:
+    /// Shadow parameters of a wall section (defined in rend_fakeradio.cpp).
+    struct WallShadows;
+
+    /// Shadow edges of a line side on a plane (defined in rend_fakeradio.cpp).
+    struct FlatShadows;
+
+public:
+    RadioShadowCache();
+
+    /**
+     * Forget all the remembered parameters. To be called when a plane in the
+     * neighborhood moves or a surface changes.
+     */
+    void clear();
+
+    /**
+     * Returns the current generation of the cache. Parameters remembered during an
+     * earlier generation are no longer valid.
+     */
+    de::duint generation() const;
+
+    WallShadows &wallShadows(LineSideSegment const &segment, de::dint section);
+
+    FlatShadows &flatShadows(LineSide const &side, de::dint planeIndex);
+
+private:
+    DENG2_PRIVATE(d)
+};
+
 DENG2_EXTERN_C de::dint rendFakeRadio;
 DENG2_EXTERN_C byte devFakeRadioUpdate;
 
@@ -139,6 +139,7 @@ DENG_EXTERN_C byte loadExtAlways;
 DENG_EXTERN_C int devNoCulling;
 DENG_EXTERN_C byte devRendSkyAlways;
 DENG_EXTERN_C byte rendInfoLums;
+DENG_EXTERN_C byte rendInfoGeometry;
 DENG_EXTERN_C byte devDrawLums;
 
 DENG_EXTERN_C byte freezeRLs;
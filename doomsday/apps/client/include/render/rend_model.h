@@ -79,6 +79,7 @@ DENG_EXTERN_C de::dfloat modelSpinSpeed;
 DENG_EXTERN_C de::dint maxModelDistance;
 DENG_EXTERN_C de::dfloat rendModelLOD;
 DENG_EXTERN_C de::dbyte precacheSkins;
+DENG_EXTERN_C de::dbyte batchModels;
 
 /**
  * Registers the console commands and variables used by this module.
@@ -129,6 +130,21 @@ TextureVariantSpec const &Rend_ModelDiffuseTextureSpec(bool noCompression);
  */
 TextureVariantSpec const &Rend_ModelShinyTextureSpec();
 
+/**
+ * Prepare the vertices of all the model vissprites linked to @ref visSprSortedHead.
+ * The models are processed concurrently, each into its own part of a shared vertex
+ * buffer. Rend_DrawModel() then uses the prepared vertices.
+ *
+ * Does nothing if batching is disabled ("rend-model-batch").
+ */
+void Rend_ModelPrepareBatch();
+
+/**
+ * Forget the vertices prepared by Rend_ModelPrepareBatch(). Must be called before
+ * the vissprites are cleared.
+ */
+void Rend_ModelEndBatch();
+
 /**
  * Render all the submodels of a model.
  */
@@ -27,8 +27,6 @@
 #include "render/billboard.h"
 #include "rend_model.h"
 
-#define MAXVISSPRITES   8192
-
 namespace world { class BspLeaf; }
 class ClientMaterial;
 
@@ -203,15 +201,29 @@ struct vispsprite_t
     } data;
 };
 
-DENG_EXTERN_C vissprite_t visSprites[MAXVISSPRITES], *visSpriteP;
 DENG_EXTERN_C vissprite_t visSprSortedHead;
 DENG_EXTERN_C vispsprite_t visPSprites[DDMAXPSPRITES];
 
 /// To be called at the start of the current render frame to clear the vissprite list.
 void R_ClearVisSprites();
 
+/// Returns the number of vissprites in the current render frame.
+de::dint R_VisSpriteCount();
+
+/**
+ * Allocates a new (zeroed) vissprite for the current render frame. The returned
+ * vissprite remains valid until R_ClearVisSprites() is called.
+ */
 vissprite_t *R_NewVisSprite(visspritetype_t type);
 
+/**
+ * Links all the vissprites of the current render frame to @ref visSprSortedHead in
+ * back to front order. Equally distant vissprites are linked in the reverse order of
+ * their creation.
+ */
 void R_SortVisSprites();
 
+/// Register the console commands of this module.
+void R_VisSpriteRegister();
+
 #endif  // DENG_CLIENT_RENDER_VISSPRITE_H
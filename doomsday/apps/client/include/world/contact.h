@@ -123,6 +123,12 @@ void R_InitContactLists(Map &map);
  */
 void R_ClearContactLists(Map &map);
 
+/**
+ * Unlinks all contacts from the subspace contact lists. The contacts themselves are
+ * kept, so they can be spread again.
+ */
+void R_UnlinkSubspaceContacts(Map &map);
+
 /**
  * Add a new contact for the specified mobj, for spreading purposes.
  */
@@ -30,8 +30,17 @@ namespace world {
 
 /**
  * Performs contact spreading for the specified @a blockmap.
+ *
+ * @param blockmap      Blockmap of the contacts.
+ * @param region        Map space region in which to perform spreading.
+ * @param spreadBlocks  Cells already processed (updated). Can be @c nullptr.
+ * @param parallel      Spread the contacts concurrently in worker threads. The
+ *                      resulting contact lists are identical to serial spreading.
+ *                      The visual planes of the map's subsectors must already be
+ *                      mapped, as this is not done in a thread-safe manner.
  */
-void spreadContacts(Blockmap const &blockmap, AABoxd const &region, QBitArray *spreadBlocks = 0);
+void spreadContacts(Blockmap const &blockmap, AABoxd const &region, QBitArray *spreadBlocks = 0,
+                    bool parallel = false);
 
 }  // namespace world
 
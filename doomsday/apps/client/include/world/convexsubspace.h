@@ -35,6 +35,7 @@
 
 #ifdef __CLIENT__
 class Lumobj;
+class Plane;
 #endif
 
 namespace world {
@@ -216,6 +217,36 @@ public:
     de::dint lastSpriteProjectFrame() const;
     void setLastSpriteProjectFrame(de::dint newFrameNumber);
 
+//- Retained geometry -------------------------------------------------------------------
+
+    /**
+     * Map space geometry for drawing a plane of the subspace as a triangle fan. The
+     * geometry is owned by the subspace and retained between frames.
+     */
+    struct FlatGeometry
+    {
+        de::dint vertCount;
+        de::Vector3f const *posCoords;  ///< Position coordinates.
+        de::Vector2f const *texCoords;  ///< Relative to the top left corner of the bounds.
+    };
+
+    /**
+     * Returns the retained geometry for drawing @a plane in the subspace. Ceilings are
+     * wound anticlockwise and all other planes clockwise. The geometry is rebuilt only
+     * if it has been marked dirty or the smoothed height of the plane has changed since
+     * the geometry was last built.
+     *
+     * @param plane  Plane to draw (need not be attributed to the sector of the subspace).
+     *
+     * @see markFlatGeometryDirty()
+     */
+    FlatGeometry flatGeometry(Plane const &plane) const;
+
+    /**
+     * Marks all the retained flat geometry of the subspace as needing to be rebuilt.
+     */
+    void markFlatGeometryDirty();
+
 //- Audio environment -------------------------------------------------------------------
 
     /**
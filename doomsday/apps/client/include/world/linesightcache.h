@@ -0,0 +1,115 @@
+/** @file linesightcache.h  World map line of sight query cache.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DENG_WORLD_LINESIGHTCACHE_H
+#define DENG_WORLD_LINESIGHTCACHE_H
+
+#include <de/libcore.h>
+#include <de/String>
+#include <de/Vector>
+
+namespace world {
+
+class Map;
+
+/**
+ * Answers line of sight queries of a map, remembering the results for the rest of
+ * the current tic.
+ *
+ * Queries are identified by their exact parameters, as sight checks are part of the
+ * game simulation and must give the same results with or without the cache. The
+ * results are forgotten when the tic changes, or earlier if a plane moves or a
+ * polyobj is relinked.
+ *
+ * Batches of queries can be answered concurrently. This is safe as long as the map is
+ * not being changed at the same time.
+ */
+class LineSightCache
+{
+public:
+    /// Parameters and result of a line of sight query.
+    struct Query
+    {
+        de::Vector3d from;
+        de::Vector3d to;
+        de::dfloat bottomSlope;
+        de::dfloat topSlope;
+        de::dint flags;       ///< @ref lineSightFlags
+        bool result;          ///< Set when the query has been answered.
+
+        Query(de::Vector3d const &from = de::Vector3d(),
+              de::Vector3d const &to   = de::Vector3d(),
+              de::dfloat bottomSlope   = -1,
+              de::dfloat topSlope      = +1,
+              de::dint flags           = 0);
+    };
+
+public:
+    LineSightCache(Map &map);
+
+    /**
+     * Forget all remembered results. To be called when something changes in the map
+     * that may affect the results.
+     */
+    void invalidate();
+
+    /**
+     * Determines whether an uninterrupted line of sight exists between two points.
+     *
+     * @param query  Query to answer. The result is written to @a query.
+     *
+     * @return  Result of the query.
+     */
+    bool check(Query &query);
+
+    /**
+     * Answers a batch of queries. Queries whose results are not yet known are traced
+     * concurrently.
+     *
+     * @param queries  Queries to answer.
+     * @param count    Number of queries.
+     */
+    void check(Query *queries, de::dsize count);
+
+    de::duint64 hitCount() const;
+    de::duint64 missCount() const;
+
+    /**
+     * Returns a textual summary of the hit rate of the cache.
+     */
+    de::String statsSummary() const;
+
+    /**
+     * Measures the time taken to answer @a count queries made by monsters looking at
+     * the player, with and without the cache, and logs the results.
+     */
+    void benchmark(de::dint count);
+
+    /**
+     * To be called to register the commands and variables of this module.
+     */
+    static void consoleRegister();
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+}  // namespace world
+
+#endif  // DENG_WORLD_LINESIGHTCACHE_H
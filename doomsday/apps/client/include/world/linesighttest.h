@@ -31,9 +31,9 @@ namespace world {
 /**
  * Models the logic, parameters and state of a line (of) sight (LOS) test.
  *
- * @todo fixme: The state of a discrete trace is not fully encapsulated here
- * due to the manipulation of the validCount properties of the various map data elements.
- * (Which is used to avoid testing the same element multiple times during a trace.)
+ * The lines already tested during a trace are tracked separately for each thread, so
+ * tests of the same map can be traced concurrently (as long as the map is not being
+ * changed at the same time).
  *
  * @todo optimize: Make use of the blockmap to take advantage of the inherent spatial
  * locality in this data structure.
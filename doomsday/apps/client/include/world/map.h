@@ -74,6 +74,7 @@ namespace world {
 class Blockmap;
 class ConvexSubspace;
 class LineBlockmap;
+class LineSightCache;
 class Subsector;
 class Sky;
 class Thinkers;
@@ -702,6 +703,22 @@ public:  //- Data structures ---------------------------------------------------
      */
     BspLeaf &bspLeafAt_FixedPrecision(de::Vector2d const &point) const;
 
+    /**
+     * Consults the reject matrix of the map to determine whether sight between the
+     * sectors @a a and @a b is impossible. The matrix is built in the background when
+     * editing ends; nothing is rejected until it is ready. Must be called in the main
+     * thread.
+     *
+     * @return  @c true if no line of sight can exist between the sectors. If @c false,
+     * a line of sight may or may not exist.
+     */
+    bool isSightRejected(Sector const &a, Sector const &b) const;
+
+    /**
+     * Provides access to the line of sight query cache of the map.
+     */
+    LineSightCache &lineSightCache() const;
+
     /**
      * Given an @a emitter origin, attempt to identify the map element to which it belongs.
      *
@@ -773,6 +790,14 @@ public:  //- Data structures ---------------------------------------------------
      */
     void spreadAllContacts(AABoxd const &region);
 
+    /**
+     * Measures the time taken to spread all the contacts of the map, both serially
+     * and in parallel, and logs the results.
+     *
+     * @param iterations  Number of times each measurement is repeated.
+     */
+    void benchmarkContactSpreading(de::dint iterations);
+
 #endif  // __CLIENT__
 
 public:
@@ -787,6 +812,11 @@ public:
      */
     de::String objectSummaryAsStyledText() const;
 
+    /**
+     * Returns a textual summary of the reject matrix lookups made so far.
+     */
+    de::String rejectSummary() const;
+
     /**
      * To be called to register the commands and variables of this module.
      */
@@ -23,7 +23,10 @@
 #ifndef DENG_WORLD_REJECT_H
 #define DENG_WORLD_REJECT_H
 
-#if 0 // Needs updating
+#include <de/Block>
+
+namespace world {
+
 class Map;
 
 /**
@@ -64,14 +67,58 @@ class Map;
  *
  *     ceiling(numSectors^2)
  *
- * For now we only do very basic reject processing, limited to determining
- * all isolated sector groups (islands that are surrounded by void space).
- *
  * @note Algorithm:
- * Initially all sectors are in individual groups. Next, we scan the line
- * list. For each 2-sectored line, merge the two sector groups into one.
+ * The matrix is built from the convex subspaces of the BSP. Each half-edge whose
+ * twin is attributed to another subspace is a portal; all other edges block. For
+ * each subspace, sight is flowed through chains of portals: the window through
+ * the next portal is clipped against the separating lines of the source portal
+ * and the current window (in 2D). Subspaces reached by the flow are visible.
+ * Plane heights, middle textures and polyobjs are ignored, so the result is
+ * conservative. Should the flow from a subspace exceed a work limit, all the
+ * subspaces connected to it are considered visible instead (i.e., the old
+ * "isolated sector groups" behavior).
+ *
+ * The subspaces are processed concurrently in the background, so that loading the
+ * map does not wait for the matrix. Sight checks are traced normally until the
+ * matrix is ready. The resulting matrix is cached in the MetadataBank, keyed by a
+ * hash of the line geometry of the map.
  */
-byte *BuildRejectForMap(Map const &map);
-#endif
+class RejectMatrixBuilder
+{
+public:
+    /**
+     * Collects the geometry of @a map and starts building its reject matrix in the
+     * background, unless a cached matrix is available.
+     *
+     * @param map  Map to build the matrix for. The BSP must have been built. The
+     *             map is not accessed after the constructor returns.
+     */
+    explicit RejectMatrixBuilder(Map const &map);
+
+    /**
+     * Cancels the build if it is still in progress. Does not wait for the
+     * background tasks to stop.
+     */
+    ~RejectMatrixBuilder();
+
+    /**
+     * Determines if the matrix has been built.
+     */
+    bool isReady() const;
+
+    /**
+     * Returns the finished matrix and adds it to the cache. Must be called in the
+     * main thread.
+     *
+     * @return  Packed reject matrix (sectorCount x sectorCount bits), or an empty
+     * block if the matrix is not ready.
+     */
+    de::Block takeMatrix();
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+} // namespace world
 
 #endif // DENG_WORLD_REJECT_H
@@ -33,11 +33,12 @@
 #include <doomsday/world/MaterialManifest>
 #include <doomsday/world/Materials>
 #include <doomsday/EntityDatabase>
+#include <QVector>
 
 #include "network/net_main.h"
 
 #include "world/blockmap.h"
-#include "world/linesighttest.h"
+#include "world/linesightcache.h"
 #include "world/maputil.h"
 #include "world/p_players.h"
 #include "world/clientserverworld.h"
@@ -1642,8 +1643,35 @@ DENG_EXTERN_C dd_bool P_CheckLineSight(const_pvec3d_t from, const_pvec3d_t to, c
 {
     if(!App_World().hasMap()) return false;  // Continue iteration.
 
-    return LineSightTest(from, to, bottomSlope, topSlope, flags)
-                .trace(App_World().map().bspTree());
+    LineSightCache::Query query(from, to, bottomSlope, topSlope, flags);
+    return App_World().map().lineSightCache().check(query);
+}
+
+#undef P_CheckLineSights
+DENG_EXTERN_C void P_CheckLineSights(linesightquery_t *queries, int count)
+{
+    if(!queries || count <= 0) return;
+
+    if(!App_World().hasMap())
+    {
+        for(int i = 0; i < count; ++i) queries[i].result = false;
+        return;
+    }
+
+    QVector<LineSightCache::Query> batch;
+    batch.reserve(count);
+    for(int i = 0; i < count; ++i)
+    {
+        linesightquery_t const &q = queries[i];
+        batch << LineSightCache::Query(q.from, q.to, q.bottomSlope, q.topSlope, q.flags);
+    }
+
+    App_World().map().lineSightCache().check(batch.data(), dsize(count));
+
+    for(int i = 0; i < count; ++i)
+    {
+        queries[i].result = batch.at(i).result;
+    }
 }
 
 #undef Interceptor_Origin
@@ -1855,6 +1883,7 @@ DENG_DECLARE_API(Map) =
     P_PathTraverse,
     P_PathTraverse2,
     P_CheckLineSight,
+    P_CheckLineSights,
 
     Interceptor_Origin,
     Interceptor_Direction,
@@ -371,23 +371,20 @@ int MPE_PolyobjCreate(int const *lines, int lineCount, int tag, int sequenceType
     return po->indexInMap();
 }
 
-#undef MPE_GameObjProperty
-dd_bool MPE_GameObjProperty(char const *entityName, int elementIndex,
-    char const *propertyName, valuetype_t valueType, void *valueAdr)
+/**
+ * Resolves the definition of the game object property @a propertyName of the
+ * entity @a entityName. Logs a warning if either is unknown.
+ *
+ * @return  The found property definition; otherwise @c nullptr.
+ */
+static MapEntityPropertyDef *gameObjPropertyDef(char const *entityName, char const *propertyName)
 {
-    LOG_AS("MPE_GameObjProperty");
-
-    ERROR_IF_NOT_INITIALIZED();
-
-    if(!entityName || !propertyName || !valueAdr)
-        return false; // Hmm...
-
     // Is this a known entity?
     MapEntityDef *entityDef = P_MapEntityDefByName(entityName);
     if(!entityDef)
     {
         LOG_WARNING("Unknown entity name:\"%s\", ignoring.") << entityName;
-        return false;
+        return nullptr;
     }
 
     // Is this a known property?
@@ -396,8 +393,24 @@ dd_bool MPE_GameObjProperty(char const *entityName, int elementIndex,
     {
         LOG_WARNING("Entity \"%s\" has no \"%s\" property, ignoring.")
                 << entityName << propertyName;
-        return false;
+        return nullptr;
     }
+    return propertyDef;
+}
+
+#undef MPE_GameObjProperty
+dd_bool MPE_GameObjProperty(char const *entityName, int elementIndex,
+    char const *propertyName, valuetype_t valueType, void *valueAdr)
+{
+    LOG_AS("MPE_GameObjProperty");
+
+    ERROR_IF_NOT_INITIALIZED();
+
+    if(!entityName || !propertyName || !valueAdr)
+        return false; // Hmm...
+
+    MapEntityPropertyDef *propertyDef = gameObjPropertyDef(entityName, propertyName);
+    if(!propertyDef) return false;
 
     try
     {
@@ -412,6 +425,34 @@ dd_bool MPE_GameObjProperty(char const *entityName, int elementIndex,
     return false;
 }
 
+#undef MPE_GameObjPropertyv
+dd_bool MPE_GameObjPropertyv(char const *entityName, int firstElementIndex, int count,
+    char const *propertyName, valuetype_t valueType, void const *values, int stride)
+{
+    LOG_AS("MPE_GameObjPropertyv");
+
+    ERROR_IF_NOT_INITIALIZED();
+
+    if(!entityName || !propertyName || (count > 0 && !values))
+        return false; // Hmm...
+
+    // The definition is resolved only once for the entire range.
+    MapEntityPropertyDef *propertyDef = gameObjPropertyDef(entityName, propertyName);
+    if(!propertyDef) return false;
+
+    try
+    {
+        EntityDatabase &entities = editMap->entityDatabase();
+        entities.setProperties(propertyDef, firstElementIndex, count, valueType, values, stride);
+        return true;
+    }
+    catch(Error const &er)
+    {
+        LOG_WARNING("%s. Ignoring.") << er.asText();
+    }
+    return false;
+}
+
 DENG_DECLARE_API(MPE) =
 {
     { DE_API_MAP_EDIT },
@@ -425,5 +466,6 @@ DENG_DECLARE_API(MPE) =
     MPE_SectorCreate,
     MPE_PlaneCreate,
     MPE_PolyobjCreate,
-    MPE_GameObjProperty
+    MPE_GameObjProperty,
+    MPE_GameObjPropertyv
 };
@@ -23,12 +23,14 @@
 #include "world/map.h"
 #include "world/blockmap.h"
 #include "world/convexsubspace.h"
+#include "world/lineowner.h"
 #include "world/p_object.h"
 #include "world/p_players.h"
 #include "world/surface.h"
 #include "client/clskyplane.h"
 #include "client/cledgeloop.h"
 
+#include "render/rend_fakeradio.h"
 #include "render/rend_main.h" // Rend_SkyLightColor(), useBias
 //#include "BiasIllum"
 //#include "BiasTracker"
@@ -94,6 +96,51 @@ static DotPath composeSurfacePath(Surface const &surface)
 }
 #endif // DENG2_DEBUG
 
+/**
+ * Collects the sectors whose plane heights may affect the FakeRadio edge spans of
+ * @a line. The neighbor scan of a line side continues along co-aligned lines past
+ * the line's own vertexes, so the chains of co-aligned lines are followed to their
+ * ends, gathering the sectors of all lines around each vertex met on the way.
+ *
+ * The heights are not considered here as they change at runtime; the result is the
+ * set of all sectors the scan could possibly visit.
+ */
+static void collectRadioNeighborSectors(Line &line, QSet<Sector *> &sectors)
+{
+    static dint const SEP = 10; // Same tolerance as in the neighbor scan.
+
+    QSet<Vertex const *> visited;
+    QList<QPair<Line *, dint>> pending; // Line and the vertex where to continue.
+    pending << qMakePair(&line, dint(Line::From)) << qMakePair(&line, dint(Line::To));
+
+    while (!pending.isEmpty())
+    {
+        auto const next = pending.takeLast();
+        Line &chainLine = *next.first;
+        LineOwner *base = chainLine.vertexOwner(next.second);
+        if (!base || visited.contains(&chainLine.vertex(next.second)))
+            continue;
+
+        visited.insert(&chainLine.vertex(next.second));
+
+        LineOwner *own = base;
+        do
+        {
+            Line &other = own->line();
+            if (Sector *sec = other.front().sectorPtr()) sectors.insert(sec);
+            if (Sector *sec = other.back ().sectorPtr()) sectors.insert(sec);
+
+            // Lines continuing in either direction extend the chain.
+            binangle_t const diff = binangle_t(other.angle() - chainLine.angle()) % BANG_180;
+            if (&other != &chainLine && (diff <= SEP || diff >= BANG_180 - SEP))
+            {
+                dint const far = (&other.from() == &chainLine.vertex(next.second)? Line::To : Line::From);
+                pending << qMakePair(&other, far);
+            }
+        } while ((own = &own->next()) != base);
+    }
+}
+
 /**
  * @todo optimize: Translation of decorations on the world up axis would be a trivial
  * operation to perform, which, would not require plotting decorations again. This
@@ -216,6 +263,15 @@ DENG2_PIMPL(ClientSubsector)
     //QHash<Id::Type, DecoratedSurface> decorSurfaces;
     QSet<Surface *> decorSurfaces;
 
+    /// FakeRadio shadow parameters of the walls and shadow casting line sides.
+    RadioShadowCache radioShadowCache;
+
+    /// Planes observed because FakeRadio shadows depend on them.
+    QSet<Plane const *> radioNeighborPlanes;
+
+    /// Planes whose height changes are observed for mapping and geometry.
+    QSet<Plane const *> heightObservedPlanes;
+
     Impl(Public *i) : Base(i)
     {}
 
@@ -303,16 +359,36 @@ DENG2_PIMPL(ClientSubsector)
             {
                 plane->audienceForHeightChange        () += this;
                 plane->audienceForHeightSmoothedChange() += this;
+                heightObservedPlanes.insert(plane);
             }
         }
         else
         {
-            plane->audienceForHeightSmoothedChange() -= this;
-            plane->audienceForHeightChange        () -= this;
-            plane->audienceForDeletion            () -= this;
+            // FakeRadio still needs to know about the smoothed height.
+            if (!radioNeighborPlanes.contains(plane))
+            {
+                plane->audienceForHeightSmoothedChange() -= this;
+            }
+            plane->audienceForHeightChange() -= this;
+            plane->audienceForDeletion    () -= this;
+            heightObservedPlanes.remove(plane);
         }
     }
 
+    /**
+     * Observes height changes of the planes of a @a sector in the neighborhood, as the
+     * FakeRadio shadows of the subsector depend on them.
+     */
+    void observeRadioNeighbor(Sector &sector)
+    {
+        sector.forAllPlanes([this] (Plane &plane)
+        {
+            plane.audienceForHeightSmoothedChange() += this;
+            radioNeighborPlanes.insert(&plane);
+            return LoopContinue;
+        });
+    }
+
     void observeSubsector(ClientSubsector *subsec, bool yes = true)
     {
         if (!subsec || subsec == thisPublic)
@@ -1150,6 +1226,7 @@ DENG2_PIMPL(ClientSubsector)
     void lineFlagsChanged(Line &line, dint oldFlags)
     {
         LOG_AS("ClientSubsector");
+        radioShadowCache.clear();
         line.forAllSides([this, &oldFlags] (LineSide &side)
         {
             if (side.sectorPtr() == &self().sector())
@@ -1177,6 +1254,7 @@ DENG2_PIMPL(ClientSubsector)
     void materialDimensionsChanged(Material &material)
     {
         LOG_AS("ClientSubsector");
+        radioShadowCache.clear();
         markDependentSurfacesForRedecoration(material);
     }
 
@@ -1275,11 +1353,23 @@ DENG2_PIMPL(ClientSubsector)
     {
         LOG_AS("ClientSubsector");
 
+        // FakeRadio shadows depend on the planes of the neighborhood.
+        radioShadowCache.clear();
+        if (!heightObservedPlanes.contains(&plane))
+            return;
+
         // We may need to update one or both mapped planes.
         maybeInvalidateMapping(plane.indexInSector());
 
         // We may need to project new decorations.
         markDependentSurfacesForRedecoration(plane);
+
+        // Retained flat geometry must be rebuilt.
+        self().forAllSubspaces([] (ConvexSubspace &subspace)
+        {
+            subspace.markFlatGeometryDirty();
+            return LoopContinue;
+        });
     }
 
 #if 0
@@ -1310,6 +1400,7 @@ DENG2_PIMPL(ClientSubsector)
     void surfaceMaterialChanged(Surface &surface)
     {
         LOG_AS("ClientSubsector");
+        radioShadowCache.clear();
         //DecoratedSurface &ds = decorSurfaces[surface.uniqueId()];
 
         DecoratedSurface &ds = allocDecorationState(surface);
@@ -1338,6 +1429,7 @@ DENG2_PIMPL(ClientSubsector)
     void surfaceOriginSmoothedChanged(Surface &surface)
     {
         LOG_AS("ClientSubsector");
+        radioShadowCache.clear();
         if (surface.hasMaterial())
         {
             allocDecorationState(surface).markForUpdate();
@@ -1357,8 +1449,11 @@ ClientSubsector::ClientSubsector(QVector<ConvexSubspace *> const &subspaces)
     : Subsector(subspaces)
     , d(new Impl(this))
 {
+    QSet<Sector *> backSectors;
+    QSet<Sector *> radioSectors;
+
     // Observe changes to surfaces in the subsector.
-    forAllSubspaces([this] (ConvexSubspace &subspace)
+    forAllSubspaces([this, &backSectors, &radioSectors] (ConvexSubspace &subspace)
     {
         HEdge *hedge = subspace.poly().hedge();
         do
@@ -1383,13 +1478,24 @@ ClientSubsector::ClientSubsector(QVector<ConvexSubspace *> const &subspaces)
                     Sector &backsec = front.back().sector();
                     d->observePlane(&backsec.floor());
                     d->observePlane(&backsec.ceiling());
+                    backSectors.insert(&backsec);
                 }
+
+                // Sectors along the co-aligned walls affect FakeRadio shadows.
+                collectRadioNeighborSectors(front.line(), radioSectors);
             }
         } while ((hedge = &hedge->next()) != subspace.poly().hedge());
 
         return LoopContinue;
     });
 
+    // Observe the rest of the FakeRadio neighborhood.
+    radioSectors.remove(&sector());
+    for (Sector *neighbor : radioSectors.subtract(backSectors))
+    {
+        d->observeRadioNeighbor(*neighbor);
+    }
+
     // Observe changes to planes in the sector.
     Plane *floor = &sector().floor();
     d->observePlane(floor);
@@ -1642,6 +1748,11 @@ ClientSubsector::AudioEnvironment const &ClientSubsector::reverb() const
     return d->reverb;
 }
 
+RadioShadowCache &ClientSubsector::radioShadowCache() const
+{
+    return d->radioShadowCache;
+}
+
 void ClientSubsector::markVisPlanesDirty()
 {
     d->maybeInvalidateMapping(Sector::Floor);
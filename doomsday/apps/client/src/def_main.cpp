@@ -30,10 +30,14 @@
 #include <de/findfile.h>
 #include <de/c_wrapper.h>
 #include <de/App>
+#include <de/MetadataBank>
 #include <de/PackageLoader>
+#include <de/Reader>
 #include <de/ScriptSystem>
 #include <de/NativePath>
 #include <de/RecordValue>
+#include <de/Version>
+#include <de/Writer>
 #include <doomsday/doomsdayapp.h>
 #include <doomsday/console/cmd.h>
 #include <doomsday/defs/decoration.h>
@@ -79,6 +83,11 @@ using namespace de;
 RuntimeDefs runtimeDefs;
 
 static bool defsInited;
+
+static String const DEFS_CACHE_CATEGORY = "Definitions";
+
+/// Increment when the contents of the cached definitions change.
+static duint32 const DEFS_CACHE_VERSION = 1;
 static mobjinfo_t *gettingFor;
 
 static inline FS1 &fileSys()
@@ -649,6 +658,213 @@ static void readAllDefinitions()
     LOG_RES_VERBOSE("readAllDefinitions: Completed in %.2f seconds") << begunAt.since();
 }
 
+/**
+ * Identifies the inputs of readAllDefinitions(): the engine build, the game, the
+ * command line, and the loaded files and packages. The definition files themselves
+ * (including the ones read via Include) are checked when the cached definitions are
+ * used.
+ */
+static Block definitionsCacheId()
+{
+    Block data;
+    Writer writer(data);
+
+    writer << DEFS_CACHE_VERSION << Version::currentBuild().asHumanReadableText()
+           << (App_GameLoaded()? App_CurrentGame().id() : String());
+
+    // Conditional definitions depend on the command line.
+    CommandLine const &cmdLine = App::commandLine();
+    for (dint i = 0; i < cmdLine.count(); ++i)
+    {
+        writer << cmdLine.at(i);
+    }
+
+    // Definition lumps, MAPINFOs, and textures come from the loaded files.
+    for (FileHandle const *hndl : fileSys().loadedFiles())
+    {
+        File1 const &file = hndl->file();
+        writer << file.composePath() << duint64(file.size()) << duint32(file.lastModified());
+    }
+
+    for (DataBundle const *bundle : DataBundle::loadedBundles())
+    {
+        writer << bundle->asFile().metaId();
+    }
+
+    // Adding or removing files in a package's definitions folder changes what is read.
+    for (Package *pkg : App::packageLoader().loadedPackagesInOrder())
+    {
+        writer << pkg->identifier() << pkg->sourceFile().metaId();
+
+        res::DoomsdayPackage ddPkg(*pkg);
+        if (ddPkg.hasDefinitions())
+        {
+            pkg->root().locate<Folder const>(ddPkg.defsPath()).forContents([&writer] (String name, File &)
+            {
+                writer << name;
+                return LoopContinue;
+            });
+        }
+    }
+
+    if (App_GameLoaded() && !CommandLine_Exists("-noauto"))
+    {
+        FS1::PathList foundPaths;
+        fileSys().findAllPaths(de::makeUri("$(App.DefsPath)/$(GamePlugin.Name)/auto/*.ded").resolved(), 0, foundPaths);
+        for (FS1::PathListItem const &found : foundPaths)
+        {
+            writer << found.path;
+        }
+    }
+
+    return data.md5Hash();
+}
+
+static void writeCachedDefinitions(Block const &cacheId, DEDSourceLog const &sources)
+{
+    Block data;
+    Writer writer(data);
+    writer.withHeader();
+
+    writer << duint32(sources.files.size());
+    for (String const &path : sources.files)
+    {
+        writer << path << DED_SourceFileId(path);
+    }
+    writer.writeElements(sources.modelPaths);
+    writer << *DED_Definitions();
+
+    MetadataBank::get().setMetadata(DEFS_CACHE_CATEGORY, cacheId, data.compressed());
+}
+
+/**
+ * Loads the definitions from the cache, if they are up to date.
+ *
+ * @param cacheId  Identifies the inputs of the definitions.
+ * @param defs     Definitions to replace with the cached ones.
+ * @param sources  The sources of the cached definitions are recorded here.
+ *
+ * @return @c true, if the cached definitions were loaded.
+ */
+static bool readCachedDefinitions(Block const &cacheId, ded_t &defs, DEDSourceLog &sources)
+{
+    try
+    {
+        if (Block data = MetadataBank::get().check(DEFS_CACHE_CATEGORY, cacheId))
+        {
+            data = data.decompressed();
+            Reader reader(data);
+            reader.withHeader();
+
+            DEDSourceLog cachedSources;
+            duint32 count;
+            reader >> count;
+            for (duint32 i = 0; i < count; ++i)
+            {
+                String path;
+                Block fileId;
+                reader >> path >> fileId;
+                if (DED_SourceFileId(path) != fileId)
+                {
+                    LOG_RES_VERBOSE("Cached definitions are out of date (\"%s\" has changed)")
+                            << NativePath(path).pretty();
+                    return false;
+                }
+                cachedSources.files << path;
+            }
+            reader.readElements(cachedSources.modelPaths);
+            reader >> defs;
+
+            sources = cachedSources;
+            return true;
+        }
+    }
+    catch (Error const &er)
+    {
+        LOGDEV_RES_WARNING("Corrupt cached definitions: %s") << er.asText();
+        defs.clear();
+    }
+    return false;
+}
+
+/**
+ * Generates the material definitions and parses all the definition files.
+ *
+ * @param sources  The sources of the definitions are recorded here.
+ */
+static void parseAllDefinitions(DEDSourceLog &sources)
+{
+    // Generate definitions.
+    generateMaterialDefs();
+
+    // Read all definitions files and lumps.
+    LOG_RES_MSG("Parsing definition files...");
+    DED_SetSourceLog(&sources);
+    try
+    {
+        readAllDefinitions();
+    }
+    catch (...)
+    {
+        DED_SetSourceLog(nullptr);
+        throw;
+    }
+    DED_SetSourceLog(nullptr);
+}
+
+/**
+ * Checks that the cached definitions are identical to the parsed ones (the
+ * -checkdedcache option). The parsed definitions are the ones left in use.
+ */
+static void checkCachedDefinitions(Block const &cacheId)
+{
+    LOG_AS("checkdedcache");
+
+    ded_t cached;
+    DEDSourceLog cachedSources;
+    if (!readCachedDefinitions(cacheId, cached, cachedSources))
+    {
+        LOG_RES_MSG("No up-to-date cached definitions to check; they will be written now");
+        DEDSourceLog sources;
+        parseAllDefinitions(sources);
+        writeCachedDefinitions(cacheId, sources);
+        return;
+    }
+
+    DEDSourceLog sources;
+    try
+    {
+        parseAllDefinitions(sources);
+    }
+    catch (...)
+    {
+        cached.clear();
+        throw;
+    }
+
+    StringList differing = cached.differingSections(*DED_Definitions());
+    if (cachedSources.files != sources.files)
+    {
+        differing << "source files";
+    }
+    if (cachedSources.modelPaths != sources.modelPaths)
+    {
+        differing << "model paths";
+    }
+    cached.clear();
+
+    if (differing.isEmpty())
+    {
+        LOG_RES_MSG("Cached definitions are identical to the parsed definitions (%i files)")
+                << sources.files.size();
+    }
+    else
+    {
+        LOG_RES_ERROR("Cached definitions differ from the parsed definitions: %s")
+                << String::join(differing, ", ");
+    }
+}
+
 static void defineFlaremap(de::Uri const &resourceUri)
 {
     if (resourceUri.isEmpty()) return;
@@ -1207,12 +1423,35 @@ void Def_Read()
     defs.clear();
     runtimeDefs.clear();
 
-    // Generate definitions.
-    generateMaterialDefs();
+    // The parsed definitions are cached; the cache can be bypassed with -nodedcache.
+    bool const useCache = !CommandLine_Exists("-nodedcache");
+    Block const cacheId = (useCache? definitionsCacheId() : Block());
 
-    // Read all definitions files and lumps.
-    LOG_RES_MSG("Parsing definition files...");
-    readAllDefinitions();
+    if (useCache && CommandLine_Exists("-checkdedcache"))
+    {
+        checkCachedDefinitions(cacheId);
+    }
+    else
+    {
+        DEDSourceLog sources;
+        if (useCache && readCachedDefinitions(cacheId, defs, sources))
+        {
+            // The model paths were added while parsing.
+            for (String const &path : sources.modelPaths)
+            {
+                DED_AddModelPath(path);
+            }
+            LOG_RES_MSG("Using cached definitions from %i files") << sources.files.size();
+        }
+        else
+        {
+            parseAllDefinitions(sources);
+            if (useCache)
+            {
+                writeCachedDefinitions(cacheId, sources);
+            }
+        }
+    }
 
     // Any definition hooks?
     DoomsdayApp::plugins().callAllHooks(HOOK_DEFS, 0, &defs);
@@ -311,6 +311,31 @@ void N_SendPacket(dint flags)
     }
 }
 
+#ifdef __SERVER__
+void N_SendEncodedPacket(dint player, Block const &encoded, dsize packetSize)
+{
+    if(!::allowSending) return;
+
+    DENG2_ASSERT(player >= 0 && player < DDMAXPLAYERS);
+    if(!DD_Player(player)->isConnected())
+    {
+        // Do not send anything to disconnected players.
+        return;
+    }
+
+    ::numOutBytes += packetSize;
+
+    try
+    {
+        App_ServerSystem().user(DD_Player(player)->remoteUserId).sendEncoded(encoded);
+    }
+    catch(Error const &er)
+    {
+        LOGDEV_NET_WARNING("N_SendEncodedPacket failed: ") << er.asText();
+    }
+}
+#endif
+
 void N_AddSentBytes(dsize bytes)
 {
     ::numSentBytes += bytes;
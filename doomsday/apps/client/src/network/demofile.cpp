@@ -0,0 +1,365 @@
+/** @file demofile.cpp  Demo file format.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "network/demofile.h"
+#include "network/net_buf.h"
+
+#include <de/Log>
+#include <de/Reader>
+#include <de/Writer>
+
+using namespace de;
+
+/*
+ * File layout (little-endian):
+ *
+ *   magic (uint32), version (uint32)
+ *   chunks: type (uint8), payload size (uint32), payload
+ *
+ * The first chunk is the header. An incomplete chunk at the end of the file (from an
+ * interrupted recording) is ignored.
+ */
+static duint32 const DEMO_MAGIC   = 0x4d454444; // "DDEM"
+static duint32 const DEMO_VERSION = 1;
+static dsize   const DEMO_CHUNK_HEADER_SIZE = 5;
+
+/// Buffered packets are written to the file when the buffer grows this large.
+static dsize const DEMO_WRITE_BUFFER_SIZE = 64 * 1024;
+
+enum DemoChunkType
+{
+    DemoHeaderChunk = 1,
+    DemoPacketChunk = 2
+};
+
+DENG2_PIMPL_NOREF(DemoWriter)
+{
+    File &file;
+    Block buffer;              ///< Chunks not yet written to the file.
+    bool finished = false;
+
+    Impl(File &file) : file(file) {}
+
+    void writeChunk(DemoChunkType type, Block const &payload)
+    {
+        DENG2_ASSERT(!finished);
+        Writer(buffer, buffer.size()) << duint8(type) << duint32(payload.size());
+        buffer += payload;
+    }
+
+    void flush()
+    {
+        file << buffer;
+        file.flush();
+        buffer.clear();
+    }
+};
+
+DemoWriter::DemoWriter(File &file, DemoHeader const &header)
+    : d(new Impl(file))
+{
+    Writer(d->buffer) << DEMO_MAGIC << DEMO_VERSION;
+
+    Block payload;
+    Writer writer(payload);
+    writer << header.gameId << duint32(header.packages.size());
+    for (String const &pkg : header.packages)
+    {
+        writer << pkg;
+    }
+    writer << header.mapId;
+    d->writeChunk(DemoHeaderChunk, payload);
+    d->flush();
+}
+
+void DemoWriter::writePacket(DemoPacket const &packet)
+{
+    Block payload;
+    Writer(payload) << packet.tic << packet.type << packet.data;
+    d->writeChunk(DemoPacketChunk, payload);
+
+    if (d->buffer.size() >= DEMO_WRITE_BUFFER_SIZE)
+    {
+        d->flush();
+    }
+}
+
+void DemoWriter::finish()
+{
+    if (d->finished) return;
+
+    d->flush();
+    d->finished = true;
+}
+
+DENG2_PIMPL_NOREF(DemoReader)
+{
+    Block data;
+    DemoHeader header;
+    duint32 firstPacketOffset = 0;
+    duint32 length = 0;
+
+    duint32 pos = 0;           ///< Offset of the chunk following the current packet.
+    DemoPacket packet;
+    bool hasPacket = false;
+
+    /**
+     * Reads the chunk header at @a offset.
+     *
+     * @return  @c false if there is no complete chunk at @a offset.
+     */
+    bool chunkAt(duint32 offset, duint8 &type, duint32 &size) const
+    {
+        if (offset + DEMO_CHUNK_HEADER_SIZE > data.size()) return false;
+        Reader reader(data, littleEndianByteOrder, offset);
+        reader >> type >> size;
+        return offset + DEMO_CHUNK_HEADER_SIZE + size <= data.size();
+    }
+
+    Reader payloadReader(duint32 chunkOffset) const
+    {
+        return Reader(data, littleEndianByteOrder, chunkOffset + DEMO_CHUNK_HEADER_SIZE);
+    }
+
+    void parse()
+    {
+        Reader reader(data);
+        duint32 magic, version;
+        reader >> magic >> version;
+        if (magic != DEMO_MAGIC)
+        {
+            throw FormatError("DemoReader", "Not a demo file");
+        }
+        if (version != DEMO_VERSION)
+        {
+            throw FormatError("DemoReader", QString("Unsupported demo version %1").arg(version));
+        }
+
+        duint8 type;
+        duint32 size;
+        duint32 const headerOffset = duint32(reader.offset());
+        if (!chunkAt(headerOffset, type, size) || type != DemoHeaderChunk)
+        {
+            throw FormatError("DemoReader", "Demo header is missing");
+        }
+        Reader headerReader = payloadReader(headerOffset);
+        duint32 count;
+        headerReader >> header.gameId >> count;
+        for (duint32 i = 0; i < count; ++i)
+        {
+            String pkg;
+            headerReader >> pkg;
+            header.packages << pkg;
+        }
+        headerReader >> header.mapId;
+        firstPacketOffset = headerOffset + DEMO_CHUNK_HEADER_SIZE + size;
+    }
+
+    /**
+     * Reads the first packet at or after @a offset.
+     */
+    void readPacketFrom(duint32 offset)
+    {
+        hasPacket = false;
+        duint8 type;
+        duint32 size;
+        while (chunkAt(offset, type, size))
+        {
+            duint32 const chunkOffset = offset;
+            offset += DEMO_CHUNK_HEADER_SIZE + size;
+            if (type == DemoPacketChunk)
+            {
+                payloadReader(chunkOffset) >> packet.tic >> packet.type >> packet.data;
+                if (packet.data.size() > NETBUFFER_MAXSIZE)
+                {
+                    throw FormatError("DemoReader", "Packet is too large");
+                }
+                hasPacket = true;
+                break;
+            }
+        }
+        pos = offset;
+    }
+
+    void findLength()
+    {
+        for (readPacketFrom(firstPacketOffset); hasPacket; readPacketFrom(pos))
+        {
+            length = de::max(length, packet.tic);
+        }
+    }
+
+    void read(String const &description)
+    {
+        try
+        {
+            parse();
+            findLength();
+            readPacketFrom(firstPacketOffset);
+        }
+        catch (IByteArray::OffsetError const &er)
+        {
+            throw FormatError("DemoReader", "Demo \"" + description + "\" is truncated: " +
+                              er.asText());
+        }
+    }
+};
+
+DemoReader::DemoReader(File const &file)
+    : d(new Impl)
+{
+    file >> d->data;
+    d->read(file.description());
+}
+
+DemoReader::DemoReader(Block const &data, String const &description)
+    : d(new Impl)
+{
+    d->data = data;
+    d->read(description);
+}
+
+DemoHeader const &DemoReader::header() const
+{
+    return d->header;
+}
+
+duint32 DemoReader::lengthInTics() const
+{
+    return d->length;
+}
+
+bool DemoReader::hasPacket() const
+{
+    return d->hasPacket;
+}
+
+DemoPacket const &DemoReader::packet() const
+{
+    DENG2_ASSERT(d->hasPacket);
+    return d->packet;
+}
+
+void DemoReader::nextPacket()
+{
+    d->readPacketFrom(d->pos);
+}
+
+static DemoPacket makeTestPacket(int index)
+{
+    DemoPacket packet;
+    packet.tic  = duint32(index / 3);  // Several packets per tic.
+    packet.type = duint8(index % 256);
+    for (int i = 0; i < (index * 37) % 600; ++i)
+    {
+        packet.data.append(char((index + i * 7) % 256));
+    }
+    return packet;
+}
+
+/**
+ * Checks that the packets read from @a reader match the first @a count test packets.
+ */
+static bool checkTestPackets(DemoReader &reader, int count, String const &what)
+{
+    for (int i = 0; i < count; ++i, reader.nextPacket())
+    {
+        DemoPacket const expected = makeTestPacket(i);
+        if (!reader.hasPacket())
+        {
+            LOG_NET_ERROR("%s: packet %i is missing") << what << i;
+            return false;
+        }
+        DemoPacket const &packet = reader.packet();
+        if (packet.tic != expected.tic || packet.type != expected.type ||
+            packet.data != expected.data)
+        {
+            LOG_NET_ERROR("%s: packet %i differs from the one written") << what << i;
+            return false;
+        }
+    }
+    if (reader.hasPacket())
+    {
+        LOG_NET_ERROR("%s: there are more packets than were written") << what;
+        return false;
+    }
+    return true;
+}
+
+bool DemoFile_CheckRoundTrip(File &file, int packetCount)
+{
+    DemoHeader header;
+    header.gameId   = "doom1";
+    header.packages = StringList({ "net.dengine.base", "net.dengine.test.demo" });
+    header.mapId    = "e1m1";
+
+    {
+        DemoWriter writer(file, header);
+        for (int i = 0; i < packetCount; ++i)
+        {
+            writer.writePacket(makeTestPacket(i));
+        }
+        writer.finish();
+    }
+
+    Block written;
+    file >> written;
+
+    try
+    {
+        DemoReader reader(written, file.description());
+        if (reader.header().gameId   != header.gameId ||
+            reader.header().packages != header.packages ||
+            reader.header().mapId    != header.mapId)
+        {
+            LOG_NET_ERROR("Demo header differs from the one written");
+            return false;
+        }
+        duint32 const expectedLength = (packetCount > 0? makeTestPacket(packetCount - 1).tic : 0);
+        if (reader.lengthInTics() != expectedLength)
+        {
+            LOG_NET_ERROR("Demo length is %i tics, expected %i")
+                    << reader.lengthInTics() << expectedLength;
+            return false;
+        }
+        if (!checkTestPackets(reader, packetCount, "Complete demo"))
+        {
+            return false;
+        }
+
+        if (packetCount > 0)
+        {
+            // An interrupted recording ends in the middle of a chunk. All the complete
+            // packets can be read.
+            dsize const lastSize = DEMO_CHUNK_HEADER_SIZE + 4 + 1 + 4 +
+                                   makeTestPacket(packetCount - 1).data.size();
+            DemoReader truncated(written.left(written.size() - lastSize + 3),
+                                 file.description() + " (truncated)");
+            if (!checkTestPackets(truncated, packetCount - 1, "Truncated demo"))
+            {
+                return false;
+            }
+        }
+    }
+    catch (Error const &er)
+    {
+        LOG_NET_ERROR("Failed to read the demo back: %s") << er.asText();
+        return false;
+    }
+    return true;
+}
@@ -25,21 +25,33 @@
 #include <doomsday/doomsdayapp.h>
 #include <doomsday/console/cmd.h>
 #include <doomsday/filesys/fs_util.h>
+#include <doomsday/resource/mapmanifests.h>
+#include <de/App>
+#include <de/FileSystem>
+#include <de/NativeFile>
+#include <de/PackageLoader>
 
+#include "client/cl_def.h"
 #include "client/cl_player.h"
 
 #include "api_filesys.h"
 #include "api_player.h"
+#include "sys_system.h"
 
+#include "network/demofile.h"
 #include "network/net_main.h"
 #include "network/net_buf.h"
 
 #include "render/rend_main.h"
 #include "render/viewports.h"
 
+#include "world/clientserverworld.h"
+#include "world/map.h"
 #include "world/p_object.h"
 #include "world/p_players.h"
 
+#include <memory>
+
 using namespace de;
 
 #define DEMOTIC SECONDS_TO_TICKS(demoTime)
@@ -49,20 +61,12 @@ using namespace de;
 #define LCAMF_FOV           0x2  ///< FOV has changed (short).
 #define LCAMF_CAMERA        0x4  ///< Camera mode.
 
-#pragma pack(1)
-struct demopacket_header_t
-{
-    dushort length;
-};
-#pragma pack()
-
 extern dfloat netConnectTime;
 
-static char const *demoPath = "/home/demo/";
+static char const *demoPath = "/home/demo";
 
-#if 0
-LZFILE *playdemo;
-#endif
+static std::unique_ptr<DemoWriter> recorders[DDMAXPLAYERS];
+static std::unique_ptr<DemoReader> playdemo;
 dint playback;
 dint viewangleDelta;
 dfloat lookdirDelta;
@@ -73,6 +77,7 @@ dd_bool demoOnGround;
 static DemoTimer readInfo;
 static dfloat startFOV;
 static dint demoStartTic;
+static bool demoCatchingUp;  ///< Packets are being read late, after seeking.
 
 void Demo_WriteLocalCamera(dint plrNum);
 
@@ -86,60 +91,53 @@ void Demo_Init()
  * Open a demo file and begin recording.
  * Returns @c false if the recording can't be begun.
  */
-dd_bool Demo_BeginRecording(char const * /*fileName*/, dint /*plrNum*/)
+dd_bool Demo_BeginRecording(char const *fileName, dint plrNum)
 {
-    return false;
+    if(plrNum < 0 || plrNum >= DDMAXPLAYERS)
+        return false;
 
-#if 0
-    client_t *cl  = &::clients[plrNum];
-    player_t *plr = &DD_Player(plrNum);
+    auto &cl = *DD_Player(plrNum);
 
     // Is a demo already being recorded for this client?
-    if(cl->recording || ::playback || (::isDedicated && !plrNum) || !plr->shared.inGame)
+    if(cl.recording || ::playback || !cl.publicData().inGame)
         return false;
 
-    // Compose the real file name.
-    ddstring_t buf; Str_Appendf(Str_InitStd(&buf), "%s%s", ::demoPath, fileName);
-    F_ExpandBasePath(&buf, &buf);
-    F_ToNativeSlashes(&buf, &buf);
+    if(!App_World().hasMap())
+        return false;
+
+    DemoHeader header;
+    header.gameId   = App_CurrentGame().id();
+    header.packages = PackageLoader::get().loadedPackageIdsInOrder();
+    header.mapId    = App_World().map().id();
 
     // Open the demo file.
-    cl->demo = lzOpen(Str_Text(&buf), "wp");
-    Str_Free(&buf);
-    if(!cl->demo)
+    try
+    {
+        Folder &folder = App::fileSystem().makeFolder(demoPath);
+        File &file = folder.replaceFile(fileName);
+        recorders[plrNum].reset(new DemoWriter(file, header));
+    }
+    catch(Error const &er)
     {
-        return false;  // Couldn't open it!
+        LOG_RES_ERROR("Failed to open demo file \"%s\": %s") << fileName << er.asText();
+        return false;
     }
 
-    cl->recording    = true;
-    cl->recordPaused = false;
+    cl.recording    = true;
+    cl.recordPaused = false;
 
-    ::writeInfo[plrNum].first       = true;
-    ::writeInfo[plrNum].canwrite    = false;
-    ::writeInfo[plrNum].cameratimer = 0;
-    ::writeInfo[plrNum].fov         = -1;  // Must be written in the first packet.
+    DemoTimer &inf = cl.demoTimer();
+    inf.first       = true;
+    inf.canwrite    = false;
+    inf.cameratimer = 0;
+    inf.fov         = -1;  // Must be written in the first packet.
 
-    if(::isServer)
-    {
-        // Playing demos alters gametic. This'll make sure we're going to get updates.
-        ::clients[0].lastTransmit = -1;
-        // Servers need to send a handshake packet.
-        // It only needs to recorded in the demo file, though.
-        ::allowSending = false;
-        Sv_Handshake(plrNum, false);
-        // Enable sending to network.
-        ::allowSending = true;
-    }
-    else
-    {
-        // Clients need a Handshake packet.
-        // Request a new one from the server.
-        Cl_SendHello();
-    }
+    // Clients need a Handshake packet.
+    // Request a new one from the server.
+    Cl_SendHello();
 
     // The operation is a success.
     return true;
-#endif
 }
 
 void Demo_PauseRecording(dint playerNum)
@@ -188,14 +186,20 @@ void Demo_StopRecording(dint playerNum)
     if(!cl.recording) return;
 
     // Close demo file.
-    //lzClose(cl.demo); cl.demo = nullptr;
+    try
+    {
+        recorders[playerNum]->finish();
+    }
+    catch(Error const &er)
+    {
+        LOG_RES_ERROR("Failed to finish demo: %s") << er.asText();
+    }
+    recorders[playerNum].reset();
     cl.recording = false;
 }
 
 void Demo_WritePacket(dint playerNum)
 {
-    DENG_UNUSED(playerNum);
-#if 0
     if(playerNum < 0)
     {
         Demo_BroadcastPacket();
@@ -227,37 +231,31 @@ void Demo_WritePacket(dint playerNum)
             return;
     }
 
-    // This counts as an update. (We know the client is alive.)
-    //::clients[playerNum].updateCount = UPDATECOUNT;
+    DemoWriter *recorder = recorders[playerNum].get();
+    DENG2_ASSERT(recorder);
 
-    LZFILE *file = cl.demo;
-    if(!file) App_Error("Demo_WritePacket: No demo file!\n");
-
-    byte ptime;
+    DemoPacket packet;
     if(!inf.first)
     {
-        ptime = (cl.recordPaused ? inf.pausetime : DEMOTIC)
-              - inf.begintime;
+        packet.tic = duint32((cl.recordPaused ? inf.pausetime : DEMOTIC) - inf.begintime);
     }
     else
     {
-        ptime = 0;
         inf.first     = false;
         inf.begintime = DEMOTIC;
     }
-    lzWrite(&ptime, 1, file);
-
-    demopacket_header_t hdr;  // The header.
-    if(::netBuffer.length >= sizeof(hdr.length))
-        App_Error("Demo_WritePacket: Write buffer too large!\n");
+    packet.type = ::netBuffer.msg.type;
+    packet.data = Block(::netBuffer.msg.data, ::netBuffer.length);
 
-    hdr.length = (dushort) 1 + ::netBuffer.length;
-    lzWrite(&hdr, sizeof(hdr), file);
-
-    // Write the packet itself.
-    lzPutC(::netBuffer.msg.type, file);
-    lzWrite(::netBuffer.msg.data, (long) netBuffer.length, file);
-#endif
+    try
+    {
+        recorder->writePacket(packet);
+    }
+    catch(Error const &er)
+    {
+        LOG_RES_ERROR("Demo recording of player %i failed: %s") << playerNum << er.asText();
+        Demo_StopRecording(playerNum);
+    }
 }
 
 void Demo_BroadcastPacket()
@@ -283,25 +281,68 @@ dd_bool Demo_BeginPlayback(char const *fileName)
             return false;
     }
 
-    // Compose the real file name.
-    ddstring_t buf; Str_Set(Str_InitStd(&buf), fileName);
-    if(!F_IsAbsolute(&buf))
+    // Open the demo file.
+    try
     {
-        Str_Prepend(&buf, demoPath);
+        // Absolute and base-relative paths refer to the native file system.
+        ddstring_t buf; Str_Set(Str_InitStd(&buf), fileName);
+        bool const isNative = F_IsAbsolute(&buf) || fileName[0] == '>' || fileName[0] == '}';
+        if(isNative)
+        {
+            F_ExpandBasePath(&buf, &buf);
+            F_ToNativeSlashes(&buf, &buf);
+        }
+        String const path = Str_Text(&buf);
+        Str_Free(&buf);
+
+        if(isNative)
+        {
+            std::unique_ptr<File> nativeFile(NativeFile::newStandalone(NativePath(path)));
+            playdemo.reset(new DemoReader(*nativeFile));
+        }
+        else
+        {
+            File const &file = App::rootFolder().locate<File const>(String(demoPath) / path);
+            playdemo.reset(new DemoReader(file));
+        }
+    }
+    catch(Error const &er)
+    {
+        LOG_RES_ERROR("Failed to open demo \"%s\": %s") << fileName << er.asText();
+        return false;
     }
-    F_ExpandBasePath(&buf, &buf);
-    F_ToNativeSlashes(&buf, &buf);
 
-    // Open the demo file.
-#if 0
-    playdemo = lzOpen(Str_Text(&buf), "rp");
-#endif
-    Str_Free(&buf);
+    if(playdemo->header().gameId != App_CurrentGame().id())
+    {
+        LOG_RES_ERROR("Demo \"%s\" was recorded with game \"%s\"")
+            << fileName << playdemo->header().gameId;
+        playdemo.reset();
+        return false;
+    }
 
-#if 0
-    if(!playdemo)
-#endif
+    // The same packages must be loaded as during the recording.
+    StringList missing;
+    for(String const &pkg : playdemo->header().packages)
+    {
+        if(!PackageLoader::get().isLoaded(pkg))
+            missing << pkg;
+    }
+    if(!missing.isEmpty())
+    {
+        LOG_RES_ERROR("Demo \"%s\" requires packages that are not loaded: %s")
+            << fileName << String::join(missing, ", ");
+        playdemo.reset();
         return false;
+    }
+
+    String const &mapId = playdemo->header().mapId;
+    if(!App_Resources().mapManifests().tryFindMapManifest(de::Uri("Maps", Path(mapId))))
+    {
+        LOG_RES_ERROR("Demo \"%s\" was recorded on map \"%s\", which is not available")
+            << fileName << mapId;
+        playdemo.reset();
+        return false;
+    }
 
     // OK, let's begin the demo.
     ::playback       = true;
@@ -314,6 +355,7 @@ dd_bool Demo_BeginPlayback(char const *fileName)
     ::demoZ          = 0;
     ::startFOV       = 95; //Rend_FieldOfView();
     ::demoStartTic   = DEMOTIC;
+    ::demoCatchingUp = false;
     std::memset(::posDelta, 0, sizeof(::posDelta));
 
     // Start counting frames from here.
@@ -329,13 +371,12 @@ void Demo_StopPlayback()
 {
     if(!::playback) return;
 
-#if 0
     LOG_MSG("Demo was %.2f seconds (%i tics) long.")
         << ((DEMOTIC - ::demoStartTic) / dfloat( TICSPERSEC ))
         << (DEMOTIC - ::demoStartTic);
 
     ::playback = false;
-    lzClose(::playdemo); playdemo = nullptr;
+    playdemo.reset();
     //::fieldOfView = ::startFOV;
     Net_StopGame();
 
@@ -353,20 +394,14 @@ void Demo_StopPlayback()
     // "Play demo once" mode?
     if(CommandLine_Check("-playdemo"))
         Sys_Quit();
-#endif
 }
 
 dd_bool Demo_ReadPacket()
 {
-    return false;
-#if 0
-    static byte ptime;
-    dint nowtime = DEMOTIC;
-
-    if(!playback)
+    if(!::playback)
         return false;
 
-    if(lzEOF(::playdemo))
+    if(!playdemo->hasPacket())
     {
         Demo_StopPlayback();
         // Any interested parties?
@@ -374,33 +409,56 @@ dd_bool Demo_ReadPacket()
         return false;
     }
 
+    dint const nowtime = DEMOTIC;
     if(::readInfo.first)
     {
         ::readInfo.first = false;
         ::readInfo.begintime = nowtime;
-        ptime = lzGetC(::playdemo);
     }
 
     // Check if the packet can be read.
-    if(Net_TimeDelta(nowtime - ::readInfo.begintime, ptime) < 0)
+    DemoPacket const &packet = playdemo->packet();
+    dint const demoTic = nowtime - ::readInfo.begintime;
+    if(dint(packet.tic) > demoTic)
         return false;  // Can't read yet.
 
-    // Read the packet.
-    demopacket_header_t hdr;
-    lzRead(&hdr, sizeof(hdr), ::playdemo);
+    // Packets that are late are being replayed after a seek.
+    ::demoCatchingUp = (demoTic - dint(packet.tic) > LOCALCAM_WRITE_TICS);
 
     // Get the packet.
-    ::netBuffer.length = hdr.length - 1;
-    ::netBuffer.player = 0; // From the server.
-    ::netBuffer.msg.type = lzGetC(::playdemo);
-    lzRead(::netBuffer.msg.data, (long) ::netBuffer.length, ::playdemo);
-    //::netBuffer.cursor = ::netBuffer.msg.data;
+    ::netBuffer.length   = packet.data.size();
+    ::netBuffer.player   = 0; // From the server.
+    ::netBuffer.msg.type = packet.type;
+    std::memcpy(::netBuffer.msg.data, packet.data.constData(), ::netBuffer.length);
+
+    playdemo->nextPacket();
+    return true;
+}
+
+/**
+ * Moves the playback position forward to @a tic. The packets up to @a tic are
+ * delivered at once. Seeking backwards is not possible because the demo does not
+ * record the world state needed for restarting from an earlier position.
+ *
+ * @return @c true if successful.
+ */
+dd_bool Demo_Seek(dint tic)
+{
+    if(!::playback) return false;
 
-    // Read the next packet time.
-    ptime = lzGetC(::playdemo);
+    tic = de::min(tic, dint(playdemo->lengthInTics()));
+    dint const nowtime = DEMOTIC;
+    dint const demoTic = (::readInfo.first ? 0 : nowtime - ::readInfo.begintime);
 
+    if(tic < demoTic)
+    {
+        LOG_NET_ERROR("Cannot seek backwards in a demo (now at %.1f seconds)")
+            << demoTic / dfloat(TICSPERSEC);
+        return false;
+    }
+    ::readInfo.first     = false;
+    ::readInfo.begintime = nowtime - tic;
     return true;
-#endif
 }
 
 /**
@@ -464,7 +522,7 @@ void Demo_ReadLocalCamera()
     if(!mob) return;
 
     dint intertics = LOCALCAM_WRITE_TICS;
-    if(::netBuffer.msg.type == PKT_DEMOCAM_RESUME)
+    if(::netBuffer.msg.type == PKT_DEMOCAM_RESUME || ::demoCatchingUp)
         intertics = 1;
 
     // Framez keeps track of the current camera Z.
@@ -586,6 +644,23 @@ D_CMD(PlayDemo)
     return Demo_BeginPlayback(argv[1]);
 }
 
+D_CMD(SeekDemo)
+{
+    DENG2_UNUSED2(src, argc);
+
+    if(!::playback)
+    {
+        LOG_SCR_ERROR("No demo is being played");
+        return false;
+    }
+
+    // The position is given in seconds.
+    dint const tic = dint(String(argv[1]).toFloat() * TICSPERSEC);
+    LOG_SCR_MSG("Seeking to %.1f seconds (of %.1f)")
+        << tic / dfloat(TICSPERSEC) << playdemo->lengthInTics() / dfloat(TICSPERSEC);
+    return Demo_Seek(tic);
+}
+
 D_CMD(RecordDemo)
 {
     DENG2_UNUSED(src);
@@ -695,6 +770,35 @@ D_CMD(StopDemo)
     return true;
 }
 
+/**
+ * Writes a test demo and reads it back to check that the recorded data is unchanged.
+ */
+D_CMD(DemoRoundTrip)
+{
+    DENG2_UNUSED3(src, argc, argv);
+
+    LOG_AS("demoroundtrip");
+
+    String const fileName = "roundtrip-check.demo";
+    bool passed = false;
+    try
+    {
+        Folder &folder = App::fileSystem().makeFolder(demoPath);
+        passed = DemoFile_CheckRoundTrip(folder.replaceFile(fileName), 1000);
+        folder.destroyFile(fileName);
+    }
+    catch(Error const &er)
+    {
+        LOG_RES_ERROR("Failed to write the test demo: %s") << er.asText();
+    }
+
+    if(passed)
+        LOG_MSG("Demo round trip check passed");
+    else
+        LOG_MSG("Demo round trip check failed");
+    return passed;
+}
+
 #if 0
 /**
  * Make a demo lump.
@@ -717,5 +821,8 @@ void Demo_Register()
     C_CMD_FLAGS("pausedemo",    nullptr,    PauseDemo,  CMDF_NO_NULLGAME);
     C_CMD_FLAGS("playdemo",     "s",        PlayDemo,   CMDF_NO_NULLGAME);
     C_CMD_FLAGS("recorddemo",   nullptr,    RecordDemo, CMDF_NO_NULLGAME);
+    C_CMD_FLAGS("seekdemo",     "s",        SeekDemo,   CMDF_NO_NULLGAME);
     C_CMD_FLAGS("stopdemo",     nullptr,    StopDemo,   CMDF_NO_NULLGAME);
+
+    C_CMD("demoroundtrip", nullptr, DemoRoundTrip);
 }
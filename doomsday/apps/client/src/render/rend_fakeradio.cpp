@@ -21,7 +21,10 @@
 #include "render/rend_fakeradio.h"
 
 #include <de/Vector>
+#include <doomsday/console/cmd.h>
 #include <doomsday/console/var.h>
+#include <QHash>
+#include <QPair>
 #include "clientapp.h"
 
 #include "gl/gl_texmanager.h"
@@ -68,6 +71,9 @@ dint rendFakeRadio              = true;  ///< cvar
 static dfloat fakeRadioDarkness = 1.2f;  ///< cvar
 byte devFakeRadioUpdate         = true;  ///< cvar
 
+static duint64 radioShadowCacheHits;      ///< Shadows found in a RadioShadowCache.
+static duint64 radioShadowCacheRebuilds;  ///< Shadows that had to be (re)projected.
+
 /**
  * Returns the "shadow darkness" (factor) for the given @a ambientLight (level), derived
  * from values in Config.
@@ -243,6 +249,69 @@ struct ProjectedShadowData
     Vector2f texCoords[4];  ///< { bl, tl, br, tr }
 };
 
+struct RadioShadowCache::WallShadows
+{
+    duint generation = 0;        ///< Cache generation when the shadows were projected.
+    dfloat shadowSize = 0;
+    ddouble edgeZ[4];            ///< { left bottom, left top, right bottom, right top }
+    dbyte receivedMask = 0;      ///< One bit per WallShadow.
+    ProjectedShadowData projected[4];
+
+    bool isValid(duint currentGeneration, WallEdge const &leftEdge, WallEdge const &rightEdge,
+                 dfloat currentShadowSize) const
+    {
+        return generation == currentGeneration
+            && fequal(shadowSize, currentShadowSize)
+            && edgeZ[0] == leftEdge .bottom().z() && edgeZ[1] == leftEdge .top().z()
+            && edgeZ[2] == rightEdge.bottom().z() && edgeZ[3] == rightEdge.top().z();
+    }
+};
+
+struct RadioShadowCache::FlatShadows
+{
+    duint generation = 0;        ///< Cache generation when the edges were prepared.
+    ShadowEdge edges[2];         ///< { left, right }
+};
+
+DENG2_PIMPL_NOREF(RadioShadowCache)
+{
+    duint generation = 1;
+    QHash<QPair<LineSideSegment const *, dint>, WallShadows> walls;
+    QHash<QPair<LineSide const *, dint>, FlatShadows *> flats;
+
+    ~Impl()
+    {
+        qDeleteAll(flats);
+    }
+};
+
+RadioShadowCache::RadioShadowCache() : d(new Impl)
+{}
+
+void RadioShadowCache::clear()
+{
+    // The entries are kept around for reuse; they are recognized as stale by their
+    // generation.
+    d->generation++;
+}
+
+duint RadioShadowCache::generation() const
+{
+    return d->generation;
+}
+
+RadioShadowCache::WallShadows &RadioShadowCache::wallShadows(LineSideSegment const &segment, dint section)
+{
+    return d->walls[qMakePair(&segment, section)];
+}
+
+RadioShadowCache::FlatShadows &RadioShadowCache::flatShadows(LineSide const &side, dint planeIndex)
+{
+    FlatShadows *&found = d->flats[qMakePair(&side, planeIndex)];
+    if (!found) found = new FlatShadows;
+    return *found;
+}
+
 static void setTopShadowParams(WallEdge const &leftEdge, WallEdge const &rightEdge, ddouble shadowSize,
     ProjectedShadowData &projected)
 {
@@ -885,8 +954,40 @@ void Rend_DrawWallRadio(WallEdge const &leftEdge, WallEdge const &rightEdge, dfl
     if(shadowSize < MIN_SHADOW_SIZE)
         return;
 
-    // Ensure we have up-to-date information for generating shadow geometry.
-    leftEdge.lineSide().updateRadioForFrame(R_FrameCount());
+    // Shadow parameters are remembered in the subsector (the edge geometry is compared,
+    // too, as it also depends on the surface and material properties).
+    DENG2_ASSERT(leftEdge.lineSide().leftHEdge());
+    auto const &subsec = leftEdge.lineSide().leftHEdge()->face().mapElementAs<ConvexSubspace>()
+                            .subsector().as<world::ClientSubsector>();
+    RadioShadowCache &cache = subsec.radioShadowCache();
+    RadioShadowCache::WallShadows &shadows = cache.wallShadows(leftEdge.lineSideSegment(),
+                                                               leftEdge.spec().section);
+    if (shadows.isValid(cache.generation(), leftEdge, rightEdge, shadowSize))
+    {
+        radioShadowCacheHits++;
+    }
+    else
+    {
+        radioShadowCacheRebuilds++;
+
+        // Ensure we have up-to-date information for generating shadow geometry.
+        leftEdge.lineSide().updateRadioForFrame(R_FrameCount());
+
+        shadows.generation   = cache.generation();
+        shadows.shadowSize   = shadowSize;
+        shadows.edgeZ[0]     = leftEdge .bottom().z();
+        shadows.edgeZ[1]     = leftEdge .top   ().z();
+        shadows.edgeZ[2]     = rightEdge.bottom().z();
+        shadows.edgeZ[3]     = rightEdge.top   ().z();
+        shadows.receivedMask = 0;
+        for (dint i = TopShadow; i <= RightShadow; ++i)
+        {
+            if (projectWallShadow(leftEdge, rightEdge, WallShadow(i), shadowSize, shadows.projected[i]))
+            {
+                shadows.receivedMask |= 1 << i;
+            }
+        }
+    }
 
     Vector3f const posCoords[] = {
         leftEdge .bottom().origin(),
@@ -895,66 +996,76 @@ void Rend_DrawWallRadio(WallEdge const &leftEdge, WallEdge const &rightEdge, dfl
         rightEdge.top   ().origin()
     };
 
-    ProjectedShadowData projected;
-
-    if(projectWallShadow(leftEdge, rightEdge, TopShadow, shadowSize, projected))
+    if (shadows.receivedMask & (1 << TopShadow))
     {
         drawWallShadow(posCoords, leftEdge, rightEdge, shadowDark,
-                       projected);
+                       shadows.projected[TopShadow]);
     }
 
-    if(projectWallShadow(leftEdge, rightEdge, BottomShadow, shadowSize, projected))
+    if (shadows.receivedMask & (1 << BottomShadow))
     {
         drawWallShadow(posCoords, leftEdge, rightEdge, shadowDark,
-                       projected);
+                       shadows.projected[BottomShadow]);
     }
 
-    if(projectWallShadow(leftEdge, rightEdge, LeftShadow, shadowSize, projected))
+    if (shadows.receivedMask & (1 << LeftShadow))
     {
         drawWallShadow(posCoords, leftEdge, rightEdge,
                        shadowDark * de::cubed(wallSideOpenness(leftEdge, rightEdge, false/*left edge*/) * .8f),
-                       projected);
+                       shadows.projected[LeftShadow]);
     }
 
-    if(projectWallShadow(leftEdge, rightEdge, RightShadow, shadowSize, projected))
+    if (shadows.receivedMask & (1 << RightShadow))
     {
         drawWallShadow(posCoords, leftEdge, rightEdge,
                        shadowDark * de::cubed(wallSideOpenness(leftEdge, rightEdge, true/*right edge*/) * .8f),
-                       projected);
+                       shadows.projected[RightShadow]);
     }
 }
 
 /**
- * Determines whether FakeRadio flat, shadow geometry should be drawn between the vertices of
- * the given half-edges @a hEdges and prepares the ShadowEdges @a edges accordingly.
+ * Finds the ShadowEdges of FakeRadio flat, shadow geometry between the vertices of the
+ * given line @a side, preparing them if the ones remembered in the subsector of the
+ * side are no longer valid.
  *
- * @param edges             ShadowEdge descriptors for both edges { left, right }.
- * @param hEdges            Half-edge accessors for both edges { left, right }.
+ * @param side              Shadow casting line side.
  * @param sectorPlaneIndex  Logical index of the sector plane to consider a shadow for.
- * @param shadowDark        Shadow darkness factor.
  *
- * @return  @c true if one or both edges are partially in shadow.
+ * @return  ShadowEdge descriptors for both edges { left, right }, or @c nullptr if no
+ * shadow should be drawn.
  */
-static bool prepareFlatShadowEdges(ShadowEdge edges[2], HEdge const *hEdges[2], dint sectorPlaneIndex,
-    dfloat shadowDark)
+static ShadowEdge const *findFlatShadowEdges(LineSide const &side, dint sectorPlaneIndex)
 {
-    DENG2_ASSERT(edges && hEdges && hEdges[0] && hEdges[1]);
+    HEdge const &hedge = *side.leftHEdge();
 
     // If the sector containing the shadowing line section is fully closed (i.e., volume is
     // not positive) then skip shadow drawing entirely.
     /// @todo Encapsulate this logic in ShadowEdge -ds
-    if(!hEdges[0]->hasFace() || !hEdges[0]->face().hasMapElement())
-        return false;
+    if(!hedge.hasFace() || !hedge.face().hasMapElement())
+        return nullptr;
 
-    if(!hEdges[0]->face().mapElementAs<ConvexSubspace>().subsector().as<world::ClientSubsector>().hasWorldVolume())
-        return false;
+    auto const &subsec = hedge.face().mapElementAs<ConvexSubspace>().subsector().as<world::ClientSubsector>();
+    if(!subsec.hasWorldVolume())
+        return nullptr;
 
-    for(dint i = 0; i < 2; ++i)
+    RadioShadowCache &cache = subsec.radioShadowCache();
+    RadioShadowCache::FlatShadows &shadows = cache.flatShadows(side, sectorPlaneIndex);
+    if(shadows.generation == cache.generation())
+    {
+        radioShadowCacheHits++;
+    }
+    else
     {
-        edges[i].init(*hEdges[i], i);
-        edges[i].prepare(sectorPlaneIndex);
+        radioShadowCacheRebuilds++;
+
+        for(dint i = 0; i < 2; ++i)
+        {
+            shadows.edges[i].init(hedge, i);
+            shadows.edges[i].prepare(sectorPlaneIndex);
+        }
+        shadows.generation = cache.generation();
     }
-    return (edges[0].shadowStrength(shadowDark) >= .0001 && edges[1].shadowStrength(shadowDark) >= .0001);
+    return shadows.edges;
 }
 
 static uint makeFlatShadowGeometry(DrawList::Indices &indices, Store &verts, gl::Primitive &primitive,
@@ -1022,7 +1133,6 @@ void Rend_DrawFlatRadio(ConvexSubspace const &subspace)
         return;
 
     static DrawList::Indices indices;
-    static ShadowEdge shadowEdges[2/*left, right*/];  // Keep these around (needed often).
 
     // Can skip drawing for Planes that do not face the viewer - find the 2D vector to subspace center.
     auto const eyeToSubspace = Vector2f(Rend_EyeOrigin().xz() - subspace.poly().center());
@@ -1057,9 +1167,11 @@ void Rend_DrawFlatRadio(ConvexSubspace const &subspace)
                 if (Vector3f(eyeToSubspace, Rend_EyeOrigin().y - plane.heightSmoothed())
                          .dot(plane.surface().normal()) >= 0)
                 {
-                    HEdge const *hEdges[2/*left, right*/] = { side.leftHEdge(), side.leftHEdge() };
+                    ShadowEdge const *shadowEdges = findFlatShadowEdges(side, pln);
 
-                    if (prepareFlatShadowEdges(shadowEdges, hEdges, pln, shadowDark))
+                    if (shadowEdges
+                        && shadowEdges[0].shadowStrength(shadowDark) >= .0001
+                        && shadowEdges[1].shadowStrength(shadowDark) >= .0001)
                     {
                         bool const haveFloor = plane.surface().normal()[2] > 0;
 
@@ -1081,8 +1193,23 @@ void Rend_DrawFlatRadio(ConvexSubspace const &subspace)
     });
 }
 
+D_CMD(FakeRadioStats)
+{
+    DENG2_UNUSED3(src, argc, argv);
+
+    duint64 const total = radioShadowCacheHits + radioShadowCacheRebuilds;
+    LOG_SCR_MSG("FakeRadio shadows: %i cached, %i rebuilt (%.1f%% cached)")
+            << radioShadowCacheHits << radioShadowCacheRebuilds
+            << (total? 100.0 * radioShadowCacheHits / total : 0.0);
+
+    radioShadowCacheHits = radioShadowCacheRebuilds = 0;
+    return true;
+}
+
 void Rend_RadioRegister()
 {
+    C_CMD      ("fakeradiostats",               "",                     FakeRadioStats);
+
     C_VAR_INT  ("rend-fakeradio",               &::rendFakeRadio,       0, 0, 2);
     C_VAR_FLOAT("rend-fakeradio-darkness",      &::fakeRadioDarkness,   0, 0, 2);
 
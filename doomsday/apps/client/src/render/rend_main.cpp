@@ -100,6 +100,7 @@
 #include <de/vector1.h>
 #include <de/GLInfo>
 #include <de/GLState>
+#include <de/Time>
 #include <QtAlgorithms>
 #include <QBitArray>
 #include <cmath>
@@ -305,6 +306,7 @@ dbyte devSectorIndices;          ///< @c 1= Draw sector indicies.
 dbyte devThinkerIds;             ///< @c 1= Draw (mobj) thinker indicies.
 
 dbyte rendInfoLums;              ///< @c 1= Print lumobj debug info to the console.
+dbyte rendInfoGeometry;          ///< @c 1= Print world geometry generation time to the console.
 dbyte devDrawLums;               ///< @c 1= Draw lumobjs origins.
 
 #if 0
@@ -1017,24 +1019,40 @@ static void lightWallOrFlatGeometry(Geometry &verts, duint numVertices, Vector3f
 }
 
 static void makeFlatGeometry(Geometry &verts, duint numVertices, Vector3f const *posCoords,
-    Vector3d const &topLeft, Vector3d const & /*bottomRight*/, MapElement &mapElement, dint geomGroup,
-    Matrix3f const &surfaceTangents, dfloat uniformOpacity, Vector3f const &color, Vector3f const *color2,
-    dfloat glowing, dfloat const luminosityDeltas[2], bool useVertexLighting = true)
+    Vector2f const *texCoords, Vector3d const &topLeft, Vector3d const & /*bottomRight*/,
+    MapElement &mapElement, dint geomGroup, Matrix3f const &surfaceTangents, dfloat uniformOpacity,
+    Vector3f const &color, Vector3f const *color2, dfloat glowing, dfloat const luminosityDeltas[2],
+    bool useVertexLighting = true)
 {
     DENG2_ASSERT(posCoords);
 
-    for (duint i = 0; i < numVertices; ++i)
-    {
-        verts.pos[i] = posCoords[i];
+    std::memcpy(verts.pos, posCoords, sizeof(Vector3f) * numVertices);
 
-        Vector3f const delta(posCoords[i] - topLeft);
+    if (texCoords)
+    {
+        // Use the retained texture coordinates.
         if (verts.tex)  // Primary.
         {
-            verts.tex[i] = Vector2f(delta.x, -delta.y);
+            std::memcpy(verts.tex, texCoords, sizeof(Vector2f) * numVertices);
         }
         if (verts.tex2)  // Inter.
         {
-            verts.tex2[i] = Vector2f(delta.x, -delta.y);
+            std::memcpy(verts.tex2, texCoords, sizeof(Vector2f) * numVertices);
+        }
+    }
+    else
+    {
+        for (duint i = 0; i < numVertices; ++i)
+        {
+            Vector3f const delta(posCoords[i] - topLeft);
+            if (verts.tex)  // Primary.
+            {
+                verts.tex[i] = Vector2f(delta.x, -delta.y);
+            }
+            if (verts.tex2)  // Inter.
+            {
+                verts.tex2[i] = Vector2f(delta.x, -delta.y);
+            }
         }
     }
 
@@ -1339,6 +1357,10 @@ struct rendworldpoly_params_t
     dint            geomGroup;
 
     bool            isWall;
+// Flat only:
+    struct {
+        Vector2f const *texCoords;      ///< Retained texture coordinates (if any).
+    } flat;
 // Wall only:
     struct {
         coord_t width;
@@ -1395,7 +1417,7 @@ static bool renderWorldPoly(Vector3f const *rvertices, duint numVertices,
     }
     else
     {
-        makeFlatGeometry(verts, numVertices, rvertices, *p.topLeft, *p.bottomRight,
+        makeFlatGeometry(verts, numVertices, rvertices, p.flat.texCoords, *p.topLeft, *p.bottomRight,
                          *p.mapElement, p.geomGroup, *p.surfaceTangentMatrix,
                          p.alpha, *p.surfaceColor, p.wall.surfaceColor2, p.glowing, p.surfaceLuminosityDeltas,
                          !skyMaskedMaterial);
@@ -2651,6 +2673,12 @@ static void wallLuminosityDeltas(WallEdge const &leftEdge, WallEdge const &right
     }
 }
 
+/**
+ * @todo Performance: Retain the wall geometry between frames like the flat geometry
+ * (see ConvexSubspace::flatGeometry()). The edges depend on the planes on both sides
+ * of the line, the surface material origins and the line flags, so all of these would
+ * need to mark the geometry dirty.
+ */
 static void writeWall(WallEdge const &leftEdge, WallEdge const &rightEdge,
     bool *retWroteOpaque = nullptr, coord_t *retBottomZ = nullptr, coord_t *retTopZ = nullptr)
 {
@@ -2786,55 +2814,6 @@ static void writeWall(WallEdge const &leftEdge, WallEdge const &rightEdge,
     if (retTopZ)        *retTopZ        = rightEdge.top   ().z();
 }
 
-/**
- * Prepare a trifan geometry according to the edges of the current subspace.
- * If a fan base HEdge has been chosen it will be used as the center of the
- * trifan, else the mid point of this leaf will be used instead.
- *
- * @param direction  Vertex winding direction.
- * @param height     Z map space height coordinate to be set for each vertex.
- * @param verts      Built position coordinates are written here. It is the
- *                   responsibility of the caller to release this storage with
- *                   @ref R_FreeRendVertices() when done.
- *
- * @return  Number of built vertices.
- */
-static duint buildSubspacePlaneGeometry(ClockDirection direction, coord_t height,
-    Vector3f **verts)
-{
-    DENG2_ASSERT(verts);
-
-    Face const &poly       = curSubspace->poly();
-    HEdge *fanBase         = curSubspace->fanBase();
-    duint const totalVerts = poly.hedgeCount() + (!fanBase? 2 : 0);
-
-    *verts = R_AllocRendVertices(totalVerts);
-
-    duint n = 0;
-    if (!fanBase)
-    {
-        (*verts)[n] = Vector3f(poly.center(), height);
-        n++;
-    }
-
-    // Add the vertices for each hedge.
-    HEdge *baseNode = fanBase? fanBase : poly.hedge();
-    HEdge *node = baseNode;
-    do
-    {
-        (*verts)[n] = Vector3f(node->origin(), height);
-        n++;
-    } while ((node = &node->neighbor(direction)) != baseNode);
-
-    // The last vertex is always equal to the first.
-    if (!fanBase)
-    {
-        (*verts)[n] = Vector3f(poly.hedge()->origin(), height);
-    }
-
-    return totalVerts;
-}
-
 static void writeSubspacePlane(Plane &plane)
 {
     Face const &poly       = curSubspace->poly();
@@ -2952,13 +2931,12 @@ static void writeSubspacePlane(Plane &plane)
         curSectorLightLevel = plane.sector().lightLevel();
     }
 
-    // Allocate position coordinates.
-    Vector3f *posCoords;
-    duint vertCount = buildSubspacePlaneGeometry((plane.isSectorCeiling())? Anticlockwise : Clockwise,
-                                                 plane.heightSmoothed(), &posCoords);
+    // The geometry is retained by the subspace and only rebuilt when necessary.
+    ConvexSubspace::FlatGeometry const geom = curSubspace->flatGeometry(plane);
+    parm.flat.texCoords = geom.texCoords;
 
     // Draw this section.
-    renderWorldPoly(posCoords, vertCount, parm, matAnimator);
+    renderWorldPoly(geom.posCoords, geom.vertCount, parm, matAnimator);
 
     if (&plane.sector() != &curSubspace->subsector().sector())
     {
@@ -2967,8 +2945,6 @@ static void writeSubspacePlane(Plane &plane)
         curSectorLightColor = color.toVector3f();
         curSectorLightLevel = color.w;
     }
-
-    R_FreeRendVertices(posCoords);
 }
 
 static void writeSkyMaskStrip(dint vertCount, Vector3f const *posCoords, Vector2f const *texCoords,
@@ -4451,10 +4427,13 @@ static void drawMasked()
 
     R_SortVisSprites();
 
-    if (::visSpriteP && ::visSpriteP > ::visSprites)
+    if (R_VisSpriteCount() > 0)
     {
         bool primaryHaloDrawn = false;
 
+        // Prepare the vertices of all the models in advance.
+        Rend_ModelPrepareBatch();
+
         // Draw all vissprites back to front.
         // Sprites look better with Z buffer writes turned off.
         for (vissprite_t *spr = ::visSprSortedHead.next; spr != &::visSprSortedHead; spr = spr->next)
@@ -4507,6 +4486,8 @@ static void drawMasked()
             // And we're done...
             H_SetupState(false);
         }
+
+        Rend_ModelEndBatch();
     }
 }
 
@@ -4718,6 +4699,30 @@ static void drawAllLists(Map &map)
     DENG2_ASSERT(!Sys_GLCheckError());
 }
 
+/**
+ * Accumulates the time spent generating world geometry and periodically prints the
+ * average time per frame.
+ */
+static void reportGeometryTime(TimeSpan elapsed)
+{
+    static Time periodStartedAt;
+    static ddouble periodTotal;
+    static dint periodFrames;
+
+    periodTotal += elapsed;
+    periodFrames++;
+
+    if (periodStartedAt.since() >= 2.0)
+    {
+        LOG_GL_MSG("World geometry: %.3f ms/frame (%i frames)")
+                << periodTotal * 1000 / periodFrames << periodFrames;
+
+        periodStartedAt = Time();
+        periodTotal     = 0;
+        periodFrames    = 0;
+    }
+}
+
 void Rend_RenderMap(Map &map)
 {
     //GL_SetMultisample(true);
@@ -4761,7 +4766,12 @@ void Rend_RenderMap(Map &map)
         curSubspace = nullptr;
 
         // Draw the world!
+        Time const startedAt;
         traverseBspTreeAndDrawSubspaces(&map.bspTree());
+        if (rendInfoGeometry)
+        {
+            reportGeometryTime(startedAt.since());
+        }
     }
     drawAllLists(map);
 
@@ -6430,6 +6440,7 @@ void Rend_Register()
     C_VAR_FLOAT("rend-glow-scale", &glowHeightFactor, 0, 0.1f, 10);
     C_VAR_INT("rend-glow-wall", &useGlowOnWalls, 0, 0, 1);
 
+    C_VAR_BYTE("rend-info-geometry", &rendInfoGeometry, CVF_NO_ARCHIVE, 0, 1);
     C_VAR_BYTE("rend-info-lums", &rendInfoLums, 0, 0, 1);
 
     C_VAR_INT2("rend-light", &useDynLights, 0, 0, 1, useDynlightsChanged);
@@ -6516,6 +6527,7 @@ void Rend_Register()
 
     Rend_RadioRegister();
     Rend_SpriteRegister();
+    R_VisSpriteRegister();
     PostProcessing::consoleRegister();
     fx::Bloom::consoleRegister();
     fx::Vignette::consoleRegister();
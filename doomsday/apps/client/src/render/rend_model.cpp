@@ -42,6 +42,7 @@
 #include "ClientTexture"
 #include "ClientMaterial"
 
+#include <doomsday/console/cmd.h>
 #include <doomsday/console/var.h>
 #include <doomsday/world/Materials>
 #include <de/Log>
@@ -50,9 +51,13 @@
 #include <de/binangle.h>
 #include <de/memory.h>
 #include <de/concurrency.h>
+#include <de/TaskPool>
+#include <de/Time>
+#include <QHash>
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
+#include <vector>
 
 using namespace de;
 
@@ -84,6 +89,7 @@ float modelSpinSpeed   = 1;
 int maxModelDistance   = 1500;
 float rend_model_lod   = 256;
 byte precacheSkins     = true;
+byte batchModels       = true;
 
 static bool inited;
 
@@ -101,16 +107,14 @@ static Vector3f *modelNormCoords;
 static Vector4ub *modelColorCoords;
 static Vector2f *modelTexCoords;
 
-// Global variables for ease of use. (Egads!)
-static Vector3f modelCenter;
-static FrameModelLOD *activeLod;
-
 static uint vertexBufferMax; ///< Maximum number of vertices we'll be required to render per submodel.
 static uint vertexBufferSize; ///< Current number of vertices supported by the render buffer.
 #ifdef DENG_DEBUG
 static bool announcedVertexBufferMaxBreach; ///< @c true if an attempt has been made to expand beyond our capability.
 #endif
 
+D_CMD(ModelBatchBench);
+
 /*static void modelAspectModChanged()
 {
     /// @todo Reload and resize all models.
@@ -129,6 +133,9 @@ void Rend_ModelRegister()
     C_VAR_FLOAT("rend-model-spin-speed",     &modelSpinSpeed,       CVF_NO_MAX | CVF_NO_MIN, 0, 0);
     //C_VAR_INT  ("rend-model-shiny-multitex", &modelShinyMultitex,   0, 0, 1);
     C_VAR_FLOAT("rend-model-shiny-strength", &modelShinyFactor,     0, 0, 10);
+    C_VAR_BYTE ("rend-model-batch",          &batchModels,          0, 0, 1);
+
+    C_CMD("modelbatchbench", NULL, ModelBatchBench);
 }
 
 void Rend_ModelInit()
@@ -465,39 +472,59 @@ static void drawPrimitives(rendcmd_t mode,
     DGL_End();
 }
 
+/**
+ * Rotation of M_RotateVector() in matrix form, so that the trigonometry only needs
+ * to be done once when rotating a set of vectors.
+ */
+struct VectorRotation
+{
+    dfloat m[3][3];
+
+    VectorRotation(dfloat degYaw, dfloat degPitch)
+    {
+        for (dint col = 0; col < 3; ++col)
+        {
+            dfloat basis[3] = { 0, 0, 0 };
+            basis[col] = 1;
+            M_RotateVector(basis, degYaw, degPitch);
+            for (dint row = 0; row < 3; ++row)
+            {
+                m[row][col] = basis[row];
+            }
+        }
+    }
+};
+
 /**
  * Interpolate linearly between two sets of vertices.
+ *
+ * All vertices are processed regardless of the active LOD so that the loops have no
+ * branches and can be vectorized by the compiler.
  */
 static void Mod_LerpVertices(float inter, int count, FrameModelFrame const &from,
     FrameModelFrame const &to, Vector3f *posOut, Vector3f *normOut)
 {
     DENG2_ASSERT(&from.model == &to.model); // sanity check.
-    DENG2_ASSERT(!activeLod || &activeLod->model == &from.model); // sanity check.
     DENG2_ASSERT(from.vertices.count() == to.vertices.count()); // sanity check.
+    DENG2_ASSERT(from.vertices.count() >= count); // sanity check.
 
-    FrameModelFrame::VertexBuf::const_iterator startIt = from.vertices.begin();
-    FrameModelFrame::VertexBuf::const_iterator endIt   = to.vertices.begin();
+    FrameModelFrame::Vertex const *start = from.vertices.constData();
+    FrameModelFrame::Vertex const *end   = to.vertices.constData();
 
     if (&from == &to || de::fequal(inter, 0))
     {
-        for (int i = 0; i < count; ++i, startIt++, posOut++, normOut++)
+        for (int i = 0; i < count; ++i)
         {
-            if (!activeLod || activeLod->hasVertex(i))
-            {
-                *posOut  = startIt->pos;
-                *normOut = startIt->norm;
-            }
+            posOut[i]  = start[i].pos;
+            normOut[i] = start[i].norm;
         }
     }
     else
     {
-        for (int i = 0; i < count; ++i, startIt++, endIt++, posOut++, normOut++)
+        for (int i = 0; i < count; ++i)
         {
-            if (!activeLod || activeLod->hasVertex(i))
-            {
-                *posOut  = de::lerp(startIt->pos,  endIt->pos,  inter);
-                *normOut = de::lerp(startIt->norm, endIt->norm, inter);
-            }
+            posOut[i]  = start[i].pos  + (end[i].pos  - start[i].pos)  * inter;
+            normOut[i] = start[i].norm + (end[i].norm - start[i].norm) * inter;
         }
     }
 }
@@ -518,8 +545,6 @@ static void Mod_MirrorCoords(dint count, Vector3f *coords, dint axis)
  * @param yaw     Yaw rotation angle.
  * @param pitch   Pitch rotation angle.
  * @param invert  @c true= flip light normal (for use with inverted models).
- *
- * @todo Construct a rotation matrix once and use it for all lights.
  */
 static Vector3f rotateLightVector(VectorLightData const &vlight, dfloat yaw, dfloat pitch,
     bool invert = false)
@@ -537,53 +562,73 @@ static Vector3f rotateLightVector(VectorLightData const &vlight, dfloat yaw, dfl
     return Vector3f(rotated);
 }
 
+/// Maximum number of vector lights affecting a model (see "rend-model-lights").
+#define MAX_MODEL_LIGHTS    11
+
+/**
+ * Vector light affecting a model, with the direction already in model space.
+ */
+struct ModelLight
+{
+    Vector3f direction;
+    Vector3f color;
+    dfloat offset;
+    dfloat lightSide;
+    dfloat darkSide;
+    bool affectedByAmbient;
+};
+
 /**
  * Calculate vertex lighting.
+ *
+ * The vertices are processed in blocks: the contribution of each light is accumulated
+ * for the whole block at a time.
  */
 static void Mod_VertexColors(Vector4ub *out, dint count, Vector3f const *normCoords,
-    duint lightListIdx, duint maxLights, Vector4f const &ambient, bool invert,
-    dfloat rotateYaw, dfloat rotatePitch)
+    ModelLight const *lights, dint lightCount, Vector4f const &ambient)
 {
+    static dint const BLOCK_SIZE = 64;
+
     Vector4f const saturated(1, 1, 1, 1);
+    Vector3f accum[2][BLOCK_SIZE];  // [color, extra]
 
-    for (dint i = 0; i < count; ++i, out++, normCoords++)
+    for (dint first = 0; first < count; first += BLOCK_SIZE)
     {
-        if (activeLod && !activeLod->hasVertex(i))
-            continue;
+        dint const num = de::min(BLOCK_SIZE, count - first);
+        Vector3f const *normal = normCoords + first;
 
-        Vector3f const &normal = *normCoords;
+        // Begin with total darkness.
+        for (dint i = 0; i < num; ++i)
+        {
+            accum[0][i] = accum[1][i] = Vector3f();
+        }
 
         // Accumulate contributions from all affecting lights.
-        dint numProcessed = 0;
-        Vector3f accum[2];  // Begin with total darkness [color, extra].
-        ClientApp::renderSystem().forAllVectorLights(lightListIdx, [&maxLights, &invert, &rotateYaw
-                                                      , &rotatePitch, &normal
-                                                      , &accum, &numProcessed] (VectorLightData const &vlight)
+        for (dint k = 0; k < lightCount; ++k)
         {
-            numProcessed += 1;
-
-            // We must transform the light vector to model space.
-            Vector3f const lightDirection
-                    = rotateLightVector(vlight, rotateYaw, rotatePitch, invert);
-
-            dfloat strength = lightDirection.dot(normal)
-                            + vlight.offset;  // Shift a bit towards the light.
+            ModelLight const &light = lights[k];
+            Vector3f *dest = accum[light.affectedByAmbient? 0 : 1];
 
-            // Ability to both light and shade.
-            if (strength > 0) strength *= vlight.lightSide;
-            else             strength *= vlight.darkSide;
+            for (dint i = 0; i < num; ++i)
+            {
+                dfloat strength = light.direction.x * normal[i].x
+                                + light.direction.y * normal[i].y
+                                + light.direction.z * normal[i].z
+                                + light.offset;  // Shift a bit towards the light.
 
-            accum[vlight.affectedByAmbient? 0 : 1]
-                += vlight.color * de::clamp(-1.f, strength, 1.f);
+                // Ability to both light and shade.
+                strength *= (strength > 0? light.lightSide : light.darkSide);
 
-            // Time to stop?
-            return (maxLights && duint(numProcessed) == maxLights);
-        });
+                dest[i] += light.color * de::clamp(-1.f, strength, 1.f);
+            }
+        }
 
         // Check for ambient and convert to ubyte.
-        Vector4f color(accum[0].max(ambient) + accum[1], ambient[3]);
-
-        *out = (color.min(saturated) * 255).toVector4ub();
+        for (dint i = 0; i < num; ++i)
+        {
+            Vector4f color(accum[0][i].max(ambient) + accum[1][i], ambient[3]);
+            out[first + i] = (color.min(saturated) * 255).toVector4ub();
+        }
     }
 }
 
@@ -617,20 +662,16 @@ static void Mod_FixedVertexColors(dint count, Vector4ub *colorCoords, Vector4ub
 static void Mod_ShinyCoords(Vector2f *out, int count, Vector3f const *normCoords,
     float normYaw, float normPitch, float shinyAng, float shinyPnt, float reactSpeed)
 {
-    for (int i = 0; i < count; ++i, out++, normCoords++)
-    {
-        if (activeLod && !activeLod->hasVertex(i))
-            continue;
+    // Rotate the normal vectors so that they approximate the model's orientation
+    // compared to the viewer. The rotation is the same for all vertices.
+    VectorRotation const rot((shinyPnt + normYaw) * 360 * reactSpeed,
+                             (shinyAng + normPitch - .5f) * 180 * reactSpeed);
 
-        float rotatedNormal[3] = { normCoords->x, normCoords->y, normCoords->z };
-
-        // Rotate the normal vector so that it approximates the
-        // model's orientation compared to the viewer.
-        M_RotateVector(rotatedNormal,
-                       (shinyPnt + normYaw) * 360 * reactSpeed,
-                       (shinyAng + normPitch - .5f) * 180 * reactSpeed);
-
-        *out = Vector2f(rotatedNormal[0] + 1, rotatedNormal[2]);
+    for (int i = 0; i < count; ++i)
+    {
+        Vector3f const &n = normCoords[i];
+        out[i] = Vector2f(rot.m[0][0] * n.x + rot.m[0][1] * n.y + rot.m[0][2] * n.z + 1,
+                          rot.m[2][0] * n.x + rot.m[2][1] * n.y + rot.m[2][2] * n.z);
     }
 }
 
@@ -709,10 +750,48 @@ static inline MaterialVariantSpec const &modelSkinMaterialSpec()
                                  1, -2, -1, true, true, false, false);
 }
 
-static void drawSubmodel(uint number, vissprite_t const &spr)
+/**
+ * Parameters for drawing one submodel of a model vissprite. These are resolved before
+ * drawing so that the vertices can be prepared in advance (and concurrently).
+ */
+struct SubmodelParams
+{
+    enum Lighting { FullBright, UniformLight, VectorLit };
+
+    FrameModelDef *mf;
+    FrameModelDef *mfNext;
+    FrameModel *mdl;
+    FrameModelFrame *frame;
+    FrameModelFrame *nextFrame;
+    FrameModelLOD *lod;
+    dint numVerts;
+    dint zSign;
+    dfloat inter;
+    dfloat alpha;
+    blendmode_t blending;
+
+    Lighting lighting;
+    Vector4f ambient;
+    ModelLight lights[MAX_MODEL_LIGHTS];
+    dint lightCount;
+
+    dfloat shininess;
+    Vector4f shinyColor;
+    dfloat normYaw;
+    dfloat normPitch;
+    dfloat shinyAng;
+    dfloat shinyPnt;
+    dfloat shinyReact;
+};
+
+/**
+ * Determines how submodel @a number of the model vissprite @a spr is to be drawn.
+ *
+ * @return  @c false if the submodel should not be drawn.
+ */
+static bool resolveSubmodel(uint number, vissprite_t const &spr, SubmodelParams &p)
 {
     drawmodelparams_t const &parm = *VS_MODEL(&spr);
-    int const zSign = (spr.pose.mirrored? -1 : 1);
     FrameModelDef *mf = parm.mf, *mfNext = parm.nextMF;
     SubmodelDef const &smf = mf->subModelDef(number);
 
@@ -720,7 +799,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
 
     // Do not bother with infinitely small models...
     if (mf->scale == Vector3f(0, 0, 0))
-        return;
+        return false;
 
     float alpha = spr.light.ambientColor[CA];
 
@@ -733,7 +812,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     }
 
     // Would this be visible?
-    if (alpha <= 0) return;
+    if (alpha <= 0) return false;
 
     blendmode_t blending = smf.blendMode;
     // Is the submodel-defined blend mode in effect?
@@ -742,8 +821,6 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
         blending = BM_ADD;
     }
 
-    int useSkin = chooseSkin(*mf, number, parm.id, parm.selector, parm.tmap);
-
     // Scale interpos. Intermark becomes zero and endmark becomes one.
     // (Full sub-interpolation!) But only do it for the standard
     // interrange. If a custom one is defined, don't touch interpos.
@@ -792,47 +869,22 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     int numVerts = mdl.vertexCount();
 
     // Ensure our vertex render buffers can accommodate this.
-    if (!resizeVertexBuffer(numVerts))
+    if (!Rend_ModelExpandVertexBuffers(numVerts))
     {
         // No can do, we aint got the power!
-        return;
-    }
-
-    // Setup transformation.
-    DGL_MatrixMode(DGL_MODELVIEW);
-    DGL_PushMatrix();
-
-    // Model space => World space
-    DGL_Translatef(spr.pose.origin[VX] + spr.pose.srvo[VX] +
-                   de::lerp(mf->offset.x, mfNext->offset.x, inter),
-                   spr.pose.origin[VZ] + spr.pose.srvo[VZ] +
-                   de::lerp(mf->offset.y, mfNext->offset.y, inter),
-                   spr.pose.origin[VY] + spr.pose.srvo[VY] + zSign *
-                   de::lerp(mf->offset.z, mfNext->offset.z, inter));
-
-    if (spr.pose.extraYawAngle || spr.pose.extraPitchAngle)
-    {
-        // Sky models have an extra rotation.
-        DGL_Scalef(1, 200 / 240.0f, 1);
-        DGL_Rotatef(spr.pose.extraYawAngle, 1, 0, 0);
-        DGL_Rotatef(spr.pose.extraPitchAngle, 0, 0, 1);
-        DGL_Scalef(1, 240 / 200.0f, 1);
+        return false;
     }
 
-    // Model rotation.
-    DGL_Rotatef(spr.pose.viewAligned? spr.pose.yawAngleOffset   : spr.pose.yaw,   0, 1, 0);
-    DGL_Rotatef(spr.pose.viewAligned? spr.pose.pitchAngleOffset : spr.pose.pitch, 0, 0, 1);
-
-    // Scaling and model space offset.
-    DGL_Scalef(de::lerp(mf->scale.x, mfNext->scale.x, inter),
-             de::lerp(mf->scale.y, mfNext->scale.y, inter),
-             de::lerp(mf->scale.z, mfNext->scale.z, inter));
-    if (spr.pose.extraScale)
-    {
-        // Particle models have an extra scale.
-        DGL_Scalef(spr.pose.extraScale, spr.pose.extraScale, spr.pose.extraScale);
-    }
-    DGL_Translatef(smf.offset.x, smf.offset.y, smf.offset.z);
+    p.mf        = mf;
+    p.mfNext    = mfNext;
+    p.mdl       = &mdl;
+    p.frame     = frame;
+    p.nextFrame = nextFrame;
+    p.numVerts  = numVerts;
+    p.zSign     = (spr.pose.mirrored? -1 : 1);
+    p.inter     = inter;
+    p.alpha     = alpha;
+    p.blending  = blending;
 
     // Determine the suitable LOD.
     if (mdl.lodCount() > 1 && rend_model_lod != 0)
@@ -844,73 +896,64 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
         }
 
         // Determine the LOD we will be using.
-        activeLod = &mdl.lod(de::clamp<int>(0, lodFactor * spr.pose.distance, mdl.lodCount() - 1));
+        p.lod = &mdl.lod(de::clamp<int>(0, lodFactor * spr.pose.distance, mdl.lodCount() - 1));
     }
     else
     {
-        activeLod = 0;
-    }
-
-    // Interpolate vertices and normals.
-    Mod_LerpVertices(inter, numVerts, *frame, *nextFrame,
-                     modelPosCoords, modelNormCoords);
-
-    if (zSign < 0)
-    {
-        Mod_MirrorCoords(numVerts, modelPosCoords, 2);
-        Mod_MirrorCoords(numVerts, modelNormCoords, 1);
+        p.lod = 0;
     }
 
-    // Coordinates to the center of the model (game coords).
-    modelCenter = Vector3f(spr.pose.origin[VX], spr.pose.origin[VY], spr.pose.midZ())
-            + Vector3d(spr.pose.srvo) + Vector3f(mf->offset.x, mf->offset.z, mf->offset.y);
-
-    // Calculate lighting.
-    Vector4f ambient;
+    // Determine lighting.
+    p.lightCount = 0;
     if (smf.testFlag(MFF_FULLBRIGHT) && !smf.testFlag(MFF_DIM))
     {
         // Submodel-specific lighting override.
-        ambient = Vector4f(1, 1, 1, 1);
-        Mod_FullBrightVertexColors(numVerts, modelColorCoords, alpha);
+        p.lighting = SubmodelParams::FullBright;
+        p.ambient  = Vector4f(1, 1, 1, 1);
     }
     else if (!spr.light.vLightListIdx)
     {
         // Lit uniformly.
-        ambient = Vector4f(spr.light.ambientColor, alpha);
-        Mod_FixedVertexColors(numVerts, modelColorCoords,
-                              (ambient * 255).toVector4ub());
+        p.lighting = SubmodelParams::UniformLight;
+        p.ambient  = Vector4f(spr.light.ambientColor, alpha);
     }
     else
     {
         // Lit normally.
-        ambient = Vector4f(spr.light.ambientColor, alpha);
+        p.lighting = SubmodelParams::VectorLit;
+        p.ambient  = Vector4f(spr.light.ambientColor, alpha);
+
+        // We must transform the light vectors to model space.
+        bool const invert = (mf->scale[VY] < 0);
+        dint const maxLights = de::min(modelLight + 1, MAX_MODEL_LIGHTS);
+        ClientApp::renderSystem().forAllVectorLights(spr.light.vLightListIdx,
+                                                     [&p, &spr, &invert, &maxLights]
+                                                     (VectorLightData const &vlight)
+        {
+            ModelLight &light = p.lights[p.lightCount++];
+            light.direction = rotateLightVector(vlight, -spr.pose.yaw, -spr.pose.pitch, invert);
+            light.color     = vlight.color;
+            light.offset    = vlight.offset;
+            light.lightSide = vlight.lightSide;
+            light.darkSide  = vlight.darkSide;
+            light.affectedByAmbient = vlight.affectedByAmbient;
 
-        Mod_VertexColors(modelColorCoords, numVerts,
-                         modelNormCoords, spr.light.vLightListIdx, modelLight + 1,
-                         ambient, (mf->scale[VY] < 0), -spr.pose.yaw, -spr.pose.pitch);
+            // Time to stop?
+            return (p.lightCount == maxLights);
+        });
     }
 
-    TextureVariant *shinyTexture = 0;
-    float shininess = 0;
+    p.shininess = 0;
     if (mf->def.hasSub(number))
     {
-        shininess = float(de::clamp(0.0, mf->def.sub(number).getd("shiny") * modelShinyFactor, 1.0));
-        // Ensure we've prepared the shiny skin.
-        if (shininess > 0)
+        p.shininess = float(de::clamp(0.0, mf->def.sub(number).getd("shiny") * modelShinyFactor, 1.0));
+        if (!mf->subModelDef(number).shinySkin)
         {
-            if (ClientTexture *tex = static_cast<ClientTexture *>(mf->subModelDef(number).shinySkin))
-            {
-                shinyTexture = tex->prepareVariant(Rend_ModelShinyTextureSpec());
-            }
-            else
-            {
-                shininess = 0;
-            }
+            p.shininess = 0;
         }
     }
 
-    Vector4f color;
-    if (shininess > 0)
+    if (p.shininess > 0)
     {
         // Calculate shiny coordinates.
         Vector3f shinyColor = mf->def.sub(number).get("shinyColor");
@@ -919,50 +962,216 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
         float offset = parm.shineYawOffset;
 
         // Calculate normalized (0,1) model yaw and pitch.
-        float normYaw = M_CycleIntoRange(((spr.pose.viewAligned? spr.pose.yawAngleOffset
-                                                               : spr.pose.yaw) + offset) / 360, 1);
+        p.normYaw = M_CycleIntoRange(((spr.pose.viewAligned? spr.pose.yawAngleOffset
+                                                           : spr.pose.yaw) + offset) / 360, 1);
 
         offset = parm.shinePitchOffset;
 
-        float normPitch = M_CycleIntoRange(((spr.pose.viewAligned? spr.pose.pitchAngleOffset
-                                                                 : spr.pose.pitch) + offset) / 360, 1);
+        p.normPitch = M_CycleIntoRange(((spr.pose.viewAligned? spr.pose.pitchAngleOffset
+                                                             : spr.pose.pitch) + offset) / 360, 1);
 
-        float shinyAng = 0;
-        float shinyPnt = 0;
+        p.shinyAng = 0;
+        p.shinyPnt = 0;
         if (parm.shinepspriteCoordSpace)
         {
             // This is a hack to accommodate the psprite coordinate space.
-            shinyPnt = 0.5;
+            p.shinyPnt = 0.5;
         }
         else
         {
-            Vector3f delta = modelCenter;
+            // Coordinates to the center of the model (game coords).
+            Vector3f delta = Vector3f(spr.pose.origin[VX], spr.pose.origin[VY], spr.pose.midZ())
+                    + Vector3d(spr.pose.srvo) + Vector3f(mf->offset.x, mf->offset.z, mf->offset.y);
 
             if (!parm.shineTranslateWithViewerPos)
             {
                 delta -= Rend_EyeOrigin().xzy();
             }
 
-            shinyAng = QATAN2(delta.z, M_ApproxDistancef(delta.x, delta.y)) / PI + 0.5f; // shinyAng is [0,1]
+            p.shinyAng = QATAN2(delta.z, M_ApproxDistancef(delta.x, delta.y)) / PI + 0.5f; // shinyAng is [0,1]
 
-            shinyPnt = QATAN2(delta.y, delta.x) / (2 * PI);
+            p.shinyPnt = QATAN2(delta.y, delta.x) / (2 * PI);
         }
 
-        Mod_ShinyCoords(modelTexCoords, numVerts,
-                        modelNormCoords, normYaw, normPitch, shinyAng, shinyPnt,
-                        mf->def.sub(number).getf("shinyReact"));
+        p.shinyReact = mf->def.sub(number).getf("shinyReact");
 
         // Shiny color.
         if (smf.testFlag(MFF_SHINY_LIT))
         {
-            color = Vector4f(ambient * shinyColor, shininess);
+            p.shinyColor = Vector4f(p.ambient * shinyColor, p.shininess);
         }
         else
         {
-            color = Vector4f(shinyColor, shininess);
+            p.shinyColor = Vector4f(shinyColor, p.shininess);
         }
     }
 
+    return true;
+}
+
+/**
+ * Calculates the vertex coordinates, colors and shiny texture coordinates of a
+ * submodel. Does not access any shared state, so may be called in any thread.
+ */
+static void prepareSubmodelVertices(SubmodelParams const &p, Vector3f *posCoords,
+    Vector3f *normCoords, Vector4ub *colorCoords, Vector2f *texCoords)
+{
+    // Interpolate vertices and normals.
+    Mod_LerpVertices(p.inter, p.numVerts, *p.frame, *p.nextFrame, posCoords, normCoords);
+
+    if (p.zSign < 0)
+    {
+        Mod_MirrorCoords(p.numVerts, posCoords, 2);
+        Mod_MirrorCoords(p.numVerts, normCoords, 1);
+    }
+
+    // Calculate lighting.
+    switch (p.lighting)
+    {
+    case SubmodelParams::FullBright:
+        Mod_FullBrightVertexColors(p.numVerts, colorCoords, p.alpha);
+        break;
+
+    case SubmodelParams::UniformLight:
+        Mod_FixedVertexColors(p.numVerts, colorCoords, (p.ambient * 255).toVector4ub());
+        break;
+
+    case SubmodelParams::VectorLit:
+        Mod_VertexColors(colorCoords, p.numVerts, normCoords, p.lights, p.lightCount,
+                         p.ambient);
+        break;
+    }
+
+    if (p.shininess > 0)
+    {
+        Mod_ShinyCoords(texCoords, p.numVerts, normCoords, p.normYaw, p.normPitch,
+                        p.shinyAng, p.shinyPnt, p.shinyReact);
+    }
+}
+
+/**
+ * Submodels of the current frame whose vertices have been prepared in advance.
+ */
+struct ModelBatch
+{
+    struct Prepared
+    {
+        SubmodelParams params;
+        dint first; ///< First vertex in the buffers.
+    };
+    typedef QPair<vissprite_t const *, duint> Key;
+
+    QVector<Prepared> prepared;
+    QHash<Key, dint> index;
+
+    // The vertex buffers are shared by all the submodels and only grow.
+    QVector<Vector3f> posCoords;
+    QVector<Vector3f> normCoords;
+    QVector<Vector4ub> colorCoords;
+    QVector<Vector2f> texCoords;
+
+    void clear()
+    {
+        prepared.clear();
+        index.clear();
+    }
+};
+static ModelBatch modelBatch;
+
+/// Minimum number of vertices to prepare per task.
+static dint const MODEL_BATCH_TASK_VERTS = 8192;
+
+static void drawSubmodel(uint number, vissprite_t const &spr)
+{
+    drawmodelparams_t const &parm = *VS_MODEL(&spr);
+    SubmodelDef const &smf = parm.mf->subModelDef(number);
+
+    SubmodelParams resolved;
+    SubmodelParams const *p;
+    Vector3f *posCoords;
+    Vector4ub *colorCoords;
+    Vector2f *texCoords;
+
+    auto found = modelBatch.index.constFind(ModelBatch::Key(&spr, number));
+    if (found != modelBatch.index.constEnd())
+    {
+        // Already prepared.
+        ModelBatch::Prepared const &prep = modelBatch.prepared.at(found.value());
+        p           = &prep.params;
+        posCoords   = modelBatch.posCoords.data()   + prep.first;
+        colorCoords = modelBatch.colorCoords.data() + prep.first;
+        texCoords   = modelBatch.texCoords.data()   + prep.first;
+    }
+    else
+    {
+        if (!resolveSubmodel(number, spr, resolved)) return;
+
+        // Ensure our vertex render buffers can accommodate this.
+        if (!resizeVertexBuffer(resolved.numVerts)) return;
+
+        prepareSubmodelVertices(resolved, modelPosCoords, modelNormCoords,
+                                modelColorCoords, modelTexCoords);
+        p           = &resolved;
+        posCoords   = modelPosCoords;
+        colorCoords = modelColorCoords;
+        texCoords   = modelTexCoords;
+    }
+
+    FrameModelDef *mf = p->mf, *mfNext = p->mfNext;
+    FrameModel &mdl = *p->mdl;
+    float const inter = p->inter;
+    float const alpha = p->alpha;
+    float const shininess = p->shininess;
+    blendmode_t const blending = p->blending;
+    int const zSign = p->zSign;
+
+    int useSkin = chooseSkin(*mf, number, parm.id, parm.selector, parm.tmap);
+
+    // Setup transformation.
+    DGL_MatrixMode(DGL_MODELVIEW);
+    DGL_PushMatrix();
+
+    // Model space => World space
+    DGL_Translatef(spr.pose.origin[VX] + spr.pose.srvo[VX] +
+                   de::lerp(mf->offset.x, mfNext->offset.x, inter),
+                   spr.pose.origin[VZ] + spr.pose.srvo[VZ] +
+                   de::lerp(mf->offset.y, mfNext->offset.y, inter),
+                   spr.pose.origin[VY] + spr.pose.srvo[VY] + zSign *
+                   de::lerp(mf->offset.z, mfNext->offset.z, inter));
+
+    if (spr.pose.extraYawAngle || spr.pose.extraPitchAngle)
+    {
+        // Sky models have an extra rotation.
+        DGL_Scalef(1, 200 / 240.0f, 1);
+        DGL_Rotatef(spr.pose.extraYawAngle, 1, 0, 0);
+        DGL_Rotatef(spr.pose.extraPitchAngle, 0, 0, 1);
+        DGL_Scalef(1, 240 / 200.0f, 1);
+    }
+
+    // Model rotation.
+    DGL_Rotatef(spr.pose.viewAligned? spr.pose.yawAngleOffset   : spr.pose.yaw,   0, 1, 0);
+    DGL_Rotatef(spr.pose.viewAligned? spr.pose.pitchAngleOffset : spr.pose.pitch, 0, 0, 1);
+
+    // Scaling and model space offset.
+    DGL_Scalef(de::lerp(mf->scale.x, mfNext->scale.x, inter),
+             de::lerp(mf->scale.y, mfNext->scale.y, inter),
+             de::lerp(mf->scale.z, mfNext->scale.z, inter));
+    if (spr.pose.extraScale)
+    {
+        // Particle models have an extra scale.
+        DGL_Scalef(spr.pose.extraScale, spr.pose.extraScale, spr.pose.extraScale);
+    }
+    DGL_Translatef(smf.offset.x, smf.offset.y, smf.offset.z);
+
+    // Ensure we've prepared the shiny skin.
+    TextureVariant *shinyTexture = 0;
+    if (shininess > 0)
+    {
+        ClientTexture *tex = static_cast<ClientTexture *>(mf->subModelDef(number).shinySkin);
+        shinyTexture = tex->prepareVariant(Rend_ModelShinyTextureSpec());
+    }
+    Vector4f const &color = p->shinyColor;
+
     TextureVariant *skinTexture = 0;
     if (renderTextures == 2)
     {
@@ -999,7 +1208,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     DGL_Enable(DGL_TEXTURE_2D);
 
     FrameModel::Primitives const &primitives =
-        activeLod? activeLod->primitives : mdl.primitives();
+        p->lod? p->lod->primitives : mdl.primitives();
 
     // Render using multiple passes?
     if (shininess <= 0 || alpha < 1 ||
@@ -1013,7 +1222,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
             GL_BindTexture(renderTextures? skinTexture : 0);
 
             drawPrimitives(RC_COMMAND_COORDS, primitives,
-                           modelPosCoords, modelColorCoords);
+                           posCoords, colorCoords);
         }
 
         if (shininess > 0)
@@ -1028,7 +1237,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
                 GL_BlendMode(BM_NORMAL);
 
             // Shiny color.
-            Mod_FixedVertexColors(numVerts, modelColorCoords,
+            Mod_FixedVertexColors(p->numVerts, colorCoords,
                                   (color * 255).toVector4ub());
 
             // We'll use multitexturing to clear out empty spots in
@@ -1043,7 +1252,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
             GL_BindTexture(renderTextures? skinTexture : 0);
 
             drawPrimitives(RC_BOTH_COORDS, primitives,
-                           modelPosCoords, modelColorCoords, modelTexCoords);
+                           posCoords, colorCoords, texCoords);
 
             selectTexUnits(1);
             DGL_ModulateTexture(1);
@@ -1070,7 +1279,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
         GL_BindTexture(renderTextures? skinTexture : 0);
 
         drawPrimitives(RC_BOTH_COORDS, primitives,
-                       modelPosCoords, modelColorCoords, modelTexCoords);
+                       posCoords, colorCoords, texCoords);
 
         selectTexUnits(1);
         DGL_ModulateTexture(1);
@@ -1098,6 +1307,201 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     GL_BlendMode(BM_NORMAL);
 }
 
+/**
+ * Prepares the vertices of all the model vissprites linked to @a head into the batch.
+ */
+static void prepareModelBatch(vissprite_t const &head)
+{
+    modelBatch.clear();
+
+    // Resolve the parameters of all the visible submodels and allocate their vertices.
+    dint vertexCount = 0;
+    for (vissprite_t const *spr = head.next; spr != &head; spr = spr->next)
+    {
+        if (spr->type != VSPR_MODEL) continue;
+
+        drawmodelparams_t const &parm = *VS_MODEL(spr);
+        if (!parm.mf) continue;
+
+        for (uint i = 0; i < parm.mf->subCount(); ++i)
+        {
+            if (!parm.mf->subModelId(i)) continue;
+
+            ModelBatch::Prepared prep;
+            if (!resolveSubmodel(i, *spr, prep.params)) continue;
+
+            prep.first = vertexCount;
+            vertexCount += prep.params.numVerts;
+
+            modelBatch.index.insert(ModelBatch::Key(spr, i), modelBatch.prepared.size());
+            modelBatch.prepared.append(prep);
+        }
+    }
+
+    if (modelBatch.prepared.isEmpty()) return;
+
+    if (modelBatch.posCoords.size() < vertexCount)
+    {
+        modelBatch.posCoords  .resize(vertexCount);
+        modelBatch.normCoords .resize(vertexCount);
+        modelBatch.colorCoords.resize(vertexCount);
+        modelBatch.texCoords  .resize(vertexCount);
+    }
+    Vector3f  *posCoords   = modelBatch.posCoords.data();
+    Vector3f  *normCoords  = modelBatch.normCoords.data();
+    Vector4ub *colorCoords = modelBatch.colorCoords.data();
+    Vector2f  *texCoords   = modelBatch.texCoords.data();
+
+    // Each task prepares a run of consecutive submodels into their own slices of the
+    // vertex buffers.
+    auto prepareRange = [posCoords, normCoords, colorCoords, texCoords] (dint begin, dint end)
+    {
+        for (dint i = begin; i < end; ++i)
+        {
+            ModelBatch::Prepared const &prep = modelBatch.prepared.at(i);
+            prepareSubmodelVertices(prep.params, posCoords + prep.first, normCoords + prep.first,
+                                    colorCoords + prep.first, texCoords + prep.first);
+        }
+    };
+
+    TaskPool tasks;
+    dint const count = modelBatch.prepared.size();
+    dint begin = 0;
+    dint runVerts = 0;
+    for (dint i = 0; i < count; ++i)
+    {
+        runVerts += modelBatch.prepared.at(i).params.numVerts;
+        if (runVerts >= MODEL_BATCH_TASK_VERTS || i == count - 1)
+        {
+            dint const end = i + 1;
+            if (begin == 0 && end == count)
+            {
+                // Not worth a task.
+                prepareRange(begin, end);
+            }
+            else
+            {
+                tasks.start([prepareRange, begin, end] () { prepareRange(begin, end); });
+            }
+            begin = end;
+            runVerts = 0;
+        }
+    }
+    tasks.waitForDone();
+}
+
+void Rend_ModelPrepareBatch()
+{
+    DENG2_ASSERT(inited);
+    DENG_ASSERT_IN_MAIN_THREAD();
+
+    modelBatch.clear();
+
+    if (!batchModels) return;
+
+    prepareModelBatch(visSprSortedHead);
+}
+
+void Rend_ModelEndBatch()
+{
+    modelBatch.clear();
+}
+
+/**
+ * Prepares the vertices of @a instances copies of a model visible in the latest frame,
+ * both one submodel at a time (as when batching is disabled) and as a batch. Nothing
+ * is drawn.
+ */
+static void benchmarkModelBatch(dint instances)
+{
+    // The vissprites and vector lights of the latest frame are still available.
+    vissprite_t const *model = nullptr;
+    for (vissprite_t const *spr = visSprSortedHead.next; spr != &visSprSortedHead; spr = spr->next)
+    {
+        if (spr->type == VSPR_MODEL && VS_MODEL(spr)->mf)
+        {
+            model = spr;
+            break;
+        }
+    }
+    if (!model)
+    {
+        LOG_GL_WARNING("No models were visible in the latest frame");
+        return;
+    }
+
+    // Copies of the model vissprite in a list of their own.
+    std::vector<vissprite_t> copies(instances, *model);
+    vissprite_t head;
+    head.next = head.prev = &head;
+    for (vissprite_t &spr : copies)
+    {
+        spr.next = &head;
+        spr.prev = head.prev;
+        head.prev->next = &spr;
+        head.prev = &spr;
+    }
+
+    dint const rounds = 10;
+    dint vertexCount = 0;
+
+    Time startedAt;
+    for (dint round = 0; round < rounds; ++round)
+    {
+        vertexCount = 0;
+        for (vissprite_t const &spr : copies)
+        {
+            drawmodelparams_t const &parm = *VS_MODEL(&spr);
+            for (uint i = 0; i < parm.mf->subCount(); ++i)
+            {
+                SubmodelParams params;
+                if (!parm.mf->subModelId(i) || !resolveSubmodel(i, spr, params)) continue;
+                if (!resizeVertexBuffer(params.numVerts)) continue;
+
+                prepareSubmodelVertices(params, modelPosCoords, modelNormCoords,
+                                        modelColorCoords, modelTexCoords);
+                vertexCount += params.numVerts;
+            }
+        }
+    }
+    ddouble const unbatched = startedAt.since();
+
+    startedAt = Time();
+    for (dint round = 0; round < rounds; ++round)
+    {
+        prepareModelBatch(head);
+    }
+    ddouble const batched = startedAt.since();
+    modelBatch.clear();
+
+    LOG_GL_MSG("Prepared %i instances of a model (%i vertices in total), average of %i rounds:")
+            << instances << vertexCount << rounds;
+    LOG_GL_MSG("  Unbatched:  %.3f ms") << unbatched / rounds * 1000;
+    LOG_GL_MSG("  Batched:    %.3f ms") << batched   / rounds * 1000;
+}
+
+D_CMD(ModelBatchBench)
+{
+    DENG2_UNUSED(src);
+
+    LOG_AS("modelbatchbench (Cmd)");
+
+    if (argc > 2)
+    {
+        LOG_SCR_NOTE("Usage: %s (instances)") << argv[0];
+        return true;
+    }
+
+    if (!inited)
+    {
+        LOG_SCR_WARNING("The model renderer is not initialized");
+        return false;
+    }
+
+    benchmarkModelBatch(argc == 2? de::max(1, String(argv[1]).toInt()) : 500);
+    return true;
+}
+
 void Rend_DrawModel(vissprite_t const &spr)
 {
     drawmodelparams_t const &parm = *VS_MODEL(&spr);
@@ -31,35 +31,52 @@
 #include "world/convexsubspace.h"
 #include "client/clientsubsector.h"
 
+#include <doomsday/console/cmd.h>
+#include <de/Time>
+#include <de/mathutil.h>
+#include <QVector>
+#include <cstring>
+#include <vector>
+
 using namespace de;
 
-/// @todo This should not be a fixed-size array. -jk
-vissprite_t visSprites[MAXVISSPRITES], *visSpriteP;
+/// Vissprites are allocated in blocks, so that the addresses of existing vissprites
+/// remain valid when more are allocated.
+#define VISSPRITE_BLOCK_SIZE    1024
+
+static QVector<vissprite_t *> visSpriteBlocks;  ///< Arena of vissprites (owned).
+static dint visSpriteCount;                     ///< Number in use in the current frame.
+
 vispsprite_t visPSprites[DDMAXPSPRITES];
 
 vissprite_t visSprSortedHead;
 
-static vissprite_t overflowVisSprite;
+static inline vissprite_t &visSprite(dint index)
+{
+    return visSpriteBlocks[index / VISSPRITE_BLOCK_SIZE][index % VISSPRITE_BLOCK_SIZE];
+}
 
 void R_ClearVisSprites()
 {
-    visSpriteP = visSprites;
+    // The blocks are reused in the next frame.
+    visSpriteCount = 0;
 }
 
-vissprite_t *R_NewVisSprite(visspritetype_t type)
+dint R_VisSpriteCount()
 {
-    vissprite_t *spr;
+    return visSpriteCount;
+}
 
-    if (visSpriteP == &visSprites[MAXVISSPRITES])
-    {
-        spr = &overflowVisSprite;
-    }
-    else
+vissprite_t *R_NewVisSprite(visspritetype_t type)
+{
+    if (visSpriteCount == visSpriteBlocks.count() * VISSPRITE_BLOCK_SIZE)
     {
-        visSpriteP++;
-        spr = visSpriteP - 1;
+        // The arena grows as needed.
+        visSpriteBlocks.append(new vissprite_t[VISSPRITE_BLOCK_SIZE]);
     }
 
+    vissprite_t *spr = &visSprite(visSpriteCount++);
+
     de::zapPtr(spr);
     spr->type = type;
 
@@ -116,58 +133,200 @@ void VisSprite_SetupModel(vissprite_t *spr, VisEntityPose const &pose, VisEntity
     p.shineTranslateWithViewerPos = p.shinepspriteCoordSpace = false;
 }
 
+/**
+ * Returns a sort key for @a distance. The keys compare as unsigned integers in the same
+ * order as the distances (the IEEE 754 representation is made monotonic).
+ */
+static inline duint64 distanceSortKey(ddouble distance)
+{
+    duint64 bits;
+    std::memcpy(&bits, &distance, sizeof(bits));
+    return (bits & 0x8000000000000000ull)? ~bits : (bits | 0x8000000000000000ull);
+}
+
 void R_SortVisSprites()
 {
-    if(!visSpriteP) return;
+    visSprSortedHead.next = visSprSortedHead.prev = &visSprSortedHead;
 
-    dint const count = visSpriteP - visSprites;
-    if(count <= 0) return;
+    dint const count = visSpriteCount;
+    if (count <= 0) return;
+
+    // Vissprites are drawn back to front. Equally distant vissprites are drawn in the
+    // reverse order of their creation. The order is determined with a stable LSD
+    // radix sort (one byte per pass) of the distances in ascending order, and then
+    // linking the vissprites in reverse.
+    static std::vector<duint64> keys, tempKeys;
+    static std::vector<dint> order, tempOrder;
+    keys.resize(count);
+    tempKeys.resize(count);
+    order.resize(count);
+    tempOrder.resize(count);
+
+    dint histogram[8][256];
+    de::zap(histogram);
+    for (dint i = 0; i < count; ++i)
+    {
+        duint64 const key = distanceSortKey(visSprite(i).pose.distance);
+        keys[i]  = key;
+        order[i] = i;
+        for (dint b = 0; b < 8; ++b)
+        {
+            histogram[b][(key >> (8 * b)) & 0xff]++;
+        }
+    }
 
-    vissprite_t unsorted;
-    unsorted.next = unsorted.prev = &unsorted;
+    for (dint b = 0; b < 8; ++b)
+    {
+        dint *counts = histogram[b];
+
+        // If all keys have the same value in this byte, the pass can be skipped.
+        if (counts[(keys[0] >> (8 * b)) & 0xff] == count) continue;
+
+        // Starting offsets of each bucket.
+        dint offset = 0;
+        for (dint k = 0; k < 256; ++k)
+        {
+            dint const n = counts[k];
+            counts[k] = offset;
+            offset += n;
+        }
 
-    for(vissprite_t *ds = visSprites; ds < visSpriteP; ds++)
+        for (dint i = 0; i < count; ++i)
+        {
+            dint const dest = counts[(keys[i] >> (8 * b)) & 0xff]++;
+            tempKeys [dest] = keys[i];
+            tempOrder[dest] = order[i];
+        }
+        keys.swap(tempKeys);
+        order.swap(tempOrder);
+    }
+
+    // Link the vissprites, farthest first.
+    for (dint i = count - 1; i >= 0; --i)
     {
-        ds->next = ds + 1;
-        ds->prev = ds - 1;
+        vissprite_t *spr = &visSprite(order[i]);
+        spr->next = &visSprSortedHead;
+        spr->prev = visSprSortedHead.prev;
+        visSprSortedHead.prev->next = spr;
+        visSprSortedHead.prev = spr;
     }
-    visSprites[0].prev = &unsorted;
-    unsorted.next = &visSprites[0];
-    (visSpriteP - 1)->next = &unsorted;
-    unsorted.prev = visSpriteP - 1;
+}
 
-    // Pull the vissprites out by distance.
+/**
+ * Links the vissprites of the current render frame to @ref visSprSortedHead using the
+ * selection sort that R_SortVisSprites() used to do. Used as the reference for
+ * checking the sort order.
+ */
+static void sortVisSpritesBySelection()
+{
     visSprSortedHead.next = visSprSortedHead.prev = &visSprSortedHead;
 
-    /// @todo Optimize:
-    /// Profile results from nuts.wad show over 25% of total execution time
-    /// was spent sorting vissprites (nuts.wad map01 is a perfect pathological
-    /// test case).
-    ///
-    /// Rather than try to speed up the sort, it would make more sense to
-    /// actually construct the vissprites in z order if it can be done in
-    /// linear time.
-
-    vissprite_t *best = nullptr;
-    for(dint i = 0; i < count; ++i)
+    dint const count = visSpriteCount;
+    if (count <= 0) return;
+
+    // Unsorted vissprites in the order of creation.
+    QVector<dint> nextUnsorted(count + 1), prevUnsorted(count + 1);
+    for (dint i = 0; i <= count; ++i) // count is the list head.
     {
+        nextUnsorted[i] = (i + 1) % (count + 1);
+        prevUnsorted[i] = (i + count) % (count + 1);
+    }
+
+    for (dint n = 0; n < count; ++n)
+    {
+        dint best = -1;
         ddouble bestdist = 0;
-        for(vissprite_t *ds = unsorted.next; ds != &unsorted; ds = ds->next)
+        for (dint i = nextUnsorted[count]; i != count; i = nextUnsorted[i])
         {
-            if(ds->pose.distance >= bestdist)
+            if (visSprite(i).pose.distance >= bestdist)
             {
-                bestdist = ds->pose.distance;
-                best = ds;
+                bestdist = visSprite(i).pose.distance;
+                best = i;
             }
         }
+        DENG2_ASSERT(best >= 0);
+
+        nextUnsorted[prevUnsorted[best]] = nextUnsorted[best];
+        prevUnsorted[nextUnsorted[best]] = prevUnsorted[best];
+
+        vissprite_t *spr = &visSprite(best);
+        spr->next = &visSprSortedHead;
+        spr->prev = visSprSortedHead.prev;
+        visSprSortedHead.prev->next = spr;
+        visSprSortedHead.prev = spr;
+    }
+}
+
+static QVector<vissprite_t const *> sortedVisSprites()
+{
+    QVector<vissprite_t const *> sorted;
+    for (vissprite_t const *spr = visSprSortedHead.next; spr != &visSprSortedHead; spr = spr->next)
+    {
+        sorted << spr;
+    }
+    return sorted;
+}
 
-        best->next->prev = best->prev;
-        best->prev->next = best->next;
-        best->next = &visSprSortedHead;
-        best->prev = visSprSortedHead.prev;
-        visSprSortedHead.prev->next = best;
-        visSprSortedHead.prev = best;
+/**
+ * Sorts @a count vissprites at random distances with both R_SortVisSprites() and the
+ * old selection sort, and checks that the resulting orders are identical. Many of
+ * the distances are equal, to check the ordering of ties.
+ */
+static void benchmarkVisSpriteSort(dint count)
+{
+    R_ClearVisSprites();
+    for (dint i = 0; i < count; ++i)
+    {
+        vissprite_t *spr = R_NewVisSprite(VSPR_SPRITE);
+        spr->pose.distance = dint(RNG_RandFloat() * 2048) + ((i % 3)? 0 : RNG_RandFloat());
     }
+
+    Time startedAt;
+    R_SortVisSprites();
+    TimeSpan const radix = startedAt.since();
+    auto const radixOrder = sortedVisSprites();
+
+    startedAt = Time();
+    sortVisSpritesBySelection();
+    TimeSpan const selection = startedAt.since();
+    auto const selectionOrder = sortedVisSprites();
+
+    // Nothing is left to be drawn.
+    R_ClearVisSprites();
+    R_SortVisSprites();
+
+    LOG_GL_MSG("Sorted %i vissprites:") << count;
+    LOG_GL_MSG("  Radix sort:      %.3f ms") << radix     * 1000;
+    LOG_GL_MSG("  Selection sort:  %.3f ms") << selection * 1000;
+    if (radixOrder == selectionOrder)
+    {
+        LOG_GL_MSG("  The sort orders are identical");
+    }
+    else
+    {
+        LOG_GL_ERROR("The radix sort order differs from the selection sort order");
+    }
+}
+
+D_CMD(VisSpriteSortBench)
+{
+    DENG2_UNUSED(src);
+
+    LOG_AS("vissortbench (Cmd)");
+
+    if (argc > 2)
+    {
+        LOG_SCR_NOTE("Usage: %s (vissprites)") << argv[0];
+        return true;
+    }
+
+    benchmarkVisSpriteSort(argc == 2? de::max(1, String(argv[1]).toInt()) : 20000);
+    return true;
+}
+
+void R_VisSpriteRegister()
+{
+    C_CMD("vissortbench", NULL, VisSpriteSortBench);
 }
 
 void VisEntityLighting::setupLighting(Vector3d const &origin, ddouble distance,
@@ -24,6 +24,8 @@
 #  include "world/audioenvironment.h"
 #  include "audio/s_environ.h"
 #  include "ClientMaterial"
+#  include "Plane"
+#  include "Sector"
 #endif
 #include "BspLeaf"
 #include "Face"
@@ -75,6 +77,15 @@ DENG2_PIMPL(ConvexSubspace)
     AudioEnvironment audioEnvironment;     ///< Cached audio characteristics.
 
     dint lastSpriteProjectFrame = 0;       ///< Frame number of last R_AddSprites.
+
+    struct RetainedFlat
+    {
+        ddouble height = 0;                ///< Height the geometry was built for.
+        bool needRebuild = true;
+        QVector<Vector3f> posCoords;
+        QVector<Vector2f> texCoords;
+    };
+    QVector<RetainedFlat> flats;           ///< Retained flat geometry, by plane index.
 #endif
 
     dint validCount = 0;                   ///< Used to prevent repeated processing.
@@ -156,9 +167,64 @@ DENG2_PIMPL(ConvexSubspace)
 
         needUpdateFanBase = false;
 
+        // The trifans must be rebuilt.
+        self().markFlatGeometryDirty();
+
 #undef MIN_TRIANGLE_EPSILON
     }
 
+    /**
+     * Build the trifan geometry for drawing a plane of the subspace.
+     *
+     * @param flat        Retained geometry to (re)build.
+     * @param planeIndex  Index of the plane in the sector (determines winding and
+     *                    the texture coordinate origin).
+     * @param height      Z map space height coordinate for each vertex.
+     */
+    void buildFlat(RetainedFlat &flat, dint planeIndex, ddouble height)
+    {
+        Face const &poly     = self().poly();
+        HEdge *fanBase       = self().fanBase();
+        dint const vertCount = poly.hedgeCount() + (!fanBase? 2 : 0);
+        ClockDirection const direction = (planeIndex == Sector::Ceiling? Anticlockwise : Clockwise);
+
+        flat.posCoords.resize(vertCount);
+        flat.texCoords.resize(vertCount);
+
+        dint n = 0;
+        if(!fanBase)
+        {
+            flat.posCoords[n++] = Vector3f(poly.center(), height);
+        }
+
+        // Add the vertices for each hedge.
+        HEdge *baseNode = fanBase? fanBase : poly.hedge();
+        HEdge *node = baseNode;
+        do
+        {
+            flat.posCoords[n++] = Vector3f(node->origin(), height);
+        } while((node = &node->neighbor(direction)) != baseNode);
+
+        // The last vertex is always equal to the first.
+        if(!fanBase)
+        {
+            flat.posCoords[n] = Vector3f(poly.hedge()->origin(), height);
+        }
+
+        // Texture coordinates are relative to the top left corner of the bounds (the
+        // Y axis is flipped for floors).
+        Vector2d const topLeft(poly.bounds().minX,
+                               poly.bounds().arvec2[planeIndex == Sector::Floor? 1 : 0][1]);
+        for(dint i = 0; i < vertCount; ++i)
+        {
+            Vector3f const &pos = flat.posCoords[i];
+            flat.texCoords[i] = Vector2f(pos.x - topLeft.x, -(pos.y - topLeft.y));
+        }
+
+        flat.height      = height;
+        flat.needRebuild = false;
+    }
+
 #endif // __CLIENT__
 };
 
@@ -384,6 +450,38 @@ dint ConvexSubspace::fanVertexCount() const
     return poly().hedgeCount() + (fanBase()? 0 : 2);
 }
 
+ConvexSubspace::FlatGeometry ConvexSubspace::flatGeometry(Plane const &plane) const
+{
+    dint const planeIndex = plane.indexInSector();
+    if(planeIndex >= d->flats.count())
+    {
+        d->flats.resize(planeIndex + 1);
+    }
+
+    // Make sure the fan base has been chosen (may invalidate the geometry).
+    fanBase();
+
+    Impl::RetainedFlat &flat = d->flats[planeIndex];
+    if(flat.needRebuild || flat.height != plane.heightSmoothed())
+    {
+        d->buildFlat(flat, planeIndex, plane.heightSmoothed());
+    }
+
+    FlatGeometry geom;
+    geom.vertCount = flat.posCoords.count();
+    geom.posCoords = flat.posCoords.constData();
+    geom.texCoords = flat.texCoords.constData();
+    return geom;
+}
+
+void ConvexSubspace::markFlatGeometryDirty()
+{
+    for(Impl::RetainedFlat &flat : d->flats)
+    {
+        flat.needRebuild = true;
+    }
+}
+
 static void accumReverbForWallSections(HEdge const *hedge,
                                        dfloat envSpaceAccum[NUM_AUDIO_ENVIRONMENTS],
                                        dfloat &total)
@@ -0,0 +1,348 @@
+/** @file linesightcache.cpp  World map line of sight query cache.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "de_base.h"
+#include "world/linesightcache.h"
+
+#include "world/clientserverworld.h"
+#include "world/linesighttest.h"
+#include "world/map.h"
+#include "world/p_players.h"
+#include "world/thinkers.h"
+#include "BspLeaf"
+#include "Sector"
+#include "dd_loop.h"  // gameTime
+#include "dd_main.h"  // gx
+
+#include <doomsday/console/cmd.h>
+#include <de/TaskPool>
+#include <de/Time>
+#include <de/timer.h>
+#include <QHash>
+#include <QVector>
+#include <cstring>
+
+using namespace de;
+
+namespace world {
+
+/// Number of queries traced by one task when answering a batch concurrently.
+static dint const LINESIGHT_TASK_SIZE = 32;
+
+/**
+ * Identifies a query by the exact bit patterns of its parameters.
+ */
+struct LineSightKey
+{
+    duint64 bits[8];
+
+    LineSightKey(LineSightCache::Query const &query)
+    {
+        ddouble const coords[6] = { query.from.x, query.from.y, query.from.z,
+                                    query.to.x,   query.to.y,   query.to.z };
+        std::memcpy(bits, coords, sizeof(coords));
+
+        duint32 slopes[2];
+        std::memcpy(&slopes[0], &query.bottomSlope, sizeof(dfloat));
+        std::memcpy(&slopes[1], &query.topSlope,    sizeof(dfloat));
+        bits[6] = (duint64(slopes[0]) << 32) | slopes[1];
+        bits[7] = duint64(query.flags);
+    }
+
+    bool operator == (LineSightKey const &other) const
+    {
+        return !std::memcmp(bits, other.bits, sizeof(bits));
+    }
+};
+
+static uint qHash(LineSightKey const &key)
+{
+    duint64 hash = 0;
+    for (duint64 bits : key.bits)
+    {
+        hash = (hash ^ bits) * 0x100000001b3ull;
+    }
+    return uint(hash ^ (hash >> 32));
+}
+
+LineSightCache::Query::Query(Vector3d const &from, Vector3d const &to, dfloat bottomSlope,
+                             dfloat topSlope, dint flags)
+    : from       (from)
+    , to         (to)
+    , bottomSlope(bottomSlope)
+    , topSlope   (topSlope)
+    , flags      (flags)
+    , result     (false)
+{}
+
+DENG2_PIMPL_NOREF(LineSightCache)
+{
+    Map &map;
+    QHash<LineSightKey, bool> results;
+    dint tic = -1;       ///< Game tic of the remembered results.
+    duint64 hits   = 0;
+    duint64 misses = 0;
+
+    Impl(Map &map) : map(map) {}
+
+    /**
+     * Forgets the remembered results if the tic has changed since they were traced.
+     */
+    void beginQueries()
+    {
+        dint const currentTic = dint(gameTime * TICSPERSEC);
+        if (currentTic != tic)
+        {
+            results.clear();
+            tic = currentTic;
+        }
+    }
+
+    /**
+     * Attempts to answer @a query without tracing.
+     *
+     * @return  @c true if the result was written to @a query.
+     */
+    bool lookup(Query &query)
+    {
+        // The reject matrix assumes that one-sided lines always block. With
+        // LS_PASSOVER/LS_PASSUNDER, LineSightTest only blocks a one-sided line up to
+        // the ceiling (down to the floor) of the sector the ray enters it from; a ray
+        // above (below) that continues through the wall into sectors the matrix
+        // considers unreachable.
+        if (!(query.flags & (LS_PASSLEFT | LS_PASSOVER | LS_PASSUNDER)))
+        {
+            Sector const *fromSector = map.bspLeafAt(query.from).sectorPtr();
+            Sector const *toSector   = map.bspLeafAt(query.to  ).sectorPtr();
+            if (fromSector && toSector && map.isSightRejected(*fromSector, *toSector))
+            {
+                query.result = false;
+                return true;
+            }
+        }
+
+        auto found = results.constFind(LineSightKey(query));
+        if (found != results.constEnd())
+        {
+            hits++;
+            query.result = found.value();
+            return true;
+        }
+        misses++;
+        return false;
+    }
+
+    /// Safe to call concurrently.
+    bool trace(Query const &query) const
+    {
+        return LineSightTest(query.from, query.to, query.bottomSlope, query.topSlope,
+                             query.flags).trace(map.bspTree());
+    }
+
+    void remember(Query const &query)
+    {
+        results.insert(LineSightKey(query), query.result);
+    }
+};
+
+LineSightCache::LineSightCache(Map &map) : d(new Impl(map))
+{}
+
+void LineSightCache::invalidate()
+{
+    d->results.clear();
+}
+
+bool LineSightCache::check(Query &query)
+{
+    d->beginQueries();
+    if (!d->lookup(query))
+    {
+        query.result = d->trace(query);
+        d->remember(query);
+    }
+    return query.result;
+}
+
+void LineSightCache::check(Query *queries, dsize count)
+{
+    d->beginQueries();
+
+    QVector<Query *> pending;
+    for (dsize i = 0; i < count; ++i)
+    {
+        if (!d->lookup(queries[i]))
+        {
+            pending << &queries[i];
+        }
+    }
+
+    dint const taskCount = (pending.size() + LINESIGHT_TASK_SIZE - 1) / LINESIGHT_TASK_SIZE;
+    if (taskCount <= 1)
+    {
+        for (Query *query : pending)
+        {
+            query->result = d->trace(*query);
+        }
+    }
+    else
+    {
+        TaskPool tasks;
+        for (dint i = 0; i < taskCount; ++i)
+        {
+            dint const begin = i * LINESIGHT_TASK_SIZE;
+            dint const end   = de::min(begin + LINESIGHT_TASK_SIZE, pending.size());
+            tasks.start([this, &pending, begin, end] ()
+            {
+                for (dint k = begin; k < end; ++k)
+                {
+                    pending.at(k)->result = d->trace(*pending.at(k));
+                }
+            });
+        }
+        tasks.waitForDone();
+    }
+
+    for (Query const *query : pending)
+    {
+        d->remember(*query);
+    }
+}
+
+duint64 LineSightCache::hitCount() const
+{
+    return d->hits;
+}
+
+duint64 LineSightCache::missCount() const
+{
+    return d->misses;
+}
+
+String LineSightCache::statsSummary() const
+{
+    duint64 const total = d->hits + d->misses;
+    if (!total) return "No queries";
+
+    return String("%1 of %2 sight queries cached (%3%)")
+            .arg(d->hits)
+            .arg(total)
+            .arg(100.0 * d->hits / total, 0, 'f', 1);
+}
+
+void LineSightCache::benchmark(dint count)
+{
+    LOG_AS("LineSightCache");
+
+    // Gather the lookers and their target.
+    QVector<mobj_t const *> mobjs;
+    d->map.thinkers().forAll(reinterpret_cast<thinkfunc_t>(gx.MobjThinker), 0x3, [&mobjs] (thinker_t *th)
+    {
+        auto const *mob = reinterpret_cast<mobj_t const *>(th);
+        if (!mob->dPlayer) mobjs << mob;
+        return LoopContinue;
+    });
+    if (mobjs.isEmpty())
+    {
+        LOG_MAP_WARNING("No objects to look with");
+        return;
+    }
+    mobj_t const *player = nullptr;
+    if (consolePlayer >= 0 && consolePlayer < DDMAXPLAYERS)
+    {
+        player = DD_Player(consolePlayer)->publicData().mo;
+    }
+
+    // Each looker looks at the player from its eyes, like the games do.
+    QVector<Query> queries;
+    queries.reserve(count);
+    for (dint i = 0; i < count; ++i)
+    {
+        mobj_t const *looker = mobjs.at(i % mobjs.size());
+        mobj_t const *target = player? player : mobjs.at((i * 7 + 1) % mobjs.size());
+        queries << Query(Vector3d(looker->origin) + Vector3d(0, 0, looker->height * 3 / 4),
+                         Vector3d(target->origin), 0, target->height);
+    }
+
+    duint64 const oldHits   = d->hits;
+    duint64 const oldMisses = d->misses;
+
+    Time startedAt;
+    dint visible = 0;
+    for (Query const &query : queries)
+    {
+        if (d->trace(query)) visible++;
+    }
+    TimeSpan const uncached = startedAt.since();
+
+    invalidate();
+    startedAt = Time();
+    for (Query &query : queries) check(query);
+    TimeSpan const firstPass = startedAt.since();
+
+    startedAt = Time();
+    for (Query &query : queries) check(query);
+    TimeSpan const secondPass = startedAt.since();
+
+    invalidate();
+    startedAt = Time();
+    check(queries.data(), dsize(queries.size()));
+    TimeSpan const batch = startedAt.since();
+
+    invalidate();
+    d->hits   = oldHits;
+    d->misses = oldMisses;
+
+    LOG_MAP_MSG("%i sight queries from %i objects (%i visible):")
+            << count << mobjs.size() << visible;
+    LOG_MAP_MSG("  Uncached:          %.2f ms") << uncached   * 1000;
+    LOG_MAP_MSG("  Cached, 1st pass:  %.2f ms") << firstPass  * 1000;
+    LOG_MAP_MSG("  Cached, 2nd pass:  %.2f ms") << secondPass * 1000;
+    LOG_MAP_MSG("  Batch (parallel):  %.2f ms") << batch      * 1000;
+}
+
+D_CMD(SightBench)
+{
+    DENG2_UNUSED(src);
+
+    LOG_AS("sightbench (Cmd)");
+
+    if (argc > 2)
+    {
+        LOG_SCR_NOTE("Usage: %s (queries)") << argv[0];
+        return true;
+    }
+
+    if (!App_World().hasMap())
+    {
+        LOG_SCR_WARNING("No map is currently loaded");
+        return false;
+    }
+
+    dint const count = (argc == 2? de::max(1, String(argv[1]).toInt()) : 5000);
+    App_World().map().lineSightCache().benchmark(count);
+    return true;
+}
+
+void LineSightCache::consoleRegister() // static
+{
+    C_CMD("sightbench", NULL, SightBench);
+}
+
+}  // namespace world
@@ -26,10 +26,11 @@
 #include <de/fixedpoint.h>
 #include <de/vector1.h>
 #include <doomsday/BspNode>
+#include <QThreadStorage>
+#include <QVector>
 
 #include "Face"
 
-#include "world/clientserverworld.h"  /// For validCount, @todo Remove me.
 #include "BspLeaf"
 #include "ConvexSubspace"
 #include "Line"
@@ -40,6 +41,41 @@ using namespace de;
 
 namespace world {
 
+/**
+ * Visitation stamps of the lines during one trace. Each thread has its own set so
+ * that traces can be made concurrently.
+ */
+struct LineSightStamps
+{
+    QVector<duint32> stamps;  ///< Indexed by line.
+    duint32 current = 0;
+
+    void begin()
+    {
+        if (!++current)
+        {
+            // Wrapped around; old stamps would be mistaken for new ones.
+            stamps.fill(0);
+            current = 1;
+        }
+    }
+
+    /// @return  @c true if @a line had not yet been visited during the trace.
+    inline bool visit(Line const &line)
+    {
+        dint const index = line.indexInMap();
+        DENG2_ASSERT(index >= 0);
+        if (index >= stamps.size())
+        {
+            stamps.resize(index + 1);  // New stamps are zero.
+        }
+        if (stamps.at(index) == current) return false;
+        stamps[index] = current;
+        return true;
+    }
+};
+static QThreadStorage<LineSightStamps> lineSightStamps;
+
 DENG2_PIMPL_NOREF(LineSightTest)
 {
     dint flags = 0;      ///< LS_* flags @ref lineSightFlags
@@ -47,6 +83,7 @@ DENG2_PIMPL_NOREF(LineSightTest)
     Vector3d to;         ///< Ray target.
     dfloat bottomSlope;  ///< Slope to bottom of target.
     dfloat topSlope;     ///< Slope to top of target.
+    LineSightStamps *stamps = nullptr;
 
     /// The ray to be traced.
     struct Ray
@@ -91,11 +128,9 @@ DENG2_PIMPL_NOREF(LineSightTest)
 
         Line &line = side.line();
 
-        if (line.validCount() == validCount)
+        if (!stamps->visit(line))
             return true;  // Ignore
 
-        line.setValidCount(validCount);
-
         // Does the ray intercept the line on the X/Y plane?
         // Try a quick bounding-box rejection.
         if (   line.bounds().minX > ray.bounds.maxX
@@ -326,7 +361,8 @@ LineSightTest::LineSightTest(Vector3d const &from, Vector3d const &to, dfloat bo
 
 bool LineSightTest::trace(BspTree const &bspRoot)
 {
-    validCount++;
+    d->stamps = &lineSightStamps.localData();
+    d->stamps->begin();
 
     d->topSlope    = d->to.z + d->topSlope    - d->from.z;
     d->bottomSlope = d->to.z + d->bottomSlope - d->from.z;
@@ -39,9 +39,11 @@
 #include "world/blockmap.h"
 #include "world/lineblockmap.h"
 #include "world/lineowner.h"
+#include "world/linesightcache.h"
 #include "world/p_object.h"
 #include "world/p_players.h"
 #include "world/polyobjdata.h"
+#include "world/reject.h"
 #include "world/sky.h"
 #include "world/thinkers.h"
 #include "BspLeaf"
@@ -79,6 +81,7 @@
 
 #include <de/LogBuffer>
 #include <de/Rectangle>
+#include <de/Time>
 
 #include <de/aabox.h>
 #include <de/charsymbols.h>
@@ -100,6 +103,8 @@ static dint bspSplitFactor = 7;  ///< cvar
 static dint lgMXSample = 1;  ///< 5 samples per block.
 #endif
 
+static byte parallelContactSpreading = true;  ///< cvar
+
 /// Milliseconds it takes for Unpredictable and Hidden mobjs to be
 /// removed from the hash. Under normal circumstances, the special
 /// status should be removed fairly quickly.
@@ -253,9 +258,9 @@ DENG2_PIMPL(Map)
             }
         }
 
-        void spread(AABoxd const &region)
+        void spread(AABoxd const &region, bool parallel = false)
         {
-            spreadContacts(*this, region, &spreadBlocks);
+            spreadContacts(*this, region, &spreadBlocks, parallel);
         }
     };
 
@@ -294,6 +299,11 @@ DENG2_PIMPL(Map)
     std::unique_ptr<Blockmap> polyobjBlockmap;
     std::unique_ptr<LineBlockmap> lineBlockmap;
     std::unique_ptr<Blockmap> subspaceBlockmap;
+    Block reject;                       ///< Sector visibility matrix (bit set = blocked).
+    std::unique_ptr<RejectMatrixBuilder> rejectBuilder; ///< Matrix not ready yet.
+    duint64 rejectTests = 0;            ///< Number of reject lookups.
+    duint64 rejectHits  = 0;            ///< Number of sight tests avoided.
+    std::unique_ptr<LineSightCache> lineSightCache;
 #ifdef __CLIENT__
     std::unique_ptr<ContactBlockmap> mobjContactBlockmap;  /// @todo Redundant?
     std::unique_ptr<ContactBlockmap> lumobjContactBlockmap;
@@ -329,10 +339,22 @@ DENG2_PIMPL(Map)
     {
         sky.setMap(thisPublic);
         sky.setIndexInMap(0);
+
+        lineSightCache.reset(new LineSightCache(*i));
     }
 
     ~Impl()
     {
+        if (rejectTests)
+        {
+            LOG_MAP_VERBOSE("Reject matrix avoided %i of %i sight tests")
+                    << rejectHits << rejectTests;
+        }
+        if (lineSightCache->hitCount() + lineSightCache->missCount())
+        {
+            LOG_MAP_VERBOSE("Line of sight cache: %s") << lineSightCache->statsSummary();
+        }
+
 #ifdef __CLIENT__
         self().removeAllLumobjs();
 #if 0
@@ -1011,6 +1033,41 @@ DENG2_PIMPL(Map)
         });
     }
 
+    /**
+     * Spreads all contacts of the map, so that no spreading remains to be done while
+     * drawing.
+     *
+     * @param parallel  Spread concurrently in worker threads.
+     */
+    void spreadAllContactsNow(bool parallel)
+    {
+        // The visual planes are mapped on first use, which is not thread-safe.
+        for (Sector *sector : sectors)
+        {
+            sector->forAllSubsectors([] (Subsector &subsec)
+            {
+                auto &clSubsec = subsec.as<ClientSubsector>();
+                clSubsec.visFloor();
+                clSubsec.visCeiling();
+                return LoopContinue;
+            });
+        }
+
+        mobjContactBlockmap  ->spread(mobjContactBlockmap->bounds(),   parallel);
+        lumobjContactBlockmap->spread(lumobjContactBlockmap->bounds(), parallel);
+    }
+
+    /**
+     * Unlinks all contacts from the subspaces, keeping the contacts themselves.
+     */
+    void unspreadAllContacts()
+    {
+        mobjContactBlockmap->spreadBlocks.fill(false);
+        lumobjContactBlockmap->spreadBlocks.fill(false);
+
+        R_UnlinkSubspaceContacts(*thisPublic);
+    }
+
     // Clear the "contact" blockmaps (BSP leaf => object).
     void removeAllContacts()
     {
@@ -1939,6 +1996,36 @@ void Map::spreadAllContacts(AABoxd const &region)
                       region.maxX + Lumobj::radiusMax(), region.maxY + Lumobj::radiusMax()));
 }
 
+void Map::benchmarkContactSpreading(dint iterations)
+{
+    LOG_AS("Map");
+
+    dint contactCount = 0;
+    R_ForAllContacts([&contactCount] (Contact const &)
+    {
+        contactCount++;
+        return LoopContinue;
+    });
+
+    ddouble elapsed[2] = { 0, 0 };
+    for (dint mode = 0; mode < 2; ++mode)
+    {
+        for (dint i = 0; i < iterations; ++i)
+        {
+            d->unspreadAllContacts();
+
+            Time const startedAt;
+            d->spreadAllContactsNow(mode != 0);
+            elapsed[mode] += startedAt.since();
+        }
+    }
+
+    LOG_MAP_MSG("Spreading %i contacts in %i subspaces (average of %i runs):")
+            << contactCount << subspaceCount() << iterations;
+    LOG_MAP_MSG("  Serial:   %.3f ms") << elapsed[0] / iterations * 1000;
+    LOG_MAP_MSG("  Parallel: %.3f ms") << elapsed[1] / iterations * 1000;
+}
+
 void Map::initGenerators()
 {
     LOG_AS("Map::initGenerators");
@@ -2597,11 +2684,13 @@ void Map::link(mobj_t &mob, dint flags)
 void Map::unlink(Polyobj &polyobj)
 {
     d->polyobjBlockmap->unlink(polyobj.bounds, &polyobj);
+    d->lineSightCache->invalidate();
 }
 
 void Map::link(Polyobj &polyobj)
 {
     d->polyobjBlockmap->link(polyobj.bounds, &polyobj);
+    d->lineSightCache->invalidate();
 }
 
 LoopResult Map::forAllLinesInBox(AABoxd const &box, dint flags, std::function<LoopResult (Line &line)> func) const
@@ -2696,6 +2785,28 @@ BspLeaf &Map::bspLeafAt_FixedPrecision(Vector2d const &point) const
     return bspTree->userData()->as<BspLeaf>();
 }
 
+bool Map::isSightRejected(Sector const &a, Sector const &b) const
+{
+    if (d->rejectBuilder && d->rejectBuilder->isReady())
+    {
+        d->reject = d->rejectBuilder->takeMatrix();
+        d->rejectBuilder.reset();
+    }
+    if (d->reject.isEmpty()) return false;
+
+    dsize const bit = dsize(a.indexInMap()) * d->sectors.count() + b.indexInMap();
+    bool const rejected = (d->reject.at(dint(bit >> 3)) & (1 << (bit & 7))) != 0;
+
+    d->rejectTests++;
+    if (rejected) d->rejectHits++;
+    return rejected;
+}
+
+LineSightCache &Map::lineSightCache() const
+{
+    return *d->lineSightCache;
+}
+
 #ifdef __CLIENT__
 
 void Map::updateScrollingSurfaces()
@@ -3340,6 +3451,11 @@ void Map::worldSystemFrameBegins(bool resetNextViewer)
 
         d->linkAllParticles();
         d->linkAllContacts();
+
+        if (parallelContactSpreading)
+        {
+            d->spreadAllContactsNow(true);
+        }
     }
 }
 
@@ -3407,6 +3523,16 @@ String Map::elementSummaryAsStyledText() const
 #undef TABBED
 }
 
+String Map::rejectSummary() const
+{
+    if (d->rejectBuilder) return "Being built";
+    if (d->reject.isEmpty()) return "None";
+
+    return String("%1 of %2 sight tests avoided")
+            .arg(d->rejectHits)
+            .arg(d->rejectTests);
+}
+
 String Map::objectSummaryAsStyledText() const
 {
 #define TABBED(count, label) String(_E(Ta) "  %1 " _E(Tb) "%2\n").arg(count).arg(label)
@@ -3487,6 +3613,9 @@ D_CMD(InspectMap)
         LOG_SCR_MSG(_E(l) "BSP: " _E(.) _E(i)) << map.bspTree().summary();
     }
 
+    LOG_SCR_MSG(_E(l) "Reject: " _E(.) _E(i)) << map.rejectSummary();
+    LOG_SCR_MSG(_E(l) "Sight cache: " _E(.) _E(i)) << map.lineSightCache().statsSummary();
+
     if (!map.subspaceBlockmap().isNull())
     {
         LOG_SCR_MSG(_E(l) "Subspace blockmap: " _E(.) _E(i)) << map.subspaceBlockmap().dimensions().asText();
@@ -3518,6 +3647,31 @@ D_CMD(InspectMap)
 #undef TABBED
 }
 
+#ifdef __CLIENT__
+D_CMD(ContactSpreadBench)
+{
+    DENG2_UNUSED(src);
+
+    LOG_AS("contactspreadbench (Cmd)");
+
+    if (argc > 2)
+    {
+        LOG_SCR_NOTE("Usage: %s (iterations)") << argv[0];
+        return true;
+    }
+
+    if (!App_World().hasMap())
+    {
+        LOG_SCR_WARNING("No map is currently loaded");
+        return false;
+    }
+
+    dint const iterations = (argc == 2? de::max(1, String(argv[1]).toInt()) : 100);
+    App_World().map().benchmarkContactSpreading(iterations);
+    return true;
+}
+#endif // __CLIENT__
+
 void Map::consoleRegister() // static
 {
     Line::consoleRegister();
@@ -3532,6 +3686,11 @@ void Map::consoleRegister() // static
 #endif
 
     C_CMD("inspectmap", "", InspectMap);
+    LineSightCache::consoleRegister();
+#ifdef __CLIENT__
+    C_VAR_BYTE("rend-dev-contact-parallel", &parallelContactSpreading, CVF_NO_ARCHIVE, 0, 1);
+    C_CMD("contactspreadbench", NULL, ContactSpreadBench);
+#endif
 }
 
 //- Runtime map editing -----------------------------------------------------------------
@@ -4044,6 +4203,10 @@ bool Map::endEditing()
     // We can now initialize the subspace blockmap.
     d->initSubspaceBlockmap();
 
+    // Determine which sectors cannot possibly see each other. Sight checks are traced
+    // until the matrix is ready.
+    d->rejectBuilder.reset(new RejectMatrixBuilder(*this));
+
     // Prepare the thinker lists.
     d->thinkers.reset(new Thinkers);
 
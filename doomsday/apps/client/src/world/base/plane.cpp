@@ -21,6 +21,7 @@
 #include "world/plane.h"
 
 #include "world/map.h"
+#include "world/linesightcache.h"
 #include "world/thinkers.h"
 #include "world/clientserverworld.h"  // ddMapSetup
 #include "Surface"
@@ -110,6 +111,12 @@ DENG2_PIMPL(Plane)
 
         notifyHeightChanged();
 
+        if(!ddMapSetup)
+        {
+            // Lines of sight may have opened or closed.
+            map().lineSightCache().invalidate();
+        }
+
 #ifdef __CLIENT__
         if(!ddMapSetup)
         {
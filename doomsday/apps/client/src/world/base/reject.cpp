@@ -23,92 +23,512 @@
  * 02110-1301 USA</small>
  */
 
-#if 0 // Needs updating.
-#include <cmath>
-
 #include "de_base.h"
+#include "world/reject.h"
+
 #include "world/map.h"
+#include "BspLeaf"
+#include "ConvexSubspace"
+#include "Face"
+#include "HEdge"
+#include "Line"
+#include "Sector"
+#include "Vertex"
+
+#include <de/MetadataBank>
+#include <de/Reader>
+#include <de/TaskPool>
+#include <de/Time>
+#include <de/Writer>
+#include <QBitArray>
+#include <QHash>
+#include <atomic>
+#include <memory>
 
 using namespace de;
 
-void BuildRejectForMap(Map const &map)
+namespace world {
+
+static String const REJECT_CACHE_CATEGORY = "MapReject";
+
+/// Increment when the output of the builder changes.
+static duint32 const REJECT_BUILDER_VERSION = 1;
+
+/// Maximum number of portal steps when flowing from one subspace.
+static dint const REJECT_FLOW_BUDGET = 200000;
+
+/// Distance tolerance for the window clipping (map units).
+static ddouble const REJECT_EPSILON = 1.0 / 128;
+
+/// Subspaces processed per task.
+static dint const REJECT_TASK_BATCH = 64;
+
+namespace internal {
+
+struct RejectSegment
+{
+    Vector2d from;
+    Vector2d to;
+
+    RejectSegment(Vector2d const &a = Vector2d(), Vector2d const &b = Vector2d())
+        : from(a), to(b) {}
+
+    Vector2d const &point(dint i) const { return i? to : from; }
+    ddouble length() const { return (to - from).length(); }
+};
+
+struct RejectPortal
+{
+    RejectSegment segment;
+    dint leaf;                      ///< Subspace on the other side.
+};
+
+struct RejectLeaf
 {
-    int *secGroups = M_Malloc(sizeof(int) * map.sectorCount());
-    int group = 0;
+    dint sector = -1;
+    dint group  = -1;               ///< Connected group of subspaces.
+    QVector<dint> portals;          ///< Portals leading out of the subspace.
+    QVector<dint> neighbors;        ///< Subspaces sharing a vertex (including self).
+};
 
-    for(uint i = 0; i < map.sectorCount(); ++i)
+/**
+ * Signed distance of @a point from the line through @a a and @a b.
+ */
+static inline ddouble rejectLineSide(Vector2d const &a, Vector2d const &b, ddouble length,
+                                     Vector2d const &point)
+{
+    Vector2d const delta = b - a;
+    return (delta.x * (point.y - a.y) - delta.y * (point.x - a.x)) / length;
+}
+
+/**
+ * Clips @a window to the region that is visible from the @a source segment through
+ * the @a pass segment. The clipping is inclusive, with a small tolerance.
+ *
+ * @return  @c false if nothing of the window remains.
+ */
+static bool rejectClipWindow(RejectSegment const &source, RejectSegment const &pass,
+                             RejectSegment &window)
+{
+    for (dint i = 0; i < 2; ++i)
+    for (dint j = 0; j < 2; ++j)
     {
-        Sector &sector = map.sectors[i];
-        secGroups[i] = group++;
-        sector.rejNext = sector.rejPrev = &sector;
+        Vector2d const &a = source.point(i);
+        Vector2d const &b = pass.point(j);
+        ddouble const length = (b - a).length();
+        if (length < REJECT_EPSILON) continue; // Degenerate.
+
+        // Only lines that separate the source from the pass are of interest.
+        ddouble const sourceSide = rejectLineSide(a, b, length, source.point(i ^ 1));
+        ddouble const passSide   = rejectLineSide(a, b, length, pass.point(j ^ 1));
+        if (!((sourceSide < -REJECT_EPSILON && passSide >  REJECT_EPSILON) ||
+              (sourceSide >  REJECT_EPSILON && passSide < -REJECT_EPSILON)))
+        {
+            continue;
+        }
+
+        // The visible region is on the same side as the pass.
+        ddouble const sign = (passSide > 0? 1 : -1);
+        ddouble const fromDist = sign * rejectLineSide(a, b, length, window.from);
+        ddouble const toDist   = sign * rejectLineSide(a, b, length, window.to);
+
+        if (fromDist < -REJECT_EPSILON && toDist < -REJECT_EPSILON)
+        {
+            return false; // Entirely hidden.
+        }
+        if (fromDist < -REJECT_EPSILON)
+        {
+            ddouble const t = (fromDist + REJECT_EPSILON) / (fromDist - toDist);
+            window.from = window.from + (window.to - window.from) * t;
+        }
+        else if (toDist < -REJECT_EPSILON)
+        {
+            ddouble const t = (toDist + REJECT_EPSILON) / (toDist - fromDist);
+            window.to = window.to + (window.from - window.to) * t;
+        }
     }
+    return true;
+}
 
-    for(uint i = 0; i < map.lineCount(); ++i)
+/**
+ * Portal graph of the map's convex subspaces.
+ */
+struct RejectBuilder
+{
+    dint sectorCount = 0;
+    QVector<RejectLeaf> leafs;
+    QVector<RejectPortal> portals;
+    QVector<QBitArray> leafVisibility; ///< Visible sectors of each subspace.
+    std::atomic_int fallbackCount { 0 };
+    std::atomic_bool cancelled { false };
+
+    explicit RejectBuilder(Map const &map)
+        : sectorCount(map.sectorCount())
     {
-        Line *line = &map.lines[i];
+        QHash<ConvexSubspace const *, dint> leafIndex;
+        map.forAllSubspaces([this, &leafIndex] (ConvexSubspace &subspace)
+        {
+            leafIndex.insert(&subspace, leafs.count());
+            RejectLeaf leaf;
+            if (Sector const *sector = subspace.bspLeaf().sectorPtr())
+            {
+                leaf.sector = sector->indexInMap();
+            }
+            leafs.append(leaf);
+            return LoopContinue;
+        });
 
-        if(!line->front().hasSector() || !line->back().hasSector())
-            continue;
+        // Vertexes are identified by position so that coincident ones are shared.
+        QHash<QPair<dint64, dint64>, QVector<dint>> vertexLeafs;
+        auto const vertexKey = [] (Vector2d const &pos) {
+            return qMakePair(dint64(std::floor(pos.x / REJECT_EPSILON)),
+                             dint64(std::floor(pos.y / REJECT_EPSILON)));
+        };
 
-        Sector *sec1 = line->front().sectorPtr();
-        Sector *sec2 = line->back().sectorPtr();
+        for (auto it = leafIndex.constBegin(); it != leafIndex.constEnd(); ++it)
+        {
+            dint const index = it.value();
+            if (leafs[index].sector < 0) continue;
 
-        if(!sec1 || !sec2 || sec1 == sec2)
-            continue;
+            HEdge const *base  = it.key()->poly().hedge();
+            HEdge const *hedge = base;
+            do
+            {
+                QVector<dint> &atVertex = vertexLeafs[vertexKey(hedge->origin())];
+                if (!atVertex.contains(index)) atVertex.append(index);
 
-        // Already in the same group?
-        if(secGroups[sec1->index] == secGroups[sec2->index])
-            continue;
+                if (hedge->hasTwin() && hedge->twin().hasFace()
+                    && hedge->twin().face().hasMapElement())
+                {
+                    auto const *other = &hedge->twin().face().mapElementAs<ConvexSubspace>();
+                    dint const otherIndex = leafIndex.value(other, -1);
+                    if (otherIndex >= 0 && otherIndex != index && leafs[otherIndex].sector >= 0)
+                    {
+                        RejectPortal portal;
+                        portal.segment = RejectSegment(hedge->origin(), hedge->twin().origin());
+                        portal.leaf    = otherIndex;
+                        leafs[index].portals.append(portals.count());
+                        portals.append(portal);
+                    }
+                }
+            } while ((hedge = &hedge->next()) != base);
+        }
 
-        // Swap sectors so that the smallest group is added to the biggest
-        // group. This is based on the assumption that sector numbers in
-        // wads will generally increase over the set of lines, and so
-        // (by swapping) we'll tend to add small groups into larger
-        // groups, thereby minimising the updates to 'rej_group' fields
-        // that is required when merging.
-        Sector *p = 0;
-        if(secGroups[sec1->index] > secGroups[sec2->index])
-        {
-            p = sec1;
-            sec1 = sec2;
-            sec2 = p;
+        // Subspaces touching at a vertex only. A point exactly on such a vertex may be
+        // attributed to either subspace.
+        for (auto const &atVertex : vertexLeafs)
+        {
+            for (dint index : atVertex)
+            for (dint other : atVertex)
+            {
+                if (!leafs[index].neighbors.contains(other))
+                {
+                    leafs[index].neighbors.append(other);
+                }
+            }
         }
 
-        // Update the group numbers in the second group
-        secGroups[sec2->index] = secGroups[sec1->index];
-        for(p = sec2->rejNext; p != sec2; p = p->rejNext)
+        findGroups();
+        leafVisibility.resize(leafs.count());
+    }
+
+    void findGroups()
+    {
+        dint group = 0;
+        QVector<dint> todo;
+        for (dint i = 0; i < leafs.count(); ++i)
         {
-            secGroups[p->index] = secGroups[sec1->index];
+            if (leafs[i].sector < 0 || leafs[i].group >= 0) continue;
+
+            leafs[i].group = group;
+            todo.append(i);
+            while (!todo.isEmpty())
+            {
+                RejectLeaf const &leaf = leafs[todo.takeLast()];
+                for (dint p : leaf.portals)
+                {
+                    RejectLeaf &next = leafs[portals[p].leaf];
+                    if (next.group < 0)
+                    {
+                        next.group = group;
+                        todo.append(portals[p].leaf);
+                    }
+                }
+            }
+            group++;
         }
+    }
+
+    /**
+     * Determines the sectors visible from subspace @a source.
+     */
+    void flow(dint source)
+    {
+        QBitArray &visible = leafVisibility[source];
+        visible = QBitArray(sectorCount);
+
+        RejectLeaf const &leaf = leafs.at(source);
+        if (leaf.sector < 0) return;
+
+        visible.setBit(leaf.sector);
+
+        struct Step
+        {
+            dint leaf;
+            RejectSegment window;
+            dint next;                  ///< Index of the next portal to try.
+        };
+        QVector<Step> stack;
+        QBitArray onPath(leafs.count());
+        dint work = 0;
+
+        onPath.setBit(source);
+        for (dint sourcePortal : leaf.portals)
+        {
+            RejectPortal const &start = portals.at(sourcePortal);
+            if (onPath.testBit(start.leaf)) continue;
+
+            visible.setBit(leafs.at(start.leaf).sector);
+            onPath.setBit(start.leaf);
+            stack.append(Step{ start.leaf, start.segment, 0 });
+
+            while (!stack.isEmpty())
+            {
+                Step &top = stack.last();
+                RejectLeaf const &current = leafs.at(top.leaf);
+                if (top.next == current.portals.count())
+                {
+                    onPath.clearBit(top.leaf);
+                    stack.removeLast();
+                    continue;
+                }
+
+                RejectPortal const &portal = portals.at(current.portals.at(top.next++));
+                if (onPath.testBit(portal.leaf)) continue;
+
+                if (++work > REJECT_FLOW_BUDGET)
+                {
+                    floodGroup(source);
+                    return;
+                }
+                if (!(work & 0xfff) && cancelled) return;
 
-        // Merge 'em baby...
-        sec1->rejNext->rejPrev = sec2;
-        sec2->rejNext->rejPrev = sec1;
+                RejectSegment window = portal.segment;
+                if (stack.count() > 1)
+                {
+                    if (!rejectClipWindow(start.segment, top.window, window))
+                        continue;
 
-        p = sec1->rejNext;
-        sec1->rejNext = sec2->rejNext;
-        sec2->rejNext = p;
+                    // A degenerate window would produce degenerate separators.
+                    if (window.length() < REJECT_EPSILON)
+                        window = portal.segment;
+                }
+
+                visible.setBit(leafs.at(portal.leaf).sector);
+                onPath.setBit(portal.leaf);
+                stack.append(Step{ portal.leaf, window, 0 });
+            }
+        }
     }
 
-    size_t rejectSize = (map.sectorCount() * map.sectorCount() + 7) / 8;
-    byte *matrix = Z_Calloc(rejectSize, PU_MAPSTATIC, 0);
+    /// Everything connected to @a source is considered visible.
+    void floodGroup(dint source)
+    {
+        fallbackCount++;
+
+        QBitArray &visible = leafVisibility[source];
+        dint const group = leafs.at(source).group;
+        for (RejectLeaf const &leaf : leafs)
+        {
+            if (leaf.sector >= 0 && leaf.group == group)
+            {
+                visible.setBit(leaf.sector);
+            }
+        }
+    }
 
-    for(int view = 0; view < map.sectorCount(); ++view)
-    for(int target = 0; target < view; ++target)
+    Block matrix() const
     {
-        if(secGroups[view] == secGroups[target])
-            continue;
+        QVector<QBitArray> sectorVisibility(sectorCount, QBitArray(sectorCount));
+        for (RejectLeaf const &leaf : leafs)
+        {
+            if (leaf.sector < 0) continue;
+
+            QBitArray &visible = sectorVisibility[leaf.sector];
+            for (dint other : leaf.neighbors)
+            {
+                visible |= leafVisibility[other];
+            }
+        }
+
+        Block packed((dsize(sectorCount) * sectorCount + 7) / 8);
+        packed.fill('\0');
+        for (dint i = 0; i < sectorCount; ++i)
+        for (dint k = 0; k < sectorCount; ++k)
+        {
+            // Visibility is symmetric.
+            if (sectorVisibility[i].testBit(k) || sectorVisibility[k].testBit(i))
+                continue;
+
+            dsize const bit = dsize(i) * sectorCount + k;
+            packed.data()[bit >> 3] |= (1 << (bit & 7));
+        }
+        return packed;
+    }
+};
+
+} // namespace internal
+
+using namespace internal;
+
+/**
+ * Identifies the line geometry of the map, which is all that the reject matrix
+ * depends on.
+ */
+static Block rejectCacheId(Map const &map)
+{
+    Block geometry;
+    Writer writer(geometry);
+    writer << REJECT_BUILDER_VERSION << dint32(map.sectorCount()) << dint32(map.lineCount());
+    map.forAllLines([&writer] (Line &line)
+    {
+        writer << line.from().origin().x << line.from().origin().y
+               << line.to  ().origin().x << line.to  ().origin().y
+               << dint32(line.front().hasSector()? line.front().sector().indexInMap() : -1)
+               << dint32(line.back ().hasSector()? line.back ().sector().indexInMap() : -1);
+        return LoopContinue;
+    });
+    return geometry.md5Hash();
+}
+
+DENG2_PIMPL_NOREF(RejectMatrixBuilder)
+{
+    /**
+     * State shared with the background tasks, which may outlive the builder if it
+     * is deleted before they are done.
+     */
+    struct Build
+    {
+        RejectBuilder graph;
+        std::atomic_int pendingBatches { 0 };
+        std::atomic_bool ready { false };
+        Block matrix;                   ///< Written by the task finishing last.
+        Time startedAt;
+
+        explicit Build(Map const &map) : graph(map) {}
+    };
+
+    Block id;
+    dsize expectedSize = 0;
+    Block matrix;                       ///< Cached or taken matrix.
+    std::shared_ptr<Build> build;
+    TaskPool tasks;
+
+    Block cachedMatrix() const
+    {
+        try
+        {
+            if (Block const data = MetadataBank::get().check(REJECT_CACHE_CATEGORY, id))
+            {
+                Block cached;
+                Reader(data).withHeader() >> cached;
+                if (cached.size() == expectedSize)
+                {
+                    return cached;
+                }
+            }
+        }
+        catch (Error const &er)
+        {
+            LOGDEV_MAP_WARNING("Corrupt cached metadata: %s") << er.asText();
+        }
+        return Block();
+    }
 
-        // For symmetry, do two bits at a time.
-        int p1 = view * map.sectorCount() + target;
-        int p2 = target * map.sectorCount() + view;
+    void startBuild(Map const &map)
+    {
+        build.reset(new Build(map));
+
+        dint const leafCount = build->graph.leafs.count();
+        if (!leafCount)
+        {
+            build->matrix = build->graph.matrix();
+            build->ready  = true;
+            return;
+        }
 
-        matrix[p1 >> 3] |= (1 << (p1 & 7));
-        matrix[p2 >> 3] |= (1 << (p2 & 7));
+        build->pendingBatches = (leafCount + REJECT_TASK_BATCH - 1) / REJECT_TASK_BATCH;
+        for (dint first = 0; first < leafCount; first += REJECT_TASK_BATCH)
+        {
+            dint const last = de::min(first + REJECT_TASK_BATCH, leafCount);
+            std::shared_ptr<Build> shared = build;
+            tasks.start([shared, first, last] ()
+            {
+                for (dint i = first; i < last && !shared->graph.cancelled; ++i)
+                {
+                    shared->graph.flow(i);
+                }
+                // The last batch to finish combines the results.
+                if (--shared->pendingBatches == 0 && !shared->graph.cancelled)
+                {
+                    shared->matrix = shared->graph.matrix();
+                    shared->ready  = true;
+                }
+            });
+        }
     }
+};
+
+RejectMatrixBuilder::RejectMatrixBuilder(Map const &map)
+    : d(new Impl)
+{
+    LOG_AS("RejectMatrixBuilder");
 
-    M_Free(secGroups);
+    d->expectedSize = (dsize(map.sectorCount()) * map.sectorCount() + 7) / 8;
+    d->id = rejectCacheId(map);
 
-    return matrix;
+    d->matrix = d->cachedMatrix();
+    if (!d->matrix.isEmpty())
+    {
+        LOG_MAP_VERBOSE("Using cached reject matrix");
+        return;
+    }
+    d->startBuild(map);
 }
-#endif
+
+RejectMatrixBuilder::~RejectMatrixBuilder()
+{
+    if (d->build)
+    {
+        d->build->graph.cancelled = true;
+    }
+}
+
+bool RejectMatrixBuilder::isReady() const
+{
+    return !d->matrix.isEmpty() || (d->build && d->build->ready);
+}
+
+Block RejectMatrixBuilder::takeMatrix()
+{
+    LOG_AS("RejectMatrixBuilder");
+
+    if (d->build && d->build->ready)
+    {
+        auto const &build = *d->build;
+        LOG_MAP_VERBOSE("Reject matrix for %i sectors built in %.2f seconds (%i of %i"
+                        " subspaces exceeded the work limit)")
+                << build.graph.sectorCount << build.startedAt.since()
+                << dint(build.graph.fallbackCount) << build.graph.leafs.count();
+
+        d->matrix = build.matrix;
+        d->build.reset();
+
+        Block data;
+        Writer(data).withHeader() << d->matrix;
+        MetadataBank::get().setMetadata(REJECT_CACHE_CATEGORY, d->id, data);
+    }
+    return d->matrix;
+}
+
+} // namespace world
@@ -210,6 +210,11 @@ void R_ClearContactLists(Map &map)
     contactCursor = contactFirst;
     contacts = nullptr;
 
+    R_UnlinkSubspaceContacts(map);
+}
+
+void R_UnlinkSubspaceContacts(Map &map)
+{
     // Start reusing nodes from the first one in the list.
     ContactList::reset();
 
@@ -28,7 +28,7 @@
 #include "Sector"
 #include "Subsector"
 #include "Surface"
-#include "world/clientserverworld.h"  // validCount
+#include "world/map.h"
 
 #include "render/rend_main.h"  // Rend_mapSurfaceMaterialSpec
 #include "MaterialAnimator"
@@ -36,8 +36,12 @@
 
 #include "client/clientsubsector.h"
 
+#include <de/Guard>
+#include <de/Lockable>
+#include <de/TaskPool>
 #include <de/vector1.h>
 #include <QBitArray>
+#include <QThreadStorage>
 
 using namespace de;
 
@@ -63,57 +67,76 @@ static ddouble pointOnHEdgeSide(HEdge const &hedge, Vector2d const &point)
     return V2d_PointOnLineSide(pointV1, fromOriginV1, directionV1);
 }
 
-struct ContactSpreader
+/// Number of contacts spread by one task when spreading in parallel.
+static dint const CONTACT_SPREAD_TASK_SIZE = 64;
+
+/**
+ * Visitation stamps of the subspaces during the spreading of one contact. Each thread
+ * has its own set so that contacts can be spread concurrently.
+ */
+struct ContactSpreadStamps
 {
-    world::Blockmap const &_blockmap;
-    QBitArray *_spreadBlocks = nullptr;
+    QVector<duint32> stamps;  ///< Indexed by subspace.
+    duint32 current = 0;
 
-    struct SpreadState
+    void begin(dint subspaceCount)
     {
-        Contact *contact = nullptr;
-        AABoxd contactBounds;
-    };
-    SpreadState _spread;
+        if (stamps.size() != subspaceCount)
+        {
+            stamps.fill(0, subspaceCount);
+            current = 0;
+        }
+        if (!++current)
+        {
+            // Wrapped around; old stamps would be mistaken for new ones.
+            stamps.fill(0);
+            current = 1;
+        }
+    }
 
-    ContactSpreader(world::Blockmap const &blockmap, QBitArray *spreadBlocks = nullptr)
-        : _blockmap(blockmap)
+    inline bool isVisited(ConvexSubspace const &subspace) const
     {
-        _spreadBlocks = spreadBlocks;
+        return stamps.at(subspace.indexInMap()) == current;
     }
 
-    /**
-     * Spread contacts in the blockmap to any touched neighbors.
-     *
-     * @param box   Map space region in which to perform spreading.
-     */
-    void spread(AABoxd const &box)
+    inline void visit(ConvexSubspace const &subspace)
     {
-        BlockmapCellBlock const cellBlock = _blockmap.toCellBlock(box);
+        stamps[subspace.indexInMap()] = current;
+    }
+};
+static QThreadStorage<ContactSpreadStamps> contactSpreadStamps;
 
-        BlockmapCell cell;
-        for(cell.y = cellBlock.min.y; cell.y < cellBlock.max.y; ++cell.y)
-        for(cell.x = cellBlock.min.x; cell.x < cellBlock.max.x; ++cell.x)
-        {
-            if(_spreadBlocks)
-            {
-                // Should we skip this cell?
-                int cellIndex = _blockmap.toCellIndex(cell.x, cell.y);
-                if(_spreadBlocks->testBit(cellIndex))
-                    continue;
+/// Material animators are not thread-safe.
+static Lockable contactSpreadMaterialLock;
 
-                // Mark the cell as processed.
-                _spreadBlocks->setBit(cellIndex);
-            }
+/**
+ * Contact to be linked to a subspace. Spreading only produces these so that the
+ * contact lists can be updated in a deterministic order afterwards.
+ */
+struct ContactLink
+{
+    ConvexSubspace *subspace;
+    Contact *contact;
+};
+typedef QVector<ContactLink> ContactLinks;
 
-            _blockmap.forAllInCell(cell, [this] (void *element)
-            {
-                spreadContact(*static_cast<Contact *>(element));
-                return LoopContinue;
-            });
-        }
-    }
+struct ContactSpreader
+{
+    ContactSpreadStamps &_stamps;
+    ContactLinks &_links;
+
+    struct SpreadState
+    {
+        Contact *contact = nullptr;
+        AABoxd contactBounds;
+    };
+    SpreadState _spread;
+
+    ContactSpreader(ContactLinks &links)
+        : _stamps(contactSpreadStamps.localData())
+        , _links(links)
+    {}
 
-private:
     /**
      * Link the contact in all non-degenerate subspaces which touch the linked
      * object (tests are done with subspace bounding boxes and the spread test).
@@ -124,10 +147,11 @@ private:
     {
         ConvexSubspace &subspace = contact.objectBspLeafAtOrigin().subspace();
 
-        R_ContactList(subspace, contact.type()).link(&contact);
+        _links.append(ContactLink{ &subspace, &contact });
 
         // Spread to neighboring BSP leafs.
-        subspace.setValidCount(++validCount);
+        _stamps.begin(subspace.map().subspaceCount());
+        _stamps.visit(subspace);
 
         _spread.contact       = &contact;
         _spread.contactBounds = contact.objectBounds();
@@ -135,6 +159,7 @@ private:
         spreadInSubspace(subspace);
     }
 
+private:
     void maybeSpreadOverEdge(HEdge *hedge)
     {
         DENG2_ASSERT(_spread.contact != 0);
@@ -152,7 +177,7 @@ private:
         auto &backSubsec   = backSubspace.subsector().as<ClientSubsector>();
 
         // Which way does the spread go?
-        if (!(subspace.validCount() == validCount && backSubspace.validCount() != validCount))
+        if (!(_stamps.isVisited(subspace) && !_stamps.isVisited(backSubspace)))
         {
             return; // Not eligible for spreading.
         }
@@ -172,7 +197,8 @@ private:
             return;
 
         // Do not spread if the sector on the back side is closed with no height.
-        if(!backSubsec.hasWorldVolume())
+        // (Not using hasWorldVolume() as its cached result is not thread-safe.)
+        if (backSubsec.visCeiling().heightSmoothed() - backSubsec.visFloor().heightSmoothed() <= 0)
             return;
 
         if (   backSubsec.visCeiling().heightSmoothed() <= subsec.visFloor  ().heightSmoothed()
@@ -222,6 +248,8 @@ private:
                     openTop = fromSubsec.visCeiling().heightSmoothed();
                 }
 
+                DENG2_GUARD(contactSpreadMaterialLock);
+
                 MaterialAnimator &matAnimator = *facingLineSide.middle().materialAnimator();
                         //.as<ClientMaterial>().getAnimator(Rend_MapSurfaceMaterialSpec());
 
@@ -242,9 +270,9 @@ private:
         }
 
         // During the next step this contact will spread from the back leaf.
-        backSubspace.setValidCount(validCount);
+        _stamps.visit(backSubspace);
 
-        R_ContactList(backSubspace, _spread.contact->type()).link(_spread.contact);
+        _links.append(ContactLink{ &backSubspace, _spread.contact });
 
         spreadInSubspace(backSubspace);
     }
@@ -269,10 +297,90 @@ private:
     }
 };
 
+/**
+ * Links the contacts to the subspaces' contact lists in the order they were produced.
+ */
+static void linkContacts(ContactLinks const &links)
+{
+    for (ContactLink const &link : links)
+    {
+        R_ContactList(*link.subspace, link.contact->type()).link(link.contact);
+    }
+}
+
 void spreadContacts(Blockmap const &blockmap, AABoxd const &region,
-    QBitArray *spreadBlocks)
+    QBitArray *spreadBlocks, bool parallel)
 {
-    ContactSpreader(blockmap, spreadBlocks).spread(region);
+    // Collect the contacts of the cells that have not yet been processed.
+    static QVector<Contact *> contacts;
+    contacts.resize(0);
+
+    BlockmapCellBlock const cellBlock = blockmap.toCellBlock(region);
+    BlockmapCell cell;
+    for(cell.y = cellBlock.min.y; cell.y < cellBlock.max.y; ++cell.y)
+    for(cell.x = cellBlock.min.x; cell.x < cellBlock.max.x; ++cell.x)
+    {
+        if(spreadBlocks)
+        {
+            // Should we skip this cell?
+            int cellIndex = blockmap.toCellIndex(cell.x, cell.y);
+            if(spreadBlocks->testBit(cellIndex))
+                continue;
+
+            // Mark the cell as processed.
+            spreadBlocks->setBit(cellIndex);
+        }
+
+        blockmap.forAllInCell(cell, [] (void *element)
+        {
+            contacts.append(static_cast<Contact *>(element));
+            return LoopContinue;
+        });
+    }
+
+    if(contacts.isEmpty()) return;
+
+    dint const taskCount = (parallel? (contacts.size() + CONTACT_SPREAD_TASK_SIZE - 1) / CONTACT_SPREAD_TASK_SIZE
+                                    : 1);
+    if(taskCount <= 1)
+    {
+        static ContactLinks links;
+        links.resize(0);
+
+        ContactSpreader spreader(links);
+        for(Contact *contact : contacts)
+        {
+            spreader.spreadContact(*contact);
+        }
+        linkContacts(links);
+        return;
+    }
+
+    // Each task spreads a run of consecutive contacts. The results are linked in
+    // task order, so the contact lists end up the same as when spreading serially.
+    QVector<ContactLinks> results(taskCount);
+    {
+        TaskPool tasks;
+        for(dint i = 0; i < taskCount; ++i)
+        {
+            dint const begin = i * CONTACT_SPREAD_TASK_SIZE;
+            dint const end   = de::min(begin + CONTACT_SPREAD_TASK_SIZE, contacts.size());
+            ContactLinks *links = &results[i];
+            tasks.start([begin, end, links] ()
+            {
+                ContactSpreader spreader(*links);
+                for(dint k = begin; k < end; ++k)
+                {
+                    spreader.spreadContact(*contacts.at(k));
+                }
+            });
+        }
+        tasks.waitForDone();
+    }
+    for(ContactLinks const &links : results)
+    {
+        linkContacts(links);
+    }
 }
 
 }  // namespace world
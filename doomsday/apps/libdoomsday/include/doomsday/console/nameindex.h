@@ -0,0 +1,127 @@
+/** @file nameindex.h  Case-insensitive hash index of console names.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDOOMSDAY_CONSOLE_NAMEINDEX_H
+#define LIBDOOMSDAY_CONSOLE_NAMEINDEX_H
+
+#include <de/Utf8String>
+#include <QMultiHash>
+#include <cstring>
+
+/**
+ * Case-insensitive index for finding console variables and commands by their full
+ * name. The index does not own the objects.
+ *
+ * The names are stored case-folded. A name being looked up is hashed and compared
+ * as is, so finding an object does not allocate memory. Only ASCII letters are
+ * folded; console names are expected to be plain ASCII.
+ *
+ * @ingroup console
+ */
+template <typename Type>
+class NameIndex
+{
+public:
+    /**
+     * Adds an object to the index. An existing object with the same name is
+     * replaced.
+     */
+    void insert(char const *name, Type *object)
+    {
+        de::duint32 const key = hash(name);
+        for (auto i = _index.find(key); i != _index.end() && i.key() == key; ++i)
+        {
+            if (equals(i.value().name, name))
+            {
+                i.value().object = object;
+                return;
+            }
+        }
+        Entry entry;
+        entry.name.reserve(std::strlen(name));
+        for (char const *c = name; *c; ++c)
+        {
+            entry.name += fold(*c);
+        }
+        entry.object = object;
+        _index.insert(key, entry);
+    }
+
+    /**
+     * Finds an object by name.
+     *
+     * @return  The object, or @c nullptr if there is no object with the name.
+     */
+    Type *find(char const *name) const
+    {
+        if (!name) return nullptr;
+
+        de::duint32 const key = hash(name);
+        for (auto i = _index.constFind(key); i != _index.constEnd() && i.key() == key; ++i)
+        {
+            if (equals(i.value().name, name))
+            {
+                return i.value().object;
+            }
+        }
+        return nullptr;
+    }
+
+    void clear()
+    {
+        _index.clear();
+    }
+
+    int size() const
+    {
+        return _index.size();
+    }
+
+private:
+    static inline char fold(char c)
+    {
+        return (c >= 'A' && c <= 'Z')? char(c - 'A' + 'a') : c;
+    }
+
+    /// FNV-1a hash of the case-folded name.
+    static de::duint32 hash(char const *name)
+    {
+        de::duint32 h = 2166136261u;
+        for (; *name; ++name)
+        {
+            h = (h ^ de::duint8(fold(*name))) * 16777619u;
+        }
+        return h;
+    }
+
+    static bool equals(de::Utf8String const &folded, char const *name)
+    {
+        char const *f = folded.c_str();
+        for (; *f && *f == fold(*name); ++f, ++name) {}
+        return !*f && !*name;
+    }
+
+    struct Entry
+    {
+        de::Utf8String name;
+        Type *object = nullptr;
+    };
+    QMultiHash<de::duint32, Entry> _index;
+};
+
+#endif // LIBDOOMSDAY_CONSOLE_NAMEINDEX_H
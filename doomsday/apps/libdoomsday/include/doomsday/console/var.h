@@ -167,6 +167,15 @@ void Con_AddKnownWordsForVariables();
 
 LIBDOOMSDAY_PUBLIC void Con_AddVariable(cvartemplate_t const *tpl);
 LIBDOOMSDAY_PUBLIC void Con_AddVariableList(cvartemplate_t const *tplList);
+/**
+ * Finds a variable by its full path. The comparison is case insensitive. The lookup
+ * does not allocate memory, and the returned variable remains valid until the
+ * variables are cleared.
+ *
+ * @param path  Path of the variable, e.g., "rend-light-ambient".
+ *
+ * @return  Variable, or @c nullptr if not found.
+ */
 LIBDOOMSDAY_PUBLIC cvar_t *Con_FindVariable(char const *path);
 
 LIBDOOMSDAY_PUBLIC ddstring_t const *CVar_TypeName(cvartype_t type);
@@ -22,6 +22,7 @@
 
 #include <vector>
 #include <de/libcore.h>
+#include <de/ISerializable>
 #include <de/Record>
 #include <de/String>
 #include <de/Vector>
@@ -42,7 +43,7 @@
  * important. The Game DLL must be recompiled with the new constants if the order of the
  * array items changes.
  */
-struct LIBDOOMSDAY_PUBLIC ded_s
+struct LIBDOOMSDAY_PUBLIC ded_s : public de::ISerializable
 {
     de::Record names; ///< Namespace where definition values are stored.
 
@@ -209,6 +210,30 @@ public:
      */
     de::String findEpisode(de::String const &mapId) const;
 
+    /**
+     * Serializes all the definitions, for caching the parsed definitions. Only the
+     * same build of the engine can deserialize the data, as definition arrays are
+     * written as raw memory.
+     */
+    void operator >> (de::Writer &to) const override;
+
+    /**
+     * Replaces all the existing definitions with deserialized ones. If the data is
+     * invalid, the definitions are left empty.
+     */
+    void operator << (de::Reader &from) override;
+
+    /**
+     * Compares all the definitions with another set of definitions. Runtime links
+     * between definitions are not compared.
+     *
+     * @param other  Definitions to compare with.
+     *
+     * @return Names of the sections where the definitions differ. Empty, if the
+     * definitions are identical.
+     */
+    de::StringList differingSections(ded_s const &other) const;
+
 protected:
     void release();
 
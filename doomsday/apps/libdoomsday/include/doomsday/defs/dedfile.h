@@ -24,8 +24,45 @@
 
 #include "../libdoomsday.h"
 #include "ded.h"
+#include <de/Block>
 #include <de/String>
 
+/**
+ * Definition sources encountered while reading definitions. Needed for determining
+ * if cached definitions are still up to date, and for restoring the side effects of
+ * the definitions when they are loaded from the cache.
+ */
+struct LIBDOOMSDAY_PUBLIC DEDSourceLog
+{
+    de::StringList files;       ///< Files read, including the ones read via Include.
+    de::StringList modelPaths;  ///< Native paths added with ModelPath.
+};
+
+/**
+ * Sets the log where the sources of definitions read from now on are recorded.
+ *
+ * @param log  Source log, or @c nullptr to stop recording.
+ */
+LIBDOOMSDAY_PUBLIC void DED_SetSourceLog(DEDSourceLog *log);
+
+/**
+ * Identifies the current version of a definition file, so it can be determined if the
+ * file has changed since the definitions were cached.
+ *
+ * @param path  Definition file, located like Def_ReadProcessDED() does.
+ *
+ * @return MD5 hash of the path, size, and modification time of the file. An empty
+ * block is returned if the file is not found.
+ */
+LIBDOOMSDAY_PUBLIC de::Block DED_SourceFileId(de::String const &path);
+
+/**
+ * Adds a search path for models (the ModelPath directive).
+ *
+ * @param nativePath  Native directory path.
+ */
+LIBDOOMSDAY_PUBLIC void DED_AddModelPath(de::String const &nativePath);
+
 LIBDOOMSDAY_PUBLIC void Def_ReadProcessDED(ded_t *defs, de::String path);
 
 /**
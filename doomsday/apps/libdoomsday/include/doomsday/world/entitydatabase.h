@@ -37,8 +37,11 @@
  * at all about the values or indeed even what properties are registered; it is
  * simply a way of piping information from one part of the system to another.
  *
- * @todo C++ allows making this more generic: a set/map of polymorphic objects
- * e.g., QVariant.
+ * Values are stored in columns: each entity property has its own densely indexed
+ * array of values (indexed by element index), which are stored inline rather than
+ * as individually allocated objects. A property definition is resolved to its
+ * column by its logical index in the owning MapEntityDef, so no name lookups are
+ * needed once the definition is known.
  */
 class LIBDOOMSDAY_PUBLIC EntityDatabase
 {
@@ -55,17 +58,30 @@ public:
     bool hasEntity(MapEntityDef const *entityDef, int elementIndex) const;
 
     /**
-     * Lookup a known entity element property value in the database.
+     * Lookup a known entity element property value in the database and convert
+     * it to the specified type.
      *
      * @param def           Definition of the property to lookup an element value for.
      * @param elementIndex  Unique element index of the value to lookup.
-     *
-     * @return The found PropertyValue.
+     * @param valueType     DDVT_* value type to convert the value to.
+     * @param dst           The converted value is written here.
      */
-    PropertyValue const &property(MapEntityPropertyDef const *def, int elementIndex) const;
+    void property(MapEntityPropertyDef const *def, int elementIndex,
+                  valuetype_t valueType, void *dst) const;
 
     bool hasPropertyValue(MapEntityPropertyDef const *def, int elementIndex) const;
 
+    /**
+     * Replace/add a value for a known entity element property to the database.
+     *
+     * @param def           Definition of the property to add an element value for.
+     * @param elementIndex  Unique element index for the value.
+     * @param valueType     DDVT_* value type of the value pointed at by @a valueAdr.
+     * @param valueAdr      Address of the value to be copied into the database.
+     */
+    void setProperty(MapEntityPropertyDef const *def, int elementIndex,
+                     valuetype_t valueType, void const *valueAdr);
+
     /**
      * Replace/add a value for a known entity element property to the database.
      *
@@ -76,12 +92,20 @@ public:
     void setProperty(MapEntityPropertyDef const *def, int elementIndex,
                      PropertyValue *value);
 
-    /// @copydoc setProperty
-    inline void setProperty(MapEntityPropertyDef const *def, int elementIndex,
-                            valuetype_t valueType, void *valueAdr)
-    {
-        setProperty(def, elementIndex, BuildPropertyValue(valueType, valueAdr));
-    }
+    /**
+     * Replace/add values for a range of consecutive elements in one go. The
+     * property definition is resolved only once for the whole range.
+     *
+     * @param def                Definition of the property to add element values for.
+     * @param firstElementIndex  Element index of the first value.
+     * @param count              Number of values.
+     * @param valueType          DDVT_* value type of the source values.
+     * @param values             Address of the first source value.
+     * @param stride             Distance in bytes between consecutive source values.
+     *                           Use zero if the values are tightly packed.
+     */
+    void setProperties(MapEntityPropertyDef const *def, int firstElementIndex, int count,
+                       valuetype_t valueType, void const *values, int stride = 0);
 
 private:
     DENG2_PRIVATE(d)
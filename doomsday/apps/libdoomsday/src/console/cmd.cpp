@@ -19,6 +19,7 @@
 #include "doomsday/console/cmd.h"
 #include "doomsday/console/alias.h"
 #include "doomsday/console/knownword.h"
+#include "doomsday/console/nameindex.h"
 #include "doomsday/help.h"
 #include <de/memoryblockset.h>
 #include <de/memoryzone.h>
@@ -33,6 +34,9 @@ using namespace de;
 
 static ccmd_t *ccmdListHead;
 
+/// Heads of the overload lists by command name, for quick lookup.
+static NameIndex<ccmd_t> ccmdIndex;
+
 /// @todo Replace with a data structure that allows for deletion of elements.
 static blockset_t *ccmdBlockSet;
 
@@ -56,6 +60,7 @@ void Con_ClearCommands(void)
     }
     ccmdBlockSet = 0;
     ccmdListHead = 0;
+    ccmdIndex.clear();
     numUniqueNamedCCmds = 0;
     mappedConfigVariables.clear();
 }
@@ -221,6 +226,9 @@ void Con_AddCommand(ccmdtemplate_t const* ccmd)
     newCCmd->next = ccmdListHead;
     ccmdListHead = newCCmd;
 
+    // The new command becomes the head of its overload list.
+    ccmdIndex.insert(newCCmd->name, newCCmd);
+
     if (!overloaded)
     {
         ++numUniqueNamedCCmds;
@@ -244,17 +252,9 @@ void Con_AddCommandList(ccmdtemplate_t const* cmdList)
 
 ccmd_t *Con_FindCommand(char const *name)
 {
-    /// @todo Use a faster than O(n) linear search.
     if (name && name[0])
     {
-        for (ccmd_t *ccmd = ccmdListHead; ccmd; ccmd = ccmd->next)
-        {
-            if (qstricmp(name, ccmd->name)) continue;
-
-            // Locate the head of the overload list.
-            while (ccmd->prevOverload) { ccmd = ccmd->prevOverload; }
-            return ccmd;
-        }
+        return ccmdIndex.find(name);
     }
     return 0;
 }
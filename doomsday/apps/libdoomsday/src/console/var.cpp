@@ -20,6 +20,7 @@
 #include "doomsday/console/var.h"
 #include "doomsday/console/exec.h"
 #include "doomsday/console/knownword.h"
+#include "doomsday/console/nameindex.h"
 #include "doomsday/uri.h"
 
 #include <de/c_wrapper.h>
@@ -27,6 +28,7 @@
 #include <de/Function>
 #include <de/PathTree>
 #include <de/TextValue>
+#include <de/Time>
 
 using namespace de;
 
@@ -35,9 +37,12 @@ using namespace de;
 
 typedef UserDataPathTree CVarDirectory;
 
-/// Console variable directory.
+/// Console variable directory. Used for listing and completing variable names.
 static CVarDirectory *cvarDirectory;
 
+/// Variables by full path, for quick lookup.
+static NameIndex<cvar_t> cvarIndex;
+
 static ddstring_s *emptyStr;
 static de::Uri *emptyUri;
 
@@ -129,6 +134,7 @@ void Con_ClearVariables()
 
     cvarDirectory->traverse(flags, NULL, CVarDirectory::no_hash, clearVariable);
     cvarDirectory->clear();
+    cvarIndex.clear();
 }
 
 /// Construct a new variable from the specified template and add it to the database.
@@ -154,6 +160,7 @@ static cvar_t* addVariable(cvartemplate_t const& tpl)
     newVar->notifyChanged = tpl.notifyChanged;
     newVar->directoryNode = node;
     node->setUserPointer(newVar);
+    cvarIndex.insert(tpl.path, newVar);
 
     Con_UpdateKnownWords();
     return newVar;
@@ -544,17 +551,12 @@ void Con_AddVariableList(cvartemplate_t const *tplList)
 
 cvar_t *Con_FindVariable(Path const &path)
 {
-    if (CVarDirectory::Node const *node =
-            cvarDirectory->tryFind(path, PathTree::NoBranch | PathTree::MatchFull))
-    {
-        return reinterpret_cast<cvar_t *>(node->userPointer());
-    }
-    return nullptr;
+    return Con_FindVariable(path.toString().toUtf8().constData());
 }
 
 cvar_t *Con_FindVariable(char const *path)
 {
-    return Con_FindVariable(Path(path, CVARDIRECTORY_DELIMITER));
+    return cvarIndex.find(path);
 }
 
 String Con_VarAsStyledText(cvar_t *var, char const *prefix)
@@ -722,6 +724,50 @@ typedef struct {
     dd_bool ignoreHidden;
 } countvariableparams_t;
 
+static int collectVariablePath(CVarDirectory::Node &node, void *context)
+{
+    auto *paths = reinterpret_cast<QList<QByteArray> *>(context);
+    paths->append(node.path(CVARDIRECTORY_DELIMITER).toUtf8());
+    return 0; // Continue iteration.
+}
+
+/**
+ * Compares the time it takes to find all variables in the directory and in the
+ * index.
+ */
+static void benchmarkVariableLookup()
+{
+    QList<QByteArray> paths;
+    cvarDirectory->traverse(PathTree::NoBranch, NULL, CVarDirectory::no_hash,
+                            collectVariablePath, &paths);
+
+    int const rounds = 100;
+    Time startedAt;
+    for (int i = 0; i < rounds; ++i)
+    {
+        for (QByteArray const &path : paths)
+        {
+            cvarDirectory->tryFind(Path(path.constData(), CVARDIRECTORY_DELIMITER),
+                                   PathTree::NoBranch | PathTree::MatchFull);
+        }
+    }
+    TimeDelta const directoryTime = startedAt.since();
+
+    startedAt = Time();
+    for (int i = 0; i < rounds; ++i)
+    {
+        for (QByteArray const &path : paths)
+        {
+            Con_FindVariable(path.constData());
+        }
+    }
+    TimeDelta const indexTime = startedAt.since();
+
+    LOG_SCR_MSG("Finding %i variables %i times: directory %.2f ms, index %.2f ms")
+            << paths.size() << rounds
+            << ddouble(directoryTime) * 1000 << ddouble(indexTime) * 1000;
+}
+
 static int countVariable(CVarDirectory::Node& node, void* parameters)
 {
     DENG_ASSERT(parameters);
@@ -778,6 +824,7 @@ D_CMD(PrintVarStats)
     {
         cvarDirectory->debugPrintHashDistribution();
         cvarDirectory->debugPrint(CVARDIRECTORY_DELIMITER);
+        benchmarkVariableLookup();
     }
     return true;
 }
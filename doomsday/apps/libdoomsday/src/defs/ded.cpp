@@ -25,10 +25,15 @@
 #include <de/memory.h>
 #include <de/strutil.h>
 #include <de/ArrayValue>
+#include <de/ByteRefArray>
 #include <de/NumberValue>
+#include <de/Reader>
 #include <de/RecordValue>
+#include <de/Writer>
+#include <QRegExp>
 
 #include "doomsday/defs/decoration.h"
+#include "doomsday/defs/definition.h"
 #include "doomsday/defs/episode.h"
 #include "doomsday/defs/thing.h"
 #include "doomsday/defs/state.h"
@@ -703,6 +708,391 @@ int ded_s::getTextNum(char const *id) const
     return -1; // Not found.
 }
 
+/// Increment when the serialized format of the definitions changes.
+static duint32 const DED_SERIAL_VERSION = 1;
+
+/*
+ * Serialization of definition arrays: the elements are written as raw memory with
+ * their pointers cleared, each followed by the data owned by the element.
+ */
+
+template <typename PODType> static void writeDEDArray(Writer &, DEDArray<PODType> const &);
+template <typename PODType> static void readDEDArray (Reader &, DEDArray<PODType> &);
+
+// Visits the pointers owned by each type of element.
+template <typename Op> static void visitDEDOwned(ded_sprid_t &, Op &) {}
+template <typename Op> static void visitDEDOwned(ded_ptcstage_t &, Op &) {}
+template <typename Op> static void visitDEDOwned(ded_sectortype_t &, Op &) {}
+
+template <typename Op> static void visitDEDOwned(ded_uri_t &def, Op &op) {
+    op(def.uri);
+}
+template <typename Op> static void visitDEDOwned(ded_light_t &def, Op &op) {
+    op(def.up); op(def.down); op(def.sides); op(def.flare);
+}
+template <typename Op> static void visitDEDOwned(ded_sound_t &def, Op &op) {
+    op(def.ext);
+}
+template <typename Op> static void visitDEDOwned(ded_text_t &def, Op &op) {
+    op(def.text);
+}
+template <typename Op> static void visitDEDOwned(ded_tenviron_t &def, Op &op) {
+    op(def.materials);
+}
+template <typename Op> static void visitDEDOwned(ded_value_t &def, Op &op) {
+    op(def.id); op(def.text);
+}
+template <typename Op> static void visitDEDOwned(ded_detailtexture_t &def, Op &op) {
+    op(def.material1); op(def.material2); op(def.stage.texture);
+}
+template <typename Op> static void visitDEDOwned(ded_ptcgen_t &def, Op &op) {
+    op(def.stateNext); op(def.material); op(def.map); op(def.stages);
+}
+template <typename Op> static void visitDEDOwned(ded_reflection_t &def, Op &op) {
+    op(def.material); op(def.stage.texture); op(def.stage.maskTexture);
+}
+template <typename Op> static void visitDEDOwned(ded_group_member_t &def, Op &op) {
+    op(def.material);
+}
+template <typename Op> static void visitDEDOwned(ded_group_t &def, Op &op) {
+    op(def.members);
+}
+template <typename Op> static void visitDEDOwned(ded_linetype_t &def, Op &op) {
+    op(def.actMaterial); op(def.deactMaterial);
+}
+template <typename Op> static void visitDEDOwned(ded_compositefont_mappedcharacter_t &def, Op &op) {
+    op(def.path);
+}
+template <typename Op> static void visitDEDOwned(ded_compositefont_t &def, Op &op) {
+    op(def.uri); op(def.charMap);
+}
+
+/// Clears the pointers of a shallow copy of an element.
+struct DEDOwnedDetacher
+{
+    void operator () (de::Uri *&uri)        { uri = nullptr; }
+    void operator () (char *&str)           { str = nullptr; }
+    void operator () (ded_ptcgen_t *&link)  { link = nullptr; }
+
+    template <typename PODType>
+    void operator () (DEDArray<PODType> &array) {
+        array.elements = nullptr;
+        array.count = ded_count_t();
+    }
+};
+
+struct DEDOwnedWriter
+{
+    Writer &to;
+
+    DEDOwnedWriter(Writer &to) : to(to) {}
+
+    void operator () (de::Uri *&uri) {
+        to << duint8(uri? 1 : 0);
+        if (uri) to << *uri;
+    }
+    void operator () (char *&str) {
+        to << duint8(str? 1 : 0);
+        if (str) to << Block(str);
+    }
+    void operator () (ded_ptcgen_t *&) {} // Runtime link, not serialized.
+
+    template <typename PODType>
+    void operator () (DEDArray<PODType> &array) {
+        writeDEDArray(to, array);
+    }
+};
+
+/// Restores the owned data of an element whose pointers have been cleared.
+struct DEDOwnedReader
+{
+    Reader &from;
+
+    DEDOwnedReader(Reader &from) : from(from) {}
+
+    void operator () (de::Uri *&uri) {
+        duint8 present;
+        from >> present;
+        if (present)
+        {
+            // Owned by the element already, in case reading fails.
+            uri = new de::Uri;
+            from >> *uri;
+        }
+    }
+    void operator () (char *&str) {
+        duint8 present;
+        from >> present;
+        if (present)
+        {
+            Block text;
+            from >> text;
+            str = M_StrDup(text.constData());
+        }
+    }
+    void operator () (ded_ptcgen_t *&) {}
+
+    template <typename PODType>
+    void operator () (DEDArray<PODType> &array) {
+        readDEDArray(from, array);
+    }
+};
+
+template <typename PODType>
+static void writeDEDArray(Writer &to, DEDArray<PODType> const &array)
+{
+    DEDOwnedDetacher detach;
+    DEDOwnedWriter writeOwned(to);
+
+    to << duint32(array.size());
+    for (int i = 0; i < array.size(); ++i)
+    {
+        PODType detached;
+        std::memcpy(&detached, &array[i], sizeof(PODType));
+        visitDEDOwned(detached, detach);
+
+        to.writeBytes(sizeof(PODType), ByteRefArray(&detached, sizeof(PODType)));
+        visitDEDOwned(array[i], writeOwned);
+    }
+}
+
+template <typename PODType>
+static void readDEDArray(Reader &from, DEDArray<PODType> &array)
+{
+    DEDOwnedReader readOwned(from);
+
+    duint32 count;
+    from >> count;
+    for (duint32 i = 0; i < count; ++i)
+    {
+        // Elements are appended one at a time so that the array remains valid
+        // (and can be cleared) if the data turns out to be invalid.
+        PODType *elem = array.append();
+        ByteRefArray raw(elem, sizeof(PODType));
+        from.readBytesFixedSize(raw);
+        visitDEDOwned(*elem, readOwned);
+    }
+}
+
+static void writeDEDRegister(Writer &to, DEDRegister const &reg)
+{
+    to << duint32(reg.size());
+    for (int i = 0; i < reg.size(); ++i)
+    {
+        to << reg[i];
+    }
+}
+
+static void readDEDRegister(Reader &from, DEDRegister &reg)
+{
+    duint32 count;
+    from >> count;
+    for (duint32 i = 0; i < count; ++i)
+    {
+        Record def;
+        from >> def;
+
+        // The register assigns the ordinals, and the copied members get indexed
+        // for lookups.
+        reg.append().assign(def, QRegExp(defn::Definition::VAR_ORDER));
+    }
+}
+
+void ded_s::operator >> (Writer &to) const
+{
+    to << DED_SERIAL_VERSION << dint32(version) << dint32(modelFlags) << modelScale << modelOffset;
+
+    writeDEDRegister(to, flags);
+    writeDEDRegister(to, episodes);
+    writeDEDRegister(to, things);
+    writeDEDRegister(to, states);
+    writeDEDArray   (to, sprites);
+    writeDEDArray   (to, lights);
+    writeDEDRegister(to, materials);
+    writeDEDRegister(to, models);
+    writeDEDRegister(to, skies);
+    writeDEDArray   (to, sounds);
+    writeDEDRegister(to, musics);
+    writeDEDRegister(to, mapInfos);
+    writeDEDArray   (to, text);
+    writeDEDArray   (to, textureEnv);
+    writeDEDArray   (to, values);
+    writeDEDArray   (to, details);
+    writeDEDArray   (to, ptcGens);
+    writeDEDRegister(to, finales);
+    writeDEDRegister(to, decorations);
+    writeDEDArray   (to, reflections);
+    writeDEDArray   (to, groups);
+    writeDEDArray   (to, lineTypes);
+    writeDEDArray   (to, sectorTypes);
+    writeDEDArray   (to, compositeFonts);
+}
+
+void ded_s::operator << (Reader &from)
+{
+    clear();
+
+    try
+    {
+        duint32 serialVersion;
+        from >> serialVersion;
+        if (serialVersion != DED_SERIAL_VERSION)
+        {
+            throw DeserializationError("ded_s::operator <<",
+                                       QString("Unsupported version %1").arg(serialVersion));
+        }
+
+        dint32 ver, mflags;
+        from >> ver >> mflags >> modelScale >> modelOffset;
+        version    = ver;
+        modelFlags = mflags;
+
+        readDEDRegister(from, flags);
+        readDEDRegister(from, episodes);
+        readDEDRegister(from, things);
+        readDEDRegister(from, states);
+        readDEDArray   (from, sprites);
+        readDEDArray   (from, lights);
+        readDEDRegister(from, materials);
+        readDEDRegister(from, models);
+        readDEDRegister(from, skies);
+        readDEDArray   (from, sounds);
+        readDEDRegister(from, musics);
+        readDEDRegister(from, mapInfos);
+        readDEDArray   (from, text);
+        readDEDArray   (from, textureEnv);
+        readDEDArray   (from, values);
+        readDEDArray   (from, details);
+        readDEDArray   (from, ptcGens);
+        readDEDRegister(from, finales);
+        readDEDRegister(from, decorations);
+        readDEDArray   (from, reflections);
+        readDEDArray   (from, groups);
+        readDEDArray   (from, lineTypes);
+        readDEDArray   (from, sectorTypes);
+        readDEDArray   (from, compositeFonts);
+    }
+    catch (Error const &)
+    {
+        clear();
+        throw;
+    }
+}
+
+/*
+ * Comparison of definitions, for checking that cached definitions are identical to
+ * freshly parsed ones. Values are compared by their text representation and record
+ * members by name, so the order of the members does not matter.
+ */
+
+static bool sameDefinitionValue(Value const &a, Value const &b);
+
+static bool sameDefinition(Record const &a, Record const &b)
+{
+    if (a.members().size() != b.members().size()) return false;
+
+    DENG2_FOR_EACH_CONST(Record::Members, i, a.members())
+    {
+        if (!b.hasMember(i.key()) ||
+            !sameDefinitionValue(i.value()->value(), b[i.key()].value()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool sameDefinitionValue(Value const &a, Value const &b)
+{
+    auto const *recA = maybeAs<RecordValue>(&a);
+    auto const *recB = maybeAs<RecordValue>(&b);
+    if (recA && recB && recA->record() && recB->record())
+    {
+        return sameDefinition(*recA->record(), *recB->record());
+    }
+
+    auto const *arrayA = maybeAs<ArrayValue>(&a);
+    auto const *arrayB = maybeAs<ArrayValue>(&b);
+    if (arrayA && arrayB)
+    {
+        if (arrayA->size() != arrayB->size()) return false;
+        for (int i = 0; i < arrayA->elements().size(); ++i)
+        {
+            if (!sameDefinitionValue(*arrayA->elements().at(i), *arrayB->elements().at(i)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return a.asText() == b.asText();
+}
+
+static bool sameSection(DEDRegister const &a, DEDRegister const &b)
+{
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i)
+    {
+        if (!sameDefinition(a[i], b[i])) return false;
+    }
+    return true;
+}
+
+template <typename PODType>
+static bool sameSection(DEDArray<PODType> const &a, DEDArray<PODType> const &b)
+{
+    // The serialized form omits the runtime pointers but includes everything they own.
+    Block serialA, serialB;
+    Writer writerA(serialA), writerB(serialB);
+    writeDEDArray(writerA, a);
+    writeDEDArray(writerB, b);
+    return serialA == serialB;
+}
+
+StringList ded_s::differingSections(ded_s const &other) const
+{
+    StringList differing;
+
+    if (version != other.version || modelFlags != other.modelFlags ||
+        modelScale != other.modelScale || modelOffset != other.modelOffset)
+    {
+        differing << "header";
+    }
+
+#define DED_COMPARE_SECTION(Name) \
+    if (!sameSection(Name, other.Name)) differing << #Name;
+
+    DED_COMPARE_SECTION(flags)
+    DED_COMPARE_SECTION(episodes)
+    DED_COMPARE_SECTION(things)
+    DED_COMPARE_SECTION(states)
+    DED_COMPARE_SECTION(sprites)
+    DED_COMPARE_SECTION(lights)
+    DED_COMPARE_SECTION(materials)
+    DED_COMPARE_SECTION(models)
+    DED_COMPARE_SECTION(skies)
+    DED_COMPARE_SECTION(sounds)
+    DED_COMPARE_SECTION(musics)
+    DED_COMPARE_SECTION(mapInfos)
+    DED_COMPARE_SECTION(text)
+    DED_COMPARE_SECTION(textureEnv)
+    DED_COMPARE_SECTION(values)
+    DED_COMPARE_SECTION(details)
+    DED_COMPARE_SECTION(ptcGens)
+    DED_COMPARE_SECTION(finales)
+    DED_COMPARE_SECTION(decorations)
+    DED_COMPARE_SECTION(reflections)
+    DED_COMPARE_SECTION(groups)
+    DED_COMPARE_SECTION(lineTypes)
+    DED_COMPARE_SECTION(sectorTypes)
+    DED_COMPARE_SECTION(compositeFonts)
+
+#undef DED_COMPARE_SECTION
+
+    return differing;
+}
+
 static void destroyDefinitions()
 {
     delete DED_Definitions();
@@ -23,6 +23,7 @@
 #include <de/App>
 #include <de/Folder>
 #include <de/LogBuffer>
+#include <de/Writer>
 #include "doomsday/defs/dedparser.h"
 #include "doomsday/filesys/fs_main.h"
 #include "doomsday/filesys/fs_util.h"
@@ -32,6 +33,7 @@
 using namespace de;
 
 static char dedReadError[512];
+static DEDSourceLog *dedSourceLog;
 
 void DED_SetError(String const &message)
 {
@@ -39,6 +41,46 @@ void DED_SetError(String const &message)
     strncpy(dedReadError, msg.toUtf8().constData(), sizeof(dedReadError));
 }
 
+void DED_SetSourceLog(DEDSourceLog *log)
+{
+    dedSourceLog = log;
+}
+
+Block DED_SourceFileId(String const &sourcePath)
+{
+    if (sourcePath.isEmpty()) return Block();
+
+    if (File const *file = App::rootFolder().tryLocate<File const>(sourcePath))
+    {
+        return file->metaId();
+    }
+
+    try
+    {
+        String fullPath = (NativePath::workPath() / NativePath(sourcePath).expand()).withSeparators('/');
+        QScopedPointer<FileHandle> hndl(&App_FileSystem().openFile(fullPath, "rb"));
+        File1 &file = hndl->file();
+
+        Block data;
+        Writer(data) << file.composePath() << duint64(file.size()) << duint32(file.lastModified());
+        App_FileSystem().releaseFile(file);
+        return data.md5Hash();
+    }
+    catch (FS1::NotFoundError const &)
+    {} // Ignore.
+
+    return Block();
+}
+
+void DED_AddModelPath(String const &nativePath)
+{
+    de::Uri newSearchPath = de::Uri::fromNativeDirPath(NativePath(nativePath));
+    FS1::Scheme &scheme = App_FileSystem().scheme(ResourceClass::classForId(RC_MODEL).defaultScheme());
+    scheme.addSearchPath(reinterpret_cast<de::Uri const &>(newSearchPath), FS1::ExtraPaths);
+
+    if (dedSourceLog) dedSourceLog->modelPaths << nativePath;
+}
+
 void Def_ReadProcessDED(ded_t *defs, String sourcePath)
 {
      LOG_AS("Def_ReadProcessDED");
@@ -54,6 +96,7 @@ void Def_ReadProcessDED(ded_t *defs, String sourcePath)
          {
              App_FatalError("Def_ReadProcessDED: %s\n", dedReadError);
          }
+         if (dedSourceLog) dedSourceLog->files << sourcePath;
         return; // Done!
     }
     catch (...)
@@ -80,6 +123,7 @@ void Def_ReadProcessDED(ded_t *defs, String sourcePath)
     {
         App_FatalError("Def_ReadProcessDED: %s\n", dedReadError);
     }
+    if (dedSourceLog) dedSourceLog->files << sourcePath;
 }
 
 int DED_ReadLump(ded_t *ded, lumpnum_t lumpNum)
@@ -185,7 +185,8 @@ DENG2_PIMPL(DoomsdayApp)
                             .arg(++counter, 3, 10, QChar('0')));
                 }
                 FS::get().makeFolder(folderPath)
-                        .attach(new DirectoryFeed(path, DirectoryFeed::OnlyThisFolder));
+                        .attach(new DirectoryFeed(path, DirectoryFeed::OnlyThisFolder |
+                                                  DirectoryFeed::WatchChanges));
             }
             else
             {
@@ -203,7 +204,9 @@ DENG2_PIMPL(DoomsdayApp)
             {
                 LOG_RES_NOTE("Using %s package folder (including subfolders): %s")
                         << description << path.pretty();
-                App::rootFolder().locate<Folder>(PATH_LOCAL_PACKS).attach(new DirectoryFeed(path));
+                App::rootFolder().locate<Folder>(PATH_LOCAL_PACKS).attach(
+                            new DirectoryFeed(path, DirectoryFeed::DefaultFlags |
+                                                    DirectoryFeed::WatchChanges));
             }
             else
             {
@@ -30,6 +30,9 @@
 
 #include <QList>
 #include <QSet>
+#include <QThread>
+#include <atomic>
+#include <algorithm>
 
 using namespace de;
 
@@ -47,9 +50,22 @@ DENG2_PIMPL(Bundles)
     de::Info identityRegistry;
     QSet<DataBundle const *> bundlesToIdentify; // lock for access
     LoopCallback mainCall;
-    QHash<DataBundle::Format, BlockElements> formatEntries;
     TaskPool tasks;
 
+    /**
+     * Registry entries of one format. The entries are also indexed by the criteria
+     * that are usually decisive, so that matching a bundle does not need to score
+     * every entry of the format.
+     */
+    struct FormatIndex
+    {
+        BlockElements entries;          ///< In registry order.
+        QMultiHash<duint32, int> bySize;  ///< "fileSize" => entry index.
+        QMultiHash<duint32, int> byCrc;   ///< "lumpDirCRC32" => entry index.
+        QList<int> alwaysScored;        ///< Entries that may match without size or CRC.
+    };
+    QHash<DataBundle::Format, FormatIndex> formatIndex;
+
     Impl(Public *i) : Base(i)
     {
         // Observe new data files.
@@ -109,21 +125,44 @@ DENG2_PIMPL(Bundles)
 
         DENG2_ASSERT(App::rootFolder().has("/sys/bundles"));
 
-        bool wasIdentified = false;
-        int count = 0;
+        // All workers need the registry, so it must be ready before they start.
+        parseRegistry();
+
+        std::atomic<bool> wasIdentified(false);
+        std::atomic<int> count(0);
         Time startedAt;
 
-        while (auto const *bundle = nextToIdentify())
+        auto identifyWorker = [this, &wasIdentified, &count] ()
+        {
+            while (auto const *bundle = nextToIdentify())
+            {
+                ++count;
+                if (bundle->identifyPackages())
+                {
+                    wasIdentified = true;
+                }
+            }
+        };
+
+        // Bundles are identified concurrently; this thread works as well.
+        int const threadCount = de::max(1, QThread::idealThreadCount());
         {
-            ++count;
-            if (bundle->identifyPackages())
+            TaskPool workers;
+            for (int i = 1; i < threadCount; ++i)
             {
-                wasIdentified = true;
+                workers.start(identifyWorker);
             }
+            identifyWorker();
+            workers.waitForDone();
         }
-        if (count)
+
+        if (int const identified = count)
         {
-            LOG_RES_MSG("Identified %i data bundles in %.1f seconds") << count << startedAt.since();
+            ddouble const elapsed = startedAt.since();
+            LOG_RES_MSG("Identified %i data bundles in %.1f seconds (%.1f bundles/s, %i threads)")
+                    << identified << elapsed
+                    << (elapsed > 0? identified / elapsed : 0.0)
+                    << threadCount;
         }
         return wasIdentified;
     }
@@ -136,7 +175,7 @@ DENG2_PIMPL(Bundles)
 
         String const defPath = "/packs/net.dengine.base/databundles.dei";
 
-        formatEntries.clear();
+        formatIndex.clear();
         identityRegistry.parse(App::rootFolder().locate<File const>(defPath));
 
         for (auto *elem : identityRegistry.root().contentsInOrder())
@@ -175,8 +214,68 @@ DENG2_PIMPL(Bundles)
                         String::format("%i", de::min(MATCH_MAXIMUM_SCORE, ruleCount))));
             }
 
-            formatEntries[bundleFormat].append(&block);
+            indexEntry(bundleFormat, block);
+        }
+    }
+
+    void indexEntry(DataBundle::Format bundleFormat, de::Info::BlockElement const &block)
+    {
+        FormatIndex &index = formatIndex[bundleFormat];
+        int const entryIndex = index.entries.size();
+        index.entries.append(&block);
+
+        bool const isWad = (bundleFormat == DataBundle::Iwad || bundleFormat == DataBundle::Pwad);
+
+        String const fileSize = block.keyValue(QStringLiteral("fileSize"));
+        if (!fileSize.isEmpty())
+        {
+            index.bySize.insert(fileSize.toUInt(), entryIndex);
+        }
+
+        String const lumpDirCRC32 = block.keyValue(QStringLiteral("lumpDirCRC32"));
+        if (isWad && !lumpDirCRC32.isEmpty())
+        {
+            index.byCrc.insert(lumpDirCRC32.toUInt(nullptr, 16), entryIndex);
+        }
+
+        // The highest score the entry can reach when neither the file size nor the
+        // lump directory CRC matches (see Bundles::match()).
+        int looseScore = 1; // file type
+        if (block.find(QStringLiteral("fileName"))) ++looseScore;
+        if (isWad && maybeAs<de::Info::ListElement>(block.find(QStringLiteral("lumps")))) ++looseScore;
+
+        if (block.keyValue(VAR_REQUIRED_SCORE).text.toInt() <= looseScore)
+        {
+            index.alwaysScored.append(entryIndex);
+        }
+    }
+
+    /// Returns the (read-only) index of a format; may be called from any thread.
+    FormatIndex const &indexForFormat(DataBundle::Format format) const
+    {
+        static FormatIndex const empty;
+        auto found = formatIndex.constFind(format);
+        return found != formatIndex.constEnd()? found.value() : empty;
+    }
+
+    /**
+     * Returns the indices of the registry entries that can possibly match a bundle,
+     * in registry order.
+     */
+    QVector<int> candidateEntries(DataBundle const &bundle)
+    {
+        parseRegistry();
+
+        FormatIndex const &index = indexForFormat(bundle.format());
+        QVector<int> candidates = index.alwaysScored.toVector();
+        candidates << index.bySize.values(duint32(bundle.asFile().size())).toVector();
+        if (auto const *lumpDir = bundle.lumpDirectory())
+        {
+            candidates << index.byCrc.values(lumpDir->crc32()).toVector();
         }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        return candidates;
     }
 
     DENG2_PIMPL_AUDIENCE(Identify)
@@ -197,7 +296,7 @@ de::Info const &Bundles::identityRegistry() const
 Bundles::BlockElements Bundles::formatEntries(DataBundle::Format format) const
 {
     d->parseRegistry();
-    return d->formatEntries[format];
+    return d->indexForFormat(format).entries;
 }
 
 void Bundles::identify()
@@ -237,9 +336,13 @@ Bundles::MatchResult Bundles::match(DataBundle const &bundle) const
     MatchResult match;
     File const &source = bundle.asFile();
 
-    // Find the best match from the registry.
-    for (auto const *def : formatEntries(bundle.format()))
+    // Find the best match from the registry. Only the entries that can possibly
+    // reach their required score are checked.
+    QVector<int> const candidates = d->candidateEntries(bundle);
+    BlockElements const &entries = d->indexForFormat(bundle.format()).entries;
+    for (int entryIndex : candidates)
     {
+        auto const *def = entries.at(entryIndex);
         int score = 0;
 
         // Match the file name.
@@ -92,6 +92,16 @@ DENG2_PIMPL(DataBundle), public Lockable
         delete pkgLink.get();
     }
 
+    /**
+     * Bundles may be identified concurrently. Package links are created one at a
+     * time so that bundles cannot end up choosing the same link path.
+     */
+    static Lockable &linkLock()
+    {
+        static Lockable lock;
+        return lock;
+    }
+
     static Folder &bundleFolder()
     {
         return App::rootFolder().locate<Folder>(QStringLiteral("/sys/bundles"));
@@ -241,6 +251,7 @@ DENG2_PIMPL(DataBundle), public Lockable
         versionedPackageId = packageId;
 
         // Finally, make a link that represents the package.
+        DENG2_GUARD_FOR(linkLock(), linking);
         if (auto chosen = chooseUniqueLinkPathAndVersion(self().asFile(), packageId,
                                                          meta.gets(VAR_VERSION),
                                                          meta.geti(VAR_BUNDLE_SCORE)))
@@ -21,83 +21,212 @@
 #include "doomsday/world/entitydatabase.h"
 
 #include <de/Log>
-#include <map>
+#include <QHash>
+#include <memory>
+#include <vector>
 
 using namespace de;
 
-// An entity is a set of one or more properties.
-// Key is the unique identifier of said property in the
-// MapEntityPropertyDef it is derived from.
-typedef std::map<int, PropertyValue *> Entity;
+namespace {
 
-// Entities are stored in a set, each associated with a unique map element index.
-typedef std::map<int, Entity> Entities;
+/**
+ * A single property value stored inline in a column.
+ */
+struct Cell
+{
+    valuetype_t type; ///< DDVT_NONE if no value has been set.
+    union {
+        byte    byteValue;
+        int16_t int16Value;
+        int32_t int32Value;
+        fixed_t fixedValue;
+        angle_t angleValue;
+        float   floatValue;
+        double  doubleValue;
+    };
+
+    Cell() : type(DDVT_NONE), doubleValue(0) {}
+
+    bool hasValue() const { return type != DDVT_NONE; }
+
+    void set(valuetype_t valueType, void const *src)
+    {
+        DENG2_ASSERT(src);
+        switch (valueType)
+        {
+        case DDVT_BYTE:   byteValue   = *(   (byte const *) src); break;
+        case DDVT_SHORT:  int16Value  = *(  (short const *) src); break;
+        case DDVT_INT:    int32Value  = *(    (int const *) src); break;
+        case DDVT_FIXED:  fixedValue  = *((fixed_t const *) src); break;
+        case DDVT_ANGLE:  angleValue  = *((angle_t const *) src); break;
+        case DDVT_FLOAT:  floatValue  = *(  (float const *) src); break;
+        case DDVT_DOUBLE: doubleValue = *( (double const *) src); break;
+        default:
+            throw Error("EntityDatabase::setProperty", QString("Unknown/not-supported value type %1").arg(valueType));
+        }
+        type = valueType;
+    }
+};
 
-// Entities are grouped in sets by their unique identifier.
-typedef std::map<int, Entities> EntitySet;
+/**
+ * Writes @a pvalue converted to @a dstType to @a dst.
+ */
+void convertValue(PropertyValue const &pvalue, valuetype_t dstType, void *dst)
+{
+    switch (dstType)
+    {
+    case DDVT_FIXED:  *((fixed_t *) dst) = pvalue.asFixed();  break;
+    case DDVT_FLOAT:  *(  (float *) dst) = pvalue.asFloat();  break;
+    case DDVT_DOUBLE: *( (double *) dst) = pvalue.asDouble(); break;
+    case DDVT_BYTE:   *(   (byte *) dst) = pvalue.asByte();   break;
+    case DDVT_INT:    *(    (int *) dst) = pvalue.asInt32();  break;
+    case DDVT_SHORT:  *(  (short *) dst) = pvalue.asInt16();  break;
+    case DDVT_ANGLE:  *((angle_t *) dst) = pvalue.asAngle();  break;
+    default:
+        throw Error("EntityDatabase::property", QString("Unknown value type %1").arg(dstType));
+    }
+}
+
+/**
+ * Writes the value of @a cell converted to @a dstType to @a dst. The conversion
+ * rules are those of the PropertyValue that corresponds to the cell's type.
+ */
+void readCell(Cell const &cell, valuetype_t dstType, void *dst)
+{
+    switch (cell.type)
+    {
+    case DDVT_BYTE:   convertValue(PropertyByteValue  (cell.byteValue),   dstType, dst); break;
+    case DDVT_SHORT:  convertValue(PropertyInt16Value (cell.int16Value),  dstType, dst); break;
+    case DDVT_INT:    convertValue(PropertyInt32Value (cell.int32Value),  dstType, dst); break;
+    case DDVT_FIXED:  convertValue(PropertyFixedValue (cell.fixedValue),  dstType, dst); break;
+    case DDVT_ANGLE:  convertValue(PropertyAngleValue (cell.angleValue),  dstType, dst); break;
+    case DDVT_FLOAT:  convertValue(PropertyFloatValue (cell.floatValue),  dstType, dst); break;
+    case DDVT_DOUBLE: convertValue(PropertyDoubleValue(cell.doubleValue), dstType, dst); break;
+    default:
+        DENG2_ASSERT(!"EntityDatabase: Cell has no value");
+        break;
+    }
+}
+
+dsize valueTypeSize(valuetype_t type)
+{
+    switch (type)
+    {
+    case DDVT_BYTE:   return sizeof(byte);
+    case DDVT_SHORT:  return sizeof(short);
+    case DDVT_INT:    return sizeof(int);
+    case DDVT_FIXED:  return sizeof(fixed_t);
+    case DDVT_ANGLE:  return sizeof(angle_t);
+    case DDVT_FLOAT:  return sizeof(float);
+    case DDVT_DOUBLE: return sizeof(double);
+    default:
+        throw Error("EntityDatabase::setProperties", QString("Unknown/not-supported value type %1").arg(type));
+    }
+}
+
+/**
+ * All the values of one property, indexed by element index.
+ */
+typedef std::vector<Cell> Column;
+
+/**
+ * All the entities of one type. Columns are indexed by the logical index of the
+ * property in the MapEntityDef.
+ */
+struct EntityTable
+{
+    uint count = 0;
+    std::vector<bool> present; ///< Indexed by element index.
+    std::vector<Column> columns;
+
+    bool has(int elementIndex) const
+    {
+        return elementIndex >= 0 && duint(elementIndex) < present.size() && present[elementIndex];
+    }
+
+    void add(int elementIndex)
+    {
+        if (duint(elementIndex) >= present.size())
+        {
+            present.resize(elementIndex + 1, false);
+        }
+        if (!present[elementIndex])
+        {
+            present[elementIndex] = true;
+            count++;
+        }
+    }
+};
+
+} // namespace
 
 DENG2_PIMPL(EntityDatabase)
 {
-    EntitySet entitySets;
+    /// Entity tables are keyed by MapEntityDef identifier.
+    QHash<int, EntityTable> tables;
 
     Impl(Public *i) : Base(i)
     {}
 
-    ~Impl()
+    static int columnIndex(MapEntityPropertyDef const &def)
     {
-        DENG2_FOR_EACH(EntitySet, setIt, entitySets)
-        DENG2_FOR_EACH(Entities, entityIt, setIt->second)
-        DENG2_FOR_EACH(Entity, propIt, entityIt->second)
-        {
-            delete propIt->second;
-        }
+        DENG2_ASSERT(def.entity);
+        int const index = int(&def - def.entity->props);
+        DENG2_ASSERT(index >= 0 && duint(index) < def.entity->numProps);
+        return index;
     }
 
-    /**
-     * Lookup the set in which entities with the unique identifier
-     * @a entityId are stored.
-     */
-    Entities *entities(int entityId)
+    EntityTable const *tryFindTable(int entityId) const
     {
-        std::pair<EntitySet::iterator, bool> result;
-        result = entitySets.insert(std::pair<int, Entities>(entityId, Entities()));
-        return &result.first->second;
+        auto found = tables.constFind(entityId);
+        if (found != tables.constEnd()) return &found.value();
+        return nullptr;
     }
 
     /**
-     * Lookup an entity in @a set by its unique @a elementIndex.
+     * Returns the column of @a def, which has room for at least @a minSize values.
      */
-    Entity *entityByElementIndex(Entities& set, int elementIndex, bool canCreate)
+    Column &column(MapEntityPropertyDef const &def, int minSize)
     {
-        // Do we already have a record for this entity?
-        Entities::iterator found = set.find(elementIndex);
-        if (found != set.end()) return &found->second;
+        EntityTable &table = tables[def.entity->id];
+        if (table.columns.size() < def.entity->numProps)
+        {
+            table.columns.resize(def.entity->numProps);
+        }
+        Column &col = table.columns[columnIndex(def)];
+        if (col.size() < duint(minSize))
+        {
+            col.resize(minSize);
+        }
+        return col;
+    }
 
-        if (!canCreate) return 0;
+    Cell const *tryFindCell(MapEntityPropertyDef const &def, int elementIndex) const
+    {
+        EntityTable const *table = tryFindTable(def.entity->id);
+        if (!table || !table->has(elementIndex))
+        {
+            throw Error("EntityDatabase::property", QString("There is no element %1 of type %2")
+                                                        .arg(elementIndex)
+                                                        .arg(Str_Text(P_NameForMapEntityDef(def.entity))));
+        }
+        duint const index = columnIndex(def);
+        if (index >= table->columns.size()) return nullptr;
 
-        // A new entity.
-        std::pair<Entities::iterator, bool> result;
-        result = set.insert(std::pair<int, Entity>(elementIndex, Entity()));
-        return &result.first->second;
+        Column const &col = table->columns[index];
+        if (duint(elementIndex) >= col.size() || !col[elementIndex].hasValue())
+        {
+            return nullptr;
+        }
+        return &col[elementIndex];
     }
 
-    PropertyValue const *tryFindPropertyValue(MapEntityPropertyDef const &def,
-                                              int elementIndex)
+    static void checkElementIndex(int elementIndex)
     {
-         Entities *set = entities(def.entity->id);
-         Entity const *entity = entityByElementIndex(*set, elementIndex, false /*do not create*/);
-         if (!entity)
-         {
-             throw Error("EntityDatabase::property", QString("There is no element %1 of type %2")
-                                                         .arg(elementIndex)
-                                                         .arg(Str_Text(P_NameForMapEntityDef(def.entity))));
-         }
-         Entity::const_iterator found = entity->find(def.id);
-         if (found == entity->end())
-         {
-             return nullptr;
-         }
-         return found->second;
+        if (elementIndex < 0)
+        {
+            throw Error("EntityDatabase::setProperty", QString("Invalid element index %1").arg(elementIndex));
+        }
     }
 };
 
@@ -107,24 +236,29 @@ EntityDatabase::EntityDatabase() : d(new Impl(this))
 uint EntityDatabase::entityCount(MapEntityDef const *entityDef) const
 {
     DENG2_ASSERT(entityDef);
-    Entities *set = d->entities(entityDef->id);
-    return set->size();
+    if (EntityTable const *table = d->tryFindTable(entityDef->id))
+    {
+        return table->count;
+    }
+    return 0;
 }
 
 bool EntityDatabase::hasEntity(MapEntityDef const *entityDef, int elementIndex) const
 {
     DENG2_ASSERT(entityDef);
-    Entities *set = d->entities(entityDef->id);
-    return d->entityByElementIndex(*set, elementIndex, false /*do not create*/) != 0;
+    EntityTable const *table = d->tryFindTable(entityDef->id);
+    return table && table->has(elementIndex);
 }
 
-PropertyValue const &EntityDatabase::property(MapEntityPropertyDef const *def,
-                                              int elementIndex) const
+void EntityDatabase::property(MapEntityPropertyDef const *def, int elementIndex,
+                              valuetype_t valueType, void *dst) const
 {
     DENG2_ASSERT(def);
-    if (auto const *propValue = d->tryFindPropertyValue(*def, elementIndex))
+    DENG2_ASSERT(dst);
+    if (Cell const *cell = d->tryFindCell(*def, elementIndex))
     {
-        return *propValue;
+        readCell(*cell, valueType, dst);
+        return;
     }
     throw Error("EntityDatabase::property",
                 QString("Element %1 of type %2 has no value for property %3")
@@ -136,28 +270,60 @@ PropertyValue const &EntityDatabase::property(MapEntityPropertyDef const *def,
 bool EntityDatabase::hasPropertyValue(MapEntityPropertyDef const *def, int elementIndex) const
 {
     DENG2_ASSERT(def);
-    return d->tryFindPropertyValue(*def, elementIndex) != nullptr;
+    return d->tryFindCell(*def, elementIndex) != nullptr;
 }
 
 void EntityDatabase::setProperty(MapEntityPropertyDef const *def, int elementIndex,
-    PropertyValue *value)
+                                 valuetype_t valueType, void const *valueAdr)
 {
     DENG2_ASSERT(def);
-    Entities *set = d->entities(def->entity->id);
-    Entity *entity = d->entityByElementIndex(*set, elementIndex, true);
-    if (!entity)
-        throw Error("EntityDatabase::setProperty", "Failed adding new entity element record");
-
-    // Do we already have a record for this?
-    Entity::iterator found = entity->find(def->id);
-    if (found != entity->end())
+    d->checkElementIndex(elementIndex);
+
+    Column &col = d->column(*def, elementIndex + 1);
+    col[elementIndex].set(valueType, valueAdr);
+    d->tables[def->entity->id].add(elementIndex);
+}
+
+void EntityDatabase::setProperty(MapEntityPropertyDef const *def, int elementIndex,
+                                 PropertyValue *value)
+{
+    DENG2_ASSERT(value);
+    std::unique_ptr<PropertyValue> owned(value);
+
+    // Store the value using its original type so that conversions on lookup
+    // produce the same results as before.
+    switch (value->type())
     {
-        PropertyValue **adr = &found->second;
-        delete *adr;
-        *adr = value;
-        return;
+    case DDVT_BYTE:   { byte    v = value->asByte();   setProperty(def, elementIndex, DDVT_BYTE,   &v); break; }
+    case DDVT_SHORT:  { short   v = value->asInt16();  setProperty(def, elementIndex, DDVT_SHORT,  &v); break; }
+    case DDVT_INT:    { int     v = value->asInt32();  setProperty(def, elementIndex, DDVT_INT,    &v); break; }
+    case DDVT_FIXED:  { fixed_t v = value->asFixed();  setProperty(def, elementIndex, DDVT_FIXED,  &v); break; }
+    case DDVT_ANGLE:  { angle_t v = value->asAngle();  setProperty(def, elementIndex, DDVT_ANGLE,  &v); break; }
+    case DDVT_FLOAT:  { float   v = value->asFloat();  setProperty(def, elementIndex, DDVT_FLOAT,  &v); break; }
+    case DDVT_DOUBLE: { double  v = value->asDouble(); setProperty(def, elementIndex, DDVT_DOUBLE, &v); break; }
+    default:
+        throw Error("EntityDatabase::setProperty", QString("Unknown/not-supported value type %1").arg(value->type()));
     }
+}
+
+void EntityDatabase::setProperties(MapEntityPropertyDef const *def, int firstElementIndex,
+                                   int count, valuetype_t valueType, void const *values,
+                                   int stride)
+{
+    DENG2_ASSERT(def);
+    if (count <= 0) return;
 
-    // Add a new record.
-    entity->insert(std::pair<int, PropertyValue *>(def->id, value));
+    DENG2_ASSERT(values);
+    d->checkElementIndex(firstElementIndex);
+
+    dsize const step = (stride > 0? dsize(stride) : valueTypeSize(valueType));
+    Column &col = d->column(*def, firstElementIndex + count);
+    EntityTable &table = d->tables[def->entity->id];
+
+    byte const *src = reinterpret_cast<byte const *>(values);
+    for (int i = 0; i < count; ++i, src += step)
+    {
+        col[firstElementIndex + i].set(valueType, src);
+        table.add(firstElementIndex + i);
+    }
 }
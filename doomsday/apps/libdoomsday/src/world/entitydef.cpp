@@ -22,7 +22,6 @@
 #include "doomsday/world/entitydef.h"
 #include "doomsday/world/world.h"
 #include "doomsday/world/map.h"
-#include "doomsday/world/propertyvalue.h"
 #include "doomsday/EntityDatabase"
 
 #include <cmath>
@@ -296,22 +295,6 @@ static MapEntityPropertyDef *entityPropertyDef(int entityId, int propertyId)
     return property; // Found it.
 }
 
-static void setValue(void *dst, valuetype_t dstType, PropertyValue const &pvalue)
-{
-    switch (dstType)
-    {
-    case DDVT_FIXED:  *((fixed_t *) dst) = pvalue.asFixed();  break;
-    case DDVT_FLOAT:  *(  (float *) dst) = pvalue.asFloat();  break;
-    case DDVT_DOUBLE: *( (double *) dst) = pvalue.asDouble(); break;
-    case DDVT_BYTE:   *(   (byte *) dst) = pvalue.asByte();   break;
-    case DDVT_INT:    *(    (int *) dst) = pvalue.asInt32();  break;
-    case DDVT_SHORT:  *(  (short *) dst) = pvalue.asInt16();  break;
-    case DDVT_ANGLE:  *((angle_t *) dst) = pvalue.asAngle();  break;
-    default:
-        throw Error("setValue", QString("Unknown value type %d").arg(dstType));
-    }
-}
-
 dd_bool P_GMOPropertyIsSet(int entityId, int elementIndex, int propertyId)
 {
     if (World::get().hasMap())
@@ -332,7 +315,7 @@ Type getEntityValue(int entityId, int elementIndex, int propertyId)
         {
             EntityDatabase const &db = World::get().map().entityDatabase();
             MapEntityPropertyDef const *propDef = entityPropertyDef(entityId, propertyId);
-            setValue(&returnVal, returnValueType, db.property(propDef, elementIndex));
+            db.property(propDef, elementIndex, returnValueType, &returnVal);
         }
         return returnVal;
     }
@@ -0,0 +1,49 @@
+/** @file demohash.h  Comparing demo playback against a reference.
+ * @ingroup libcommon
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef LIBCOMMON_DEMOHASH_H
+#define LIBCOMMON_DEMOHASH_H
+
+#include "dd_share.h"
+
+/**
+ * The "demohash" command plays back a demo and hashes the state of the mobjs after
+ * every game tic. The first time the hashes are saved as a reference; after that
+ * they are compared against the reference, so that a change in the game code can
+ * be checked to leave the simulation bit-identical.
+ */
+D_CMD(DemoHash);
+
+void DemoHash_Register();
+
+/**
+ * Hashes the world state, if a demo is being checked. Called after each sharp tic
+ * in a map.
+ */
+void DemoHash_Ticker();
+
+/**
+ * Reports the outcome of the check, if a demo was being checked.
+ *
+ * @param aborted  @c true, if the playback did not end normally.
+ */
+void DemoHash_PlaybackStopped(bool aborted);
+
+#endif // LIBCOMMON_DEMOHASH_H
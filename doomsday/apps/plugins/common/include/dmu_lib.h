@@ -302,4 +302,61 @@ void P_TranslatePlaneMaterialOriginXY(Plane *plane, float deltaX, float deltaY);
 } // extern "C"
 #endif
 
+#ifdef __cplusplus
+#include <memory>
+
+/**
+ * Sectors that share a tag, in ascending index order.
+ *
+ * A range keeps the index it was taken from alive, so changes to the tags made during
+ * an iteration do not affect it. Unlike the tagged iterlists, ranges have no shared
+ * rover, so iterations can be nested.
+ */
+class SectorTagRange
+{
+public:
+    SectorTagRange() : _begin(nullptr), _end(nullptr) {}
+    SectorTagRange(std::shared_ptr<void const> const &index,
+                   Sector *const *begin, Sector *const *end)
+        : _index(index), _begin(begin), _end(end) {}
+
+    Sector *const *begin() const { return _begin; }
+    Sector *const *end() const   { return _end; }
+    bool isEmpty() const         { return _begin == _end; }
+    int size() const             { return int(_end - _begin); }
+
+    /// Returns the sector with the lowest index, or @c nullptr if the range is empty.
+    Sector *first() const { return isEmpty()? nullptr : *_begin; }
+
+private:
+    std::shared_ptr<void const> _index;
+    Sector *const *_begin;
+    Sector *const *_end;
+};
+
+/**
+ * (Re)builds the index of sector tags and XG act tags for the current map.
+ */
+void P_BuildSectorTagIndex();
+
+void P_DestroySectorTagIndex();
+
+/**
+ * To be called when the tag or the XG sector type (and thus the act tag) of a sector
+ * changes. The index is rebuilt when it is next used.
+ */
+void P_SectorTagsChanged();
+
+/**
+ * Returns the sectors whose tag is @a tag.
+ */
+SectorTagRange P_SectorsWithTag(int tag);
+
+/**
+ * Returns the XG sectors whose act tag is @a actTag.
+ */
+SectorTagRange P_SectorsWithActTag(int actTag);
+
+#endif // __cplusplus
+
 #endif /* LIBCOMMON_DMU_LIB_H */
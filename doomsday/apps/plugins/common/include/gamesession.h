@@ -21,6 +21,7 @@
 #define LIBCOMMON_GAMESESSION_H
 
 #include <de/String>
+#include <de/Time>
 #include <doomsday/AbstractSession>
 #include <doomsday/uri.h>
 #include "doomsday.h"
@@ -217,6 +218,17 @@ public:  // Saved session management -------------------------------------------
      */
     de::String savedUserDescription(de::String const &saveName);
 
+    /**
+     * Measures the time that saving blocks the game thread: composing the metadata and
+     * capturing the game state. Nothing is written.
+     *
+     * @return  Capture time in seconds.
+     */
+    de::TimeSpan measureSaveCapture();
+
+    /// Maximum time that saving may block the game thread (one tic).
+    static de::TimeSpan saveCaptureBudget();
+
 public:
     /// Returns the singleton instance.
     static GameSession &gameSession();
@@ -23,6 +23,7 @@
 #define LIBCOMMON_P_MAP_H
 
 #include "common.h"
+#include "p_iterlist.h"
 
 DENG_EXTERN_C dd_bool tmFloatOk; ///< @c true= move would be ok if within "tmFloorZ - tmCeilingZ".
 DENG_EXTERN_C coord_t tmFloorZ;
@@ -232,6 +233,61 @@ int P_MobjCount(int type, int tid);
 
 #ifdef __cplusplus
 } // extern "C"
+
+/**
+ * Working state of a movement check. P_CheckPosition() and P_TryMove() keep
+ * everything they find about the position being checked in a context, so that
+ * checks using separate contexts do not interfere with each other.
+ *
+ * The public functions above use a shared default context and copy its results
+ * to the @c tm* globals after each call.
+ */
+struct MoveContext
+{
+    AABoxd box;               ///< Bounding box of the thing at the checked position.
+    mobj_t *thing;            ///< Thing being checked.
+    coord_t pos[3];           ///< Position being checked.
+    dd_bool floatOk;          ///< @c true= move would be ok if within "floorZ - ceilingZ".
+    coord_t floorZ;
+    coord_t ceilingZ;
+    coord_t dropoffZ;         ///< Lowest point contacted (monsters won't move to a drop off).
+#if __JHEXEN__
+    world_Material *floorMaterial;
+    mobj_t *blockingMobj;
+#else
+    dd_bool fellDown;         ///< $dropoff_fix
+    Line *hitLine;            ///< Special line to send a Hit event to.
+    int unstuck;              ///< $unstuck: used to check unsticking
+#endif
+    Line *blockingLine;       ///< $unstuck: blocking line
+    Line *ceilingLine;        ///< Line that determined ceilingZ.
+    Line *floorLine;          ///< Line that determined floorZ.
+    iterlist_t *specHit;      ///< Special lines contacted during the check.
+
+    /**
+     * @param specHit  List where contacted special lines are collected. Must
+     *                 remain valid while the context is in use.
+     */
+    MoveContext(iterlist_t *specHit = nullptr);
+};
+
+/**
+ * Checks the position of @a thing, like P_CheckPositionXYZ(), using the given
+ * context for all intermediate state and results.
+ */
+dd_bool P_CheckPositionWithContext(MoveContext &ctx, mobj_t *thing, coord_t const pos[3]);
+
+/**
+ * Attempts to move @a thing to a new position, like P_TryMoveXY(), using the
+ * given context for all intermediate state and results.
+ */
+#if __JHEXEN__
+dd_bool P_TryMoveWithContext(MoveContext &ctx, mobj_t *thing, coord_t x, coord_t y);
+#else
+dd_bool P_TryMoveWithContext(MoveContext &ctx, mobj_t *thing, coord_t x, coord_t y,
+                             dd_bool dropoff, dd_bool slide);
 #endif
 
+#endif // __cplusplus
+
 #endif // LIBCOMMON_P_MAP_H
@@ -0,0 +1,208 @@
+/** @file demohash.cpp  Comparing demo playback against a reference.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "common.h"
+#include "demohash.h"
+
+#include <de/App>
+#include <de/Block>
+#include <de/FileSystem>
+#include <de/LogBuffer>
+#include <de/Writer>
+#include <de/math.h>
+#include <QList>
+
+#include "g_common.h"
+
+using namespace de;
+
+static String const demoHashFolder = "/home/demohash";
+
+/// State of the check in progress.
+static struct DemoHashCheck
+{
+    bool active = false;
+    bool recording = false;     ///< Writing a new reference instead of comparing.
+    String demoName;
+    String referencePath;
+    QList<duint32> reference;
+    QList<duint32> hashes;
+    int firstMismatch = -1;     ///< Tic where the hashes first differed.
+} demoHashCheck;
+
+static int hashMobjWorker(thinker_t *th, void *context)
+{
+    de::Writer &writer = *static_cast<de::Writer *>(context);
+    mobj_t const *mo = reinterpret_cast<mobj_t const *>(th);
+
+    // Coordinates are written in full precision, so that any difference is noticed.
+    writer << dint32(mo->type)
+           << mo->origin[VX] << mo->origin[VY] << mo->origin[VZ]
+           << mo->mom[MX] << mo->mom[MY] << mo->mom[MZ]
+           << duint32(mo->angle)
+           << mo->floorZ << mo->ceilingZ
+           << dint32(mo->sprite) << dint32(mo->frame) << dint32(mo->tics)
+           << dint32(mo->health) << dint32(mo->flags) << dint32(mo->flags2);
+    return false; // Continue iteration.
+}
+
+/**
+ * Hashes the state of all the mobjs in the map, in thinker order.
+ */
+static duint32 hashWorldState()
+{
+    Block state;
+    de::Writer writer(state);
+    Thinker_Iterate(P_MobjThinker, hashMobjWorker, &writer);
+    return crc32(state);
+}
+
+static QList<duint32> readDemoHashes(File const &file)
+{
+    Block raw;
+    file >> raw;
+
+    QList<duint32> hashes;
+    foreach (QString const &line, String::fromUtf8(raw).split('\n', QString::SkipEmptyParts))
+    {
+        // Each line has the tic number and the hash.
+        QStringList const parts = line.split(' ', QString::SkipEmptyParts);
+        if (parts.size() != 2) continue;
+        hashes << parts.at(1).toUInt(nullptr, 16);
+    }
+    return hashes;
+}
+
+void DemoHash_Ticker()
+{
+    if (!demoHashCheck.active || !Get(DD_PLAYBACK)) return;
+
+    int const tic = demoHashCheck.hashes.size();
+    demoHashCheck.hashes << hashWorldState();
+
+    if (!demoHashCheck.recording && demoHashCheck.firstMismatch < 0 &&
+        (tic >= demoHashCheck.reference.size() ||
+         demoHashCheck.reference.at(tic) != demoHashCheck.hashes.last()))
+    {
+        demoHashCheck.firstMismatch = tic;
+    }
+}
+
+void DemoHash_PlaybackStopped(bool aborted)
+{
+    if (!demoHashCheck.active) return;
+
+    LOG_AS("demohash");
+
+    demoHashCheck.active = false;
+    int const tics = demoHashCheck.hashes.size();
+
+    if (aborted)
+    {
+        LOG_MSG("Playback of \"%s\" was aborted after %i tics; nothing was checked")
+                << demoHashCheck.demoName << tics;
+    }
+    else if (demoHashCheck.recording)
+    {
+        String text;
+        for (int i = 0; i < tics; ++i)
+        {
+            text += String("%1 %2\n").arg(i).arg(demoHashCheck.hashes.at(i), 8, 16, QChar('0'));
+        }
+        try
+        {
+            File &file = App::fileSystem().makeFolder(demoHashFolder)
+                    .replaceFile(demoHashCheck.referencePath.fileName());
+            file << text.toUtf8();
+            file.flush();
+            LOG_MSG("Wrote the reference hashes of %i tics to \"%s\"")
+                    << tics << demoHashCheck.referencePath;
+        }
+        catch (Error const &er)
+        {
+            LOG_RES_ERROR("Failed to write \"%s\": %s")
+                    << demoHashCheck.referencePath << er.asText();
+        }
+    }
+    else if (demoHashCheck.firstMismatch >= 0)
+    {
+        LOG_MSG("Demo hash check of \"%s\" failed: the world state differs from the "
+                "reference at tic %i") << demoHashCheck.demoName << demoHashCheck.firstMismatch;
+    }
+    else if (tics != demoHashCheck.reference.size())
+    {
+        LOG_MSG("Demo hash check of \"%s\" failed: playback lasted %i tics instead of %i")
+                << demoHashCheck.demoName << tics << demoHashCheck.reference.size();
+    }
+    else
+    {
+        LOG_MSG("Demo hash check of \"%s\" passed: %i tics are identical to the reference")
+                << demoHashCheck.demoName << tics;
+    }
+
+    demoHashCheck.reference.clear();
+    demoHashCheck.hashes.clear();
+}
+
+D_CMD(DemoHash)
+{
+    DENG2_UNUSED(src);
+
+    LOG_AS("demohash");
+
+    bool const record = (argc >= 3 && !qstricmp(argv[2], "record"));
+    String const demoName = argv[1];
+
+    demoHashCheck = DemoHashCheck();
+    demoHashCheck.demoName      = demoName;
+    demoHashCheck.referencePath = demoHashFolder / demoName.fileNameWithoutExtension() + ".txt";
+
+    if (!record)
+    {
+        if (auto const *file = App::rootFolder().tryLocate<File const>(demoHashCheck.referencePath))
+        {
+            demoHashCheck.reference = readDemoHashes(*file);
+        }
+    }
+    demoHashCheck.recording = demoHashCheck.reference.isEmpty();
+
+    if (!DD_Executef(true, "playdemo \"%s\"", demoName.toUtf8().constData()))
+    {
+        LOG_SCR_ERROR("Failed to play back \"%s\"") << demoName;
+        return false;
+    }
+    demoHashCheck.active = true;
+
+    if (demoHashCheck.recording)
+    {
+        LOG_MSG("Playing back \"%s\" to record the reference hashes") << demoName;
+    }
+    else
+    {
+        LOG_MSG("Playing back \"%s\" to compare against %i reference hashes")
+                << demoName << demoHashCheck.reference.size();
+    }
+    return true;
+}
+
+void DemoHash_Register()
+{
+    C_CMD_FLAGS("demohash", "s",  DemoHash, CMDF_NO_NULLGAME);
+    C_CMD_FLAGS("demohash", "ss", DemoHash, CMDF_NO_NULLGAME);
+}
@@ -44,6 +44,7 @@
 #include "d_net.h"
 #include "d_netcl.h"
 #include "d_netsv.h"
+#include "demohash.h"
 #include "dmu_lib.h"
 #include "fi_lib.h"
 #include "g_controls.h"
@@ -1662,6 +1663,7 @@ void G_Ticker(timespan_t ticLength)
 
             P_DoTick();
             HU_UpdatePsprites();
+            DemoHash_Ticker();
 
             // Activate briefings once again (disabled for autostart or loading a saved game).
             briefDisabled = false;
@@ -2236,6 +2238,8 @@ int Hook_DemoStop(int /*hookType*/, int val, void * /*context*/)
 {
     bool aborted = val != 0;
 
+    DemoHash_PlaybackStopped(aborted);
+
     G_ChangeGameState(GS_WAITING);
 
     if (!aborted && singledemo)
@@ -3081,6 +3085,7 @@ static void registerGameStatusCVars()
 void G_ConsoleRegister()
 {
     GameSession::consoleRegister();
+    DemoHash_Register();
 
     C_VAR_BYTE("game-save-confirm",              &cfg.common.confirmQuickGameSave,  0, 0, 1);
     /* Alias */ C_VAR_BYTE("menu-quick-ask",     &cfg.common.confirmQuickGameSave,  0, 0, 1);
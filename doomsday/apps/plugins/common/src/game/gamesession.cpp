@@ -22,10 +22,12 @@
 
 #include <de/App>
 #include <de/CommandLine>
+#include <de/Loop>
 #include <de/ArrayValue>
 #include <de/NumberValue>
 #include <de/RecordValue>
 #include <de/PackageLoader>
+#include <de/TaskPool>
 #include <de/Time>
 #include <de/TextValue>
 #include <de/ZipArchive>
@@ -40,6 +42,7 @@
 #include "hu_menu.h"
 #include "hu_inventory.h"
 #include "mapstatewriter.h"
+#include "p_actor.h"
 #include "p_inventory.h"
 #include "p_map.h"
 #include "p_mapsetup.h"
@@ -56,6 +59,9 @@
 #  include "hereticv13mapstatereader.h"
 #endif
 
+#include <atomic>
+#include <functional>
+
 using namespace de;
 
 namespace common {
@@ -103,7 +109,8 @@ using namespace internal;
 static String const internalSavePath = "/home/cache/internal.save";
 static GameSession theSession;
 
-DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory
+DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory,
+DENG2_OBSERVES(Loop, Iteration)
 {
     String episodeId;
     GameRuleset rules;
@@ -114,15 +121,125 @@ DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory
 
     acs::System acscriptSys;  ///< The One acs::System instance.
 
+    /**
+     * Game state captured on the game thread, to be written to a .save package in the
+     * background. Compressing and writing out the package is the slow part of saving.
+     */
+    struct SaveSnapshot
+    {
+        duint generation = 0;         ///< Value of saveGeneration when captured.
+        String path;                  ///< Package to update.
+        String copyPath;              ///< If not empty, the updated package is copied here.
+        GameStateMetadata metadata;
+        String mapStateName;          ///< Name of the map state file in the "maps" folder.
+        Block mapState;
+#if __JHEXEN__
+        Block acsWorldState;
+#endif
+
+        /// Snapshots that only update the internal save can be dropped if the session
+        /// ends before they are written. Saves requested by the user are always written.
+        bool isDiscardable() const { return copyPath.isEmpty(); }
+
+        /// Called in the main thread when the snapshot has been written (@c true) or
+        /// writing it failed (@c false).
+        std::function<void (bool)> completed;
+    };
+
+    /// Maximum time for capturing the game state on the game thread (one tic).
+    static TimeSpan captureTimeBudget() { return 1.0 / TICSPERSEC; }
+
+    /// Outcome of writing a snapshot, to be reported in the main thread.
+    struct FinishedSave
+    {
+        String path;
+        String dest;
+        bool succeeded = false;
+        String errorText;
+        std::function<void (bool)> completed;
+    };
+
+    TaskPool saveTasks;                      ///< Writes one snapshot at a time.
+    std::atomic<duint> saveGeneration { 0 }; ///< Incremented when pending snapshots become stale.
+    LockableT<QList<FinishedSave>> finishedSaves;
+
     Impl(Public *i) : Base(i)
     {}
 
+    ~Impl()
+    {
+        // Completions are not reported after this, as they would call into the game
+        // plugin as it is being unloaded.
+        waitForPendingSave();
+    }
+
+    /**
+     * Blocks until the snapshot being written in the background (if any) is done. To be
+     * called before accessing the .save packages on the game thread.
+     */
+    void waitForPendingSave()
+    {
+        saveTasks.waitForDone();
+    }
+
+    /**
+     * Marks the snapshot not yet written (if any) stale, so that it will not be written
+     * if possible, and waits for the background writing to finish.
+     */
+    void discardPendingSave()
+    {
+        saveGeneration++;
+        waitForPendingSave();
+
+        // The session is ending, so the outcomes are no longer reported.
+        DENG2_GUARD(finishedSaves);
+        for (FinishedSave const &finished : finishedSaves.value)
+        {
+            LOG_RES_VERBOSE("Not reporting the writing of \"%s\" as the session ended")
+                    << finished.dest;
+        }
+        finishedSaves.value.clear();
+    }
+
+    /**
+     * Reports the outcomes of the snapshots written in the background. The game
+     * session is notified of a save only after the package has been written.
+     */
+    void loopIteration() override
+    {
+        QList<FinishedSave> finished;
+        {
+            DENG2_GUARD(finishedSaves);
+            if (finishedSaves.value.isEmpty()) return;
+            std::swap(finished, finishedSaves.value);
+        }
+
+        LOG_AS("GameSession");
+        for (FinishedSave const &save : finished)
+        {
+            if (save.succeeded)
+            {
+                if (auto *saved = App::rootFolder().tryLocate<GameStateFolder>(save.path))
+                {
+                    DoomsdayApp::app().gameSessionWasSaved(self(), *saved);
+                }
+            }
+            else
+            {
+                LOG_RES_WARNING("Error writing game state to \"%s\":\n") << save.dest << save.errorText;
+            }
+            if (save.completed) save.completed(save.succeeded);
+        }
+    }
+
     inline String userSavePath(String const &fileName) {
         return AbstractSession::savePath() / fileName + ".save";
     }
 
     void cleanupInternalSave()
     {
+        discardPendingSave();
+
         // Ensure the internal save folder exists.
         App::fileSystem().makeFolder(internalSavePath.fileNamePath());
 
@@ -226,51 +343,69 @@ DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory
     }
 
     /**
-     * Write the current map state to a file and notify the application about the change
-     * in the game state folder.
+     * Serializes the current map state using the legacy writer_s.
      *
-     * @param dest            Destination file for the serialized map state.
-     * @param saveFolder      Folder containing the save.
      * @param excludePlayers  Should players be excluded from the state?
      */
-    void serializeCurrentMapState(File &dest, GameStateFolder &saveFolder, bool excludePlayers = false)
+    Block captureMapState(bool excludePlayers = false)
     {
         Block data;
         SV_OpenFileForWrite(data);
         writer_s *writer = SV_NewWriter();
         MapStateWriter mapStateWriter;
         //self().setThinkerMapping(&mapStateWriter);
-        // Serialize the data using the legacy writer_s.
         mapStateWriter.write(writer, excludePlayers);
         Writer_Delete(writer);
         SV_CloseFile();
+        //self().setThinkerMapping(nullptr);
+        return data;
+    }
 
+    /**
+     * Write the current map state to a file and notify the application about the change
+     * in the game state folder.
+     *
+     * @param dest            Destination file for the serialized map state.
+     * @param saveFolder      Folder containing the save.
+     * @param excludePlayers  Should players be excluded from the state?
+     */
+    void serializeCurrentMapState(File &dest, GameStateFolder &saveFolder, bool excludePlayers = false)
+    {
         // Write to the file.
-        dest << data;
+        dest << captureMapState(excludePlayers);
 
         DoomsdayApp::app().gameSessionWasSaved(self(), saveFolder);
-        //self().setThinkerMapping(nullptr);
     }
 
     /**
      * Update/create a new GameStateFolder at the specified @a path from the current
-     * game state.
+     * game state. The state is captured immediately, but the package is written in
+     * the background (see waitForPendingSave()).
+     *
+     * @param path       Package to update.
+     * @param metadata   Metadata of the saved session.
+     * @param copyPath   If not empty, the updated package is then copied here.
+     * @param completed  Called in the main thread after the package has been written,
+     *                   with @c true if writing succeeded. Not called if the session
+     *                   ends before that.
      */
-    GameStateFolder &updateGameStateFolder(String const &path, GameStateMetadata const &metadata)
+    void updateGameStateFolder(String const &path, GameStateMetadata const &metadata,
+                               String const &copyPath = String(),
+                               std::function<void (bool)> completed = nullptr)
     {
         DENG2_ASSERT(self().hasBegun());
 
         LOG_AS("GameSession");
         LOG_RES_VERBOSE("Serializing to \"%s\"...") << path;
 
+        Time const startedAt;
+
+        // The package may still be in use by the previous save.
+        waitForPendingSave();
+
         // Does the .save already exist?
         auto *saved = App::rootFolder().tryLocate<GameStateFolder>(path);
-        if (saved)
-        {
-            DENG2_ASSERT(saved->mode().testFlag(File::Write));
-            saved->replaceFile("Info") << composeSaveInfo(metadata).toUtf8();
-        }
-        else
+        if (!saved)
         {
             // Create an empty package containing only the metadata.
             File &save = App::rootFolder().replaceFile(path);
@@ -283,28 +418,112 @@ DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory
             saved = &save.reinterpret()->as<GameStateFolder>();
             saved->populate();
         }
+        DENG2_ASSERT(saved->mode().testFlag(File::Write));
+
+        // Capture the current game state.
+        auto *snapshot = new SaveSnapshot;
+        snapshot->generation   = saveGeneration;
+        snapshot->path         = path;
+        snapshot->copyPath     = copyPath;
+        snapshot->metadata     = metadata;
+        snapshot->completed    = completed;
+        captureState(*snapshot);
+
+        // The game thread should not be blocked for more than a tic.
+        TimeSpan const captureTime = startedAt.since();
+        if (captureTime > captureTimeBudget())
+        {
+            LOG_RES_WARNING("Capturing the game state took %.1f ms, exceeding the budget of %.1f ms")
+                    << captureTime * 1000 << captureTimeBudget() * 1000;
+        }
+        else
+        {
+            LOG_RES_VERBOSE("Game state captured in %.1f ms") << captureTime * 1000;
+        }
 
-        // Save the current game state to the .save package.
+        // The outcome is reported in the main thread, on a later loop iteration.
+        Loop::get().audienceForIteration() += this;
+
+        saveTasks.start([this, snapshot] ()
+        {
+            FinishedSave finished;
+            finished.path      = snapshot->path;
+            finished.dest      = (snapshot->copyPath.isEmpty()? snapshot->path : snapshot->copyPath);
+            finished.succeeded = writeSnapshot(*snapshot, finished.errorText);
+            finished.completed = snapshot->completed;
+            delete snapshot;
+
+            DENG2_GUARD(finishedSaves);
+            finishedSaves.value.append(finished);
+        });
+    }
+
+    /**
+     * Captures the current map (and world) state into a snapshot. This is the part of
+     * saving that has to be done on the game thread.
+     */
+    void captureState(SaveSnapshot &snapshot)
+    {
+        snapshot.mapStateName  = self().mapUri().path() + "State";
+        snapshot.mapState      = captureMapState();
 #if __JHEXEN__
-        de::Writer(saved->replaceFile("ACScriptState")).withHeader()
-                << acscriptSys.serializeWorldState();
+        snapshot.acsWorldState = acscriptSys.serializeWorldState();
 #endif
+    }
 
-        Folder &mapsFolder = App::fileSystem().makeFolder(saved->path() / "maps");
-        DENG2_ASSERT(mapsFolder.mode().testFlag(File::Write));
+    /**
+     * Writes a captured game state to its .save package. Called in a background thread.
+     *
+     * @param snapshot   Captured game state.
+     * @param errorText  Description of the error, if writing fails.
+     *
+     * @return @c true if the snapshot was written or discarded as stale.
+     */
+    bool writeSnapshot(SaveSnapshot const &snapshot, String &errorText)
+    {
+        LOG_AS("GameSession");
 
-        //MapStateWriter mapStateWriter;
-        //self().setThinkerMapping(&mapStateWriter);
-        serializeCurrentMapState(mapsFolder.replaceFile(self().mapUri().path() + "State"),
-                                 *saved);
-                //<< serializeCurrentMapState(mapStateWriter);
-        //DoomsdayApp::app().gameSessionWasSaved(self(), *saved);
-        //self().setThinkerMapping(nullptr);
+        if (snapshot.isDiscardable() && snapshot.generation != saveGeneration)
+        {
+            LOG_RES_VERBOSE("Discarded a stale snapshot of \"%s\"") << snapshot.path;
+            return true;
+        }
 
-        saved->flush();  // No need to populate; FS2 Files already in sync with source data.
-        saved->cacheMetadata(metadata);  // Avoid immediately reopening the .save package.
+        try
+        {
+            Time const startedAt;
 
-        return *saved;
+            auto &saved = App::rootFolder().locate<GameStateFolder>(snapshot.path);
+            DENG2_ASSERT(saved.mode().testFlag(File::Write));
+
+            saved.replaceFile("Info") << composeSaveInfo(snapshot.metadata).toUtf8();
+#if __JHEXEN__
+            de::Writer(saved.replaceFile("ACScriptState")).withHeader()
+                    << snapshot.acsWorldState;
+#endif
+
+            Folder &mapsFolder = App::fileSystem().makeFolder(saved.path() / "maps");
+            DENG2_ASSERT(mapsFolder.mode().testFlag(File::Write));
+            mapsFolder.replaceFile(snapshot.mapStateName) << snapshot.mapState;
+
+            saved.flush();  // No need to populate; FS2 Files already in sync with source data.
+            saved.cacheMetadata(snapshot.metadata);  // Avoid immediately reopening the .save package.
+
+            if (!snapshot.copyPath.isEmpty())
+            {
+                AbstractSession::copySaved(snapshot.copyPath, snapshot.path);
+            }
+
+            LOG_RES_VERBOSE("\"%s\" written in %.1f ms")
+                    << (snapshot.copyPath.isEmpty()? snapshot.path : snapshot.copyPath)
+                    << startedAt.since() * 1000;
+            return true;
+        }
+        catch (Error const &er)
+        {
+            errorText = er.asText();
+        }
+        return false;
     }
 
 #if __JDOOM__ || __JDOOM64__
@@ -493,6 +712,9 @@ DENG2_PIMPL(GameSession), public GameStateFolder::IMapStateReaderFactory
 
     void loadSaved(String const &savePath)
     {
+        // The save may still be being written.
+        waitForPendingSave();
+
         ::briefDisabled = true;
 
         G_StopDemo();
@@ -1041,6 +1263,7 @@ void GameSession::end()
         G_ResetViewEffects();
     }
 
+    d->discardPendingSave();
     AbstractSession::removeSaved(internalSavePath);
 
     setInProgress(false);
@@ -1189,6 +1412,8 @@ void GameSession::leaveMap(de::Uri const &nextMapUri, uint nextMapEntryPoint)
     GameStateFolder *saved = nullptr;
     if (!d->rules.deathmatch) // Never save in deathmatch.
     {
+        d->waitForPendingSave();
+
         saved = &App::rootFolder().locate<GameStateFolder>(internalSavePath);
         auto &mapsFolder = saved->locate<Folder>("maps");
 
@@ -1280,39 +1505,18 @@ void GameSession::leaveMap(de::Uri const &nextMapUri, uint nextMapEntryPoint)
 
     if (saved)
     {
-        DENG2_ASSERT(saved->mode().testFlag(File::Write));
-
-        GameStateMetadata metadata = d->metadata();
-
         /// @todo Use the existing sessionId?
         //metadata.set("sessionId", saved->metadata().geti("sessionId"));
-        saved->replaceFile("Info") << composeSaveInfo(metadata).toUtf8();
-
-#if __JHEXEN__
-        // Save the world-state of the Script interpreter.
-        de::Writer(saved->replaceFile("ACScriptState")).withHeader()
-                << d->acscriptSys.serializeWorldState();
-#endif
 
         // Save the state of the current map.
-        auto &mapsFolder = saved->locate<Folder>("maps");
-        DENG2_ASSERT(mapsFolder.mode().testFlag(File::Write));
-
-        File &outFile = mapsFolder.replaceFile(mapUri().path() + "State");
-        //MapStateWriter mapStateWriter;
-        //setThinkerMapping(&mapStateWriter);
-        d->serializeCurrentMapState(outFile, *saved);
-        //DoomsdayApp::app().gameSessionWasSaved(*this, *saved);
-        //setThinkerMapping(nullptr);
-
-        saved->flush(); // Write all changes to the package.
-        saved->cacheMetadata(metadata); // Avoid immediately reopening the .save package.
+        d->updateGameStateFolder(internalSavePath, d->metadata());
     }
 }
 
 String GameSession::userDescription()
 {
     if (!hasBegun()) return "";
+    d->waitForPendingSave();
     return App::rootFolder().locate<GameStateFolder>(internalSavePath)
                                 .metadata().gets("userDescription", "");
 }
@@ -1345,21 +1549,25 @@ void GameSession::save(String const &saveName, String const &userDescription)
         GameStateMetadata metadata = d->metadata();
         metadata.set("userDescription", chooseSaveDescription(savePath, userDescription));
 
-        // Update the existing internal .save package.
-        d->updateGameStateFolder(internalSavePath, metadata);
-
-        // In networked games the server tells the clients to save also.
-        NetSv_SaveGame(metadata.getui("sessionId"));
+        // Update the existing internal .save package and copy it to the destination
+        // slot. The package is written in the background; the game is saved only
+        // after it has been written successfully.
+        duint const sessionId = metadata.getui("sessionId");
+        d->updateGameStateFolder(internalSavePath, metadata, savePath,
+                                 [sessionId] (bool succeeded)
+        {
+            if (!succeeded) return;
 
-        // Copy the internal saved session to the destination slot.
-        AbstractSession::copySaved(savePath, internalSavePath);
+            // In networked games the server tells the clients to save also.
+            NetSv_SaveGame(sessionId);
 
-        P_SetMessage(&players[CONSOLEPLAYER], TXT_GAMESAVED);
+            P_SetMessage(&players[CONSOLEPLAYER], TXT_GAMESAVED);
 
-        // Notify the engine that the game was saved.
-        /// @todo After the engine has the primary responsibility of saving the game,
-        /// this notification is unnecessary.
-        Plug_Notify(DD_NOTIFY_GAME_SAVED, nullptr);
+            // Notify the engine that the game was saved.
+            /// @todo After the engine has the primary responsibility of saving the game,
+            /// this notification is unnecessary.
+            Plug_Notify(DD_NOTIFY_GAME_SAVED, nullptr);
+        });
     }
     catch (Error const &er)
     {
@@ -1379,17 +1587,20 @@ void GameSession::load(String const &saveName)
 
 void GameSession::copySaved(String const &destName, String const &sourceName)
 {
+    d->waitForPendingSave();
     AbstractSession::copySaved(d->userSavePath(destName), d->userSavePath(sourceName));
     LOG_MSG("Copied savegame \"%s\" to \"%s\"") << sourceName << destName;
 }
 
 void GameSession::removeSaved(String const &saveName)
 {
+    d->waitForPendingSave();
     AbstractSession::removeSaved(d->userSavePath(saveName));
 }
 
 String GameSession::savedUserDescription(String const &saveName)
 {
+    d->waitForPendingSave();
     String const savePath = d->userSavePath(saveName);
     if (auto const *saved = App::rootFolder().tryLocate<GameStateFolder>(savePath))
     {
@@ -1398,11 +1609,90 @@ String GameSession::savedUserDescription(String const &saveName)
     return ""; // Not found.
 }
 
+TimeSpan GameSession::measureSaveCapture()
+{
+    DENG2_ASSERT(hasBegun());
+
+    Time const startedAt;
+    Impl::SaveSnapshot snapshot;
+    snapshot.metadata = d->metadata();
+    d->captureState(snapshot);
+    return startedAt.since();
+}
+
+TimeSpan GameSession::saveCaptureBudget() // static
+{
+    return Impl::captureTimeBudget();
+}
+
 acs::System &GameSession::acsSystem()
 {
     return d->acscriptSys;
 }
 
+static int collectSyntheticSourceWorker(thinker_t *th, void *context)
+{
+    auto &sources = *static_cast<QList<mobj_t *> *>(context);
+    auto *mo = reinterpret_cast<mobj_t *>(th);
+    if (!mo->player) sources << mo;
+    return false; // Continue iteration.
+}
+
+/**
+ * Checks that saving stays within the game thread budget. The current map can be made
+ * heavier with temporary copies of the mobjs in it.
+ */
+D_CMD(SaveBudget)
+{
+    DENG2_UNUSED(src);
+    LOG_AS("savebudget");
+
+    if (!theSession.hasBegun() || G_GameState() != GS_MAP)
+    {
+        LOG_SCR_ERROR("A map must be in progress");
+        return false;
+    }
+
+    dint const copies  = (argc > 1? de::max(0, String(argv[1]).toInt()) : 0);
+    dint const repeats = (argc > 2? de::max(1, String(argv[2]).toInt()) : 10);
+
+    // Spawn the synthetic mobjs.
+    QList<mobj_t *> sources;
+    Thinker_Iterate(P_MobjThinker, collectSyntheticSourceWorker, &sources);
+    QList<mobj_t *> spawned;
+    for (dint i = 0; i < copies && !sources.isEmpty(); ++i)
+    {
+        mobj_t const *orig = sources.at(i % sources.size());
+        if (mobj_t *mo = P_SpawnMobjXYZ(mobjtype_t(orig->type), orig->origin[VX], orig->origin[VY],
+                                        orig->origin[VZ], orig->angle, 0))
+        {
+            spawned << mo;
+        }
+    }
+
+    ddouble total = 0;
+    ddouble worst = 0;
+    for (dint i = 0; i < repeats; ++i)
+    {
+        ddouble const elapsed = theSession.measureSaveCapture();
+        total += elapsed;
+        worst = de::max(worst, elapsed);
+    }
+
+    for (mobj_t *mo : spawned)
+    {
+        P_MobjRemove(mo, true);
+    }
+
+    ddouble const budget = GameSession::saveCaptureBudget();
+    bool const passed = (worst <= budget);
+    LOG_SCR_MSG("Capturing the game state with %i extra mobjs: average %.2f ms, worst %.2f ms, "
+                "budget %.2f ms: %s")
+            << spawned.size() << total / repeats * 1000 << worst * 1000 << budget * 1000
+            << (passed? "OK" : "OVER BUDGET");
+    return passed;
+}
+
 void GameSession::consoleRegister()  // static
 {
     static dint        gsvRuleSkill = 0;
@@ -1418,6 +1708,8 @@ void GameSession::consoleRegister()  // static
     C_VAR_URIPTR ("map-id",         &gsvMap,        READONLYCVAR, 0, 0);
 
 #undef READONLYCVAR
+
+    C_CMD("savebudget", nullptr, SaveBudget);
 }
 
 }  // namespace common
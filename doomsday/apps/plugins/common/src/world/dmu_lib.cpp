@@ -18,8 +18,10 @@
  * 02110-1301 USA</small>
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 #include "common.h"
 #include "dmu_lib.h"
@@ -55,6 +57,21 @@ static uint numLineTagLists;
 static TagList *sectorTagLists;
 static uint numSectorTagLists;
 
+/**
+ * Immutable index of sectors sorted by tag, and then by sector index.
+ */
+struct SectorTagIndex
+{
+    std::vector<int> tags;          ///< Tag of each sector in @ref sectors.
+    std::vector<Sector *> sectors;
+};
+
+typedef std::shared_ptr<SectorTagIndex const> SectorTagIndexPtr;
+
+static SectorTagIndexPtr sectorTagIndex;
+static SectorTagIndexPtr sectorActTagIndex;
+static bool sectorTagIndexNeedsRebuild;
+
 Line *P_AllocDummyLine()
 {
     xline_t *extra = (xline_t *)Z_Calloc(sizeof(xline_t), PU_GAMESTATIC, 0);
@@ -307,16 +324,97 @@ iterlist_t *P_GetSectorIterListForTag(int tag, dd_bool createNewList)
     return (tagList->list = IterList_New());
 }
 
+/**
+ * @param actTags  Index the XG act tags instead of the sector tags.
+ */
+static SectorTagIndexPtr buildSectorTagIndex(bool actTags)
+{
+    std::vector<std::pair<int, int>> keys;  // (tag, sector index)
+    keys.reserve(numsectors);
+    for(int i = 0; i < numsectors; ++i)
+    {
+        xsector_t const *xsec = P_ToXSector((Sector *)P_ToPtr(DMU_SECTOR, i));
+        if(!actTags)
+        {
+            keys.push_back(std::make_pair(int(xsec->tag), i));
+        }
+#if __JDOOM__ || __JHERETIC__ || __JDOOM64__
+        else if(xsec->xg)
+        {
+            keys.push_back(std::make_pair(xsec->xg->info.actTag, i));
+        }
+#endif
+    }
+    std::sort(keys.begin(), keys.end());
+
+    auto *index = new SectorTagIndex;
+    index->tags.reserve(keys.size());
+    index->sectors.reserve(keys.size());
+    for(auto const &key : keys)
+    {
+        index->tags.push_back(key.first);
+        index->sectors.push_back((Sector *)P_ToPtr(DMU_SECTOR, key.second));
+    }
+    return SectorTagIndexPtr(index);
+}
+
+static SectorTagRange sectorTagRange(SectorTagIndexPtr const &index, int tag)
+{
+    if(!index) return SectorTagRange();
+
+    auto const found = std::equal_range(index->tags.begin(), index->tags.end(), tag);
+    Sector *const *base = index->sectors.data();
+    return SectorTagRange(index, base + (found.first  - index->tags.begin()),
+                                 base + (found.second - index->tags.begin()));
+}
+
+void P_BuildSectorTagIndex()
+{
+    sectorTagIndex    = buildSectorTagIndex(false);
+    sectorActTagIndex = buildSectorTagIndex(true);
+    sectorTagIndexNeedsRebuild = false;
+}
+
+void P_DestroySectorTagIndex()
+{
+    sectorTagIndex.reset();
+    sectorActTagIndex.reset();
+    sectorTagIndexNeedsRebuild = false;
+}
+
+void P_SectorTagsChanged()
+{
+    // Ranges in use keep referencing the old index.
+    if(sectorTagIndex)
+    {
+        sectorTagIndexNeedsRebuild = true;
+    }
+}
+
+SectorTagRange P_SectorsWithTag(int tag)
+{
+    if(sectorTagIndexNeedsRebuild) P_BuildSectorTagIndex();
+    return sectorTagRange(sectorTagIndex, tag);
+}
+
+SectorTagRange P_SectorsWithActTag(int actTag)
+{
+    if(sectorTagIndexNeedsRebuild) P_BuildSectorTagIndex();
+    return sectorTagRange(sectorActTagIndex, actTag);
+}
+
 void P_BuildAllTagLists()
 {
     P_BuildSectorTagLists();
     P_BuildLineTagLists();
+    P_BuildSectorTagIndex();
 }
 
 void P_DestroyAllTagLists()
 {
     P_DestroyLineTagLists();
     P_DestroySectorTagLists();
+    P_DestroySectorTagIndex();
 }
 
 Sector *P_GetNextSector(Line *line, Sector *sec)
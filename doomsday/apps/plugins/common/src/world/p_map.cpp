@@ -41,22 +41,13 @@
 
 /*
  * Try move variables:
+ *
+ * Results of the latest check made with the default context (see MoveContext).
  */
-static AABoxd tmBox;
-static mobj_t *tmThing;
 dd_bool tmFloatOk; ///< @c true= move would be ok if within "tmFloorZ - tmCeilingZ".
 coord_t tmFloorZ;
 coord_t tmCeilingZ;
-#if __JHEXEN__
-static world_Material *tmFloorMaterial;
-#endif
 dd_bool tmFellDown; // $dropoff_fix
-static coord_t tm[3];
-static coord_t tmDropoffZ;
-#if __JDOOM__ || __JDOOM64__ || __JHERETIC__
-static Line *tmHitLine;
-static int tmUnstuck; ///< $unstuck: used to check unsticking
-#endif
 Line *tmBlockingLine; // $unstuck: blocking line
 #if __JHEXEN__
 mobj_t *tmBlockingMobj;
@@ -67,6 +58,57 @@ mobj_t *tmBlockingMobj;
 Line *tmCeilingLine;
 Line *tmFloorLine;
 
+MoveContext::MoveContext(iterlist_t *specHit)
+    : thing        (nullptr)
+    , floatOk      (false)
+    , floorZ       (0)
+    , ceilingZ     (0)
+    , dropoffZ     (0)
+#if __JHEXEN__
+    , floorMaterial(nullptr)
+    , blockingMobj (nullptr)
+#else
+    , fellDown     (false)
+    , hitLine      (nullptr)
+    , unstuck      (0)
+#endif
+    , blockingLine (nullptr)
+    , ceilingLine  (nullptr)
+    , floorLine    (nullptr)
+    , specHit      (specHit)
+{
+    pos[VX] = pos[VY] = pos[VZ] = 0;
+}
+
+/**
+ * Context used by the public movement functions. Nested checks made through them
+ * share this context, as they always have.
+ */
+static MoveContext &defaultMoveContext()
+{
+    static MoveContext ctx;
+    ctx.specHit = spechit; // Recreated with each map.
+    return ctx;
+}
+
+/**
+ * Publishes the results of a check made with the default context.
+ */
+static void exportMoveResults(MoveContext const &ctx)
+{
+    tmFloatOk      = ctx.floatOk;
+    tmFloorZ       = ctx.floorZ;
+    tmCeilingZ     = ctx.ceilingZ;
+#if __JHEXEN__
+    tmBlockingMobj = ctx.blockingMobj;
+#else
+    tmFellDown     = ctx.fellDown;
+#endif
+    tmBlockingLine = ctx.blockingLine;
+    tmCeilingLine  = ctx.ceilingLine;
+    tmFloorLine    = ctx.floorLine;
+}
+
 /*
  * Line aim/attack variables:
  */
@@ -360,24 +402,26 @@ static int untouched(Line *line, mobj_t *mobj)
 }
 #endif
 
-static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
+static int PIT_CheckThing(mobj_t *thing, void *context)
 {
+    MoveContext &ctx = *static_cast<MoveContext *>(context);
+
     // Don't clip against oneself.
-    if(thing == tmThing)
+    if(thing == ctx.thing)
     {
         return false;
     }
 
 #if __JHEXEN__
     // Don't clip on something we are stood on.
-    if(thing == tmThing->onMobj)
+    if(thing == ctx.thing->onMobj)
     {
         return false;
     }
 #endif
 
     if(!(thing->flags & (MF_SOLID | MF_SPECIAL | MF_SHOOTABLE)) ||
-       P_MobjIsCamera(thing) || P_MobjIsCamera(tmThing))
+       P_MobjIsCamera(thing) || P_MobjIsCamera(ctx.thing))
     {
         return false;
     }
@@ -385,11 +429,11 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 #if !__JHEXEN__
     // Player only.
     dd_bool overlap = false;
-    if(tmThing->player && !FEQUAL(tm[VZ], DDMAXFLOAT) &&
-       (cfg.moveCheckZ || (tmThing->flags2 & MF2_PASSMOBJ)))
+    if(ctx.thing->player && !FEQUAL(ctx.pos[VZ], DDMAXFLOAT) &&
+       (cfg.moveCheckZ || (ctx.thing->flags2 & MF2_PASSMOBJ)))
     {
-        if((thing->origin[VZ] > tm[VZ] + tmThing->height) ||
-           (thing->origin[VZ] + thing->height < tm[VZ]))
+        if((thing->origin[VZ] > ctx.pos[VZ] + ctx.thing->height) ||
+           (thing->origin[VZ] + thing->height < ctx.pos[VZ]))
         {
             return false; // Under or over it.
         }
@@ -398,9 +442,9 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
     }
 #endif
 
-    coord_t blockdist = thing->radius + tmThing->radius;
-    if(fabs(thing->origin[VX] - tm[VX]) >= blockdist ||
-       fabs(thing->origin[VY] - tm[VY]) >= blockdist)
+    coord_t blockdist = thing->radius + ctx.thing->radius;
+    if(fabs(thing->origin[VX] - ctx.pos[VX]) >= blockdist ||
+       fabs(thing->origin[VY] - ctx.pos[VY]) >= blockdist)
     {
         return false; // Didn't hit thing.
     }
@@ -408,13 +452,13 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
     if(IS_CLIENT)
     {
         // On clientside, missiles don't collide with mobjs.
-        if(tmThing->ddFlags & DDMF_MISSILE)
+        if(ctx.thing->ddFlags & DDMF_MISSILE)
         {
             return false;
         }
 
         // Players can't hit their own clmobjs.
-        if(tmThing->player && ClPlayer_ClMobj(tmThing->player - players) == thing)
+        if(ctx.thing->player && ClPlayer_ClMobj(ctx.thing->player - players) == thing)
         {
             return false;
         }
@@ -428,24 +472,24 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 */
 
 #if __JHEXEN__
-    tmBlockingMobj = thing;
+    ctx.blockingMobj = thing;
 #endif
 
 #if __JHEXEN__
-    if(tmThing->flags2 & MF2_PASSMOBJ)
+    if(ctx.thing->flags2 & MF2_PASSMOBJ)
 #else
-    if(!tmThing->player && (tmThing->flags2 & MF2_PASSMOBJ))
+    if(!ctx.thing->player && (ctx.thing->flags2 & MF2_PASSMOBJ))
 #endif
     {
         // Check if a mobj passed over/under another object.
 #if __JHERETIC__
-        if((tmThing->type == MT_IMP || tmThing->type == MT_WIZARD) &&
+        if((ctx.thing->type == MT_IMP || ctx.thing->type == MT_WIZARD) &&
            (thing->type == MT_IMP || thing->type == MT_WIZARD))
         {
             return true; // Don't let imps/wizards fly over other imps/wizards.
         }
 #elif __JHEXEN__
-        if(tmThing->type == MT_BISHOP && thing->type == MT_BISHOP)
+        if(ctx.thing->type == MT_BISHOP && thing->type == MT_BISHOP)
         {
             return true; // Don't let bishops fly over other bishops.
         }
@@ -453,8 +497,8 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 
         if(!(thing->flags & MF_SPECIAL))
         {
-            if(tmThing->origin[VZ] > thing->origin[VZ] + thing->height ||
-               tmThing->origin[VZ] + tmThing->height < thing->origin[VZ])
+            if(ctx.thing->origin[VZ] > thing->origin[VZ] + thing->height ||
+               ctx.thing->origin[VZ] + ctx.thing->height < thing->origin[VZ])
             {
                 return false; // Over/under thing.
             }
@@ -462,12 +506,12 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
     }
 
     // Check for skulls slamming into things.
-    if((tmThing->flags & MF_SKULLFLY) && (thing->flags & MF_SOLID))
+    if((ctx.thing->flags & MF_SKULLFLY) && (thing->flags & MF_SOLID))
     {
 #if __JHEXEN__
-        tmBlockingMobj = 0;
+        ctx.blockingMobj = 0;
 
-        if(tmThing->type == MT_MINOTAUR)
+        if(ctx.thing->type == MT_MINOTAUR)
         {
             // Slamming minotaurs shouldn't move non-creatures.
             if(!(thing->flags & MF_COUNTKILL))
@@ -475,9 +519,9 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                 return true;
             }
         }
-        else if(tmThing->type == MT_HOLY_FX)
+        else if(ctx.thing->type == MT_HOLY_FX)
         {
-            if((thing->flags & MF_SHOOTABLE) && thing != tmThing->target)
+            if((thing->flags & MF_SHOOTABLE) && thing != ctx.thing->target)
             {
                 if(IS_NETGAME && !COMMON_GAMESESSION->rules().deathmatch && thing->player)
                 {
@@ -487,14 +531,14 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                 if((thing->flags2 & MF2_REFLECTIVE) &&
                    (thing->player || (thing->flags2 & MF2_BOSS)))
                 {
-                    tmThing->tracer = tmThing->target;
-                    tmThing->target = thing;
+                    ctx.thing->tracer = ctx.thing->target;
+                    ctx.thing->target = thing;
                     return false;
                 }
 
                 if(thing->flags & MF_COUNTKILL || thing->player)
                 {
-                    tmThing->tracer = thing;
+                    ctx.thing->tracer = thing;
                 }
 
                 if(P_Random() < 96)
@@ -504,14 +548,14 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                     {
                         damage = 3;
                         // Ghost burns out faster when attacking players/bosses.
-                        tmThing->health -= 6;
+                        ctx.thing->health -= 6;
                     }
 
-                    P_DamageMobj(thing, tmThing, tmThing->target, damage, false);
+                    P_DamageMobj(thing, ctx.thing, ctx.thing->target, damage, false);
                     if(P_Random() < 128)
                     {
-                        P_SpawnMobj(MT_HOLY_PUFF, tmThing->origin, P_Random() << 24, 0);
-                        S_StartSound(SFX_SPIRIT_ATTACK, tmThing);
+                        P_SpawnMobj(MT_HOLY_PUFF, ctx.thing->origin, P_Random() << 24, 0);
+                        S_StartSound(SFX_SPIRIT_ATTACK, ctx.thing);
 
                         if((thing->flags & MF_COUNTKILL) && P_Random() < 128 &&
                            !S_IsPlaying(SFX_PUPPYBEAT, thing))
@@ -528,7 +572,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 
                 if(thing->health <= 0)
                 {
-                    tmThing->tracer = 0;
+                    ctx.thing->tracer = 0;
                 }
             }
 
@@ -536,7 +580,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
         }
 #endif
 
-        int damage = tmThing->damage;
+        int damage = ctx.thing->damage;
 #if __JDOOM__
         /// @attention Kludge:
         /// Older save versions did not serialize the damage property,
@@ -544,20 +588,20 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
         /// @fixme Do this during map state deserialization.
         if(damage == DDMAXINT)
         {
-            damage = tmThing->info->damage;
+            damage = ctx.thing->info->damage;
         }
 #endif
 
         damage *= (P_Random() % 8) + 1;
-        P_DamageMobj(thing, tmThing, tmThing, damage, false);
+        P_DamageMobj(thing, ctx.thing, ctx.thing, damage, false);
 
-        tmThing->flags &= ~MF_SKULLFLY;
-        tmThing->mom[MX] = tmThing->mom[MY] = tmThing->mom[MZ] = 0;
+        ctx.thing->flags &= ~MF_SKULLFLY;
+        ctx.thing->mom[MX] = ctx.thing->mom[MY] = ctx.thing->mom[MZ] = 0;
 
 #if __JHERETIC__ || __JHEXEN__
-        P_MobjChangeState(tmThing, P_GetState(mobjtype_t(tmThing->type), SN_SEE));
+        P_MobjChangeState(ctx.thing, P_GetState(mobjtype_t(ctx.thing->type), SN_SEE));
 #else
-        P_MobjChangeState(tmThing, P_GetState(mobjtype_t(tmThing->type), SN_SPAWN));
+        P_MobjChangeState(ctx.thing, P_GetState(mobjtype_t(ctx.thing->type), SN_SPAWN));
 #endif
 
         return true; // Stop moving.
@@ -565,21 +609,21 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 
 #if __JHEXEN__
     // Check for blasted thing running into another
-    if((tmThing->flags2 & MF2_BLASTED) && (thing->flags & MF_SHOOTABLE))
+    if((ctx.thing->flags2 & MF2_BLASTED) && (thing->flags & MF_SHOOTABLE))
     {
         if(!(thing->flags2 & MF2_BOSS) && (thing->flags & MF_COUNTKILL))
         {
-            thing->mom[MX] += tmThing->mom[MX];
-            thing->mom[MY] += tmThing->mom[MY];
+            thing->mom[MX] += ctx.thing->mom[MX];
+            thing->mom[MY] += ctx.thing->mom[MY];
 
-            NetSv_PlayerMobjImpulse(thing, tmThing->mom[MX], tmThing->mom[VY], 0);
+            NetSv_PlayerMobjImpulse(thing, ctx.thing->mom[MX], ctx.thing->mom[VY], 0);
 
             if((thing->mom[MX] + thing->mom[MY]) > 3)
             {
-                P_DamageMobj(thing, tmThing, tmThing,
-                             (tmThing->info->mass / 100) + 1, false);
+                P_DamageMobj(thing, ctx.thing, ctx.thing,
+                             (ctx.thing->info->mass / 100) + 1, false);
 
-                P_DamageMobj(tmThing, thing, thing,
+                P_DamageMobj(ctx.thing, thing, thing,
                              ((thing->info->mass / 100) + 1) >> 2, false);
             }
 
@@ -589,7 +633,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 #endif
 
     // Missiles can hit other things.
-    if(tmThing->flags & MF_MISSILE)
+    if(ctx.thing->flags & MF_MISSILE)
     {
 #if __JHEXEN__
         // Check for a non-shootable mobj.
@@ -599,35 +643,35 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
         }
 #else
         // Check for passing through a ghost.
-        if((thing->flags & MF_SHADOW) && (tmThing->flags2 & MF2_THRUGHOST))
+        if((thing->flags & MF_SHADOW) && (ctx.thing->flags2 & MF2_THRUGHOST))
         {
             return false;
         }
 #endif
 
         // See if it went over / under.
-        if(tmThing->origin[VZ] > thing->origin[VZ] + thing->height ||
-           tmThing->origin[VZ] + tmThing->height < thing->origin[VZ])
+        if(ctx.thing->origin[VZ] > thing->origin[VZ] + thing->height ||
+           ctx.thing->origin[VZ] + ctx.thing->height < thing->origin[VZ])
         {
             return false;
         }
 
 #if __JHEXEN__
-        if(tmThing->flags2 & MF2_FLOORBOUNCE)
+        if(ctx.thing->flags2 & MF2_FLOORBOUNCE)
         {
-            return !(tmThing->target == thing || !(thing->flags & MF_SOLID));
+            return !(ctx.thing->target == thing || !(thing->flags & MF_SOLID));
         }
 
-        if(tmThing->type == MT_LIGHTNING_FLOOR || tmThing->type == MT_LIGHTNING_CEILING)
+        if(ctx.thing->type == MT_LIGHTNING_FLOOR || ctx.thing->type == MT_LIGHTNING_CEILING)
         {
-            if((thing->flags & MF_SHOOTABLE) && thing != tmThing->target)
+            if((thing->flags & MF_SHOOTABLE) && thing != ctx.thing->target)
             {
                 if(thing->info->mass != DDMAXINT)
                 {
-                    thing->mom[MX] += tmThing->mom[MX] / 16;
-                    thing->mom[MY] += tmThing->mom[MY] / 16;
+                    thing->mom[MX] += ctx.thing->mom[MX] / 16;
+                    thing->mom[MY] += ctx.thing->mom[MY] / 16;
 
-                    NetSv_PlayerMobjImpulse(thing, tmThing->mom[MX] / 16, tmThing->mom[MY] / 16, 0);
+                    NetSv_PlayerMobjImpulse(thing, ctx.thing->mom[MX] / 16, ctx.thing->mom[MY] / 16, 0);
                 }
 
                 if((!thing->player && !(thing->flags2 & MF2_BOSS)) ||
@@ -636,16 +680,16 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                     // Lightning does more damage to centaurs.
                     if(thing->type == MT_CENTAUR || thing->type == MT_CENTAURLEADER)
                     {
-                        P_DamageMobj(thing, tmThing, tmThing->target, 9, false);
+                        P_DamageMobj(thing, ctx.thing, ctx.thing->target, 9, false);
                     }
                     else
                     {
-                        P_DamageMobj(thing, tmThing, tmThing->target, 3, false);
+                        P_DamageMobj(thing, ctx.thing, ctx.thing->target, 3, false);
                     }
 
-                    if(!S_IsPlaying(SFX_MAGE_LIGHTNING_ZAP, tmThing))
+                    if(!S_IsPlaying(SFX_MAGE_LIGHTNING_ZAP, ctx.thing))
                     {
-                        S_StartSound(SFX_MAGE_LIGHTNING_ZAP, tmThing);
+                        S_StartSound(SFX_MAGE_LIGHTNING_ZAP, ctx.thing);
                     }
 
                     if((thing->flags & MF_COUNTKILL) && P_Random() < 64 &&
@@ -660,34 +704,34 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                     }
                 }
 
-                tmThing->health--;
-                if(tmThing->health <= 0 || thing->health <= 0)
+                ctx.thing->health--;
+                if(ctx.thing->health <= 0 || thing->health <= 0)
                 {
                     return true;
                 }
 
-                if(tmThing->type == MT_LIGHTNING_FLOOR)
+                if(ctx.thing->type == MT_LIGHTNING_FLOOR)
                 {
-                    if(tmThing->lastEnemy && !tmThing->lastEnemy->tracer)
+                    if(ctx.thing->lastEnemy && !ctx.thing->lastEnemy->tracer)
                     {
-                        tmThing->lastEnemy->tracer = thing;
+                        ctx.thing->lastEnemy->tracer = thing;
                     }
                 }
-                else if(!tmThing->tracer)
+                else if(!ctx.thing->tracer)
                 {
-                    tmThing->tracer = thing;
+                    ctx.thing->tracer = thing;
                 }
             }
 
             return false; // Lightning zaps through all sprites.
         }
 
-        if(tmThing->type == MT_LIGHTNING_ZAP)
+        if(ctx.thing->type == MT_LIGHTNING_ZAP)
         {
-            if((thing->flags & MF_SHOOTABLE) && thing != tmThing->target &&
-               tmThing->lastEnemy)
+            if((thing->flags & MF_SHOOTABLE) && thing != ctx.thing->target &&
+               ctx.thing->lastEnemy)
             {
-                mobj_t *lmo = tmThing->lastEnemy;
+                mobj_t *lmo = ctx.thing->lastEnemy;
 
                 if(lmo->type == MT_LIGHTNING_FLOOR)
                 {
@@ -707,7 +751,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                 }
             }
         }
-        else if(tmThing->type == MT_MSTAFF_FX2 && thing != tmThing->target)
+        else if(ctx.thing->type == MT_MSTAFF_FX2 && thing != ctx.thing->target)
         {
             if(!thing->player && !(thing->flags2 & MF2_BOSS))
             {
@@ -719,7 +763,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
                     break;
 
                 default:
-                    P_DamageMobj(thing, tmThing, tmThing->target, 10, false);
+                    P_DamageMobj(thing, ctx.thing, ctx.thing->target, 10, false);
                     return false;
                 }
             }
@@ -728,15 +772,15 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 
         // Don't hit same species as originator.
 #if __JDOOM__ || __JDOOM64__
-        if(tmThing->target &&
-           (tmThing->target->type == thing->type ||
-           (tmThing->target->type == MT_KNIGHT && thing->type == MT_BRUISER) ||
-           (tmThing->target->type == MT_BRUISER && thing->type == MT_KNIGHT)))
+        if(ctx.thing->target &&
+           (ctx.thing->target->type == thing->type ||
+           (ctx.thing->target->type == MT_KNIGHT && thing->type == MT_BRUISER) ||
+           (ctx.thing->target->type == MT_BRUISER && thing->type == MT_KNIGHT)))
 #else
-        if(tmThing->target && tmThing->target->type == thing->type)
+        if(ctx.thing->target && ctx.thing->target->type == thing->type)
 #endif
         {
-            if(thing == tmThing->target)
+            if(thing == ctx.thing->target)
             {
                 return false;
             }
@@ -761,7 +805,7 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
             return !!(thing->flags & MF_SOLID); // Didn't do any damage.
         }
 
-        if(tmThing->flags2 & MF2_RIP)
+        if(ctx.thing->flags2 & MF2_RIP)
         {
 #if __JHEXEN__
             if(!(thing->flags & MF_NOBLOOD) &&
@@ -771,14 +815,14 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
             if(!(thing->flags & MF_NOBLOOD))
 #endif
             {   // Ok to spawn some blood.
-                P_RipperBlood(tmThing);
+                P_RipperBlood(ctx.thing);
             }
 
 #if __JHERETIC__
-            S_StartSound(SFX_RIPSLOP, tmThing);
+            S_StartSound(SFX_RIPSLOP, ctx.thing);
 #endif
 
-            int damage = tmThing->damage;
+            int damage = ctx.thing->damage;
 #if __JDOOM__
             /// @attention Kludge:
             /// Older save versions did not serialize the damage property,
@@ -786,41 +830,41 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
             /// @fixme Do this during map state deserialization.
             if(damage == DDMAXINT)
             {
-                damage = tmThing->info->damage;
+                damage = ctx.thing->info->damage;
             }
 #endif
 
             damage *= (P_Random() & 3) + 2;
-            P_DamageMobj(thing, tmThing, tmThing->target, damage, false);
+            P_DamageMobj(thing, ctx.thing, ctx.thing->target, damage, false);
 
-            if((thing->flags2 & MF2_PUSHABLE) && !(tmThing->flags2 & MF2_CANNOTPUSH))
+            if((thing->flags2 & MF2_PUSHABLE) && !(ctx.thing->flags2 & MF2_CANNOTPUSH))
             {
                 // Push thing
-                thing->mom[MX] += tmThing->mom[MX] / 4;
-                thing->mom[MY] += tmThing->mom[MY] / 4;
-                NetSv_PlayerMobjImpulse(thing, tmThing->mom[MX]/4, tmThing->mom[MY]/4, 0);
+                thing->mom[MX] += ctx.thing->mom[MX] / 4;
+                thing->mom[MY] += ctx.thing->mom[MY] / 4;
+                NetSv_PlayerMobjImpulse(thing, ctx.thing->mom[MX]/4, ctx.thing->mom[MY]/4, 0);
             }
 
-            IterList_Clear(spechit);
+            IterList_Clear(ctx.specHit);
             return false;
         }
 
         // Do damage
-        int damage = tmThing->damage;
+        int damage = ctx.thing->damage;
 #if __JDOOM__
         /// @attention Kludge:
         /// Older save versions did not serialize the damage property,
         /// so here we take the damage from the current Thing definition.
         /// @fixme Do this during map state deserialization.
-        if(tmThing->damage == DDMAXINT)
+        if(ctx.thing->damage == DDMAXINT)
         {
-            damage = tmThing->info->damage;
+            damage = ctx.thing->info->damage;
         }
 #endif
 
         damage *= (P_Random() % 8) + 1;
 #if __JDOOM__ || __JDOOM64__
-        P_DamageMobj(thing, tmThing, tmThing->target, damage, false);
+        P_DamageMobj(thing, ctx.thing, ctx.thing->target, damage, false);
 #else
         if(damage)
         {
@@ -830,17 +874,17 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
             if(!(thing->flags & MF_NOBLOOD) &&
                !(thing->flags2 & MF2_REFLECTIVE) &&
                !(thing->flags2 & MF2_INVULNERABLE) &&
-               !(tmThing->type == MT_TELOTHER_FX1) &&
-               !(tmThing->type == MT_TELOTHER_FX2) &&
-               !(tmThing->type == MT_TELOTHER_FX3) &&
-               !(tmThing->type == MT_TELOTHER_FX4) &&
-               !(tmThing->type == MT_TELOTHER_FX5) && (P_Random() < 192))
+               !(ctx.thing->type == MT_TELOTHER_FX1) &&
+               !(ctx.thing->type == MT_TELOTHER_FX2) &&
+               !(ctx.thing->type == MT_TELOTHER_FX3) &&
+               !(ctx.thing->type == MT_TELOTHER_FX4) &&
+               !(ctx.thing->type == MT_TELOTHER_FX5) && (P_Random() < 192))
 # endif
             {
-                P_SpawnBloodSplatter(tmThing->origin[VX], tmThing->origin[VY], tmThing->origin[VZ], thing);
+                P_SpawnBloodSplatter(ctx.thing->origin[VX], ctx.thing->origin[VY], ctx.thing->origin[VZ], thing);
             }
 
-            P_DamageMobj(thing, tmThing, tmThing->target, damage, false);
+            P_DamageMobj(thing, ctx.thing, ctx.thing->target, damage, false);
         }
 #endif
 
@@ -848,69 +892,69 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
         return true;
     }
 
-    if((thing->flags2 & MF2_PUSHABLE) && !(tmThing->flags2 & MF2_CANNOTPUSH))
+    if((thing->flags2 & MF2_PUSHABLE) && !(ctx.thing->flags2 & MF2_CANNOTPUSH))
     {
         // Push thing
-        thing->mom[MX] += tmThing->mom[MX] / 4;
-        thing->mom[MY] += tmThing->mom[MY] / 4;
-        NetSv_PlayerMobjImpulse(thing, tmThing->mom[MX]/4, tmThing->mom[MY]/4, 0);
+        thing->mom[MX] += ctx.thing->mom[MX] / 4;
+        thing->mom[MY] += ctx.thing->mom[MY] / 4;
+        NetSv_PlayerMobjImpulse(thing, ctx.thing->mom[MX]/4, ctx.thing->mom[MY]/4, 0);
     }
 
     // @fixme Kludge: Always treat blood as a solid.
     dd_bool solid;
-    if(tmThing->type == MT_BLOOD)
+    if(ctx.thing->type == MT_BLOOD)
     {
         solid = true;
     }
     else
     {
         solid = (thing->flags & MF_SOLID) && !(thing->flags & MF_NOCLIP) &&
-                (tmThing->flags & MF_SOLID);
+                (ctx.thing->flags & MF_SOLID);
     }
     // Kludge end.
 
 #if __JHEXEN__
-    if(tmThing->player && tmThing->onMobj && solid)
+    if(ctx.thing->player && ctx.thing->onMobj && solid)
     {
         /// @todo Unify Hexen's onMobj logic with the other games.
 
         // We may be standing on more than one thing.
-        if(tmThing->origin[VZ] > thing->origin[VZ] + thing->height - 24)
+        if(ctx.thing->origin[VZ] > thing->origin[VZ] + thing->height - 24)
         {
             // Stepping up on this is possible.
-            tmFloorZ = MAX_OF(tmFloorZ, thing->origin[VZ] + thing->height);
+            ctx.floorZ = MAX_OF(ctx.floorZ, thing->origin[VZ] + thing->height);
             solid = false;
         }
     }
 #endif
 
     // Check for special pickup.
-    if((thing->flags & MF_SPECIAL) && (tmThing->flags & MF_PICKUP))
+    if((thing->flags & MF_SPECIAL) && (ctx.thing->flags & MF_PICKUP))
     {
-        P_TouchSpecialMobj(thing, tmThing); // Can remove thing.
+        P_TouchSpecialMobj(thing, ctx.thing); // Can remove thing.
     }
 #if !__JHEXEN__
     else if(overlap && solid)
     {
         // How are we positioned, allow step up?
-        if(!(thing->flags & MF_CORPSE) && tm[VZ] > thing->origin[VZ] + thing->height - 24)
+        if(!(thing->flags & MF_CORPSE) && ctx.pos[VZ] > thing->origin[VZ] + thing->height - 24)
         {
-            tmThing->onMobj = thing;
-            if(thing->origin[VZ] + thing->height > tmFloorZ)
+            ctx.thing->onMobj = thing;
+            if(thing->origin[VZ] + thing->height > ctx.floorZ)
             {
-                tmFloorZ = thing->origin[VZ] + thing->height;
+                ctx.floorZ = thing->origin[VZ] + thing->height;
             }
             return false;
         }
     }
-    else if(!tmThing->player && solid)
+    else if(!ctx.thing->player && solid)
     {
         // A non-player object is contacting a solid object.
-        if(cfg.allowMonsterFloatOverBlocking && (tmThing->flags & MF_FLOAT) && !thing->player)
+        if(cfg.allowMonsterFloatOverBlocking && (ctx.thing->flags & MF_FLOAT) && !thing->player)
         {
             coord_t top = thing->origin[VZ] + thing->height;
-            tmThing->onMobj = thing;
-            tmFloorZ = MAX_OF(tmFloorZ, top);
+            ctx.thing->onMobj = thing;
+            ctx.floorZ = MAX_OF(ctx.floorZ, top);
             return false;
         }
     }
@@ -920,13 +964,15 @@ static int PIT_CheckThing(mobj_t *thing, void * /*context*/)
 }
 
 /**
- * Adjusts tmFloorZ and tmCeilingZ as lines are contacted.
+ * Adjusts the floor and ceiling heights of the context as lines are contacted.
  */
-static int PIT_CheckLine(Line *ld, void * /*context*/)
+static int PIT_CheckLine(Line *ld, void *context)
 {
+    MoveContext &ctx = *static_cast<MoveContext *>(context);
+
     AABoxd const *aaBox = (AABoxd *)P_GetPtrp(ld, DMU_BOUNDING_BOX);
-    if(tmBox.minX >= aaBox->maxX || tmBox.minY >= aaBox->maxY ||
-       tmBox.maxX <= aaBox->minX || tmBox.maxY <= aaBox->minY)
+    if(ctx.box.minX >= aaBox->maxX || ctx.box.minY >= aaBox->maxY ||
+       ctx.box.maxX <= aaBox->minX || ctx.box.maxY <= aaBox->minY)
     {
         return false;
     }
@@ -936,9 +982,9 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
      * collision testing -- the rest of the playsim uses coord_t, and we don't
      * want conflicting results (e.g., getting stuck in tight spaces).
      */
-    if(Mobj_IsPlayer(tmThing) && !Mobj_IsVoodooDoll(tmThing))
+    if(Mobj_IsPlayer(ctx.thing) && !Mobj_IsVoodooDoll(ctx.thing))
     {
-        if(Line_BoxOnSide(ld, &tmBox)) // double precision floats
+        if(Line_BoxOnSide(ld, &ctx.box)) // double precision floats
         {
             return false;
         }
@@ -946,7 +992,7 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     else
     {
         // Fixed-precision math gives better compatibility with vanilla DOOM.
-        if(Line_BoxOnSide_FixedPrecision(ld, &tmBox))
+        if(Line_BoxOnSide_FixedPrecision(ld, &ctx.box))
         {
             return false;
         }
@@ -956,24 +1002,24 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     xline_t *xline = P_ToXLine(ld);
 
 #if !__JHEXEN__
-    tmThing->wallHit = true;
+    ctx.thing->wallHit = true;
 
     // A Hit event will be sent to special lines.
     if(xline->special)
     {
-        tmHitLine = ld;
+        ctx.hitLine = ld;
     }
 #endif
 
     if(!P_GetPtrp(ld, DMU_BACK_SECTOR)) // One sided line.
     {
 #if __JHEXEN__
-        if(tmThing->flags2 & MF2_BLASTED)
+        if(ctx.thing->flags2 & MF2_BLASTED)
         {
-            P_DamageMobj(tmThing, NULL, NULL, tmThing->info->mass >> 5, false);
+            P_DamageMobj(ctx.thing, NULL, NULL, ctx.thing->info->mass >> 5, false);
         }
 
-        checkForPushSpecial(ld, 0, tmThing);
+        checkForPushSpecial(ld, 0, ctx.thing);
         return true;
 #else
         coord_t d1[2];
@@ -992,10 +1038,10 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
          *       are only 8 units apart could be crossed in either order.
          */
 
-        tmBlockingLine = ld;
-        return !(tmUnstuck && !untouched(ld, tmThing) &&
-            ((tm[VX] - tmThing->origin[VX]) * d1[1]) >
-            ((tm[VY] - tmThing->origin[VY]) * d1[0]));
+        ctx.blockingLine = ld;
+        return !(ctx.unstuck && !untouched(ld, ctx.thing) &&
+            ((ctx.pos[VX] - ctx.thing->origin[VX]) * d1[1]) >
+            ((ctx.pos[VY] - ctx.thing->origin[VY]) * d1[0]));
 #endif
     }
 
@@ -1005,49 +1051,49 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     if(!P_GetPtrp(ld, DMU_BACK_SECTOR)) // one sided line
     {
         // Missiles can trigger impact specials
-        if((tmThing->flags & MF_MISSILE) && xline->special)
+        if((ctx.thing->flags & MF_MISSILE) && xline->special)
         {
-            IterList_PushBack(spechit, ld);
+            IterList_PushBack(ctx.specHit, ld);
         }
         return true;
     }
 #endif
 
-    if(!(tmThing->flags & MF_MISSILE))
+    if(!(ctx.thing->flags & MF_MISSILE))
     {
         // Explicitly blocking everything?
         if(P_GetIntp(ld, DMU_FLAGS) & DDLF_BLOCKING)
         {
 #if __JHEXEN__
-            if(tmThing->flags2 & MF2_BLASTED)
+            if(ctx.thing->flags2 & MF2_BLASTED)
             {
-                P_DamageMobj(tmThing, NULL, NULL, tmThing->info->mass >> 5, false);
+                P_DamageMobj(ctx.thing, NULL, NULL, ctx.thing->info->mass >> 5, false);
             }
 
-            checkForPushSpecial(ld, 0, tmThing);
+            checkForPushSpecial(ld, 0, ctx.thing);
             return true;
 #else
             // $unstuck: allow escape.
-            return !(tmUnstuck && !untouched(ld, tmThing));
+            return !(ctx.unstuck && !untouched(ld, ctx.thing));
 #endif
         }
 
         // Block monsters only?
 #if __JHEXEN__
-        if(!tmThing->player && tmThing->type != MT_CAMERA &&
+        if(!ctx.thing->player && ctx.thing->type != MT_CAMERA &&
            (xline->flags & ML_BLOCKMONSTERS))
 #elif __JHERETIC__
-        if(!tmThing->player && tmThing->type != MT_POD &&
+        if(!ctx.thing->player && ctx.thing->type != MT_POD &&
            (xline->flags & ML_BLOCKMONSTERS))
 #else
-        if(!tmThing->player &&
+        if(!ctx.thing->player &&
            (xline->flags & ML_BLOCKMONSTERS))
 #endif
         {
 #if __JHEXEN__
-            if(tmThing->flags2 & MF2_BLASTED)
+            if(ctx.thing->flags2 & MF2_BLASTED)
             {
-                P_DamageMobj(tmThing, NULL, NULL, tmThing->info->mass >> 5, false);
+                P_DamageMobj(ctx.thing, NULL, NULL, ctx.thing->info->mass >> 5, false);
             }
 #endif
             return true;
@@ -1055,85 +1101,85 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     }
 
 #if __JDOOM64__
-    if((tmThing->flags & MF_MISSILE) && (xline->flags & ML_BLOCKALL))
+    if((ctx.thing->flags & MF_MISSILE) && (xline->flags & ML_BLOCKALL))
     {
         // $unstuck: allow escape.
-        return !(tmUnstuck && !untouched(ld, tmThing));
+        return !(ctx.unstuck && !untouched(ld, ctx.thing));
     }
 #endif
 
     LineOpening opening; Line_Opening(ld, &opening);
 
     // Adjust floor / ceiling heights.
-    if(opening.top < tmCeilingZ)
+    if(opening.top < ctx.ceilingZ)
     {
-        tmCeilingZ    = opening.top;
-        tmCeilingLine = ld;
+        ctx.ceilingZ    = opening.top;
+        ctx.ceilingLine = ld;
 #if !__JHEXEN__
-        tmBlockingLine     = ld;
+        ctx.blockingLine = ld;
 #endif
     }
-    if(opening.bottom > tmFloorZ)
+    if(opening.bottom > ctx.floorZ)
     {
-        tmFloorZ    = opening.bottom;
-        tmFloorLine = ld;
+        ctx.floorZ    = opening.bottom;
+        ctx.floorLine = ld;
 #if !__JHEXEN__
-        tmBlockingLine   = ld;
+        ctx.blockingLine = ld;
 #endif
     }
-    if(opening.lowFloor < tmDropoffZ)
+    if(opening.lowFloor < ctx.dropoffZ)
     {
-        tmDropoffZ  = opening.lowFloor;
+        ctx.dropoffZ = opening.lowFloor;
     }
 
     // If contacted a special line, add it to the list.
     if(P_ToXLine(ld)->special)
     {
-        IterList_PushBack(spechit, ld);
+        IterList_PushBack(ctx.specHit, ld);
     }
 
 #if !__JHEXEN__
-    tmThing->wallHit = false;
+    ctx.thing->wallHit = false;
 #endif
 
     return false; // Continue iteration.
 }
 
-dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
+static dd_bool checkPosition(MoveContext &ctx, mobj_t *thing, coord_t x, coord_t y, coord_t z)
 {
 #if !__JHEXEN__
     thing->onMobj  = 0;
 #endif
     thing->wallHit = false;
 
-    tmThing         = thing;
-    V3d_Set(tm, x, y, z);
-    tmBox           = AABoxd(tm[VX] - tmThing->radius, tm[VY] - tmThing->radius,
-                             tm[VX] + tmThing->radius, tm[VY] + tmThing->radius);
+    ctx.thing         = thing;
+    V3d_Set(ctx.pos, x, y, z);
+    ctx.box           = AABoxd(ctx.pos[VX] - ctx.thing->radius, ctx.pos[VY] - ctx.thing->radius,
+                               ctx.pos[VX] + ctx.thing->radius, ctx.pos[VY] + ctx.thing->radius);
 #if !__JHEXEN__
-    tmHitLine       = 0;
+    ctx.hitLine       = 0;
 #endif
 
     // The base floor/ceiling is from the BSP leaf that contains the point.
     // Any contacted lines the step closer together will adjust them.
-    Sector *newSector = Sector_AtPoint_FixedPrecision(tm);
+    Sector *newSector = Sector_AtPoint_FixedPrecision(ctx.pos);
 
-    tmCeilingLine   = tmFloorLine = 0;
-    tmFloorZ        = tmDropoffZ = P_GetDoublep(newSector, DMU_FLOOR_HEIGHT);
-    tmCeilingZ      = P_GetDoublep(newSector, DMU_CEILING_HEIGHT);
+    ctx.ceilingLine   = ctx.floorLine = 0;
+    ctx.floorZ        = ctx.dropoffZ = P_GetDoublep(newSector, DMU_FLOOR_HEIGHT);
+    ctx.ceilingZ      = P_GetDoublep(newSector, DMU_CEILING_HEIGHT);
 #if __JHEXEN__
-    tmFloorMaterial = (world_Material *)P_GetPtrp(newSector, DMU_FLOOR_MATERIAL);
+    ctx.floorMaterial = (world_Material *)P_GetPtrp(newSector, DMU_FLOOR_MATERIAL);
 #else
-    tmBlockingLine  = 0;
-    tmUnstuck       = Mobj_IsPlayer(thing) && !Mobj_IsVoodooDoll(thing);
+    ctx.blockingLine  = 0;
+    ctx.unstuck       = Mobj_IsPlayer(thing) && !Mobj_IsVoodooDoll(thing);
 #endif
 
-    IterList_Clear(spechit);
+    IterList_Clear(ctx.specHit);
 
-    if(tmThing->flags & MF_NOCLIP)
+    if(ctx.thing->flags & MF_NOCLIP)
     {
 #if __JHEXEN__
-        if(!(tmThing->flags & MF_SKULLFLY))
+        if(!(ctx.thing->flags & MF_SKULLFLY))
         {
             return true;
         }
@@ -1146,7 +1192,7 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
 
     // Check things first, possibly picking things up;
 #if __JHEXEN__
-    tmBlockingMobj = 0;
+    ctx.blockingMobj = 0;
 #endif
 
     // The camera goes through all objects.
@@ -1157,10 +1203,10 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
          * into mapblocks based on their origin point and can overlap adjacent
          * blocks by up to MAXRADIUS units.
          */
-        AABoxd tmBoxExpanded(tmBox.minX - MAXRADIUS, tmBox.minY - MAXRADIUS,
-                             tmBox.maxX + MAXRADIUS, tmBox.maxY + MAXRADIUS);
+        AABoxd boxExpanded(ctx.box.minX - MAXRADIUS, ctx.box.minY - MAXRADIUS,
+                           ctx.box.maxX + MAXRADIUS, ctx.box.maxY + MAXRADIUS);
 
-        if(Mobj_BoxIterator(&tmBoxExpanded, PIT_CheckThing, 0))
+        if(Mobj_BoxIterator(&boxExpanded, PIT_CheckThing, &ctx))
         {
             return false;
         }
@@ -1176,7 +1222,7 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
     }
 
 #if __JHEXEN__
-    if(tmThing->flags & MF_NOCLIP)
+    if(ctx.thing->flags & MF_NOCLIP)
     {
         return true;
     }
@@ -1184,10 +1230,26 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
 
     // Check lines.
 #if __JHEXEN__
-    tmBlockingMobj = 0;
+    ctx.blockingMobj = 0;
 #endif
 
-    return !Line_BoxIterator(&tmBox, LIF_ALL, PIT_CheckLine, 0);
+    return !Line_BoxIterator(&ctx.box, LIF_ALL, PIT_CheckLine, &ctx);
+}
+
+dd_bool P_CheckPositionWithContext(MoveContext &ctx, mobj_t *thing, coord_t const pos[3])
+{
+    return checkPosition(ctx, thing, pos[VX], pos[VY], pos[VZ]);
+}
+
+dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
+{
+    MoveContext &ctx = defaultMoveContext();
+#if __JHEXEN__
+    ctx.blockingMobj = tmBlockingMobj; // May have been reset by the caller.
+#endif
+    dd_bool const result = checkPosition(ctx, thing, x, y, z);
+    exportMoveResults(ctx);
+    return result;
 }
 
 dd_bool P_CheckPosition(mobj_t *thing, coord_t const pos[3])
@@ -1207,20 +1269,20 @@ dd_bool Mobj_IsRemotePlayer(mobj_t *mo)
 }
 
 #if __JDOOM64__ || __JHERETIC__
-static void checkMissileImpact(mobj_t &mobj)
+static void checkMissileImpact(MoveContext &ctx, mobj_t &mobj)
 {
     if(IS_CLIENT) return;
 
     if(!(mobj.flags & MF_MISSILE)) return;
     if(!mobj.target || !mobj.target->player) return;
 
-    if(IterList_Empty(spechit)) return;
+    if(IterList_Empty(ctx.specHit)) return;
 
-    IterList_SetIteratorDirection(spechit, ITERLIST_BACKWARD);
-    IterList_RewindIterator(spechit);
+    IterList_SetIteratorDirection(ctx.specHit, ITERLIST_BACKWARD);
+    IterList_RewindIterator(ctx.specHit);
 
     Line *line;
-    while((line = (Line *)IterList_MoveIterator(spechit)) != 0)
+    while((line = (Line *)IterList_MoveIterator(ctx.specHit)) != 0)
     {
         P_ActivateLine(line, mobj.target, 0, SPAC_IMPACT);
     }
@@ -1232,41 +1294,41 @@ static void checkMissileImpact(mobj_t &mobj)
  * MF_TELEPORT is set. $dropoff_fix
  */
 #if __JHEXEN__
-static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y)
+static dd_bool P_TryMove2(MoveContext &ctx, mobj_t *thing, coord_t x, coord_t y)
 #else
-static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
+static dd_bool P_TryMove2(MoveContext &ctx, mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 #endif
 {
     dd_bool const isRemotePlayer = Mobj_IsRemotePlayer(thing);
 
-    // $dropoff_fix: tmFellDown.
-    tmFloatOk  = false;
+    // $dropoff_fix: fellDown.
+    ctx.floatOk  = false;
 #if !__JHEXEN__
-    tmFellDown = false;
+    ctx.fellDown = false;
 #endif
 
 #if __JHEXEN__
-    if(!P_CheckPositionXY(thing, x, y))
+    if(!checkPosition(ctx, thing, x, y, DDMAXFLOAT))
 #else
-    if(!P_CheckPositionXYZ(thing, x, y, thing->origin[VZ]))
+    if(!checkPosition(ctx, thing, x, y, thing->origin[VZ]))
 #endif
     {
 #if __JHEXEN__
-        if(!tmBlockingMobj || tmBlockingMobj->player || !thing->player)
+        if(!ctx.blockingMobj || ctx.blockingMobj->player || !thing->player)
         {
             goto pushline;
         }
-        else if(tmBlockingMobj->origin[VZ] + tmBlockingMobj->height - thing->origin[VZ] > 24 ||
-                (P_GetDoublep(Mobj_Sector(tmBlockingMobj), DMU_CEILING_HEIGHT) -
-                 (tmBlockingMobj->origin[VZ] + tmBlockingMobj->height) < thing->height) ||
-                (tmCeilingZ - (tmBlockingMobj->origin[VZ] + tmBlockingMobj->height) <
+        else if(ctx.blockingMobj->origin[VZ] + ctx.blockingMobj->height - thing->origin[VZ] > 24 ||
+                (P_GetDoublep(Mobj_Sector(ctx.blockingMobj), DMU_CEILING_HEIGHT) -
+                 (ctx.blockingMobj->origin[VZ] + ctx.blockingMobj->height) < thing->height) ||
+                (ctx.ceilingZ - (ctx.blockingMobj->origin[VZ] + ctx.blockingMobj->height) <
                  thing->height))
         {
             goto pushline;
         }
 #else
 #  if __JHERETIC__
-        checkMissileImpact(*thing);
+        checkMissileImpact(ctx, *thing);
 #  endif
         // Would we hit another thing or a solid wall?
         if(!thing->onMobj || thing->wallHit)
@@ -1277,15 +1339,15 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
     if(!(thing->flags & MF_NOCLIP))
     {
 #if __JHEXEN__
-        if(tmCeilingZ - tmFloorZ < thing->height)
+        if(ctx.ceilingZ - ctx.floorZ < thing->height)
         {   // Doesn't fit.
             goto pushline;
         }
 
-        tmFloatOk = true;
+        ctx.floatOk = true;
 
         if(!(thing->flags & MF_TELEPORT) &&
-           tmCeilingZ - thing->origin[VZ] < thing->height &&
+           ctx.ceilingZ - thing->origin[VZ] < thing->height &&
            thing->type != MT_LIGHTNING_CEILING && !(thing->flags2 & MF2_FLY))
         {
             // Mobj must lower itself to fit.
@@ -1293,19 +1355,19 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
         }
 #else
         // Possibly allow escape if otherwise stuck.
-        dd_bool ret = (tmUnstuck &&
-            !(tmCeilingLine && untouched(tmCeilingLine, tmThing)) &&
-            !(tmFloorLine   && untouched(tmFloorLine, tmThing)));
+        dd_bool ret = (ctx.unstuck &&
+            !(ctx.ceilingLine && untouched(ctx.ceilingLine, ctx.thing)) &&
+            !(ctx.floorLine   && untouched(ctx.floorLine, ctx.thing)));
 
-        if(tmCeilingZ - tmFloorZ < thing->height)
+        if(ctx.ceilingZ - ctx.floorZ < thing->height)
         {
             return ret; // Doesn't fit.
         }
 
         // Mobj must lower to fit.
-        tmFloatOk = true;
+        ctx.floatOk = true;
         if(!(thing->flags & MF_TELEPORT) && !(thing->flags2 & MF2_FLY) &&
-           tmCeilingZ - thing->origin[VZ] < thing->height)
+           ctx.ceilingZ - thing->origin[VZ] < thing->height)
         {
             return ret;
         }
@@ -1318,24 +1380,24 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 # endif
             )
         {
-            if(!isRemotePlayer && tmFloorZ - thing->origin[VZ] > 24)
+            if(!isRemotePlayer && ctx.floorZ - thing->origin[VZ] > 24)
             {
 # if __JHERETIC__
-                checkMissileImpact(*thing);
+                checkMissileImpact(ctx, *thing);
 # endif
                 return ret;
             }
         }
 # if __JHERETIC__
-        if((thing->flags & MF_MISSILE) && tmFloorZ > thing->origin[VZ])
+        if((thing->flags & MF_MISSILE) && ctx.floorZ > thing->origin[VZ])
         {
-            checkMissileImpact(*thing);
+            checkMissileImpact(ctx, *thing);
         }
 # endif
 #endif
         if(thing->flags2 & MF2_FLY)
         {
-            if(thing->origin[VZ] + thing->height > tmCeilingZ)
+            if(thing->origin[VZ] + thing->height > ctx.ceilingZ)
             {
                 thing->mom[MZ] = -8;
 #if __JHEXEN__
@@ -1344,8 +1406,8 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
                 return false;
 #endif
             }
-            else if(thing->origin[VZ] < tmFloorZ &&
-                    tmFloorZ - tmDropoffZ > 24)
+            else if(thing->origin[VZ] < ctx.floorZ &&
+                    ctx.floorZ - ctx.dropoffZ > 24)
             {
                 thing->mom[MZ] = 8;
 #if __JHEXEN__
@@ -1361,7 +1423,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
            // The Minotaur floor fire (MT_MNTRFX2) can step up any amount
            && thing->type != MT_MNTRFX2 && thing->type != MT_LIGHTNING_FLOOR
            && !isRemotePlayer
-           && tmFloorZ - thing->origin[VZ] > 24)
+           && ctx.floorZ - thing->origin[VZ] > 24)
         {
             goto pushline;
         }
@@ -1369,7 +1431,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 
 #if __JHEXEN__
         if(!(thing->flags & (MF_DROPOFF | MF_FLOAT)) &&
-           (tmFloorZ - tmDropoffZ > 24) &&
+           (ctx.floorZ - ctx.dropoffZ > 24) &&
            !(thing->flags2 & MF2_BLASTED))
         {
             // Can't move over a dropoff unless it's been blasted.
@@ -1388,29 +1450,29 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
             // Dropoff height limit.
             if(cfg.avoidDropoffs)
             {
-                if(tmFloorZ - tmDropoffZ > 24)
+                if(ctx.floorZ - ctx.dropoffZ > 24)
                 {
                     return false; // Don't stand over dropoff.
                 }
             }
             else
             {
-                coord_t floorZ = tmFloorZ;
+                coord_t floorZ = ctx.floorZ;
 
                 if(thing->onMobj)
                 {
                     // Thing is stood on something so use our z position as the floor.
-                    floorZ = (thing->origin[VZ] > tmFloorZ? thing->origin[VZ] : tmFloorZ);
+                    floorZ = (thing->origin[VZ] > ctx.floorZ? thing->origin[VZ] : ctx.floorZ);
                 }
 
                 if(!dropoff)
                 {
-                    if(thing->floorZ - floorZ > 24 || thing->dropOffZ - tmDropoffZ > 24)
+                    if(thing->floorZ - floorZ > 24 || thing->dropOffZ - ctx.dropoffZ > 24)
                         return false;
                 }
                 else
                 {
-                    tmFellDown = !(thing->flags & MF_NOGRAVITY) && thing->origin[VZ] - floorZ > 24;
+                    ctx.fellDown = !(thing->flags & MF_NOGRAVITY) && thing->origin[VZ] - floorZ > 24;
                 }
             }
         }
@@ -1420,10 +1482,10 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
         /// @todo D64 Mother demon fire attack.
         if(!(thing->flags & MF_TELEPORT) /*&& thing->type != MT_SPAWNFIRE*/
             && !isRemotePlayer
-            && tmFloorZ - thing->origin[VZ] > 24)
+            && ctx.floorZ - thing->origin[VZ] > 24)
         {
             // Too big a step up
-            checkMissileImpact(*thing);
+            checkMissileImpact(ctx, *thing);
             return false;
         }
 #endif
@@ -1431,8 +1493,8 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 #if __JHEXEN__
         // Must stay within a sector of a certain floor type?
         if((thing->flags2 & MF2_CANTLEAVEFLOORPIC) &&
-           (tmFloorMaterial != P_GetPtrp(Mobj_Sector(thing), DMU_FLOOR_MATERIAL) ||
-            !FEQUAL(tmFloorZ, thing->origin[VZ])))
+           (ctx.floorMaterial != P_GetPtrp(Mobj_Sector(thing), DMU_FLOOR_MATERIAL) ||
+            !FEQUAL(ctx.floorZ, thing->origin[VZ])))
         {
             return false;
         }
@@ -1441,7 +1503,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 #if !__JHEXEN__
         // $dropoff: prevent falling objects from going up too many steps.
         if(!thing->player && (thing->intFlags & MIF_FALLING) &&
-           tmFloorZ - thing->origin[VZ] > (thing->mom[MX] * thing->mom[MX]) +
+           ctx.floorZ - thing->origin[VZ] > (thing->mom[MX] * thing->mom[MX]) +
                                           (thing->mom[MY] * thing->mom[MY]))
         {
             return false;
@@ -1456,10 +1518,10 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 
     thing->origin[VX] = x;
     thing->origin[VY] = y;
-    thing->floorZ     = tmFloorZ;
-    thing->ceilingZ   = tmCeilingZ;
+    thing->floorZ     = ctx.floorZ;
+    thing->ceilingZ   = ctx.ceilingZ;
 #if __JDOOM__ || __JDOOM64__ || __JHERETIC__
-    thing->dropOffZ   = tmDropoffZ; // $dropoff_fix: keep track of dropoffs.
+    thing->dropOffZ   = ctx.dropoffZ; // $dropoff_fix: keep track of dropoffs.
 #endif
 
     P_MobjLink(thing);
@@ -1482,7 +1544,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
     if(!(thing->flags & (MF_TELEPORT | MF_NOCLIP)))
     {
         Line *line;
-        while((line = (Line *)IterList_Pop(spechit)) != 0)
+        while((line = (Line *)IterList_Pop(ctx.specHit)) != 0)
         {
             // See if the line was crossed.
             if(P_ToXLine(line)->special)
@@ -1528,16 +1590,16 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
   pushline:
     if(!(thing->flags & (MF_TELEPORT | MF_NOCLIP)))
     {
-        if(tmThing->flags2 & MF2_BLASTED)
+        if(ctx.thing->flags2 & MF2_BLASTED)
         {
-            P_DamageMobj(tmThing, NULL, NULL, tmThing->info->mass >> 5, false);
+            P_DamageMobj(ctx.thing, NULL, NULL, ctx.thing->info->mass >> 5, false);
         }
 
-        IterList_SetIteratorDirection(spechit, ITERLIST_BACKWARD);
-        IterList_RewindIterator(spechit);
+        IterList_SetIteratorDirection(ctx.specHit, ITERLIST_BACKWARD);
+        IterList_RewindIterator(ctx.specHit);
 
         Line *line;
-        while((line = (Line *)IterList_MoveIterator(spechit)) != 0)
+        while((line = (Line *)IterList_MoveIterator(ctx.specHit)) != 0)
         {
             // See if the line was crossed.
             int side = Line_PointOnSide(line, thing->origin) < 0;
@@ -1549,22 +1611,23 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 }
 
 #if __JHEXEN__
-dd_bool P_TryMoveXY(mobj_t *thing, coord_t x, coord_t y)
+dd_bool P_TryMoveWithContext(MoveContext &ctx, mobj_t *thing, coord_t x, coord_t y)
 #else
-dd_bool P_TryMoveXY(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff, dd_bool slide)
+dd_bool P_TryMoveWithContext(MoveContext &ctx, mobj_t *thing, coord_t x, coord_t y,
+                             dd_bool dropoff, dd_bool slide)
 #endif
 {
 #if __JHEXEN__
-    return P_TryMove2(thing, x, y);
+    return P_TryMove2(ctx, thing, x, y);
 #else
     // $dropoff_fix
-    dd_bool res = P_TryMove2(thing, x, y, dropoff);
+    dd_bool res = P_TryMove2(ctx, thing, x, y, dropoff);
 
-    if(!res && tmHitLine)
+    if(!res && ctx.hitLine)
     {
         // Move not possible, see if the thing hit a line and send a Hit
         // event to it.
-        XL_HitLine(tmHitLine, Line_PointOnSide(tmHitLine, thing->origin) < 0,
+        XL_HitLine(ctx.hitLine, Line_PointOnSide(ctx.hitLine, thing->origin) < 0,
                    thing);
     }
 
@@ -1577,6 +1640,23 @@ dd_bool P_TryMoveXY(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff, dd_boo
 #endif
 }
 
+#if __JHEXEN__
+dd_bool P_TryMoveXY(mobj_t *thing, coord_t x, coord_t y)
+#else
+dd_bool P_TryMoveXY(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff, dd_bool slide)
+#endif
+{
+    MoveContext &ctx = defaultMoveContext();
+#if __JHEXEN__
+    ctx.blockingMobj = tmBlockingMobj; // May have been reset by the caller.
+    dd_bool const result = P_TryMoveWithContext(ctx, thing, x, y);
+#else
+    dd_bool const result = P_TryMoveWithContext(ctx, thing, x, y, dropoff, slide);
+#endif
+    exportMoveResults(ctx);
+    return result;
+}
+
 dd_bool P_TryMoveXYZ(mobj_t* thing, coord_t x, coord_t y, coord_t z)
 {
     coord_t const oldZ = thing->origin[VZ];
@@ -2685,10 +2765,11 @@ static int PIT_ChangeSector(mobj_t *thing, void *context)
         bool const onfloor = (thing->origin[VZ] == thing->floorZ);
 
         P_CheckPosition(thing, thing->origin);
-        thing->floorZ   = tmFloorZ;
-        thing->ceilingZ = tmCeilingZ;
+        MoveContext const &ctx = defaultMoveContext();
+        thing->floorZ   = ctx.floorZ;
+        thing->ceilingZ = ctx.ceilingZ;
 #if !__JHEXEN__
-        thing->dropOffZ = tmDropoffZ; // $dropoff_fix: remember dropoffs.
+        thing->dropOffZ = ctx.dropoffZ; // $dropoff_fix: remember dropoffs.
 #endif
 
         if(onfloor)
@@ -1054,45 +1054,36 @@ int XL_TraversePlanes(Line *line, int refType, int ref, void *data, void *contex
     // References to multiple planes
     if(findSecTagged)
     {
-        // Use tagged sector lists for these (speed).
-        if(iterlist_t *list = P_GetSectorIterListForTag(tag, false))
+        // Sectors without a tag are never referenced.
+        if(tag)
         {
-            // Find the first sector with the tag.
-            IterList_SetIteratorDirection(list, ITERLIST_FORWARD);
-            IterList_RewindIterator(list);
+            bool const ceilings = (refType == LPREF_TAGGED_CEILINGS ||
+                                   refType == LPREF_LINE_TAGGED_CEILINGS);
 
-            Sector *sec;
-            while((sec = (Sector *)IterList_MoveIterator(list)) != NULL)
+            for(Sector *sec : P_SectorsWithTag(tag))
             {
-                //xsector_t *xsec = P_ToXSector(sec);
-
-                if(refType == LPREF_TAGGED_FLOORS || refType == LPREF_TAGGED_CEILINGS)
+                if(!func(sec, ceilings, data, context, activator))
                 {
-                    if(!func(sec, refType == LPREF_TAGGED_CEILINGS, data,
-                             context, activator))
-                    {
-                        return false;
-                    }
-                }
-
-                if(refType == LPREF_LINE_TAGGED_FLOORS ||
-                   refType == LPREF_LINE_TAGGED_CEILINGS)
-                {
-                    if(!func(sec, refType == LPREF_LINE_TAGGED_CEILINGS,
-                             data, context, activator))
-                    {
-                        return false;
-                    }
+                    return false;
                 }
             }
         }
     }
+    else if(refType == LPREF_ACT_TAGGED_FLOORS || refType == LPREF_ACT_TAGGED_CEILINGS)
+    {
+        for(Sector *sec : P_SectorsWithActTag(ref))
+        {
+            if(!func(sec, refType == LPREF_ACT_TAGGED_CEILINGS, data, context, activator))
+            {
+                return false;
+            }
+        }
+    }
     else
     {
         for(int i = 0; i < numsectors; ++i)
         {
-            Sector *sec     = (Sector *)P_ToPtr(DMU_SECTOR, i);
-            xsector_t *xsec = P_ToXSector(sec);
+            Sector *sec = (Sector *)P_ToPtr(DMU_SECTOR, i);
 
             if(refType == LPREF_ALL_FLOORS || refType == LPREF_ALL_CEILINGS)
             {
@@ -1103,17 +1094,6 @@ int XL_TraversePlanes(Line *line, int refType, int ref, void *data, void *contex
                 }
             }
 
-            if((refType == LPREF_ACT_TAGGED_FLOORS ||
-                refType == LPREF_ACT_TAGGED_CEILINGS) && xsec->xg &&
-                xsec->xg->info.actTag == ref)
-            {
-                if(!func(sec, refType == LPREF_ACT_TAGGED_CEILINGS, data,
-                   context, activator))
-                {
-                   return false;
-                }
-            }
-
             // Reference all sectors with (at least) one mobj of specified
             // type inside.
             if(refType == LPREF_THING_EXIST_FLOORS ||
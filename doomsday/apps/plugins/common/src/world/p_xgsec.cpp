@@ -372,6 +372,9 @@ void XS_SetSectorType(Sector *sec, int special)
         // or anything.
         xsec->special = special;
     }
+
+    // The act tag may have changed.
+    P_SectorTagsChanged();
 }
 
 void XS_Init()
@@ -817,56 +820,23 @@ int XS_TextureHeight(Line* line, int part)
 /**
  * Returns a pointer to the first sector with the tag.
  *
- * NOTE: We cannot use the tagged sector lists here as this can be called
- * during an iteration at a higher level. Doing so would change the position
- * of the rover which would affect the other iteration.
- *
- * NOTE2: Re-above, obviously that is bad design and should be addressed.
+ * Uses the sector tag index, so this can be called during an iteration at a
+ * higher level.
  */
 Sector *XS_FindTagged(int tag)
 {
     LOG_AS("XS_FindTagged");
 
-    int k;
-    int foundcount = 0;
-    int retsectorid = 0;
-    Sector *sec, *retsector;
-
-    retsector = NULL;
+    SectorTagRange const tagged = P_SectorsWithTag(tag);
 
-    for(k = 0; k < numsectors; ++k)
+    if(xgDev && tagged.size() > 1)
     {
-        sec = (Sector *) P_ToPtr(DMU_SECTOR, k);
-        if(P_ToXSector(sec)->tag == tag)
-        {
-            if(xgDev)
-            {
-                if(foundcount == 0)
-                {
-                    retsector = sec;
-                    retsectorid = k;
-                }
-            }
-            else
-                return sec;
-
-            foundcount++;
-        }
+        LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this tag (%i)!", tag);
+        LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used",
+                               P_ToIndex(tagged.first()));
     }
 
-    if(xgDev)
-    {
-        if(foundcount > 1)
-        {
-            LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this tag (%i)!", tag);
-            LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used", retsectorid);
-        }
-
-        if(retsector)
-            return retsector;
-    }
-
-    return NULL;
+    return tagged.first();
 }
 
 /**
@@ -876,53 +846,16 @@ Sector *XS_FindActTagged(int tag)
 {
     LOG_AS("XS_FindActTagged");
 
-    int k;
-    int foundcount = 0;
-    int retsectorid = 0;
-    Sector *sec, *retsector;
-    xsector_t *xsec;
-
-    retsector = NULL;
+    SectorTagRange const tagged = P_SectorsWithActTag(tag);
 
-    for(k = 0; k < numsectors; ++k)
+    if(xgDev && tagged.size() > 1)
     {
-        sec = (Sector *) P_ToPtr(DMU_SECTOR, k);
-        xsec = P_ToXSector(sec);
-        if(xsec->xg)
-        {
-            if(xsec->xg->info.actTag == tag)
-            {
-                if(xgDev)
-                {
-                    if(foundcount == 0)
-                    {
-                        retsector = sec;
-                        retsectorid = k;
-                    }
-                }
-                else
-                {
-                    return sec;
-                }
-
-                foundcount++;
-            }
-        }
+        LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this ACT tag (%i)!", tag);
+        LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used",
+                               P_ToIndex(tagged.first()));
     }
 
-    if(xgDev)
-    {
-        if(foundcount > 1)
-        {
-            LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this ACT tag (%i)!", tag);
-            LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used", retsectorid);
-        }
-
-        if(retsector)
-            return retsector;
-    }
-
-    return NULL;
+    return tagged.first();
 }
 
 #define FSETHF_MIN          0x1 // Get min. If not set, get max.
@@ -3055,6 +2988,11 @@ void XS_Update(void)
             xsec->special = 0;
         }
     }
+
+    // The act tag index only contains sectors that have XG and was built from
+    // xg->info.actTag. Without a rebuild, XS_FindActTagged() would keep returning
+    // sectors whose xg has just been cleared.
+    P_SectorTagsChanged();
 }
 
 /**
@@ -3110,19 +3048,13 @@ D_CMD(MovePlane)
     else if(!stricmp(argv[1], "tag") && argc >= 3)
     {
         int tag = (short) strtol(argv[2], 0, 0);
-        Sector* sec = NULL;
-        iterlist_t* list;
 
         p = 3;
-        list = P_GetSectorIterListForTag(tag, false);
-        if(list)
+        if(tag)
         {   // Find the first sector with the tag.
-            IterList_SetIteratorDirection(list, ITERLIST_FORWARD);
-            IterList_RewindIterator(list);
-            while((sec = (Sector *) IterList_MoveIterator(list)) != NULL)
+            if(Sector *sec = P_SectorsWithTag(tag).first())
             {
                 sector = sec;
-                break;
             }
         }
     }
@@ -1089,32 +1089,36 @@ DENG2_PIMPL(MapImporter)
         if(things.empty()) return;
 
         LOGDEV_MAP_XVERBOSE("Transfering things...", "");
-        DENG2_FOR_EACH(Things, i, things)
+
+        // Properties are transferred one column at a time for all things.
+        dint const count = dint(things.size());
+        Thing const &first = things.front();
+        auto transfer = [&count] (char const *propertyName, valuetype_t type, void const *firstValue)
         {
-            dint idx = i - things.begin();
+            MPE_GameObjPropertyv("Thing", 0, count, propertyName, type, firstValue, dint(sizeof(Thing)));
+        };
 
-            MPE_GameObjProperty("Thing", idx, "X",            DDVT_SHORT, &i->origin[VX]);
-            MPE_GameObjProperty("Thing", idx, "Y",            DDVT_SHORT, &i->origin[VY]);
-            MPE_GameObjProperty("Thing", idx, "Z",            DDVT_SHORT, &i->origin[VZ]);
-            MPE_GameObjProperty("Thing", idx, "Angle",        DDVT_ANGLE, &i->angle);
-            MPE_GameObjProperty("Thing", idx, "DoomEdNum",    DDVT_SHORT, &i->doomEdNum);
-            MPE_GameObjProperty("Thing", idx, "SkillModes",   DDVT_INT,   &i->skillModes);
-            MPE_GameObjProperty("Thing", idx, "Flags",        DDVT_INT,   &i->flags);
+        transfer("X",                 DDVT_SHORT, &first.origin[VX]);
+        transfer("Y",                 DDVT_SHORT, &first.origin[VY]);
+        transfer("Z",                 DDVT_SHORT, &first.origin[VZ]);
+        transfer("Angle",             DDVT_ANGLE, &first.angle);
+        transfer("DoomEdNum",         DDVT_SHORT, &first.doomEdNum);
+        transfer("SkillModes",        DDVT_INT,   &first.skillModes);
+        transfer("Flags",             DDVT_INT,   &first.flags);
 
-            if(format == Id1MapRecognizer::Doom64Format)
-            {
-                MPE_GameObjProperty("Thing", idx, "ID",       DDVT_SHORT, &i->d64TID);
-            }
-            else if(format == Id1MapRecognizer::HexenFormat)
-            {
-                MPE_GameObjProperty("Thing", idx, "Special",  DDVT_BYTE,  &i->xSpecial);
-                MPE_GameObjProperty("Thing", idx, "ID",       DDVT_SHORT, &i->xTID);
-                MPE_GameObjProperty("Thing", idx, "Arg0",     DDVT_BYTE,  &i->xArgs[0]);
-                MPE_GameObjProperty("Thing", idx, "Arg1",     DDVT_BYTE,  &i->xArgs[1]);
-                MPE_GameObjProperty("Thing", idx, "Arg2",     DDVT_BYTE,  &i->xArgs[2]);
-                MPE_GameObjProperty("Thing", idx, "Arg3",     DDVT_BYTE,  &i->xArgs[3]);
-                MPE_GameObjProperty("Thing", idx, "Arg4",     DDVT_BYTE,  &i->xArgs[4]);
-            }
+        if(format == Id1MapRecognizer::Doom64Format)
+        {
+            transfer("ID",            DDVT_SHORT, &first.d64TID);
+        }
+        else if(format == Id1MapRecognizer::HexenFormat)
+        {
+            transfer("Special",       DDVT_BYTE,  &first.xSpecial);
+            transfer("ID",            DDVT_SHORT, &first.xTID);
+            transfer("Arg0",          DDVT_BYTE,  &first.xArgs[0]);
+            transfer("Arg1",          DDVT_BYTE,  &first.xArgs[1]);
+            transfer("Arg2",          DDVT_BYTE,  &first.xArgs[2]);
+            transfer("Arg3",          DDVT_BYTE,  &first.xArgs[3]);
+            transfer("Arg4",          DDVT_BYTE,  &first.xArgs[4]);
         }
     }
 
@@ -0,0 +1,173 @@
+/** @file udmfstreamparser.h  Streaming UDMF parser.
+ *
+ * @authors Copyright (c) 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef IMPORTUDMF_UDMFSTREAMPARSER_H
+#define IMPORTUDMF_UDMFSTREAMPARSER_H
+
+#include <de/Block>
+#include <de/Error>
+#include <de/String>
+#include <functional>
+
+/**
+ * UDMF parser that operates directly on the UTF-8 source bytes.
+ *
+ * Unlike UDMFParser, the source is not converted to a string nor tokenized into a
+ * separate buffer. Keys are identified by a perfect hash of the known UDMF keys and
+ * values are stored in typed form, referring to the source bytes where text is
+ * concerned. Assignments of unknown keys are syntax checked but otherwise ignored.
+ *
+ * Large sources are split into chunks at top-level block boundaries, and the chunks
+ * are parsed concurrently. The handlers are always called on the calling thread in
+ * the order in which the blocks and assignments appear in the source.
+ */
+class UDMFStreamParser
+{
+public:
+    DENG2_ERROR(SyntaxError);
+
+    enum BlockType {
+        UnknownBlock,
+        ThingBlock,
+        VertexBlock,
+        LinedefBlock,
+        SidedefBlock,
+        SectorBlock
+    };
+
+    /// Known keys.
+    enum Key {
+        UnknownKey = -1,
+        Namespace,
+        // Common:
+        Id, Special, Arg0, Arg1, Arg2, Arg3, Arg4,
+        // Things and vertices:
+        X, Y, Z, Angle, Type,
+        Ambush, Single, Dm, Coop, Friend, Dormant, Class1, Class2, Class3,
+        Standing, StrifeAlly, Translucent, Invisible,
+        Skill1, Skill2, Skill3, Skill4, Skill5,
+        // Linedefs:
+        V1, V2, SideFront, SideBack, Blocking, DontPegTop, DontPegBottom, TwoSided,
+        // Sidedefs:
+        Sector, OffsetX, OffsetY, TextureTop, TextureMiddle, TextureBottom,
+        // Sectors:
+        LightLevel, HeightFloor, HeightCeiling, TextureFloor, TextureCeiling,
+
+        KeyCount
+    };
+
+    /**
+     * Assigned value. Text values refer to the source bytes, so they are only valid
+     * during the handler callbacks.
+     */
+    struct Value
+    {
+        enum Kind { None, Integer, Number, Boolean, Text };
+
+        Kind kind;
+        union {
+            de::dint64  integer;
+            de::ddouble number;
+            bool        boolean;
+        };
+        char const *text;       ///< Quoted string contents or identifier (not terminated).
+        de::dsize textLength;
+        bool textEscaped;       ///< Text contains escape sequences.
+
+        Value();
+
+        bool isNone() const { return kind == None; }
+        de::dint    toInt() const;
+        de::ddouble toDouble() const;
+        bool        toBool() const;
+        de::String  toString() const;
+    };
+
+    struct Assignment
+    {
+        Key key;
+        Value value;
+    };
+
+    /**
+     * View of the known assignments of a block.
+     */
+    class Block
+    {
+    public:
+        Block(BlockType type, Assignment const *begin, Assignment const *end);
+
+        BlockType type() const;
+        bool contains(Key key) const;
+
+        /**
+         * Returns the value assigned to @a key. If the key has been assigned more than
+         * once, the last assignment applies. If the key has not been assigned, the
+         * returned value is None.
+         */
+        Value const &operator [] (Key key) const;
+
+    private:
+        BlockType _type;
+        Assignment const *_begin;
+        Assignment const *_end;
+    };
+
+    typedef std::function<void (Key, Value const &)> AssignmentFunc;
+    typedef std::function<void (Block const &)> BlockFunc;
+
+public:
+    UDMFStreamParser();
+
+    void setGlobalAssignmentHandler(AssignmentFunc func);
+    void setBlockHandler(BlockFunc func);
+
+    /**
+     * Sets whether large sources are split into chunks that are parsed concurrently.
+     * This is enabled by default.
+     */
+    void setConcurrent(bool enabled);
+
+    /**
+     * Parse UDMF source and make callbacks for global assignments and blocks.
+     *
+     * @param source  UDMF source text (UTF-8).
+     *
+     * @throws SyntaxError  UDMF source text has a syntax error.
+     */
+    void parse(de::Block const &source);
+
+    /// Number of blocks parsed by the latest call to parse().
+    int blockCount() const;
+
+    /// Number of chunks the source was split into in the latest call to parse().
+    int chunkCount() const;
+
+    /**
+     * Identifies a known key.
+     *
+     * @param name    Key name (case insensitive).
+     * @param length  Length of the name in bytes.
+     */
+    static Key keyForName(char const *name, de::dsize length);
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+#endif // IMPORTUDMF_UDMFSTREAMPARSER_H
@@ -18,20 +18,21 @@
  */
 
 #include "importudmf.h"
-#include "udmfparser.h"
+#include "udmfstreamparser.h"
+#ifdef DENG_IMPORTUDMF_DEBUG
+#  include "udmfparser.h"
+#endif
 
 #include <doomsday/filesys/lumpindex.h>
 #include <gamefw/mapspot.h>
 #include <de/App>
 #include <de/Log>
+#include <de/Time>
+#include <vector>
 
 using namespace de;
 
-template <valuetype_t VALUE_TYPE, typename Type>
-void gmoSetThingProperty(int index, char const *propertyId, Type value)
-{
-    MPE_GameObjProperty("Thing", index, propertyId, VALUE_TYPE, &value);
-}
+typedef UDMFStreamParser Parser;
 
 template <valuetype_t VALUE_TYPE, typename Type>
 void gmoSetSectorProperty(int index, char const *propertyId, Type value)
@@ -45,6 +46,152 @@ void gmoSetLineProperty(int index, char const *propertyId, Type value)
     MPE_GameObjProperty("XLinedef", index, propertyId, VALUE_TYPE, &value);
 }
 
+namespace {
+
+struct ThingData
+{
+    double x;
+    double y;
+    double z;
+    angle_t angle;
+    int doomEdNum;
+    int flags;
+    int skillModes;
+    int id;
+    int special;
+    int args[5];
+};
+
+struct LinedefData
+{
+    int v1;
+    int v2;
+    int sideFront;
+    int sideBack;
+    bool blocking;
+    bool dontPegTop;
+    bool dontPegBottom;
+    bool twoSided;
+    int special;
+    int id;
+    bool hasId;
+    int args[5];
+};
+
+struct SidedefData
+{
+    int sector;
+    int offsetX;
+    int offsetY;
+    String textureTop;
+    String textureMiddle;
+    String textureBottom;
+};
+
+} // namespace
+
+/**
+ * Transfers the collected things to the map editor one property at a time.
+ */
+static void transferThings(std::vector<ThingData> const &things, bool isHexen, bool isDoom64)
+{
+    if (things.empty()) return;
+
+    int const count = int(things.size());
+    ThingData const &first = things.front();
+    auto transfer = [&count] (char const *propertyName, valuetype_t type, void const *firstValue)
+    {
+        MPE_GameObjPropertyv("Thing", 0, count, propertyName, type, firstValue, int(sizeof(ThingData)));
+    };
+
+    // Properties common to all games.
+    transfer("X",          DDVT_DOUBLE, &first.x);
+    transfer("Y",          DDVT_DOUBLE, &first.y);
+    transfer("Z",          DDVT_DOUBLE, &first.z);
+    transfer("Angle",      DDVT_ANGLE,  &first.angle);
+    transfer("DoomEdNum",  DDVT_INT,    &first.doomEdNum);
+    transfer("Flags",      DDVT_INT,    &first.flags);
+    transfer("SkillModes", DDVT_INT,    &first.skillModes);
+
+    if (isHexen || isDoom64)
+    {
+        transfer("ID",      DDVT_INT,   &first.id);
+    }
+    if (isHexen)
+    {
+        transfer("Special", DDVT_INT,   &first.special);
+        transfer("Arg0",    DDVT_INT,   &first.args[0]);
+        transfer("Arg1",    DDVT_INT,   &first.args[1]);
+        transfer("Arg2",    DDVT_INT,   &first.args[2]);
+        transfer("Arg3",    DDVT_INT,   &first.args[3]);
+        transfer("Arg4",    DDVT_INT,   &first.args[4]);
+    }
+}
+
+#ifdef DENG_IMPORTUDMF_DEBUG
+/**
+ * Parses the source with the token-based UDMFParser to compare its performance
+ * with UDMFStreamParser. Enabled with the "-udmfcompare" command line option.
+ */
+static void compareWithTokenParser(Block const &source, TimeSpan streamParseTime)
+{
+    Time startedAt;
+    int blockCount = 0;
+    UDMFParser tokenParser;
+    tokenParser.setBlockHandler([&blockCount] (String const &, UDMFParser::Block const &)
+    {
+        blockCount++;
+    });
+    tokenParser.parse(String::fromUtf8(source));
+    LOGDEV_MAP_MSG("UDMFParser: %i blocks in %.3f seconds (stream parser: %.3f seconds)")
+            << blockCount << startedAt.since() << streamParseTime;
+}
+
+/**
+ * Generates a synthetic TEXTMAP with @a count blocks of each type and measures how
+ * long the different parsers take to parse it. Enabled with the "-udmfbench"
+ * command line option.
+ */
+static void benchmarkSyntheticTextmap(int count)
+{
+    QByteArray text = "namespace = \"hexen\";\n";
+    for (int i = 0; i < count; ++i)
+    {
+        text += QString("thing { x = %1.5; y = %2.0; type = 3004; angle = 90; skill1 = true; "
+                        "skill2 = true; single = true; id = %3; special = 0; }\n"
+                        "vertex { x = %1.0; y = -%2.0; }\n"
+                        "linedef { v1 = %3; v2 = %4; sidefront = %3; blocking = true; "
+                        "special = 80; arg0 = 1; } // Comment.\n"
+                        "sidedef { sector = %3; texturemiddle = \"STARTAN2\"; offsetx = 16; }\n"
+                        "sector { heightfloor = 0; heightceiling = 128; texturefloor = \"FLOOR4_8\"; "
+                        "textureceiling = \"CEIL3_5\"; lightlevel = 192; }\n")
+                .arg(i % 4096).arg(i / 4096).arg(i).arg(i + 1).toLatin1();
+    }
+    Block const source(text);
+
+    auto timeStreamParser = [&source] (bool concurrent) -> TimeSpan
+    {
+        Time startedAt;
+        UDMFStreamParser parser;
+        parser.setConcurrent(concurrent);
+        parser.parse(source);
+        return startedAt.since();
+    };
+
+    TimeSpan const concurrentTime = timeStreamParser(true);
+    TimeSpan const serialTime     = timeStreamParser(false);
+
+    Time startedAt;
+    UDMFParser tokenParser;
+    tokenParser.parse(String::fromUtf8(source));
+    TimeSpan const tokenTime = startedAt.since();
+
+    LOG_MAP_NOTE("UDMF benchmark (%i bytes, %i blocks): UDMFParser %.3f s, "
+                 "UDMFStreamParser %.3f s (serial %.3f s)")
+            << source.size() << count * 5 << tokenTime << concurrentTime << serialTime;
+}
+#endif
+
 /**
  * This function will be called when Doomsday is asked to load a map that is not
  * available in its native map format.
@@ -67,25 +214,25 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                 src->read(bytes.data(), false);
 
                 // Parse the UDMF source and use the MPE API to create the map elements.
-                UDMFParser parser;
+                Parser parser;
 
                 struct ImportState
                 {
                     bool isHexen = false;
                     bool isDoom64 = false;
 
-                    int thingCount = 0;
-                    int vertexCount = 0;
                     int sectorCount = 0;
 
-                    QList<UDMFParser::Block> linedefs;
-                    QList<UDMFParser::Block> sidedefs;
+                    std::vector<ThingData> things;
+                    std::vector<coord_t> vertexCoords;
+                    std::vector<LinedefData> linedefs;
+                    std::vector<SidedefData> sidedefs;
                 };
                 ImportState importState;
 
-                parser.setGlobalAssignmentHandler([&importState] (String const &ident, QVariant const &value)
+                parser.setGlobalAssignmentHandler([&importState] (Parser::Key key, Parser::Value const &value)
                 {
-                    if (ident == UDMFLex::NAMESPACE)
+                    if (key == Parser::Namespace)
                     {
                         LOG_MAP_VERBOSE("UDMF namespace: %s") << value.toString();
                         String const ns = value.toString().toLower();
@@ -100,94 +247,121 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                     }
                 });
 
-                parser.setBlockHandler([&importState] (String const &type, UDMFParser::Block const &block)
+                parser.setBlockHandler([&importState] (Parser::Block const &block)
                 {
-                    if (type == UDMFLex::THING)
+                    switch (block.type())
                     {
-                        int const index = importState.thingCount++;
+                    case Parser::ThingBlock: {
+                        ThingData thing;
 
-                        // Properties common to all games.
-                        gmoSetThingProperty<DDVT_DOUBLE>(index, "X", block["x"].toDouble());
-                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Y", block["y"].toDouble());
-                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Z", block["z"].toDouble());
-                        gmoSetThingProperty<DDVT_ANGLE>(index, "Angle", angle_t(double(block["angle"].toInt()) / 180.0 * ANGLE_180));
-                        gmoSetThingProperty<DDVT_INT>(index, "DoomEdNum", block["type"].toInt());
+                        thing.x         = block[Parser::X].toDouble();
+                        thing.y         = block[Parser::Y].toDouble();
+                        thing.z         = block[Parser::Z].toDouble();
+                        thing.angle     = angle_t(double(block[Parser::Angle].toInt()) / 180.0 * ANGLE_180);
+                        thing.doomEdNum = block[Parser::Type].toInt();
 
                         // Map spot flags.
                         {
                             gfw_mapspot_flags_t gfwFlags = 0;
 
-                            if (block["ambush"].toBool())      gfwFlags |= GFW_MAPSPOT_DEAF;
-                            if (block["single"].toBool())      gfwFlags |= GFW_MAPSPOT_SINGLE;
-                            if (block["dm"].toBool())          gfwFlags |= GFW_MAPSPOT_DM;
-                            if (block["coop"].toBool())        gfwFlags |= GFW_MAPSPOT_COOP;
-                            if (block["friend"].toBool())      gfwFlags |= GFW_MAPSPOT_MBF_FRIEND;
-                            if (block["dormant"].toBool())     gfwFlags |= GFW_MAPSPOT_DORMANT;
-                            if (block["class1"].toBool())      gfwFlags |= GFW_MAPSPOT_CLASS1;
-                            if (block["class2"].toBool())      gfwFlags |= GFW_MAPSPOT_CLASS2;
-                            if (block["class3"].toBool())      gfwFlags |= GFW_MAPSPOT_CLASS3;
-                            if (block["standing"].toBool())    gfwFlags |= GFW_MAPSPOT_STANDING;
-                            if (block["strifeally"].toBool())  gfwFlags |= GFW_MAPSPOT_STRIFE_ALLY;
-                            if (block["translucent"].toBool()) gfwFlags |= GFW_MAPSPOT_TRANSLUCENT;
-                            if (block["invisible"].toBool())   gfwFlags |= GFW_MAPSPOT_INVISIBLE;
-
-                            gmoSetThingProperty<DDVT_INT>(index, "Flags",
-                                    gfw_MapSpot_TranslateFlagsToInternal(gfwFlags));
+                            if (block[Parser::Ambush].toBool())      gfwFlags |= GFW_MAPSPOT_DEAF;
+                            if (block[Parser::Single].toBool())      gfwFlags |= GFW_MAPSPOT_SINGLE;
+                            if (block[Parser::Dm].toBool())          gfwFlags |= GFW_MAPSPOT_DM;
+                            if (block[Parser::Coop].toBool())        gfwFlags |= GFW_MAPSPOT_COOP;
+                            if (block[Parser::Friend].toBool())      gfwFlags |= GFW_MAPSPOT_MBF_FRIEND;
+                            if (block[Parser::Dormant].toBool())     gfwFlags |= GFW_MAPSPOT_DORMANT;
+                            if (block[Parser::Class1].toBool())      gfwFlags |= GFW_MAPSPOT_CLASS1;
+                            if (block[Parser::Class2].toBool())      gfwFlags |= GFW_MAPSPOT_CLASS2;
+                            if (block[Parser::Class3].toBool())      gfwFlags |= GFW_MAPSPOT_CLASS3;
+                            if (block[Parser::Standing].toBool())    gfwFlags |= GFW_MAPSPOT_STANDING;
+                            if (block[Parser::StrifeAlly].toBool())  gfwFlags |= GFW_MAPSPOT_STRIFE_ALLY;
+                            if (block[Parser::Translucent].toBool()) gfwFlags |= GFW_MAPSPOT_TRANSLUCENT;
+                            if (block[Parser::Invisible].toBool())   gfwFlags |= GFW_MAPSPOT_INVISIBLE;
+
+                            thing.flags = gfw_MapSpot_TranslateFlagsToInternal(gfwFlags);
                         }
 
                         // Skill level bits.
                         {
-                            static String const labels[5] = {
-                                "skill1", "skill2", "skill3", "skill4", "skill5",
+                            static Parser::Key const skillKeys[5] = {
+                                Parser::Skill1, Parser::Skill2, Parser::Skill3, Parser::Skill4, Parser::Skill5,
                             };
-                            int skillModes = 0;
+                            thing.skillModes = 0;
                             for (int skill = 0; skill < 5; ++skill)
                             {
-                                if (block[labels[skill]].toBool())
-                                    skillModes |= 1 << skill;
+                                if (block[skillKeys[skill]].toBool())
+                                    thing.skillModes |= 1 << skill;
                             }
-                            gmoSetThingProperty<DDVT_INT>(index, "SkillModes", skillModes);
                         }
 
-                        if (importState.isHexen || importState.isDoom64)
-                        {
-                            gmoSetThingProperty<DDVT_INT>(index, "ID", block["id"].toInt());
-                        }
-                        if (importState.isHexen)
-                        {
-                            gmoSetThingProperty<DDVT_INT>(index, "Special", block["special"].toInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg0", block["arg0"].toInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg1", block["arg1"].toInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg2", block["arg2"].toInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg3", block["arg3"].toInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg4", block["arg4"].toInt());
-                        }
-                    }
-                    else if (type == UDMFLex::VERTEX)
-                    {
-                        int const index = importState.vertexCount++;
-
-                        MPE_VertexCreate(block["x"].toDouble(), block["y"].toDouble(), index);
-                    }
-                    else if (type == UDMFLex::LINEDEF)
-                    {
-                        importState.linedefs.append(block);
-                    }
-                    else if (type == UDMFLex::SIDEDEF)
-                    {
-                        importState.sidedefs.append(block);
-                    }
-                    else if (type == UDMFLex::SECTOR)
-                    {
+                        thing.id      = block[Parser::Id].toInt();
+                        thing.special = block[Parser::Special].toInt();
+                        thing.args[0] = block[Parser::Arg0].toInt();
+                        thing.args[1] = block[Parser::Arg1].toInt();
+                        thing.args[2] = block[Parser::Arg2].toInt();
+                        thing.args[3] = block[Parser::Arg3].toInt();
+                        thing.args[4] = block[Parser::Arg4].toInt();
+
+                        importState.things.push_back(thing);
+                        break; }
+
+                    case Parser::VertexBlock:
+                        importState.vertexCoords.push_back(block[Parser::X].toDouble());
+                        importState.vertexCoords.push_back(block[Parser::Y].toDouble());
+                        break;
+
+                    case Parser::LinedefBlock: {
+                        LinedefData line;
+
+                        line.v1            = block[Parser::V1].toInt();
+                        line.v2            = block[Parser::V2].toInt();
+                        line.sideFront     = block[Parser::SideFront].toInt();
+                        line.sideBack      = block.contains(Parser::SideBack)? block[Parser::SideBack].toInt() : -1;
+                        line.blocking      = block[Parser::Blocking].toBool();
+                        line.dontPegTop    = block[Parser::DontPegTop].toBool();
+                        line.dontPegBottom = block[Parser::DontPegBottom].toBool();
+                        line.twoSided      = block[Parser::TwoSided].toBool();
+                        line.special       = block[Parser::Special].toInt();
+                        line.hasId         = block.contains(Parser::Id);
+                        line.id            = block[Parser::Id].toInt();
+                        line.args[0]       = block[Parser::Arg0].toInt();
+                        line.args[1]       = block[Parser::Arg1].toInt();
+                        line.args[2]       = block[Parser::Arg2].toInt();
+                        line.args[3]       = block[Parser::Arg3].toInt();
+                        line.args[4]       = block[Parser::Arg4].toInt();
+
+                        importState.linedefs.push_back(line);
+                        break; }
+
+                    case Parser::SidedefBlock: {
+                        auto texName = [] (Parser::Value const &tex) -> String {
+                            String const name = tex.toString();
+                            if (name.isEmpty()) return String();
+                            return "Textures:" + name;
+                        };
+
+                        SidedefData side;
+
+                        side.sector        = block[Parser::Sector].toInt();
+                        side.offsetX       = block[Parser::OffsetX].toInt();
+                        side.offsetY       = block[Parser::OffsetY].toInt();
+                        side.textureTop    = texName(block[Parser::TextureTop]);
+                        side.textureMiddle = texName(block[Parser::TextureMiddle]);
+                        side.textureBottom = texName(block[Parser::TextureBottom]);
+
+                        importState.sidedefs.push_back(side);
+                        break; }
+
+                    case Parser::SectorBlock: {
                         int const index = importState.sectorCount++;
 
-                        int lightlevel = block.contains("lightlevel")? block["lightlevel"].toInt() : 160;
+                        int lightlevel = block.contains(Parser::LightLevel)? block[Parser::LightLevel].toInt() : 160;
 
                         MPE_SectorCreate(float(lightlevel)/255.f, 1.f, 1.f, 1.f, index);
 
                         MPE_PlaneCreate(index,
-                                        block["heightfloor"].toDouble(),
-                                        de::Str("Flats:" + block["texturefloor"].toString()),
+                                        block[Parser::HeightFloor].toDouble(),
+                                        de::Str("Flats:" + block[Parser::TextureFloor].toString()),
                                         0.f, 0.f,
                                         1.f, 1.f, 1.f,  // color
                                         1.f,            // opacity
@@ -195,97 +369,136 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                                         -1);            // index in archive
 
                         MPE_PlaneCreate(index,
-                                        block["heightceiling"].toDouble(),
-                                        de::Str("Flats:" + block["textureceiling"].toString()),
+                                        block[Parser::HeightCeiling].toDouble(),
+                                        de::Str("Flats:" + block[Parser::TextureCeiling].toString()),
                                         0.f, 0.f,
                                         1.f, 1.f, 1.f,  // color
                                         1.f,            // opacity
                                         0, 0, -1.f,     // normal
                                         -1);            // index in archive
 
-                        gmoSetSectorProperty<DDVT_INT>(index, "Type", block["special"].toInt());
-                        gmoSetSectorProperty<DDVT_INT>(index, "Tag",  block["id"].toInt());
+                        gmoSetSectorProperty<DDVT_INT>(index, "Type", block[Parser::Special].toInt());
+                        gmoSetSectorProperty<DDVT_INT>(index, "Tag",  block[Parser::Id].toInt());
+                        break; }
+
+                    default:
+                        break;
                     }
                 });
 
-                parser.parse(String::fromUtf8(bytes));
+                Time parseStartedAt;
+                parser.parse(bytes);
+                LOGDEV_MAP_MSG("Parsed %i blocks in %.3f seconds (%i chunks)")
+                        << parser.blockCount() << parseStartedAt.since() << parser.chunkCount();
+
+#ifdef DENG_IMPORTUDMF_DEBUG
+                if (App::commandLine().has("-udmfcompare"))
+                {
+                    compareWithTokenParser(bytes, parseStartedAt.since());
+                }
+                if (auto arg = App::commandLine().check("-udmfbench", 1))
+                {
+                    benchmarkSyntheticTextmap(arg.params.at(0).toInt());
+                }
+#endif
+
+                // Vertices are created in one go.
+                {
+                    int const vertexCount = int(importState.vertexCoords.size() / 2);
+                    std::vector<int> archiveIndices(vertexCount);
+                    for (int i = 0; i < vertexCount; ++i)
+                    {
+                        archiveIndices[i] = i;
+                    }
+                    if (vertexCount > 0)
+                    {
+                        MPE_VertexCreatev(vertexCount, importState.vertexCoords.data(),
+                                          archiveIndices.data(), nullptr);
+                    }
+                }
+
+                transferThings(importState.things, importState.isHexen, importState.isDoom64);
 
                 // Now that all the linedefs and sidedefs are read, let's create them.
-                for (int index = 0; index < importState.linedefs.size(); ++index)
+                for (int index = 0; index < int(importState.linedefs.size()); ++index)
                 {
-                    UDMFParser::Block const &linedef = importState.linedefs.at(index);
+                    LinedefData const &linedef = importState.linedefs.at(index);
 
-                    int sidefront = linedef["sidefront"].toInt();
-                    int sideback  = linedef.contains("sideback")? linedef["sideback"].toInt() : -1;
+                    int const sidefront = linedef.sideFront;
+                    int const sideback  = linedef.sideBack;
 
-                    UDMFParser::Block const &front = importState.sidedefs.at(sidefront);
-                    UDMFParser::Block const *back  =
+                    int const sidedefCount = int(importState.sidedefs.size());
+                    if (sidefront < 0 || sidefront >= sidedefCount)
+                    {
+                        throw Error("importMapHook", QString("Linedef %1 has an invalid "
+                                                             "sidefront (%2)")
+                                    .arg(index).arg(sidefront));
+                    }
+                    if (sideback >= sidedefCount)
+                    {
+                        throw Error("importMapHook", QString("Linedef %1 has an invalid "
+                                                             "sideback (%2)")
+                                    .arg(index).arg(sideback));
+                    }
+
+                    SidedefData const &front = importState.sidedefs.at(sidefront);
+                    SidedefData const *back  =
                             (sideback >= 0? &importState.sidedefs.at(sideback) : nullptr);
 
-                    int frontSectorIdx = front["sector"].toInt();
-                    int backSectorIdx  = back? (*back)["sector"].toInt() : -1;
+                    int frontSectorIdx = front.sector;
+                    int backSectorIdx  = back? back->sector : -1;
 
                     // Line flags.
                     int ddLineFlags = 0;
                     short sideFlags = 0;
                     {
-                        bool const blocking      = linedef["blocking"].toBool();
-                        bool const dontpegtop    = linedef["dontpegtop"].toBool();
-                        bool const dontpegbottom = linedef["dontpegbottom"].toBool();
-                        bool const twosided      = linedef["twosided"].toBool();
+                        if (linedef.blocking)      ddLineFlags |= DDLF_BLOCKING;
+                        if (linedef.dontPegTop)    ddLineFlags |= DDLF_DONTPEGTOP;
+                        if (linedef.dontPegBottom) ddLineFlags |= DDLF_DONTPEGBOTTOM;
 
-                        if (blocking)      ddLineFlags |= DDLF_BLOCKING;
-                        if (dontpegtop)    ddLineFlags |= DDLF_DONTPEGTOP;
-                        if (dontpegbottom) ddLineFlags |= DDLF_DONTPEGBOTTOM;
-
-                        if (!twosided && back)
+                        if (!linedef.twoSided && back)
                         {
                             sideFlags |= SDF_SUPPRESS_BACK_SECTOR;
                         }
                     }
 
-                    MPE_LineCreate(linedef["v1"].toInt(),
-                                   linedef["v2"].toInt(),
+                    MPE_LineCreate(linedef.v1,
+                                   linedef.v2,
                                    frontSectorIdx,
                                    backSectorIdx,
                                    ddLineFlags,
                                    index);
 
-                    auto texName = [] (QVariant tex) -> String {
-                        if (tex.toString().isEmpty()) return String();
-                        return "Textures:" + tex.toString();
-                    };
-
                     // Front side.
                     {
-                        int const offsetx = front["offsetx"].toInt();
-                        int const offsety = front["offsety"].toInt();
+                        int const offsetx = front.offsetX;
+                        int const offsety = front.offsetY;
                         float opacity = 1.f;
 
                         MPE_LineAddSide(
                             index,
                             0 /* front */,
                             sideFlags,
-                            de::Str(texName(front["texturetop"]   )), offsetx, offsety, 1, 1, 1,
-                            de::Str(texName(front["texturemiddle"])), offsetx, offsety, 1, 1, 1, opacity,
-                            de::Str(texName(front["texturebottom"])), offsetx, offsety, 1, 1, 1,
+                            de::Str(front.textureTop   ), offsetx, offsety, 1, 1, 1,
+                            de::Str(front.textureMiddle), offsetx, offsety, 1, 1, 1, opacity,
+                            de::Str(front.textureBottom), offsetx, offsety, 1, 1, 1,
                             sidefront);
                     }
 
                     // Back side.
                     if (back)
                     {
-                        int const offsetx = (*back)["offsetx"].toInt();
-                        int const offsety = (*back)["offsety"].toInt();
+                        int const offsetx = back->offsetX;
+                        int const offsety = back->offsetY;
                         float opacity = 1.f;
 
                         MPE_LineAddSide(
                             index,
                             1 /* front */,
                             sideFlags,
-                            de::Str(texName((*back)["texturetop"]   )), offsetx, offsety, 1, 1, 1,
-                            de::Str(texName((*back)["texturemiddle"])), offsetx, offsety, 1, 1, 1, opacity,
-                            de::Str(texName((*back)["texturebottom"])), offsetx, offsety, 1, 1, 1,
+                            de::Str(back->textureTop   ), offsetx, offsety, 1, 1, 1,
+                            de::Str(back->textureMiddle), offsetx, offsety, 1, 1, 1, opacity,
+                            de::Str(back->textureBottom), offsetx, offsety, 1, 1, 1,
                             sideback);
                     }
 
@@ -298,21 +511,19 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                         gmoSetLineProperty<DDVT_SHORT>(index, "Flags", flags);
                     }
 
-                    gmoSetLineProperty<DDVT_INT>(index, "Type", linedef["special"].toInt());
+                    gmoSetLineProperty<DDVT_INT>(index, "Type", linedef.special);
 
                     if (!importState.isHexen)
                     {
-                        gmoSetLineProperty<DDVT_INT>(index, "Tag",
-                                                     linedef.contains("id")?
-                                                         linedef["id"].toInt() : -1);
+                        gmoSetLineProperty<DDVT_INT>(index, "Tag", linedef.hasId? linedef.id : -1);
                     }
                     if (importState.isHexen)
                     {
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg0", linedef["arg0"].toInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg1", linedef["arg1"].toInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg2", linedef["arg2"].toInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg3", linedef["arg3"].toInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg4", linedef["arg4"].toInt());
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg0", linedef.args[0]);
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg1", linedef.args[1]);
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg2", linedef.args[2]);
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg3", linedef.args[3]);
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg4", linedef.args[4]);
                     }
                 }
                 LOG_MAP_WARNING("Loading UDMF maps is an experimental feature");
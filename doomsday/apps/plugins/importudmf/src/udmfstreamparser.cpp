@@ -0,0 +1,764 @@
+/** @file udmfstreamparser.cpp  Streaming UDMF parser.
+ *
+ * @authors Copyright (c) 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "udmfstreamparser.h"
+
+#include <de/TaskPool>
+#include <de/math.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace de;
+
+/// Sources smaller than this are parsed in one piece.
+static dsize const MIN_CHUNK_SIZE = 256 * 1024;
+
+/// Maximum number of chunks to split a source into.
+static int const MAX_CHUNKS = 64;
+
+typedef UDMFStreamParser::Key Key;
+
+namespace internal {
+
+static char const *keyNames[UDMFStreamParser::KeyCount] =
+{
+    "namespace",
+    "id", "special", "arg0", "arg1", "arg2", "arg3", "arg4",
+    "x", "y", "z", "angle", "type",
+    "ambush", "single", "dm", "coop", "friend", "dormant", "class1", "class2", "class3",
+    "standing", "strifeally", "translucent", "invisible",
+    "skill1", "skill2", "skill3", "skill4", "skill5",
+    "v1", "v2", "sidefront", "sideback", "blocking", "dontpegtop", "dontpegbottom", "twosided",
+    "sector", "offsetx", "offsety", "texturetop", "texturemiddle", "texturebottom",
+    "lightlevel", "heightfloor", "heightceiling", "texturefloor", "textureceiling",
+};
+
+static inline char lowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z'? char(c - 'A' + 'a') : c);
+}
+
+static inline duint32 keyHash(char const *name, dsize length)
+{
+    // FNV-1a of the lower case name.
+    duint32 hash = 2166136261u;
+    for (dsize i = 0; i < length; ++i)
+    {
+        hash = (hash ^ duint8(lowerAscii(name[i]))) * 16777619u;
+    }
+    return hash;
+}
+
+static bool equalsLower(char const *name, dsize length, char const *lowerName)
+{
+    for (dsize i = 0; i < length; ++i)
+    {
+        if (!lowerName[i] || lowerAscii(name[i]) != lowerName[i]) return false;
+    }
+    return lowerName[length] == 0;
+}
+
+/**
+ * Perfect hash table of the known keys. The table size is chosen so that none of
+ * the known keys collide, so a lookup needs at most one comparison.
+ */
+struct KeyTable
+{
+    duint32 size;
+    std::vector<dint8> slots;
+
+    KeyTable()
+    {
+        for (size = UDMFStreamParser::KeyCount; ; ++size)
+        {
+            slots.assign(size, -1);
+            bool collided = false;
+            for (int i = 0; i < UDMFStreamParser::KeyCount && !collided; ++i)
+            {
+                dint8 &slot = slots[keyHash(keyNames[i], std::strlen(keyNames[i])) % size];
+                if (slot >= 0) collided = true;
+                slot = dint8(i);
+            }
+            if (!collided) break;
+        }
+    }
+
+    Key find(char const *name, dsize length) const
+    {
+        dint8 const index = slots[keyHash(name, length) % size];
+        if (index >= 0 && equalsLower(name, length, keyNames[index]))
+        {
+            return Key(index);
+        }
+        return UDMFStreamParser::UnknownKey;
+    }
+};
+
+static KeyTable const &keyTable()
+{
+    static KeyTable table;
+    return table;
+}
+
+static UDMFStreamParser::BlockType blockTypeForName(char const *name, dsize length)
+{
+    if (equalsLower(name, length, "thing"))   return UDMFStreamParser::ThingBlock;
+    if (equalsLower(name, length, "vertex"))  return UDMFStreamParser::VertexBlock;
+    if (equalsLower(name, length, "linedef")) return UDMFStreamParser::LinedefBlock;
+    if (equalsLower(name, length, "sidedef")) return UDMFStreamParser::SidedefBlock;
+    if (equalsLower(name, length, "sector"))  return UDMFStreamParser::SectorBlock;
+    return UDMFStreamParser::UnknownBlock;
+}
+
+static inline bool isWhite(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static inline bool isIdentifierStart(char c)
+{
+    // Multibyte UTF-8 sequences are accepted as letters.
+    return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (duint8(c) & 0x80);
+}
+
+static inline bool isIdentifierChar(char c)
+{
+    return isIdentifierStart(c) || isDigit(c);
+}
+
+/**
+ * Parsed contents of a range of the source. Each item is either a global
+ * assignment or a block, referring to a range of the chunk's assignments.
+ */
+struct Chunk
+{
+    struct Item
+    {
+        bool global;
+        UDMFStreamParser::BlockType type;
+        dsize first;
+        dsize count;
+    };
+
+    char const *begin;
+    char const *end;
+    std::vector<UDMFStreamParser::Assignment> assignments;
+    std::vector<Item> items;
+    String error;
+
+    Chunk(char const *begin = nullptr, char const *end = nullptr)
+        : begin(begin), end(end)
+    {}
+};
+
+/**
+ * Recursive descent parser for one chunk.
+ */
+class ChunkParser
+{
+public:
+    ChunkParser(char const *source, Chunk &chunk)
+        : _source(source)
+        , _pos(chunk.begin)
+        , _end(chunk.end)
+        , _chunk(chunk)
+    {}
+
+    void parse()
+    {
+        for (;;)
+        {
+            skipWhite();
+            if (atEnd()) break;
+
+            if (peek() == ';')
+            {
+                // Empty statement.
+                ++_pos;
+                continue;
+            }
+
+            char const *name = _pos;
+            dsize const nameLength = identifier();
+            skipWhite();
+
+            if (peek() == '{')
+            {
+                ++_pos;
+                parseBlock(blockTypeForName(name, nameLength));
+            }
+            else
+            {
+                dsize const first = _chunk.assignments.size();
+                if (parseAssignment(name, nameLength))
+                {
+                    _chunk.items.push_back(Chunk::Item{ true, UDMFStreamParser::UnknownBlock, first, 1 });
+                }
+            }
+        }
+    }
+
+private:
+    bool atEnd() const { return _pos >= _end; }
+
+    char peek() const { return _pos < _end? *_pos : 0; }
+
+    int lineNumber() const
+    {
+        int line = 1;
+        for (char const *i = _source; i < _pos; ++i)
+        {
+            if (*i == '\n') ++line;
+        }
+        return line;
+    }
+
+    void syntaxError(String const &message) const
+    {
+        throw UDMFStreamParser::SyntaxError("UDMFStreamParser",
+                                            String("%1 on line %2").arg(message).arg(lineNumber()));
+    }
+
+    void skipWhite()
+    {
+        while (_pos < _end)
+        {
+            char const c = *_pos;
+            if (isWhite(c))
+            {
+                ++_pos;
+            }
+            else if (c == '/' && _pos + 1 < _end && _pos[1] == '/')
+            {
+                while (_pos < _end && *_pos != '\n') ++_pos;
+            }
+            else if (c == '/' && _pos + 1 < _end && _pos[1] == '*')
+            {
+                char const *commentEnd = nullptr;
+                for (char const *i = _pos + 2; i + 1 < _end; ++i)
+                {
+                    if (i[0] == '*' && i[1] == '/')
+                    {
+                        commentEnd = i + 2;
+                        break;
+                    }
+                }
+                if (!commentEnd) syntaxError("Unterminated comment");
+                _pos = commentEnd;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    void expect(char c)
+    {
+        skipWhite();
+        if (peek() != c)
+        {
+            syntaxError(String("Expected '%1'").arg(QChar(c)));
+        }
+        ++_pos;
+    }
+
+    /// Reads an identifier and returns its length.
+    dsize identifier()
+    {
+        char const *start = _pos;
+        if (!isIdentifierStart(peek())) syntaxError("Expected an identifier");
+        while (_pos < _end && isIdentifierChar(*_pos)) ++_pos;
+        return dsize(_pos - start);
+    }
+
+    void parseBlock(UDMFStreamParser::BlockType type)
+    {
+        dsize const first = _chunk.assignments.size();
+        for (;;)
+        {
+            skipWhite();
+            if (atEnd()) syntaxError("Unterminated block");
+            if (peek() == '}')
+            {
+                ++_pos;
+                break;
+            }
+            if (peek() == ';')
+            {
+                ++_pos;
+                continue;
+            }
+            char const *name = _pos;
+            dsize const nameLength = identifier();
+            parseAssignment(name, nameLength);
+        }
+        if (type != UDMFStreamParser::UnknownBlock)
+        {
+            _chunk.items.push_back(Chunk::Item{ false, type, first,
+                                                _chunk.assignments.size() - first });
+        }
+        else
+        {
+            // The contents of unknown blocks are not needed.
+            _chunk.assignments.resize(first);
+        }
+    }
+
+    /**
+     * Parses the remainder of an assignment after the key. Known keys are
+     * appended to the chunk's assignments.
+     *
+     * @return @c true, if an assignment was added.
+     */
+    bool parseAssignment(char const *name, dsize nameLength)
+    {
+        expect('=');
+        skipWhite();
+        UDMFStreamParser::Value const value = parseValue();
+        expect(';');
+
+        Key const key = keyTable().find(name, nameLength);
+        if (key == UDMFStreamParser::UnknownKey) return false;
+
+        _chunk.assignments.push_back(UDMFStreamParser::Assignment{ key, value });
+        return true;
+    }
+
+    UDMFStreamParser::Value parseValue()
+    {
+        UDMFStreamParser::Value value;
+        char const c = peek();
+
+        if (c == '"')
+        {
+            char const *start = ++_pos;
+            while (_pos < _end && *_pos != '"')
+            {
+                if (*_pos == '\\')
+                {
+                    value.textEscaped = true;
+                    ++_pos;
+                }
+                ++_pos;
+            }
+            if (_pos >= _end) syntaxError("Unterminated string");
+            value.kind       = UDMFStreamParser::Value::Text;
+            value.text       = start;
+            value.textLength = dsize(_pos - start);
+            ++_pos; // Closing quote.
+        }
+        else if (isDigit(c) || c == '-' || c == '+' || c == '.')
+        {
+            parseNumber(value);
+        }
+        else if (isIdentifierStart(c))
+        {
+            char const *start = _pos;
+            dsize const len = identifier();
+            if (equalsLower(start, len, "true") || equalsLower(start, len, "false"))
+            {
+                value.kind    = UDMFStreamParser::Value::Boolean;
+                value.boolean = (lowerAscii(*start) == 't');
+            }
+            else
+            {
+                value.kind       = UDMFStreamParser::Value::Text;
+                value.text       = start;
+                value.textLength = len;
+            }
+        }
+        else
+        {
+            syntaxError("Unexpected value for assignment");
+        }
+        return value;
+    }
+
+    void parseNumber(UDMFStreamParser::Value &value)
+    {
+        char const *start = _pos;
+        char const *digits = start;
+        if (*digits == '-' || *digits == '+') ++digits;
+        bool const hex = (digits + 1 < _end && digits[0] == '0' &&
+                          (digits[1] == 'x' || digits[1] == 'X'));
+        bool isFloat = false;
+
+        _pos = digits;
+        while (_pos < _end)
+        {
+            char const c = *_pos;
+            if (c == '.')
+            {
+                isFloat = true;
+            }
+            else if (!hex && (c == 'e' || c == 'E'))
+            {
+                isFloat = true;
+                if (_pos + 1 < _end && (_pos[1] == '-' || _pos[1] == '+')) ++_pos;
+            }
+            else if (!isIdentifierChar(c))
+            {
+                break;
+            }
+            ++_pos;
+        }
+
+        // The source is null-terminated and a number token is always followed by a
+        // non-number character, so the C library conversions can be used in place.
+        char *parsedEnd = nullptr;
+        if (isFloat)
+        {
+            value.kind   = UDMFStreamParser::Value::Number;
+            value.number = std::strtod(start, &parsedEnd);
+        }
+        else
+        {
+            value.kind    = UDMFStreamParser::Value::Integer;
+            value.integer = std::strtoll(start, &parsedEnd, 0);
+            if (parsedEnd != _pos)
+            {
+                // Not valid octal; try decimal instead.
+                value.integer = std::strtoll(start, &parsedEnd, 10);
+            }
+        }
+        if (parsedEnd != _pos)
+        {
+            syntaxError("Invalid number");
+        }
+    }
+
+private:
+    char const *_source;
+    char const *_pos;
+    char const *_end;
+    Chunk &_chunk;
+};
+
+/**
+ * Finds the top-level block boundaries where the source can be split into chunks
+ * of roughly @a chunkSize bytes. Only strings, comments, and brackets are
+ * considered; syntax errors are detected later when the chunks are parsed.
+ */
+static std::vector<Chunk> splitIntoChunks(char const *begin, char const *end, dsize chunkSize)
+{
+    std::vector<Chunk> chunks;
+    char const *chunkStart = begin;
+    int depth = 0;
+
+    for (char const *pos = begin; pos < end; ++pos)
+    {
+        char const c = *pos;
+        if (c == '"')
+        {
+            for (++pos; pos < end && *pos != '"'; ++pos)
+            {
+                if (*pos == '\\') ++pos;
+            }
+        }
+        else if (c == '/' && pos + 1 < end && pos[1] == '/')
+        {
+            while (pos < end && *pos != '\n') ++pos;
+        }
+        else if (c == '/' && pos + 1 < end && pos[1] == '*')
+        {
+            for (pos += 2; pos + 1 < end && !(pos[0] == '*' && pos[1] == '/'); ++pos) {}
+            ++pos;
+        }
+        else if (c == '{')
+        {
+            ++depth;
+        }
+        else if (c == '}')
+        {
+            if (--depth == 0 && dsize(pos + 1 - chunkStart) >= chunkSize)
+            {
+                chunks.push_back(Chunk(chunkStart, pos + 1));
+                chunkStart = pos + 1;
+            }
+        }
+    }
+    if (chunkStart < end || chunks.empty())
+    {
+        chunks.push_back(Chunk(chunkStart, end));
+    }
+    return chunks;
+}
+
+static void parseChunk(char const *source, Chunk &chunk)
+{
+    try
+    {
+        ChunkParser(source, chunk).parse();
+    }
+    catch (Error const &er)
+    {
+        chunk.error = er.asText();
+    }
+}
+
+} // namespace internal
+
+using namespace internal;
+
+//---------------------------------------------------------------------------------------
+
+UDMFStreamParser::Value::Value()
+    : kind(None)
+    , integer(0)
+    , text(nullptr)
+    , textLength(0)
+    , textEscaped(false)
+{}
+
+dint UDMFStreamParser::Value::toInt() const
+{
+    switch (kind)
+    {
+    case Integer: return dint(integer);
+    case Number:  return dint(number);
+    case Boolean: return boolean? 1 : 0;
+    case Text:    return toString().toInt();
+    default:      return 0;
+    }
+}
+
+ddouble UDMFStreamParser::Value::toDouble() const
+{
+    switch (kind)
+    {
+    case Integer: return ddouble(integer);
+    case Number:  return number;
+    case Boolean: return boolean? 1 : 0;
+    case Text:    return toString().toDouble();
+    default:      return 0;
+    }
+}
+
+bool UDMFStreamParser::Value::toBool() const
+{
+    switch (kind)
+    {
+    case Integer: return integer != 0;
+    case Number:  return !fequal(number, 0.0);
+    case Boolean: return boolean;
+    case Text: {
+        String const str = toString();
+        return !str.isEmpty() && str != "0" && str.compareWithoutCase("false"); }
+    default:      return false;
+    }
+}
+
+String UDMFStreamParser::Value::toString() const
+{
+    switch (kind)
+    {
+    case Integer: return String::number(integer);
+    case Number:  return String::number(number);
+    case Boolean: return boolean? "true" : "false";
+    case Text:
+        if (!textEscaped)
+        {
+            return String::fromUtf8(QByteArray::fromRawData(text, int(textLength)));
+        }
+        else
+        {
+            QByteArray unescaped;
+            unescaped.reserve(int(textLength));
+            for (dsize i = 0; i < textLength; ++i)
+            {
+                char c = text[i];
+                if (c == '\\' && i + 1 < textLength)
+                {
+                    c = text[++i];
+                    switch (c)
+                    {
+                    case 'a': c = '\a'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'n': c = '\n'; break;
+                    case 'r': c = '\r'; break;
+                    case 't': c = '\t'; break;
+                    case 'v': c = '\v'; break;
+                    default:  break;
+                    }
+                }
+                unescaped.append(c);
+            }
+            return String::fromUtf8(unescaped);
+        }
+    default:
+        return String();
+    }
+}
+
+//---------------------------------------------------------------------------------------
+
+UDMFStreamParser::Block::Block(BlockType type, Assignment const *begin, Assignment const *end)
+    : _type(type)
+    , _begin(begin)
+    , _end(end)
+{}
+
+UDMFStreamParser::BlockType UDMFStreamParser::Block::type() const
+{
+    return _type;
+}
+
+bool UDMFStreamParser::Block::contains(Key key) const
+{
+    for (Assignment const *i = _begin; i != _end; ++i)
+    {
+        if (i->key == key) return true;
+    }
+    return false;
+}
+
+UDMFStreamParser::Value const &UDMFStreamParser::Block::operator [] (Key key) const
+{
+    static Value const none;
+    for (Assignment const *i = _end; i != _begin; --i)
+    {
+        if (i[-1].key == key) return i[-1].value;
+    }
+    return none;
+}
+
+//---------------------------------------------------------------------------------------
+
+DENG2_PIMPL_NOREF(UDMFStreamParser)
+{
+    AssignmentFunc assignmentHandler;
+    BlockFunc blockHandler;
+    bool concurrent = true;
+    int blockCount = 0;
+    int chunkCount = 0;
+};
+
+UDMFStreamParser::UDMFStreamParser()
+    : d(new Impl)
+{}
+
+void UDMFStreamParser::setGlobalAssignmentHandler(AssignmentFunc func)
+{
+    d->assignmentHandler = func;
+}
+
+void UDMFStreamParser::setBlockHandler(BlockFunc func)
+{
+    d->blockHandler = func;
+}
+
+void UDMFStreamParser::setConcurrent(bool enabled)
+{
+    d->concurrent = enabled;
+}
+
+void UDMFStreamParser::parse(de::Block const &source)
+{
+    // de::Block is always null-terminated.
+    char const *begin = source.constData();
+    char const *end   = begin + source.size();
+
+    // Skip a UTF-8 byte order mark.
+    if (source.size() >= 3 && !std::memcmp(begin, "\xef\xbb\xbf", 3))
+    {
+        begin += 3;
+    }
+
+    std::vector<Chunk> chunks;
+    dsize const sourceSize = dsize(end - begin);
+    if (d->concurrent && sourceSize >= 2 * MIN_CHUNK_SIZE)
+    {
+        chunks = splitIntoChunks(begin, end, de::max(MIN_CHUNK_SIZE, sourceSize / MAX_CHUNKS));
+    }
+    else
+    {
+        chunks.push_back(Chunk(begin, end));
+    }
+
+    if (chunks.size() > 1)
+    {
+        TaskPool tasks;
+        for (Chunk &chunk : chunks)
+        {
+            Chunk *chunkPtr = &chunk;
+            tasks.start([begin, chunkPtr] ()
+            {
+                parseChunk(begin, *chunkPtr);
+            });
+        }
+        tasks.waitForDone();
+    }
+    else
+    {
+        parseChunk(begin, chunks.front());
+    }
+
+    d->chunkCount = int(chunks.size());
+    d->blockCount = 0;
+
+    // Make the callbacks in source order.
+    for (Chunk const &chunk : chunks)
+    {
+        for (Chunk::Item const &item : chunk.items)
+        {
+            Assignment const *first = chunk.assignments.data() + item.first;
+            if (item.global)
+            {
+                if (d->assignmentHandler)
+                {
+                    d->assignmentHandler(first->key, first->value);
+                }
+            }
+            else
+            {
+                d->blockCount++;
+                if (d->blockHandler)
+                {
+                    d->blockHandler(Block(item.type, first, first + item.count));
+                }
+            }
+        }
+        if (!chunk.error.isEmpty())
+        {
+            throw SyntaxError("UDMFStreamParser::parse", chunk.error);
+        }
+    }
+}
+
+int UDMFStreamParser::blockCount() const
+{
+    return d->blockCount;
+}
+
+int UDMFStreamParser::chunkCount() const
+{
+    return d->chunkCount;
+}
+
+UDMFStreamParser::Key UDMFStreamParser::keyForName(char const *name, dsize length)
+{
+    return keyTable().find(name, length);
+}
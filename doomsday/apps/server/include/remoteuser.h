@@ -76,6 +76,11 @@ public:
     // Implements Transmitter.
     void send(de::IByteArray const &data);
 
+    /**
+     * Sends a message that has already been encoded with de::Socket::encodeMessage().
+     */
+    void sendEncoded(de::Block const &encoded);
+
 signals:
     void userDestroyed();
 
@@ -23,6 +23,7 @@
 #define SERVER_FRAME_H
 
 #include <de/libcore.h>
+#include "dd_share.h"
 
 #ifndef __cplusplus
 #  error "server/sv_frame.h requires C++"
@@ -31,4 +32,26 @@
 void Sv_TransmitFrame();
 de::dsize Sv_GetMaxFrameSize(de::dint playerNumber);
 
+/**
+ * Returns the size of the latest frame packet sent to a player, in bytes.
+ */
+de::dsize Sv_LastFrameSize(de::dint playerNumber);
+
+/**
+ * Returns the average time spent encoding a frame packet for a player, in seconds.
+ */
+de::ddouble Sv_FrameEncodeTime(de::dint playerNumber);
+
+/**
+ * Returns the total size of all frame packets sent to a player, in bytes.
+ */
+de::duint64 Sv_TotalFrameSize(de::dint playerNumber);
+
+/**
+ * Returns the total number of unacknowledged deltas that have been resent to a player.
+ */
+de::duint64 Sv_ResentDeltaCount(de::dint playerNumber);
+
+D_CMD(RateCompare);
+
 #endif  // SERVER_FRAME_H
@@ -92,6 +92,18 @@ typedef struct delta_s {
     uint            timeStamp;
 
     int             flags;
+
+    // Index of the delta in the pool's priority queue, or -1 if not queued.
+    int             queueIndex;
+
+    // Age and distance steps when the score was last calculated. The delta is
+    // rated again when either changes. -1 means the delta needs rating.
+    int             ratedAge;
+    int             ratedDistance;
+
+    // Order in which the delta was added to the pool. Deltas with equal scores
+    // are sent in this order.
+    uint            serial;
 } delta_t;
 
 typedef mobj_t  dt_mobj_t;
@@ -247,12 +259,15 @@ typedef struct pool_s {
     // not be sent.
     mislink_t       misHash[POOL_MISSILE_HASH_SIZE];
 
-    // The priority queue (a heap). Built when the pool contents are rated.
-    // Contains pointers to deltas in the hash. Becomes invalid when deltas
-    // are removed from the hash!
+    // The priority queue (a heap). Kept up to date when the pool contents are
+    // rated. Contains pointers to deltas in the hash; deltas are taken out of
+    // the queue when they are removed from the hash.
     int             queueSize;
     int             allocatedSize;
     delta_t**       queue;
+
+    // Serial numbers for deltas added to the pool.
+    uint            serialDealer;
 } pool_t;
 
 void            Sv_InitPools(void);
@@ -265,7 +280,7 @@ void            Sv_GenerateFrameDeltas(void);
 dd_bool         Sv_IsFrameTarget(uint clientNumber);
 uint            Sv_GetTimeStamp(void);
 pool_t*         Sv_GetPool(uint clientNumber);
-void            Sv_RatePool(pool_t* pool);
+void            Sv_RatePool(pool_t* pool, dd_bool rateAll);
 delta_t*        Sv_PoolQueueExtract(pool_t* pool);
 void            Sv_AckDeltaSet(uint clientNumber, int set, byte resent);
 uint            Sv_CountUnackedDeltas(uint clientNumber);
@@ -297,4 +312,29 @@ void Sv_NewSoundDelta(int soundId, mobj_t const *emitter, Sector *sourceSector,
 } // extern "C"
 #endif
 
+#ifdef __cplusplus
+#include <vector>
+
+/**
+ * Lists the queued deltas of the pool in the order they are extracted from the
+ * queue. The queue is left with the same contents.
+ */
+void Sv_PoolQueueOrder(pool_t *pool, std::vector<delta_t *> &order);
+
+/**
+ * Lists the deltas of the pool in priority order without using the queue, for
+ * checking the queue.
+ *
+ * @param pool     Pool whose deltas to list.
+ * @param order    The deltas in priority order.
+ * @param rescore  Rate every delta again instead of using the scores of the queued
+ *                 deltas, as if there were no stepped re-rating. The scores used by
+ *                 the queue are not changed.
+ *
+ * @return Number of deltas whose score equals the previous one's, so they are only
+ * ordered by their serial.
+ */
+int Sv_PoolReferenceOrder(pool_t *pool, std::vector<delta_t *> &order, bool rescore);
+#endif
+
 #endif
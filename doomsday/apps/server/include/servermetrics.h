@@ -0,0 +1,72 @@
+/** @file servermetrics.h  Performance metrics for shell users.
+ * @ingroup server
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef SERVER_SERVERMETRICS_H
+#define SERVER_SERVERMETRICS_H
+
+#include <de/Time>
+#include <de/shell/Protocol>
+
+/**
+ * Collects performance counters of the server for shell users.
+ *
+ * The timings are sampled every tic. When a sampling interval has elapsed,
+ * the accumulated values are composed into a MetricsPacket and the sampling
+ * starts over.
+ *
+ * @ingroup server
+ */
+class ServerMetrics
+{
+public:
+    ServerMetrics();
+
+    /**
+     * Discards the accumulated samples.
+     */
+    void reset();
+
+    /**
+     * Records the timings of one tic of the server loop.
+     *
+     * @param runTime       Time spent running the game tics.
+     * @param transmitTime  Time spent transmitting frames to clients.
+     */
+    void sampleTic(de::TimeSpan runTime, de::TimeSpan transmitTime);
+
+    /**
+     * Determines if a sampling interval has elapsed.
+     *
+     * @param interval  Length of the sampling interval.
+     */
+    bool isDue(de::TimeSpan interval) const;
+
+    /**
+     * Composes a packet of the metrics sampled since the previous call and starts
+     * a new sampling interval.
+     *
+     * @return Packet. Caller gets ownership.
+     */
+    de::shell::MetricsPacket *takePacket();
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+#endif // SERVER_SERVERMETRICS_H
@@ -106,5 +106,6 @@ void    N_PrintNetworkStatus(void);
 
 extern char *nptIPAddress; // cvar
 extern int nptIPPort; // cvar
+extern int shellMetricsInterval; // cvar
 
 #endif // SERVERSYSTEM_H
@@ -50,6 +50,13 @@ public:
 
     int count() const;
 
+    /**
+     * Sends a packet to all connected shell users.
+     *
+     * @param packet  Packet to send.
+     */
+    void sendToAll(de::Packet const &packet);
+
     void worldMapChanged();
 
 public slots:
@@ -259,6 +259,14 @@ void RemoteUser::send(IByteArray const &data)
     }
 }
 
+void RemoteUser::sendEncoded(Block const &encoded)
+{
+    if (d->state != Disconnected && d->socket->isOpen())
+    {
+        d->socket->sendEncoded(encoded);
+    }
+}
+
 void RemoteUser::handleIncomingPackets()
 {
     LOG_AS("RemoteUser");
@@ -24,6 +24,7 @@
 #include "de_base.h"
 #include "server/sv_pool.h"
 
+#include <algorithm>
 #include <cmath>
 #include <de/mathutil.h>
 #include <de/timer.h>
@@ -48,6 +49,12 @@ using namespace de;
 // Maximum difference in plane height where the absolute height doesn't need to be sent.
 #define PLANE_SKIP_LIMIT            ( 40 )
 
+// A queued delta is rated again when its age changes by this much (milliseconds)...
+#define DELTA_AGE_STEP              ( 100 )
+
+// ...or its distance to the owner changes by about 1/16 of an octave.
+#define DELTA_DISTANCE_STEPS        ( 16 )
+
 struct reg_mobj_t
 {
     reg_mobj_t *next;  ///< In the register hash.
@@ -81,6 +88,7 @@ void Sv_RegisterWorld(cregister_t *reg, dd_bool isInitial);
 void Sv_NewDelta(void *deltaPtr, deltatype_t type, duint id);
 dd_bool Sv_IsVoidDelta(void const *delta);
 void Sv_PoolQueueClear(pool_t *pool);
+void Sv_PoolQueueRemove(pool_t *pool, delta_t *delta);
 void Sv_GenerateNewDeltas(cregister_t *reg, dint clientNumber, dd_bool doUpdate);
 
 // The register contains the previous state of the world.
@@ -146,6 +154,7 @@ void Sv_InitPools()
         pool.queueSize     = 0;
         pool.allocatedSize = 0;
         pool.queue         = nullptr;
+        pool.serialDealer  = 0;
 
         pool.isFirst       = true;  // Set to @c false when a frame is sent.
     }
@@ -1031,6 +1040,8 @@ void Sv_NewDelta(void *deltaPtr, deltatype_t type, uint id)
     delta->type = type;
     delta->state = DELTA_NEW;
     delta->timeStamp = Sv_GetTimeStamp();
+    delta->queueIndex = -1;
+    delta->ratedAge = -1;
 }
 
 /**
@@ -1634,6 +1645,9 @@ void Sv_RemoveDelta(pool_t* pool, void* deltaPtr)
     delta_t*            delta = (delta_t *) deltaPtr;
     deltalink_t*        hash = Sv_PoolHash(pool, delta->id);
 
+    // The queue must not point to removed deltas.
+    Sv_PoolQueueRemove(pool, delta);
+
     // Update first and last links.
     if (hash->last == delta)
     {
@@ -1676,6 +1690,7 @@ void Sv_DrainPool(uint clientNumber)
     // Reset the counters.
     pool->setDealer = 0;
     pool->resendDealer = 0;
+    pool->serialDealer = 0;
 
     Sv_PoolQueueClear(pool);
 
@@ -1878,6 +1893,9 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
                     Sv_RemoveDelta(pool, iter);
                     continue;
                 }
+
+                // The contents changed, so the score must be recalculated.
+                iter->ratedAge = -1;
             }
         }
     }
@@ -1891,12 +1909,19 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
             // The existing delta must be removed.
             Sv_RemoveDelta(pool, existingNew);
         }
+        else
+        {
+            existingNew->ratedAge = -1;
+        }
     }
     else
     {
         // Add it to the end of the hash chain. We must take a copy
         // of the delta so it can be stored in the hash.
         iter = (delta_t *) Sv_CopyDelta(delta);
+        iter->queueIndex = -1;
+        iter->ratedAge = -1;
+        iter->serial = pool->serialDealer++;
 
         if (hash->last)
         {
@@ -2451,38 +2476,112 @@ void Sv_GenerateFrameDeltas(void)
     Sv_GenerateNewDeltas(&worldRegister, -1, true);
 }
 
+/**
+ * Determines if delta @a a should be sent before delta @a b. Deltas with equal
+ * scores are ordered by their arrival in the pool, so the extraction order only
+ * depends on the scores.
+ */
+static inline bool Sv_IsHigherPriority(delta_t const *a, delta_t const *b)
+{
+    if (a->score != b->score) return a->score > b->score;
+    return a->serial < b->serial;
+}
+
+/**
+ * Places the delta at the given index in the queue.
+ */
+static inline void Sv_PoolQueueSet(pool_t *pool, int index, delta_t *delta)
+{
+    pool->queue[index] = delta;
+    delta->queueIndex = index;
+}
+
 /**
  * Clears the priority queue of the pool.
  */
-void Sv_PoolQueueClear(pool_t* pool)
+void Sv_PoolQueueClear(pool_t *pool)
 {
+    for (int i = 0; i < pool->queueSize; ++i)
+    {
+        pool->queue[i]->queueIndex = -1;
+    }
     pool->queueSize = 0;
 }
 
 /**
  * Exchanges two elements in the queue.
  */
-void Sv_PoolQueueExchange(pool_t* pool, int index1, int index2)
+void Sv_PoolQueueExchange(pool_t *pool, int index1, int index2)
 {
     delta_t *temp = pool->queue[index1];
 
-    pool->queue[index1] = pool->queue[index2];
-    pool->queue[index2] = temp;
+    Sv_PoolQueueSet(pool, index1, pool->queue[index2]);
+    Sv_PoolQueueSet(pool, index2, temp);
+}
+
+/**
+ * Moves the element at @a index up in the heap until the correct place is found.
+ */
+static void Sv_PoolQueueRaise(pool_t *pool, int index)
+{
+    while (index > 0)
+    {
+        int const parent = HEAP_PARENT(index);
+
+        // Is it good now?
+        if (!Sv_IsHigherPriority(pool->queue[index], pool->queue[parent]))
+            break;
+
+        // Exchange with the parent.
+        Sv_PoolQueueExchange(pool, parent, index);
+        index = parent;
+    }
+}
+
+/**
+ * Moves the element at @a index down in the heap until the correct place is found.
+ * This is O(log n).
+ */
+static void Sv_PoolQueueLower(pool_t *pool, int index)
+{
+    for (;;)
+    {
+        int const left  = HEAP_LEFT(index);
+        int const right = HEAP_RIGHT(index);
+        int big = index;
+
+        // Which child is more important?
+        if (left < pool->queueSize &&
+            Sv_IsHigherPriority(pool->queue[left], pool->queue[big]))
+        {
+            big = left;
+        }
+        if (right < pool->queueSize &&
+            Sv_IsHigherPriority(pool->queue[right], pool->queue[big]))
+        {
+            big = right;
+        }
+
+        // Can we stop now?
+        if (big == index) break;
+
+        // Exchange and continue.
+        Sv_PoolQueueExchange(pool, index, big);
+        index = big;
+    }
 }
 
 /**
  * Adds the delta to the priority queue. More memory is allocated for the
  * queue if necessary.
  */
-void Sv_PoolQueueAdd(pool_t* pool, delta_t* delta)
+void Sv_PoolQueueAdd(pool_t *pool, delta_t *delta)
 {
-    int                 i, parent;
+    DENG2_ASSERT(delta->queueIndex < 0);
 
     // Do we need more memory?
     if (pool->allocatedSize == pool->queueSize)
     {
-        delta_t**           newQueue;
-
         // Double the memory.
         pool->allocatedSize *= 2;
         if (!pool->allocatedSize)
@@ -2492,13 +2591,12 @@ void Sv_PoolQueueAdd(pool_t* pool, delta_t* delta)
         }
 
         // Allocate the new queue.
-        newQueue = (delta_t **) Z_Malloc(pool->allocatedSize * sizeof(delta_t *), PU_MAP, 0);
+        delta_t **newQueue = (delta_t **) Z_Malloc(pool->allocatedSize * sizeof(delta_t *), PU_MAP, 0);
 
         // Copy the old data.
         if (pool->queue)
         {
-            memcpy(newQueue, pool->queue,
-                   sizeof(delta_t *) * pool->queueSize);
+            memcpy(newQueue, pool->queue, sizeof(delta_t *) * pool->queueSize);
 
             // Get rid of the old queue.
             Z_Free(pool->queue);
@@ -2507,85 +2605,57 @@ void Sv_PoolQueueAdd(pool_t* pool, delta_t* delta)
         pool->queue = newQueue;
     }
 
-    // Add the new delta to the end of the queue array.
-    i = pool->queueSize;
-    pool->queue[i] = delta;
-    ++pool->queueSize;
+    // Add the new delta to the end of the queue array and let it rise.
+    Sv_PoolQueueSet(pool, pool->queueSize++, delta);
+    Sv_PoolQueueRaise(pool, delta->queueIndex);
+}
 
-    // Rise in the heap until the correct place is found.
-    while (i > 0)
-    {
-        parent = HEAP_PARENT(i);
+/**
+ * Moves a queued delta to the correct place after its score has changed.
+ */
+void Sv_PoolQueueUpdate(pool_t *pool, delta_t *delta)
+{
+    DENG2_ASSERT(delta->queueIndex >= 0);
 
-        // Is it good now?
-        if (pool->queue[parent]->score >= delta->score)
-            break;
+    Sv_PoolQueueRaise(pool, delta->queueIndex);
+    Sv_PoolQueueLower(pool, delta->queueIndex);
+}
 
-        // Exchange with the parent.
-        Sv_PoolQueueExchange(pool, parent, i);
+/**
+ * Removes the delta from the priority queue, if it is queued.
+ */
+void Sv_PoolQueueRemove(pool_t *pool, delta_t *delta)
+{
+    int const index = delta->queueIndex;
+    if (index < 0) return;
 
-        i = parent;
+    delta->queueIndex = -1;
+
+    // The last element takes the place of the removed one.
+    delta_t *last = pool->queue[--pool->queueSize];
+    if (last != delta)
+    {
+        Sv_PoolQueueSet(pool, index, last);
+        Sv_PoolQueueUpdate(pool, last);
     }
 }
 
 /**
- * Extracts the delta with the highest priority from the queue.
+ * Extracts the delta with the highest priority from the queue. The delta is
+ * queued again the next time the pool is rated.
  *
  * @return              @c NULL, if there are no more deltas.
  */
-delta_t* Sv_PoolQueueExtract(pool_t* pool)
+delta_t *Sv_PoolQueueExtract(pool_t *pool)
 {
-    delta_t*            max;
-    int                 i, left, right, big;
-    dd_bool             isDone;
-
     if (!pool->queueSize)
     {
         // There is nothing in the queue.
         return NULL;
     }
 
-    // This is what we'll return.
-    max = pool->queue[0];
-
-    // Remove the first element from the queue.
-    pool->queue[0] = pool->queue[--pool->queueSize];
-
-    // Heapify the heap. This is O(log n).
-    i = 0;
-    isDone = false;
-    while (!isDone)
-    {
-        left = HEAP_LEFT(i);
-        right = HEAP_RIGHT(i);
-        big = i;
-
-        // Which child is more important?
-        if (left < pool->queueSize &&
-           pool->queue[left]->score > pool->queue[i]->score)
-        {
-            big = left;
-        }
-        if (right < pool->queueSize &&
-           pool->queue[right]->score > pool->queue[big]->score)
-        {
-            big = right;
-        }
-
-        // Can we stop now?
-        if (big != i)
-        {
-            // Exchange and continue.
-            Sv_PoolQueueExchange(pool, i, big);
-            i = big;
-        }
-        else
-        {
-            // Heapifying is complete.
-            isDone = true;
-        }
-    }
-
+    delta_t *max = pool->queue[0];
+    Sv_PoolQueueRemove(pool, max);
     return max;
 }
 
@@ -2639,29 +2709,22 @@ dd_bool Sv_IsPostponedDelta(void* deltaPtr, ownerinfo_t* info)
  * Calculate a priority score for the delta. A higher score indicates
  * greater importance.
  *
+ * @param distance      Distance from the owner to the delta's origin.
+ * @param age           Age of the delta in milliseconds.
+ *
  * @return              @c true iff the delta should be included in the
  *                      queue.
  */
-dd_bool Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
+dd_bool Sv_RateDelta(void* deltaPtr, coord_t distance, uint age)
 {
     float score, size;
-    coord_t distance;
     delta_t *delta = (delta_t *) deltaPtr;
     int df = delta->flags;
-    uint age = Sv_DeltaAge(delta);
 
     // The importance doubles normally in 1 second.
     float ageScoreDouble = 1.0f;
 
-    if (Sv_IsPostponedDelta(delta, info))
-    {
-        // This delta will not be considered at this time.
-        return false;
-    }
-
-    // Calculate the distance to the delta's origin.
     // If no distance can be determined, it's 1.0.
-    distance = Sv_DeltaDistance(delta, info);
     if (distance < 1)
         distance = 1;
     distance = distance * distance; // Power of two.
@@ -2744,15 +2807,31 @@ dd_bool Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
 }
 
 /**
- * Calculate a priority score for each delta and build the priority queue.
+ * @return  Distance step used for deciding when the delta needs to be rated again.
+ */
+static int Sv_DeltaDistanceStep(coord_t distance)
+{
+    return int(std::floor(std::log2(de::max(distance, 1.0)) * DELTA_DISTANCE_STEPS));
+}
+
+/**
+ * Calculate a priority score for each delta and update the priority queue.
  * The most important deltas will be included in a frame packet.
  * A pool is rated after new deltas have been generated.
+ *
+ * The queue is kept between frames. Only deltas that are new or changed, were
+ * extracted from the queue, or whose age or distance has moved to another step
+ * since they were last rated are rated again.
+ *
+ * @param pool     Pool to rate.
+ * @param rateAll  Rate every delta regardless of the steps.
  */
-void Sv_RatePool(pool_t* pool)
+void Sv_RatePool(pool_t* pool, dd_bool rateAll)
 {
 #ifdef _DEBUG
     player_t*           plr = DD_Player(pool->owner);
 #endif
+    ownerinfo_t*        info = &pool->ownerInfo;
     delta_t*            delta;
     int                 i;
 
@@ -2763,21 +2842,109 @@ void Sv_RatePool(pool_t* pool)
     }
 #endif
 
-    // Clear the queue.
-    Sv_PoolQueueClear(pool);
-
-    // We will rate all the deltas in the pool. After each delta
-    // has been rated, it's added to the priority queue.
     for (i = 0; i < POOL_HASH_SIZE; ++i)
     {
         for (delta = pool->hash[i].first; delta; delta = delta->next)
         {
-            if (Sv_RateDelta(delta, &pool->ownerInfo))
+            if (Sv_IsPostponedDelta(delta, info))
             {
-                Sv_PoolQueueAdd(pool, delta);
+                // This delta will not be considered at this time.
+                Sv_PoolQueueRemove(pool, delta);
+                continue;
             }
+
+            coord_t const distance = Sv_DeltaDistance(delta, info);
+            uint const age         = Sv_DeltaAge(delta);
+            int const ageStep      = int(age / DELTA_AGE_STEP);
+            int const distStep     = Sv_DeltaDistanceStep(distance);
+
+            if (!rateAll && delta->queueIndex >= 0 && delta->ratedAge == ageStep &&
+                delta->ratedDistance == distStep)
+            {
+                // The score is still valid.
+                continue;
+            }
+
+            delta->ratedAge      = ageStep;
+            delta->ratedDistance = distStep;
+
+            if (Sv_RateDelta(delta, distance, age))
+            {
+                if (delta->queueIndex >= 0)
+                {
+                    Sv_PoolQueueUpdate(pool, delta);
+                }
+                else
+                {
+                    Sv_PoolQueueAdd(pool, delta);
+                }
+            }
+            else
+            {
+                Sv_PoolQueueRemove(pool, delta);
+            }
+        }
+    }
+}
+
+void Sv_PoolQueueOrder(pool_t *pool, std::vector<delta_t *> &order)
+{
+    // Everything is extracted and queued again, so the queue remains as it was
+    // apart from the placement of the deltas in the heap.
+    order.clear();
+    while (delta_t *delta = Sv_PoolQueueExtract(pool))
+    {
+        order.push_back(delta);
+    }
+    for (delta_t *delta : order)
+    {
+        Sv_PoolQueueAdd(pool, delta);
+    }
+}
+
+int Sv_PoolReferenceOrder(pool_t *pool, std::vector<delta_t *> &order, bool rescore)
+{
+    ownerinfo_t *info = &pool->ownerInfo;
+
+    // Deltas paired with the scores they are sorted by.
+    std::vector<std::pair<float, delta_t *>> rated;
+    for (int i = 0; i < POOL_HASH_SIZE; ++i)
+    {
+        for (delta_t *delta = pool->hash[i].first; delta; delta = delta->next)
+        {
+            if (!rescore)
+            {
+                if (delta->queueIndex >= 0) rated.push_back(std::make_pair(delta->score, delta));
+                continue;
+            }
+            if (Sv_IsPostponedDelta(delta, info)) continue;
+
+            // The queue keeps using the score it was rated with.
+            float const queuedScore = delta->score;
+            if (Sv_RateDelta(delta, Sv_DeltaDistance(delta, info), Sv_DeltaAge(delta)))
+            {
+                rated.push_back(std::make_pair(delta->score, delta));
+            }
+            delta->score = queuedScore;
         }
     }
+
+    // Same order as Sv_IsHigherPriority().
+    std::sort(rated.begin(), rated.end(), [] (std::pair<float, delta_t *> const &a,
+                                               std::pair<float, delta_t *> const &b)
+    {
+        if (a.first != b.first) return a.first > b.first;
+        return a.second->serial < b.second->serial;
+    });
+
+    int ties = 0;
+    order.clear();
+    for (dsize i = 0; i < rated.size(); ++i)
+    {
+        if (i > 0 && rated[i - 1].first == rated[i].first) ties++;
+        order.push_back(rated[i].second);
+    }
+    return ties;
 }
 
 /**
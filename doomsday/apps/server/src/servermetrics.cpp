@@ -0,0 +1,132 @@
+/** @file servermetrics.cpp  Performance metrics for shell users.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "servermetrics.h"
+
+#include <de/memoryzone.h>
+#include <QScopedPointer>
+
+#include "server/sv_frame.h"
+#include "server/sv_pool.h"
+
+#include "dd_main.h"
+#include "world/p_players.h"
+
+using namespace de;
+
+DENG2_PIMPL_NOREF(ServerMetrics)
+{
+    Time startedAt;
+    duint32 tics = 0;
+    ddouble totalRunTime = 0;
+    ddouble maxRunTime = 0;
+    ddouble totalTransmitTime = 0;
+
+    /// Counter values of each client at the start of the interval.
+    struct ClientCounters
+    {
+        duint64 frameBytes = 0;
+        duint64 resentDeltas = 0;
+    };
+    ClientCounters counters[DDMAXPLAYERS];
+
+    void beginInterval()
+    {
+        startedAt = Time();
+        tics = 0;
+        totalRunTime = maxRunTime = totalTransmitTime = 0;
+
+        for (int i = 0; i < DDMAXPLAYERS; ++i)
+        {
+            counters[i].frameBytes   = Sv_TotalFrameSize(i);
+            counters[i].resentDeltas = Sv_ResentDeltaCount(i);
+        }
+    }
+
+    static duint32 perSecond(duint64 now, duint64 before, ddouble seconds)
+    {
+        if (now < before || seconds <= 0) return 0;
+        return duint32((now - before) / seconds);
+    }
+};
+
+ServerMetrics::ServerMetrics() : d(new Impl)
+{
+    d->beginInterval();
+}
+
+void ServerMetrics::reset()
+{
+    d->beginInterval();
+}
+
+void ServerMetrics::sampleTic(TimeSpan runTime, TimeSpan transmitTime)
+{
+    d->tics++;
+    d->totalRunTime      += runTime;
+    d->totalTransmitTime += transmitTime;
+    d->maxRunTime = de::max(d->maxRunTime, ddouble(runTime));
+}
+
+bool ServerMetrics::isDue(TimeSpan interval) const
+{
+    return d->startedAt.since() >= interval;
+}
+
+shell::MetricsPacket *ServerMetrics::takePacket()
+{
+    ddouble const elapsed = d->startedAt.since();
+
+    shell::MetricsPacket::Server sv;
+    sv.interval = elapsed;
+    sv.tics     = d->tics;
+    if (d->tics)
+    {
+        sv.ticTime      = d->totalRunTime / d->tics * 1000;
+        sv.transmitTime = d->totalTransmitTime / d->tics * 1000;
+    }
+    sv.maxTicTime = d->maxRunTime * 1000;
+
+    size_t zoneUsed = 0, zoneTotal = 0;
+    Z_GetMemoryStatus(&zoneUsed, &zoneTotal);
+    sv.zoneUsed  = zoneUsed;
+    sv.zoneTotal = zoneTotal;
+
+    QScopedPointer<shell::MetricsPacket> packet(new shell::MetricsPacket);
+    for (int i = 1; i < DDMAXPLAYERS; ++i)
+    {
+        if (!Sv_IsFrameTarget(i)) continue;
+
+        auto const &counters = d->counters[i];
+
+        shell::MetricsPacket::Client cl;
+        cl.number           = i;
+        cl.name             = DD_Player(i)->name;
+        cl.bytesPerSecond   = Impl::perSecond(Sv_TotalFrameSize(i), counters.frameBytes, elapsed);
+        cl.resendsPerSecond = Impl::perSecond(Sv_ResentDeltaCount(i), counters.resentDeltas, elapsed);
+        cl.unackedDeltas    = Sv_CountUnackedDeltas(i);
+        cl.encodeTime       = Sv_FrameEncodeTime(i) * 1000;
+        packet->addClient(cl);
+
+        sv.unackedDeltas += cl.unackedDeltas;
+    }
+    packet->setServer(sv);
+
+    d->beginInterval();
+    return packet.take();
+}
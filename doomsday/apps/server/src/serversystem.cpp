@@ -31,6 +31,7 @@
 #include "api_console.h"
 
 #include "serverapp.h"
+#include "servermetrics.h"
 #include "shellusers.h"
 #include "remoteuser.h"
 
@@ -53,6 +54,7 @@ using namespace de;
 
 char *nptIPAddress = (char *) ""; ///< Public domain for clients to connect to (cvar).
 int nptIPPort = 0; ///< Server TCP port (cvar).
+int shellMetricsInterval = 1000; ///< Milliseconds between metrics sent to shell users (cvar).
 
 static de::duint16 Server_ListenPort()
 {
@@ -71,6 +73,7 @@ DENG2_PIMPL(ServerSystem)
 
     QHash<Id, RemoteUser *> users;
     ShellUsers shellUsers;
+    ServerMetrics metrics;
 
     Impl(Public *i) : Base(i) {}
     ~Impl() { deinit(); }
@@ -139,6 +142,27 @@ DENG2_PIMPL(ServerSystem)
         return *users[id];
     }
 
+    /**
+     * Sends performance metrics to shell users at the configured interval. The
+     * metrics are only collected while someone is there to see them.
+     */
+    void updateMetrics(TimeSpan runTime, TimeSpan transmitTime)
+    {
+        if (!shellUsers.count() || shellMetricsInterval <= 0)
+        {
+            metrics.reset();
+            return;
+        }
+
+        metrics.sampleTic(runTime, transmitTime);
+
+        if (metrics.isDue(shellMetricsInterval / 1000.0))
+        {
+            QScopedPointer<shell::MetricsPacket> packet(metrics.takePacket());
+            shellUsers.sendToAll(*packet);
+        }
+    }
+
     void updateBeacon(Clock const &clock)
     {
         if (lastBeaconUpdateAt.since() > 0.5)
@@ -193,16 +217,18 @@ DENG2_PIMPL(ServerSystem)
                 RemoteUser *user = users[plr->remoteUserId];
                 if (first)
                 {
-                    LOG_MSG(_E(m) "P# Name:      Nd Jo Hs Rd Gm Age:");
+                    LOG_MSG(_E(m) "P# Name:      Nd Jo Hs Rd Gm Frame: Ms:    Age:");
                     first = false;
                 }
 
-                LOG_MSG(_E(m) "%2i %-10s %2i %c  %c  %c  %c  %f sec")
+                LOG_MSG(_E(m) "%2i %-10s %2i %c  %c  %c  %c  %5i  %5.2f  %f sec")
                         << i << plr->name << plr->remoteUserId
                         << (user->isJoined()? '*' : ' ')
                         << (plr->handshake? '*' : ' ')
                         << (plr->ready? '*' : ' ')
                         << (plr->publicData().inGame? '*' : ' ')
+                        << dint(Sv_LastFrameSize(i))
+                        << Sv_FrameEncodeTime(i) * 1000
                         << (Timer_RealSeconds() - plr->enterTime);
             }
         }
@@ -294,11 +320,15 @@ void ServerSystem::timeChanged(Clock const &clock)
 
     DENG2_TEXT_APP->loop().setRate(count? 35 : 3);
 
+    Time const startedAt;
     Loop_RunTics();
+    TimeSpan const runTime = startedAt.since();
 
     // Update clients at regular intervals.
     Sv_TransmitFrame();
 
+    d->updateMetrics(runTime, startedAt.since() - runTime);
+
     d->updateBeacon(clock);
 
     /// @todo There's no need to queue packets via net_buf, just handle
@@ -354,6 +384,9 @@ void Server_Register()
 {
     C_VAR_CHARPTR("net-ip-address", &nptIPAddress, 0, 0, 0);
     C_VAR_INT    ("net-ip-port",    &nptIPPort, CVF_NO_MAX, 0, 0);
+    C_VAR_INT    ("server-shell-metrics", &shellMetricsInterval, CVF_NO_MAX, 0, 0);
+
+    C_CMD("ratecompare", NULL, RateCompare);
 
 #ifdef _DEBUG
     C_CMD("netfreq", NULL, NetFreqs);
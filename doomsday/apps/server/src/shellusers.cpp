@@ -74,6 +74,17 @@ int ShellUsers::count() const
     return d->users.size();
 }
 
+void ShellUsers::sendToAll(Packet const &packet)
+{
+    foreach (ShellUser *user, d->users)
+    {
+        if (user->status() == shell::Link::Connected)
+        {
+            *user << packet;
+        }
+    }
+}
+
 void ShellUsers::worldMapChanged()
 {
     foreach (ShellUser *user, d->users)
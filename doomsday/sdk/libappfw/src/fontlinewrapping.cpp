@@ -1,8 +1,4 @@
 /** @file fontlinewrapping.cpp  Font line wrapping.
- *
- * @todo Performance|Refactor: Add a class dedicated for measuring text. Allow
- * measuring in increments, one character at a time, without re-measuring the
- * whole range. Allow seeking forward and backward with the measurer.
  *
  * @authors Copyright (c) 2013-2017 Jaakko Keränen <jaakko.keranen@iki.fi>
  *
@@ -23,9 +19,11 @@
 #include "de/FontLineWrapping"
 #include "de/BaseGuiApp"
 #include <de/Image>
+#include <de/TextMeasurer>
 
 #include <QMap>
 #include <atomic>
+#include <memory>
 
 namespace de {
 
@@ -76,6 +74,7 @@ DENG2_PIMPL_NOREF(FontLineWrapping)
     int indent;                 ///< Current left indentation (in pixels).
     QVector<int> prevIndents;
     int tabStop;
+    std::unique_ptr<TextMeasurer> measurer; ///< Advances of the characters of the text.
     std::atomic_bool cancelled { false };
 
     DENG2_ERROR(CancelError);
@@ -229,16 +228,6 @@ DENG2_PIMPL_NOREF(FontLineWrapping)
         return true;
     }
 
-    bool containsNewline(Rangei const &range) const
-    {
-        for (int i = range.start; i < range.end; ++i)
-        {
-            if (text.at(i) == NEWLINE)
-                return true;
-        }
-        return false;
-    }
-
     bool containsTabs(Rangei const &range) const
     {
         Font::RichFormatRef rich = format.subRange(range);
@@ -251,27 +240,53 @@ DENG2_PIMPL_NOREF(FontLineWrapping)
         return false;
     }
 
-    int findMaxWrap(int begin, int availableWidth) const
+    /**
+     * Finds the longest range starting at @a range.start that fits in @a availableWidth.
+     * The range ends at a newline.
+     *
+     * @param range           Range to fit.
+     * @param availableWidth  Maximum width.
+     * @param fitWidth        The exact advance width of the returned range is written
+     *                        here.
+     *
+     * @return End of the fitting range.
+     */
+    int findMaxWrap(Rangei const &range, int availableWidth, int &fitWidth) const
     {
-        int width = 0;
-        int end = begin;
-        while (end < text.size() && text.at(end) != NEWLINE)
+        checkCancel();
+
+        int const begin = range.start;
+        int end = measurer->findFit(begin, range.end, availableWidth);
+        for (int i = begin; i < end; ++i)
         {
-            int const charWidth = rangeAdvanceWidth(Rangei(end, end + 1));
-            if (width + charWidth > availableWidth)
+            if (text.at(i) == NEWLINE)
             {
-                // Does not fit any more.
+                end = i;
                 break;
             }
-            width += charWidth;
-            ++end;
         }
         // Fine-tune the result to be accurate (kerning is ignored and rouding errors
         // affect the end result when checking width character by character).
-        while (end > begin && rangeAdvanceWidth(Rangei(begin, end)) > availableWidth)
+        fitWidth = rangeAdvanceWidth(Rangei(begin, end));
+        if (fitWidth > availableWidth)
         {
-            // Came out too long.
-            end--;
+            while (end > begin && fitWidth > availableWidth)
+            {
+                // Came out too long.
+                fitWidth = rangeAdvanceWidth(Rangei(begin, --end));
+            }
+        }
+        else
+        {
+            while (end < range.end && text.at(end) != NEWLINE)
+            {
+                int const longer = rangeAdvanceWidth(Rangei(begin, end + 1));
+                if (longer > availableWidth) break;
+
+                // Came out too short.
+                fitWidth = longer;
+                end++;
+            }
         }
         return end;
     }
@@ -358,26 +373,18 @@ DENG2_PIMPL_NOREF(FontLineWrapping)
             // Range for the remainder of the text.
             Rangei const range(begin, rangeToWrap.end);
 
-            // Quick check: does the complete remainder fit?
-            if (!containsNewline(range))
+            // Newlines always cause a wrap.
+            int fitWidth = 0;
+            int end = findMaxWrap(range, availWidth, fitWidth);
+            int const wrapPosMax = end;
+
+            // Does the complete remainder fit?
+            if (end == range.end)
             {
-                int visWidth = rangeAdvanceWidth(range);
-                if (visWidth <= availWidth)
-                {
-                    wrappedLines << makeLine(range, visWidth);
-                    break;
-                }
+                wrappedLines << makeLine(range, fitWidth);
+                break;
             }
 
-            // Newlines always cause a wrap.
-#if 0
-            int wrapPosMax;
-            int end = findMaxWrap(begin, availWidth, wrapPosMax);
-#else
-            int end = findMaxWrap(begin, availWidth);
-            int wrapPosMax = end;
-#endif
-
             if (end < rangeToWrap.end && text.at(end) == NEWLINE)
             {
                 // The newline will be omitted from the wrapped lines.
@@ -562,6 +569,7 @@ void FontLineWrapping::reset()
     DENG2_GUARD(this);
 
     d->clearLines();
+    d->measurer.reset();
     d->indent = 0;
     d->prevIndents.clear();
     d->tabStop = 0;
@@ -587,6 +595,7 @@ void FontLineWrapping::wrapTextToWidth(String const &text, Font::RichFormat cons
     d->maxWidth = maxWidth;
     d->text     = newText;
     d->format   = format;
+    d->measurer.reset(new TextMeasurer(*d->font, d->text, d->format));
 
     // When tabs are used, we must first determine the maximum width of each tab stop.
     if (d->containsTabs(Rangei(0, text.size())))
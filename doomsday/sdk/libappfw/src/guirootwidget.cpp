@@ -166,7 +166,7 @@ DENG2_PIMPL(GuiRootWidget)
         if (atlas.isNull() || atlas->totalSize() == Atlas::Size())
         {
             window->glActivate();
-            atlas.reset(AtlasTexture::newWithKdTreeAllocator(
+            atlas.reset(AtlasTexture::newWithSkylineAllocator(
                             Atlas::BackingStore | Atlas::AllowDefragment,
                             GLTexture::maximumSize().min(GLTexture::Size(4096, 4096))));
             uTexAtlas = *atlas;
@@ -428,6 +428,12 @@ void GuiRootWidget::update()
         // Allow GL operations.
         window().glActivate();
 
+        if (d->atlas)
+        {
+            // Gradually compact the atlas before widgets update their geometry.
+            d->atlas->defragmentStep();
+        }
+
         RootWidget::update();
         d->focusIndicator->update();
     }
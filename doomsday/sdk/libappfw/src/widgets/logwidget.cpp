@@ -456,7 +456,7 @@ public Font::RichFormat::IStyle
     void glInit()
     {
         // Private atlas for the composed entry text lines.
-        entryAtlas = AtlasTexture::newWithRowAllocator(
+        entryAtlas = AtlasTexture::newWithSkylineAllocator(
                 Atlas::BackingStore | Atlas::AllowDefragment,
                 GLTexture::maximumSize().min(Atlas::Size(4096, 2048)));
 
@@ -859,6 +859,12 @@ void LogWidget::update()
     d->fetchNewCachedEntries();
     d->prune();
 
+    if (d->entryAtlas)
+    {
+        // Released entries leave gaps that are gradually compacted.
+        d->entryAtlas->defragmentStep();
+    }
+
     // The log widget's geometry is fully dynamic -- regenerated on every frame.
     d->updateGeometry();
 }
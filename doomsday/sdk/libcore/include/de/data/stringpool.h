@@ -171,6 +171,16 @@ public:
      */
     Id isInterned(String str) const;
 
+    /**
+     * Is @a str considered to be in the pool? Looking up a part of a string this way
+     * does not require making a copy of it.
+     *
+     * @param str   String to look for.
+     *
+     * @return  Id of the matching string; else @c 0.
+     */
+    Id isInterned(QStringRef const &str) const;
+
     /**
      * Retrieve an immutable copy of the interned string associated with the
      * string @a id.
@@ -0,0 +1,138 @@
+/** @file utf8string.h  UTF-8 text string with inline storage for short strings.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDENG2_UTF8STRING_H
+#define LIBDENG2_UTF8STRING_H
+
+#include "../libcore.h"
+#include "../String"
+
+#include <QStringRef>
+
+namespace de {
+
+/**
+ * UTF-8 encoded text string. Short strings are kept in inline storage inside the
+ * object, so creating, copying and destroying them does not allocate memory.
+ *
+ * Unlike String, the contents are not implicitly shared: copying a long string
+ * copies its contents. The contents are always null-terminated, so c_str() can be
+ * passed to C APIs without conversion.
+ *
+ * Comparisons are made byte-wise, which for UTF-8 is the same as comparing the
+ * Unicode code points. Use caseFolded() to make case-insensitive keys.
+ *
+ * @ingroup data
+ */
+class DENG2_PUBLIC Utf8String
+{
+public:
+    /// Maximum length of a string (in bytes) that fits in the inline storage.
+    static dsize const INLINE_CAPACITY = 23;
+
+public:
+    Utf8String();
+    Utf8String(char const *nullTerminatedUtf8);
+    Utf8String(char const *utf8, dsize length);
+    Utf8String(QString const &text);
+    Utf8String(QStringRef const &text);
+    Utf8String(QChar const *text, dsize length);
+    Utf8String(Utf8String const &other);
+    Utf8String(Utf8String &&moved);
+
+    ~Utf8String();
+
+    Utf8String &operator = (Utf8String const &other);
+    Utf8String &operator = (Utf8String &&moved);
+
+    inline bool isEmpty() const { return !_size; }
+
+    /// Length of the string in bytes (not including the terminating null).
+    inline dsize size() const { return _size; }
+
+    /// Determines if the contents are in the inline storage.
+    inline bool isInline() const { return _chars == _inline; }
+
+    /// Null-terminated UTF-8 contents.
+    inline char const *c_str() const { return _chars; }
+
+    inline char const *begin() const { return _chars; }
+    inline char const *end() const { return _chars + _size; }
+
+    void clear();
+
+    /**
+     * Makes sure there is room for at least @a size bytes without reallocating.
+     */
+    void reserve(dsize size);
+
+    Utf8String &append(char const *utf8, dsize length);
+    Utf8String &append(QChar const *text, dsize length);
+    Utf8String &operator += (Utf8String const &other);
+    Utf8String &operator += (char ch);
+
+    /**
+     * Compares the bytes of the strings.
+     *
+     * @return  Negative, zero, or positive, like @c strcmp.
+     */
+    dint compare(Utf8String const &other) const;
+
+    inline bool operator == (Utf8String const &other) const {
+        return _size == other._size && !compare(other);
+    }
+    inline bool operator != (Utf8String const &other) const {
+        return !(*this == other);
+    }
+    inline bool operator < (Utf8String const &other) const {
+        return compare(other) < 0;
+    }
+
+    /**
+     * Converts the string to a (UTF-16) String.
+     */
+    String toString() const;
+
+    /**
+     * Produces the UTF-8 encoding of @a text with the case folded, for use as a key
+     * in case-insensitive comparisons.
+     */
+    static Utf8String caseFolded(QChar const *text, dsize length);
+
+    static Utf8String caseFolded(QStringRef const &text);
+
+    /**
+     * Returns the total number of times any Utf8String has allocated memory for its
+     * contents. Useful for measuring the benefit of the inline storage.
+     */
+    static duint64 heapAllocationCount();
+
+private:
+    void appendUtf16(QChar const *text, dsize length, bool foldCase);
+
+    char *_chars;     ///< Points to _inline or to heap memory.
+    dsize _size;
+    dsize _capacity;  ///< Bytes available in _chars (not including the terminator).
+    char _inline[INLINE_CAPACITY + 1];
+};
+
+DENG2_PUBLIC uint qHash(Utf8String const &str);
+
+} // namespace de
+
+#endif // LIBDENG2_UTF8STRING_H
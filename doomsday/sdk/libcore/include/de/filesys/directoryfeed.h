@@ -24,6 +24,7 @@
 #include "../NativePath"
 
 #include <QFlags>
+#include <QHash>
 
 namespace de {
 
@@ -56,6 +57,12 @@ public:
         /// subfolders.
         PopulateNativeSubfolders = 0x4,
 
+        /// Keep track of changes in the native directory, so that repopulating only
+        /// needs to check the entries that have changed. If changes cannot be tracked
+        /// (not supported by the platform, or too many changes), the entire directory
+        /// is rescanned.
+        WatchChanges = 0x8,
+
         OnlyThisFolder = 0,
 
         DefaultFlags = PopulateNativeSubfolders
@@ -119,10 +126,15 @@ public:
 protected:
     void populateSubFolder(Folder const &folder, String const &entryName);
     void populateFile(Folder const &folder, String const &entryName, PopulatedFiles &populated);
+    PopulatedFiles populateChanges(Folder const &folder, QHash<String, duint32> const &changed);
+    bool isWatchedEntry(File const &file) const;
+    bool pruneEntry(File &file) const;
 
 private:
     NativePath const _nativePath;
     Flags _mode;
+
+    DENG2_PRIVATE(d)
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(DirectoryFeed::Flags)
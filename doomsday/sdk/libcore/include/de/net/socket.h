@@ -23,6 +23,7 @@
 #include "../libcore.h"
 #include "../IByteArray"
 #include "../Address"
+#include "../Block"
 #include "../Transmitter"
 
 #include <QTcpSocket>
@@ -142,6 +143,23 @@ public:
      */
     Socket &operator << (IByteArray const &data);
 
+    /**
+     * Sends a message that has already been encoded with encodeMessage().
+     *
+     * @param encoded  Encoded message.
+     */
+    void sendEncoded(Block const &encoded);
+
+    /**
+     * Compresses a message and prepends the protocol header to it, as send() does.
+     * Independent of any socket, so this can be called in any thread.
+     *
+     * @param packet  Data to encode.
+     *
+     * @return Message ready for sendEncoded().
+     */
+    static Block encodeMessage(IByteArray const &packet);
+
     /**
      * Returns the next received message. If nothing has been received,
      * returns @c NULL.
@@ -86,7 +86,7 @@ struct PathTree::Impl
         PathTree::Nodes const &hash = self.nodes(nodeType);
 
         // Have we already encountered this?
-        PathTree::SegmentId segmentId = segments.isInterned(segment);
+        PathTree::SegmentId segmentId = segments.isInterned(segment.toStringRef());
         if (segmentId)
         {
             // The name is known. Perhaps we have.
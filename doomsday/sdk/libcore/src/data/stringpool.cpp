@@ -22,6 +22,7 @@
 #include "de/Writer"
 #include "de/Lockable"
 #include "de/Guard"
+#include "de/Utf8String"
 
 #include <vector>
 #include <list>
@@ -45,6 +46,9 @@ typedef uint InternalId;
 
 /**
  * Case-insensitive text string (String).
+ *
+ * Strings are ordered by their case-folded UTF-8 keys, which are short enough to
+ * not need memory allocations in most cases and are quick to compare.
  */
 class CaselessString : public ISerializable
 {
@@ -54,16 +58,29 @@ public:
     {}
 
     CaselessString(QString text)
-        : _str(text), _id(0), _userValue(0), _userPointer(0)
+        : _str(text), _key(makeKey(_str)), _id(0), _userValue(0), _userPointer(0)
     {}
 
     CaselessString(CaselessString const &other)
-        : ISerializable(), _str(other._str), _id(other._id), _userValue(other._userValue), _userPointer(0)
+        : ISerializable(), _str(other._str), _key(other._key), _id(other._id)
+        , _userValue(other._userValue), _userPointer(0)
     {}
 
+    /**
+     * Makes a string that can only be used for looking up interned strings, as
+     * the text itself is not kept.
+     */
+    static CaselessString lookupKey(QStringRef const &text)
+    {
+        CaselessString str;
+        str._key = Utf8String::caseFolded(text);
+        return str;
+    }
+
     void setText(String &text)
     {
         _str = text;
+        _key = makeKey(_str);
     }
     operator String const *() const {
         return &_str;
@@ -72,10 +89,10 @@ public:
         return _str;
     }
     bool operator < (CaselessString const &other) const {
-        return _str.compare(other, Qt::CaseInsensitive) < 0;
+        return _key < other._key;
     }
     bool operator == (CaselessString const &other) const {
-        return !_str.compare(other, Qt::CaseInsensitive);
+        return _key == other._key;
     }
     InternalId id() const {
         return _id;
@@ -101,10 +118,16 @@ public:
     }
     void operator << (Reader &from) {
         from >> _str >> _id >> _userValue;
+        _key = makeKey(_str);
     }
 
 private:
+    static Utf8String makeKey(QString const &text) {
+        return Utf8String::caseFolded(text.constData(), dsize(text.size()));
+    }
+
     String _str;
+    Utf8String _key; ///< Case-folded UTF-8 text, used for ordering.
     InternalId _id; ///< The id that refers to this string.
     uint _userValue;
     void *_userPointer;
@@ -194,15 +217,15 @@ DENG2_PIMPL_NOREF(StringPool), public Lockable
         DENG2_ASSERT(count == idMap.size() - available.size());
     }
 
-    Interns::iterator findIntern(String text)
+    Interns::iterator findIntern(QStringRef const &text)
     {
-        CaselessString const key(text);
+        CaselessString const key = CaselessString::lookupKey(text);
         return interns.find(CaselessStringRef(&key)); // O(log n)
     }
 
-    Interns::const_iterator findIntern(String text) const
+    Interns::const_iterator findIntern(QStringRef const &text) const
     {
-        CaselessString const key(text);
+        CaselessString const key = CaselessString::lookupKey(text);
         return interns.find(CaselessStringRef(&key)); // O(log n)
     }
 
@@ -316,7 +339,7 @@ StringPool::Id StringPool::intern(String str)
 {
     DENG2_GUARD(d);
     
-    Interns::iterator found = d->findIntern(str); // O(log n)
+    Interns::iterator found = d->findIntern(QStringRef(&str)); // O(log n)
     if (found != d->interns.end())
     {
         // Already got this one.
@@ -390,6 +413,11 @@ void *StringPool::userPointer(Id id) const
 }
 
 StringPool::Id StringPool::isInterned(String str) const
+{
+    return isInterned(QStringRef(&str));
+}
+
+StringPool::Id StringPool::isInterned(QStringRef const &str) const
 {
     DENG2_GUARD(d);
 
@@ -431,7 +459,7 @@ bool StringPool::remove(String str)
 {
     DENG2_GUARD(d);
 
-    Interns::iterator found = d->findIntern(str); // O(log n)
+    Interns::iterator found = d->findIntern(QStringRef(&str)); // O(log n)
     if (found != d->interns.end())
     {
         d->releaseAndDestroy(found->id(), &found); // O(1) (amortized)
@@ -531,8 +559,8 @@ void StringPool::print() const
     duint count = 0;
     forAll([this, &count] (Id id)
     {
-        QByteArray strUtf8 = string(id).toUtf8();
-        fprintf(stderr, "%*u %5u %s\n", padding, count++, id, strUtf8.constData());
+        Utf8String const strUtf8(stringRef(id));
+        fprintf(stderr, "%*u %5u %s\n", padding, count++, id, strUtf8.c_str());
         return LoopContinue;
     });
     fprintf(stderr, "  There is %u %s in the pool.\n", duint( size() ),
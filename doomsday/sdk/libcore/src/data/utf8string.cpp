@@ -0,0 +1,285 @@
+/** @file utf8string.cpp  UTF-8 text string with inline storage for short strings.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/Utf8String"
+
+#include <atomic>
+#include <cstring>
+
+namespace de {
+
+static std::atomic<duint64> utf8StringHeapAllocs { 0 };
+
+/**
+ * Decodes the next code point from UTF-16. Unpaired surrogates are replaced with
+ * U+FFFD.
+ */
+static duint32 nextCodePoint(QChar const *&pos, QChar const *end)
+{
+    duint32 const ch = pos->unicode();
+    pos++;
+    if (QChar::isHighSurrogate(ch))
+    {
+        if (pos != end && pos->isLowSurrogate())
+        {
+            return QChar::surrogateToUcs4(ushort(ch), (pos++)->unicode());
+        }
+        return 0xfffd;
+    }
+    if (QChar::isLowSurrogate(ch))
+    {
+        return 0xfffd;
+    }
+    return ch;
+}
+
+static inline dsize utf8Length(duint32 cp)
+{
+    return cp < 0x80? 1 : cp < 0x800? 2 : cp < 0x10000? 3 : 4;
+}
+
+/**
+ * Encodes a code point as UTF-8.
+ *
+ * @return  Number of bytes written to @a out (at most 4).
+ */
+static dsize encodeUtf8(duint32 cp, char *out)
+{
+    if (cp < 0x80)
+    {
+        out[0] = char(cp);
+        return 1;
+    }
+    if (cp < 0x800)
+    {
+        out[0] = char(0xc0 | (cp >> 6));
+        out[1] = char(0x80 | (cp & 0x3f));
+        return 2;
+    }
+    if (cp < 0x10000)
+    {
+        out[0] = char(0xe0 | (cp >> 12));
+        out[1] = char(0x80 | ((cp >> 6) & 0x3f));
+        out[2] = char(0x80 | (cp & 0x3f));
+        return 3;
+    }
+    out[0] = char(0xf0 | (cp >> 18));
+    out[1] = char(0x80 | ((cp >> 12) & 0x3f));
+    out[2] = char(0x80 | ((cp >> 6) & 0x3f));
+    out[3] = char(0x80 | (cp & 0x3f));
+    return 4;
+}
+
+Utf8String::Utf8String()
+    : _chars(_inline), _size(0), _capacity(INLINE_CAPACITY)
+{
+    _inline[0] = 0;
+}
+
+Utf8String::Utf8String(char const *nullTerminatedUtf8) : Utf8String()
+{
+    if (nullTerminatedUtf8)
+    {
+        append(nullTerminatedUtf8, std::strlen(nullTerminatedUtf8));
+    }
+}
+
+Utf8String::Utf8String(char const *utf8, dsize length) : Utf8String()
+{
+    append(utf8, length);
+}
+
+Utf8String::Utf8String(QString const &text) : Utf8String()
+{
+    append(text.constData(), dsize(text.size()));
+}
+
+Utf8String::Utf8String(QStringRef const &text) : Utf8String()
+{
+    append(text.constData(), dsize(text.size()));
+}
+
+Utf8String::Utf8String(QChar const *text, dsize length) : Utf8String()
+{
+    append(text, length);
+}
+
+Utf8String::Utf8String(Utf8String const &other) : Utf8String()
+{
+    append(other._chars, other._size);
+}
+
+Utf8String::Utf8String(Utf8String &&moved) : Utf8String()
+{
+    *this = std::move(moved);
+}
+
+Utf8String::~Utf8String()
+{
+    if (!isInline()) delete [] _chars;
+}
+
+Utf8String &Utf8String::operator = (Utf8String const &other)
+{
+    if (this != &other)
+    {
+        _size = 0;
+        append(other._chars, other._size);
+    }
+    return *this;
+}
+
+Utf8String &Utf8String::operator = (Utf8String &&moved)
+{
+    if (this == &moved) return *this;
+
+    if (moved.isInline())
+    {
+        _size = 0;
+        append(moved._chars, moved._size);
+    }
+    else
+    {
+        // Take over the allocated memory.
+        if (!isInline()) delete [] _chars;
+        _chars    = moved._chars;
+        _size     = moved._size;
+        _capacity = moved._capacity;
+
+        moved._chars    = moved._inline;
+        moved._capacity = INLINE_CAPACITY;
+    }
+    moved._size = 0;
+    moved._chars[0] = 0;
+    return *this;
+}
+
+void Utf8String::clear()
+{
+    _size = 0;
+    _chars[0] = 0;
+}
+
+void Utf8String::reserve(dsize size)
+{
+    if (size <= _capacity) return;
+
+    dsize const newCapacity = de::max(size, _capacity * 2);
+    char *chars = new char[newCapacity + 1];
+    std::memcpy(chars, _chars, _size + 1);
+    if (!isInline()) delete [] _chars;
+    _chars    = chars;
+    _capacity = newCapacity;
+
+    utf8StringHeapAllocs++;
+}
+
+Utf8String &Utf8String::append(char const *utf8, dsize length)
+{
+    if (!length) return *this;
+
+    reserve(_size + length);
+    std::memcpy(_chars + _size, utf8, length);
+    _size += length;
+    _chars[_size] = 0;
+    return *this;
+}
+
+Utf8String &Utf8String::append(QChar const *text, dsize length)
+{
+    appendUtf16(text, length, false);
+    return *this;
+}
+
+void Utf8String::appendUtf16(QChar const *text, dsize length, bool foldCase)
+{
+    QChar const *end = text + length;
+
+    // Reserve exactly what is needed so short strings stay inline.
+    dsize needed = 0;
+    for (QChar const *pos = text; pos != end; )
+    {
+        duint32 const cp = nextCodePoint(pos, end);
+        needed += utf8Length(foldCase? QChar::toCaseFolded(cp) : cp);
+    }
+    reserve(_size + needed);
+
+    while (text != end)
+    {
+        duint32 const cp = nextCodePoint(text, end);
+        _size += encodeUtf8(foldCase? QChar::toCaseFolded(cp) : cp, _chars + _size);
+    }
+    _chars[_size] = 0;
+}
+
+Utf8String &Utf8String::operator += (Utf8String const &other)
+{
+    if (&other == this)
+    {
+        Utf8String const copy(other);
+        return append(copy._chars, copy._size);
+    }
+    return append(other._chars, other._size);
+}
+
+Utf8String &Utf8String::operator += (char ch)
+{
+    return append(&ch, 1);
+}
+
+dint Utf8String::compare(Utf8String const &other) const
+{
+    dint const result = std::memcmp(_chars, other._chars, de::min(_size, other._size));
+    if (result) return result;
+    return _size < other._size? -1 : _size > other._size? 1 : 0;
+}
+
+String Utf8String::toString() const
+{
+    return QString::fromUtf8(_chars, int(_size));
+}
+
+Utf8String Utf8String::caseFolded(QChar const *text, dsize length) // static
+{
+    Utf8String folded;
+    folded.appendUtf16(text, length, true);
+    return folded;
+}
+
+Utf8String Utf8String::caseFolded(QStringRef const &text) // static
+{
+    return caseFolded(text.constData(), dsize(text.size()));
+}
+
+duint64 Utf8String::heapAllocationCount() // static
+{
+    return utf8StringHeapAllocs;
+}
+
+uint qHash(Utf8String const &str)
+{
+    // FNV-1a.
+    duint32 hash = 2166136261u;
+    for (char const *c = str.begin(); c != str.end(); ++c)
+    {
+        hash = (hash ^ duint8(*c)) * 16777619u;
+    }
+    return hash;
+}
+
+} // namespace de
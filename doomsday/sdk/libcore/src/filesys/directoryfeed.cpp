@@ -23,14 +23,213 @@
 #include "de/FS"
 #include "de/Date"
 #include "de/App"
+#include "de/Guard"
+#include "de/Lockable"
 
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QHash>
+
+#ifdef __linux__
+#  define DENG2_HAVE_INOTIFY
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#  include <cerrno>
+#  include <cstring>
+#endif
 
 using namespace de;
 
+namespace de {
+namespace internal {
+
+/**
+ * Changes in a watched native directory since the directory was last populated.
+ */
+struct DirectoryChanges
+{
+    int watch = -1;                ///< Watch descriptor, or -1 if not watched.
+    QHash<String, duint32> names;  ///< Created, modified, or deleted entries, with the
+                                   ///< serial number of the latest event.
+    bool rescan = false;           ///< Changes have been lost; everything must be checked.
+};
+
+/**
+ * Collects changes in native directories. On Linux, inotify is used; elsewhere
+ * directories cannot be watched.
+ *
+ * The watcher must be locked when accessing the DirectoryChanges it updates. Other
+ * locks (e.g., folders) must not be acquired while the watcher is locked.
+ */
+class DirectoryWatcher : public Lockable
+{
+public:
+    static DirectoryWatcher &get()
+    {
+        static DirectoryWatcher watcher;
+        return watcher;
+    }
+
+    ~DirectoryWatcher()
+    {
+#ifdef DENG2_HAVE_INOTIFY
+        if (_fd >= 0) close(_fd);
+#endif
+    }
+
+    /**
+     * Starts collecting the changes of a native directory into @a changes. Must be
+     * locked.
+     *
+     * @return @c true, if the directory is being watched.
+     */
+    bool watch(NativePath const &path, DirectoryChanges &changes)
+    {
+        DENG2_ASSERT(changes.watch < 0);
+#ifdef DENG2_HAVE_INOTIFY
+        if (_fd < 0) return false;
+
+        int const wd = inotify_add_watch(_fd, QFile::encodeName(path.toString()).constData(),
+                                         IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB |
+                                         IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO |
+                                         IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+        if (wd < 0) return false;
+
+        changes.watch = wd;
+        _watched.insert(wd, &changes);
+        return true;
+#else
+        DENG2_UNUSED2(path, changes);
+        return false;
+#endif
+    }
+
+    /// Stops collecting changes into @a changes. Must be locked.
+    void unwatch(DirectoryChanges &changes)
+    {
+        if (changes.watch < 0) return;
+#ifdef DENG2_HAVE_INOTIFY
+        _watched.remove(changes.watch, &changes);
+        if (!_watched.contains(changes.watch))
+        {
+            // Another feed may be watching the same directory.
+            inotify_rm_watch(_fd, changes.watch);
+        }
+#endif
+        changes.watch = -1;
+    }
+
+    /// Reads all pending events and updates the watched DirectoryChanges. Must be
+    /// locked.
+    void update()
+    {
+#ifdef DENG2_HAVE_INOTIFY
+        if (_fd < 0) return;
+
+        char buf[16384] __attribute__((aligned(__alignof__(inotify_event))));
+        for (;;)
+        {
+            ssize_t const len = read(_fd, buf, sizeof(buf));
+            if (len <= 0)
+            {
+                if (len < 0 && errno == EINTR) continue;
+                break; // No more events (EAGAIN).
+            }
+            for (char const *pos = buf; pos < buf + len; )
+            {
+                auto const *event = reinterpret_cast<inotify_event const *>(pos);
+                handleEvent(*event);
+                pos += sizeof(inotify_event) + event->len;
+            }
+        }
+#endif
+    }
+
+private:
+    DirectoryWatcher()
+    {
+#ifdef DENG2_HAVE_INOTIFY
+        _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (_fd < 0)
+        {
+            LOG_RES_WARNING("Cannot watch native directories for changes: %s") << strerror(errno);
+        }
+#endif
+    }
+
+#ifdef DENG2_HAVE_INOTIFY
+    void handleEvent(inotify_event const &event)
+    {
+        ++_serial;
+        if (event.mask & IN_Q_OVERFLOW)
+        {
+            // Events have been lost.
+            for (DirectoryChanges *changes : _watched)
+            {
+                changes->rescan = true;
+            }
+            return;
+        }
+        for (DirectoryChanges *changes : _watched.values(event.wd))
+        {
+            if (event.mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT))
+            {
+                // The directory itself is gone (or changed).
+                changes->rescan = true;
+                if (event.mask & IN_IGNORED)
+                {
+                    // The watch has been removed by the system.
+                    changes->watch = -1;
+                }
+            }
+            else if (event.len > 0)
+            {
+                changes->names.insert(QFile::decodeName(event.name), _serial);
+            }
+        }
+        if (event.mask & IN_IGNORED)
+        {
+            _watched.remove(event.wd);
+        }
+    }
+
+    int _fd = -1;
+    duint32 _serial = 0;
+#endif
+    QMultiHash<int, DirectoryChanges *> _watched;
+};
+
+} // namespace internal
+} // namespace de
+
+DENG2_PIMPL_NOREF(DirectoryFeed)
+{
+    internal::DirectoryChanges changes;
+    bool populated = false; ///< Fully populated at least once.
+    bool pruneUpdated = false; ///< Watcher updated during the current pruning pass.
+
+    ~Impl()
+    {
+        if (changes.watch < 0) return;
+
+        auto &watcher = internal::DirectoryWatcher::get();
+        DENG2_GUARD(watcher);
+        watcher.unwatch(changes);
+    }
+
+    /**
+     * Determines if only the changed entries need to be checked. Must be called with
+     * the watcher locked.
+     */
+    bool isTrackingChanges() const
+    {
+        return populated && changes.watch >= 0 && !changes.rescan;
+    }
+};
+
 DirectoryFeed::DirectoryFeed(NativePath const &nativePath, Flags const &mode)
-    : _nativePath(nativePath), _mode(mode) {}
+    : _nativePath(nativePath), _mode(mode), d(new Impl) {}
 
 DirectoryFeed::~DirectoryFeed()
 {}
@@ -63,6 +262,41 @@ Feed::PopulatedFiles DirectoryFeed::populate(Folder const &folder)
         /// @throw NotFoundError The native directory was not accessible.
         throw NotFoundError("DirectoryFeed::populate", "Path '" + _nativePath + "' inaccessible");
     }
+
+    if (_mode.testFlag(WatchChanges))
+    {
+        auto &watcher = internal::DirectoryWatcher::get();
+        bool incremental = false;
+        QHash<String, duint32> changed;
+        {
+            DENG2_GUARD(watcher);
+            watcher.update();
+            d->pruneUpdated = false; // The next pruning pass will update again.
+            if (d->isTrackingChanges())
+            {
+                incremental = true;
+                changed = d->changes.names;
+                d->changes.names.clear();
+            }
+            else
+            {
+                // Everything will be scanned, so earlier changes don't matter. Watching
+                // begins before scanning so that no changes are missed.
+                d->changes.names.clear();
+                d->changes.rescan = false;
+                if (d->changes.watch < 0)
+                {
+                    watcher.watch(_nativePath, d->changes);
+                }
+                d->populated = true;
+            }
+        }
+        if (incremental)
+        {
+            return populateChanges(folder, changed);
+        }
+    }
+
     QStringList nameFilters;
     nameFilters << "*";
     QDir::Filters dirFlags = QDir::Files | QDir::NoDotAndDotDot;
@@ -85,6 +319,57 @@ Feed::PopulatedFiles DirectoryFeed::populate(Folder const &folder)
     return populated;
 }
 
+Feed::PopulatedFiles DirectoryFeed::populateChanges(Folder const &folder,
+                                                    QHash<String, duint32> const &changed)
+{
+    PopulatedFiles populated;
+    QHash<String, duint32> unhandled;
+    for (auto i = changed.constBegin(); i != changed.constEnd(); ++i)
+    {
+        String const &entryName = i.key();
+        if (folder.has(entryName))
+        {
+            // The file was changed after it was checked for pruning. It will be
+            // checked again during the next population.
+            unhandled.insert(entryName, i.value());
+            continue;
+        }
+
+        QFileInfo const entry(_nativePath / entryName);
+        if (!entry.exists() || entry.isHidden())
+        {
+            // Deleted files have already been pruned.
+            continue;
+        }
+        if (entry.isDir())
+        {
+            if (_mode.testFlag(PopulateNativeSubfolders))
+            {
+                populateSubFolder(folder, entryName);
+            }
+        }
+        else
+        {
+            populateFile(folder, entryName, populated);
+        }
+    }
+
+    if (!unhandled.isEmpty())
+    {
+        auto &watcher = internal::DirectoryWatcher::get();
+        DENG2_GUARD(watcher);
+        for (auto i = unhandled.constBegin(); i != unhandled.constEnd(); ++i)
+        {
+            // Newer events take precedence.
+            if (!d->changes.names.contains(i.key()))
+            {
+                d->changes.names.insert(i.key(), i.value());
+            }
+        }
+    }
+    return populated;
+}
+
 void DirectoryFeed::populateSubFolder(Folder const &folder, String const &entryName)
 {
     LOG_AS("DirectoryFeed::populateSubFolder");
@@ -161,6 +446,68 @@ bool DirectoryFeed::prune(File &file) const
 {
     LOG_AS("DirectoryFeed::prune");
 
+    if (_mode.testFlag(WatchChanges) && isWatchedEntry(file))
+    {
+        auto &watcher = internal::DirectoryWatcher::get();
+        bool tracking;
+        duint32 serial = 0;
+        {
+            DENG2_GUARD(watcher);
+            if (!d->pruneUpdated)
+            {
+                // The pending events are read only once for all the files of the
+                // folder. Changes arriving later are caught when populating.
+                watcher.update();
+                d->pruneUpdated = true;
+            }
+            tracking = d->isTrackingChanges();
+            if (tracking)
+            {
+                auto found = d->changes.names.constFind(file.name());
+                if (found == d->changes.names.constEnd())
+                {
+                    // Nothing has happened to the file.
+                    return false;
+                }
+                serial = found.value();
+            }
+        }
+        if (tracking)
+        {
+            if (pruneEntry(file))
+            {
+                // The entry remains among the changes so it will be repopulated.
+                return true;
+            }
+            // The file is up to date, unless it has changed again meanwhile.
+            DENG2_GUARD(watcher);
+            if (d->changes.names.value(file.name()) == serial)
+            {
+                d->changes.names.remove(file.name());
+            }
+            return false;
+        }
+    }
+    return pruneEntry(file);
+}
+
+bool DirectoryFeed::isWatchedEntry(File const &file) const
+{
+    if (file.originFeed() == this) return true;
+
+    if (Folder const *subFolder = maybeAs<Folder>(file))
+    {
+        if (subFolder->feeds().size() == 1)
+        {
+            auto const *dirFeed = maybeAs<DirectoryFeed>(subFolder->feeds().front());
+            return dirFeed && dirFeed->_nativePath.fileNamePath() == _nativePath;
+        }
+    }
+    return false;
+}
+
+bool DirectoryFeed::pruneEntry(File &file) const
+{
     /// Rules for pruning:
     /// - A file sourced by NativeFile will be pruned if it's out of sync with the hard
     ///   drive version (size, time of last modification).
@@ -225,75 +225,13 @@ DENG2_PIMPL_NOREF(Socket)
         foreach (Message *msg, receivedMessages) delete msg;
     }
 
-    void serializeAndSendMessage(IByteArray const &packet)
+    void sendEncodedMessage(Block const &encoded)
     {
-        Block payload(packet);
-        Block huffData;
-        MessageHeader header;
-
-        // Let's find the appropriate compression method of the payload. First see
-        // if the encoded contents are under 128 bytes as Huffman codes.
-        if (payload.size() <= MAX_HUFFMAN_INPUT_SIZE) // Potentially short enough.
-        {
-            huffData = codec::huffmanEncode(payload);
-            if (int(huffData.size()) <= MAX_SIZE_SMALL)
-            {
-                // We'll use this.
-                header.isHuffmanCoded = true;
-                header.size = huffData.size();
-                payload = huffData;
-            }
-            // Even if that didn't seem suitable, we'll keep it to compare against
-            // the deflated payload.
-        }
-
-        /// @todo Messages broadcasted to multiple recipients are separately
-        /// compressed for each TCP send -- should do only one compression per
-        /// message.
-
-        if (!header.size) // Try deflate.
-        {
-            int const level = (payload.size() < 10*MAX_SIZE_MEDIUM? 1 /*fast*/ : 9 /*best*/);
-            Block const deflated = payload.compressed(level);
-
-            if (!deflated.size())
-            {
-                throw ProtocolError("Socket::send:", "Failed to deflate message payload");
-            }
-            if (deflated.size() > MAX_SIZE_LARGE)
-            {
-                throw ProtocolError("Socket::send",
-                                    QString("Compressed payload is too large (%1 bytes)").arg(deflated.size()));
-            }
-
-            // Choose the smallest compression.
-            if (huffData.size() && huffData.size() <= deflated.size() && int(huffData.size()) <= MAX_SIZE_MEDIUM)
-            {
-                // Huffman yielded smaller payload.
-                header.isHuffmanCoded = true;
-                header.size = huffData.size();
-                payload = huffData;
-            }
-            else
-            {
-                // Use the deflated payload.
-                header.isDeflated = true;
-                header.size = deflated.size();
-                payload = deflated;
-            }
-        }
-
-        // Write the message header.
-        Block dest;
-        Writer(dest) << header;
-        socket->write(dest);
-
         // Update totals (for statistics).
-        dsize total = dest.size() + payload.size();
-        bytesToBeWritten += total;
-        totalBytesWritten += total;
+        bytesToBeWritten += encoded.size();
+        totalBytesWritten += encoded.size();
 
-        socket->write(payload);
+        socket->write(encoded);
     }
 
     /**
@@ -553,7 +491,83 @@ void Socket::send(IByteArray const &packet, duint /*channel*/)
         throw DisconnectedError("Socket::send", "Socket is unavailable");
     }
 
-    d->serializeAndSendMessage(packet);
+    d->sendEncodedMessage(encodeMessage(packet));
+}
+
+void Socket::sendEncoded(Block const &encoded)
+{
+    if (!d->socket)
+    {
+        /// @throw DisconnectedError Sending is not possible because the socket has been closed.
+        throw DisconnectedError("Socket::sendEncoded", "Socket is unavailable");
+    }
+
+    d->sendEncodedMessage(encoded);
+}
+
+Block Socket::encodeMessage(IByteArray const &packet)
+{
+    Block payload(packet);
+    Block huffData;
+    MessageHeader header;
+
+    // Let's find the appropriate compression method of the payload. First see
+    // if the encoded contents are under 128 bytes as Huffman codes.
+    if (payload.size() <= MAX_HUFFMAN_INPUT_SIZE) // Potentially short enough.
+    {
+        huffData = codec::huffmanEncode(payload);
+        if (int(huffData.size()) <= MAX_SIZE_SMALL)
+        {
+            // We'll use this.
+            header.isHuffmanCoded = true;
+            header.size = huffData.size();
+            payload = huffData;
+        }
+        // Even if that didn't seem suitable, we'll keep it to compare against
+        // the deflated payload.
+    }
+
+    /// @todo Messages broadcasted to multiple recipients are separately
+    /// compressed for each TCP send -- should do only one compression per
+    /// message.
+
+    if (!header.size) // Try deflate.
+    {
+        int const level = (payload.size() < 10*MAX_SIZE_MEDIUM? 1 /*fast*/ : 9 /*best*/);
+        Block const deflated = payload.compressed(level);
+
+        if (!deflated.size())
+        {
+            throw ProtocolError("Socket::send:", "Failed to deflate message payload");
+        }
+        if (deflated.size() > MAX_SIZE_LARGE)
+        {
+            throw ProtocolError("Socket::send",
+                                QString("Compressed payload is too large (%1 bytes)").arg(deflated.size()));
+        }
+
+        // Choose the smallest compression.
+        if (huffData.size() && huffData.size() <= deflated.size() && int(huffData.size()) <= MAX_SIZE_MEDIUM)
+        {
+            // Huffman yielded smaller payload.
+            header.isHuffmanCoded = true;
+            header.size = huffData.size();
+            payload = huffData;
+        }
+        else
+        {
+            // Use the deflated payload.
+            header.isDeflated = true;
+            header.size = deflated.size();
+            payload = deflated;
+        }
+    }
+
+    // The message header precedes the payload.
+    Block encoded;
+    Writer(encoded) << header;
+    encoded += payload;
+    return encoded;
 }
 
 void Socket::readIncomingBytes()
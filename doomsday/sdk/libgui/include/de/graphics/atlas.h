@@ -27,6 +27,7 @@
 #include <de/Observers>
 #include <de/Lockable>
 #include <de/Deletable>
+#include <de/Time>
 
 #include "../Image"
 
@@ -132,6 +133,18 @@ public:
         virtual Id   allocate(Size const &size, Rectanglei &rect, Id const &knownId) = 0;
         virtual void release(Id const &id) = 0;
 
+        /**
+         * Moves an allocation higher up in the atlas, if there is room for it there.
+         * Allocators that cannot move individual allocations return @c false; their
+         * layout can only be changed with optimize().
+         *
+         * @param id    Allocation to move.
+         * @param rect  New rectangle of the allocation is returned here.
+         *
+         * @return @c true, if the allocation was moved.
+         */
+        virtual bool relocate(Id const &id, Rectanglei &rect);
+
         /**
          * Finds an optimal layout for all of the allocations.
          */
@@ -246,6 +259,34 @@ public:
      */
     void cancelDeferred();
 
+    /**
+     * Relocates some of the allocations higher up in the atlas, to gather the free
+     * space in one place. The work is split over multiple calls so that a full
+     * atlas does not need to be defragmented all at once; this should be called
+     * once per frame, before the atlas contents are used. Requires BackingStore,
+     * AllowDefragment, and an allocator that supports relocation.
+     *
+     * Nothing is done until an allocation has failed, or releases have left the
+     * allocations sparse enough (checked at most twice per second). The allocations
+     * are then moved over consecutive calls, furthest down first. Moved content
+     * remains in its old place, and imageRect() keeps returning the old rectangle,
+     * until the moves are published: the Reposition audience is notified once when
+     * all allocations have been checked, or earlier if an old place is about to be
+     * overwritten.
+     *
+     * @param maxRelocations  Maximum number of allocations to move.
+     * @param timeBudget      Maximum time to spend.
+     *
+     * @return Number of allocations that were moved.
+     */
+    int defragmentStep(int maxRelocations = 16, TimeDelta const &timeBudget = .001);
+
+    /**
+     * Returns the total number of bytes of image content that have been moved in
+     * the backing store due to defragmentation.
+     */
+    duint64 movedBytes() const;
+
     /**
      * Returns the number of images in the atlas.
      */
@@ -49,6 +49,9 @@ public:
     static AtlasTexture *newWithKdTreeAllocator(Atlas::Flags const &flags = DefaultFlags,
                                                 Atlas::Size const &totalSize = Atlas::Size());
 
+    static AtlasTexture *newWithSkylineAllocator(Atlas::Flags const &flags = DefaultFlags,
+                                                 Atlas::Size const &totalSize = Atlas::Size());
+
     void clear();
 
 protected:
@@ -268,12 +268,27 @@ public:
          */
         virtual Vector4f extraRotationForNode(String const &nodeName) const;
 
+        /**
+         * Evaluates the bone transformations for the current state of the animation
+         * sequences and keeps them in the animator. The next time the model is drawn
+         * using this animator, the prepared transformations are used instead of
+         * evaluating them again.
+         *
+         * Preparing calls extraRotationForNode() for the nodes of the model. Like
+         * drawing, this must be done in the main thread: the extra rotations of
+         * derived animators (e.g., animated script variables) are not protected
+         * against concurrent access.
+         */
+        void preparePose() const;
+
         // ISerializable.
         void operator >> (Writer &to) const override;
         void operator << (Reader &from) override;
 
     private:
         DENG2_PRIVATE(d)
+
+        friend class ModelDrawable;
     };
 
     /**
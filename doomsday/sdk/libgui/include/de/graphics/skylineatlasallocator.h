@@ -0,0 +1,64 @@
+/** @file skylineatlasallocator.h  Skyline-based atlas allocator.
+ *
+ * @authors Copyright (c) 2026 agent <agent@local>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBGUI_SKYLINEATLASALLOCATOR_H
+#define LIBGUI_SKYLINEATLASALLOCATOR_H
+
+#include "../Atlas"
+
+namespace de {
+
+/**
+ * Skyline-based atlas allocator.
+ *
+ * Allocations are packed against the top of the atlas, picking the place where the
+ * bottom edge of the allocation ends up highest. Space that is released below the
+ * skyline is reused, and adjacent free rectangles are merged together.
+ *
+ * Individual allocations can be relocated, so the atlas can be defragmented
+ * incrementally with Atlas::defragmentStep().
+ *
+ * @see Atlas
+ *
+ * @ingroup gl
+ */
+class LIBGUI_PUBLIC SkylineAtlasAllocator : public Atlas::IAllocator
+{
+public:
+    SkylineAtlasAllocator();
+
+    void setMetrics(Atlas::Size const &totalSize, int margin) override;
+
+    void clear() override;
+    Id allocate(Atlas::Size const &size, Rectanglei &rect, Id const &knownId) override;
+    void release(Id const &id) override;
+    bool relocate(Id const &id, Rectanglei &rect) override;
+    bool optimize() override;
+
+    int count() const override;
+    Atlas::Ids ids() const override;
+    void rect(Id const &id, Rectanglei &rect) const override;
+    Allocations allocs() const override;
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+} // namespace de
+
+#endif // LIBGUI_SKYLINEATLASALLOCATOR_H
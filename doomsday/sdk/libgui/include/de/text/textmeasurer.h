@@ -0,0 +1,85 @@
+/** @file textmeasurer.h  Incremental text measurement.
+ *
+ * @authors Copyright (c) 2026 agent <agent@local>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBGUI_TEXTMEASURER_H
+#define LIBGUI_TEXTMEASURER_H
+
+#include "font.h"
+
+namespace de {
+
+/**
+ * Measures the characters of a text one at a time, so that the width of any range
+ * of the text can be looked up without measuring the range again. @ingroup gui
+ *
+ * The advance width of each character is measured once per distinct character and
+ * rich format style; the results are kept as a running total over the text.
+ *
+ * The width of a range is the sum of the advances of its individual characters.
+ * This ignores kerning and the rounding of fractional advances, so it may differ
+ * slightly from Font::advanceWidth() of the same range. Measure with the font when
+ * exact results are needed.
+ */
+class LIBGUI_PUBLIC TextMeasurer
+{
+public:
+    /**
+     * Measures all the characters of @a text.
+     *
+     * @param font    Font to measure with.
+     * @param text    Text to measure.
+     * @param format  Rich formatting of @a text.
+     */
+    TextMeasurer(Font const &font, String const &text, Font::RichFormatRef const &format);
+
+    /**
+     * Number of measured characters.
+     */
+    int size() const;
+
+    /**
+     * Returns the sum of the advance widths of the characters preceding @a pos.
+     *
+     * @param pos  Character position (0...size()).
+     */
+    int offset(int pos) const;
+
+    /**
+     * Returns the sum of the advance widths of the characters in @a range.
+     */
+    int advanceWidth(Rangei const &range) const;
+
+    /**
+     * Finds the longest range starting at @a begin whose width does not exceed
+     * @a availableWidth. The search is a binary search over the running totals.
+     *
+     * @param begin           Start of the range.
+     * @param maxEnd          The range cannot extend beyond this position.
+     * @param availableWidth  Maximum width of the range.
+     *
+     * @return End of the range (begin...maxEnd).
+     */
+    int findFit(int begin, int maxEnd, int availableWidth) const;
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+} // namespace de
+
+#endif // LIBGUI_TEXTMEASURER_H
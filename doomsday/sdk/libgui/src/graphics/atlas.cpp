@@ -22,11 +22,23 @@
 
 #include <QSet>
 #include <QRect>
+#include <QList>
 #include <QImage>
 #include <QPainter>
+#include <algorithm>
 
 namespace de {
 
+/// Incremental defragmentation begins when the allocations extend at least this far
+/// down the atlas (portion of the height)...
+static float const DEFRAG_MIN_EXTENT = .5f;
+
+/// ...and fill less than this portion of the area above their lowest edge.
+static float const DEFRAG_MAX_DENSITY = .75f;
+
+/// Minimum interval between fragmentation checks.
+static TimeDelta const DEFRAG_CHECK_INTERVAL = .5;
+
 DENG2_PIMPL(Atlas)
 {
     Flags flags;
@@ -39,8 +51,26 @@ DENG2_PIMPL(Atlas)
     bool needCommit;
     bool needFullCommit;
     bool mayDefrag;
+    bool checkFragmentation;  ///< Something has been released since the last check.
+    bool relocateRequested;   ///< An allocation failed.
+    duint64 movedBytes;
     QList<Rectanglei> changedAreas;
     Time fullReportedAt;
+    Time fragmentationCheckedAt;
+
+    /**
+     * Ongoing incremental defragmentation. Moved content stays visible at its old
+     * place, and imageRect() returns the old rectangle, until the moves are
+     * published with a single Reposition notification.
+     */
+    struct Relocation
+    {
+        QList<Id> order;                        ///< Furthest down first.
+        int next = 0;
+        QSet<Id::Type> released;                ///< Released after the order was made.
+        QHash<Id::Type, Rectanglei> oldRects;   ///< Unpublished moves.
+    };
+    std::unique_ptr<Relocation> relocation;
 
     // Minimum backing size is 1x1 pixels.
     Impl(Public *i, Flags const &flg, Size const &size)
@@ -52,6 +82,9 @@ DENG2_PIMPL(Atlas)
         , needCommit(false)
         , needFullCommit(true)
         , mayDefrag(false)
+        , checkFragmentation(false)
+        , relocateRequested(false)
+        , movedBytes(0)
     {
         if (hasBacking())
         {
@@ -247,6 +280,10 @@ DENG2_PIMPL(Atlas)
     {
         DENG2_ASSERT(hasBacking());
 
+        // The backing store is composed from the current layout, where the content
+        // of unpublished moves already is.
+        relocation.reset();
+
         IAllocator::Allocations const oldLayout = allocator->allocs();
         if (!allocator->optimize())
         {
@@ -262,8 +299,9 @@ DENG2_PIMPL(Atlas)
         IAllocator::Allocations optimal = allocator->allocs();
         DENG2_FOR_EACH(IAllocator::Allocations, i, optimal)
         {
-            defragged.draw(backing.subImage(oldLayout[i.key()]),
-                           i.value().topLeft);
+            Image const content = backing.subImage(oldLayout[i.key()]);
+            defragged.draw(content, i.value().topLeft);
+            movedBytes += duint64(content.byteCount());
         }
 
         // Defragmentation complete, use the revised backing store.
@@ -277,6 +315,169 @@ DENG2_PIMPL(Atlas)
         }
     }
 
+    /**
+     * Determines if the allocations have become fragmented enough to begin moving
+     * them.
+     */
+    bool isFragmented()
+    {
+        fragmentationCheckedAt = Time::currentHighPerformanceTime();
+        checkFragmentation = false;
+
+        duint64 usedPx = 0;
+        int extent = 0;
+        foreach (Rectanglei const &alloc, allocator->allocs().values())
+        {
+            usedPx += duint64(alloc.width()) * alloc.height();
+            extent = de::max(extent, alloc.bottom());
+        }
+        if (extent < totalSize.y * DEFRAG_MIN_EXTENT) return false;
+        return usedPx < duint64(totalSize.x) * extent * DEFRAG_MAX_DENSITY;
+    }
+
+    void beginRelocation()
+    {
+        IAllocator::Allocations const layout = allocator->allocs();
+        relocation.reset(new Relocation);
+        relocation->order = layout.keys();
+        std::sort(relocation->order.begin(), relocation->order.end(),
+                  [&layout] (Id const &a, Id const &b) {
+            return layout[a].bottom() > layout[b].bottom();
+        });
+    }
+
+    /**
+     * Moves some of the allocations higher up in the backing store, continuing the
+     * ongoing relocation. A relocation is begun if an allocation has failed or the
+     * atlas has become fragmented.
+     *
+     * @return Number of moved allocations.
+     */
+    int relocateSome(int maxRelocations, TimeDelta const &timeBudget)
+    {
+        DENG2_ASSERT(hasBacking());
+
+        if (!relocation)
+        {
+            bool const mustCheck = checkFragmentation &&
+                    (!fragmentationCheckedAt.isValid() ||
+                     fragmentationCheckedAt.since() > DEFRAG_CHECK_INTERVAL);
+            if (relocateRequested || (mustCheck && isFragmented()))
+            {
+                relocateRequested = false;
+                beginRelocation();
+            }
+            else
+            {
+                return 0;
+            }
+        }
+
+        Time const startedAt = Time::currentHighPerformanceTime();
+        int relocated = 0;
+        while (relocation->next < relocation->order.size())
+        {
+            if (relocated == maxRelocations || startedAt.since() > timeBudget)
+            {
+                return relocated;
+            }
+            Id const id = relocation->order.at(relocation->next++);
+            if (relocation->released.contains(id)) continue;
+            if (deferred.contains(id)) continue; // Not in the backing store yet.
+
+            Rectanglei oldRect;
+            allocator->rect(id, oldRect);
+            Rectanglei newRect;
+            if (allocator->relocate(id, newRect))
+            {
+                moveContent(id, oldRect, newRect);
+                ++relocated;
+            }
+        }
+
+        // Everything has been checked.
+        publishRelocation();
+        return relocated;
+    }
+
+    /**
+     * Copies the content of a moved allocation. The content also remains in its
+     * old place until the move is published.
+     */
+    void moveContent(Id const &id, Rectanglei const &oldRect, Rectanglei const &newRect)
+    {
+        bool const overwritesOld = newRect.expanded(margin).overlaps(oldRect);
+
+        // The old places of unpublished moves must remain intact.
+        if (overwritesOld || overlapsUnpublished(newRect.expanded(margin)))
+        {
+            publishMoves();
+        }
+
+        Image const content = backing.subImage(oldRect);
+        if (overwritesOld)
+        {
+            // The old content cannot be kept, so this move is published right away.
+            backing.fill(oldRect.expanded(margin), Image::Color(0, 0, 0, 0));
+            markAsChanged(oldRect);
+        }
+        backing.fill(newRect.expanded(margin), Image::Color(0, 0, 0, 0));
+        backing.draw(content, newRect.topLeft);
+        movedBytes += duint64(content.byteCount());
+        markAsChanged(newRect);
+
+        if (overwritesOld)
+        {
+            notifyRepositioned();
+        }
+        else
+        {
+            relocation->oldRects.insert(id, oldRect);
+        }
+    }
+
+    bool overlapsUnpublished(Rectanglei const &rect) const
+    {
+        if (!relocation) return false;
+        for (Rectanglei const &old : relocation->oldRects)
+        {
+            if (old.overlaps(rect)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Clears the old places of the moved allocations and notifies the Reposition
+     * audience, so that users start using the new places.
+     */
+    void publishMoves()
+    {
+        if (!relocation || relocation->oldRects.isEmpty()) return;
+
+        for (Rectanglei const &old : relocation->oldRects)
+        {
+            backing.fill(old.expanded(margin), Image::Color(0, 0, 0, 0));
+            markAsChanged(old);
+        }
+        relocation->oldRects.clear();
+        notifyRepositioned();
+    }
+
+    void notifyRepositioned()
+    {
+        DENG2_FOR_PUBLIC_AUDIENCE2(Reposition, i)
+        {
+            i->atlasContentRepositioned(self());
+        }
+    }
+
+    /// Ends the ongoing relocation.
+    void publishRelocation()
+    {
+        publishMoves();
+        relocation.reset();
+    }
+
     Image::Size sizeWithBorders(Image::Size const &size)
     {
         return size + Image::Size(2 * border, 2 * border);
@@ -285,7 +486,15 @@ DENG2_PIMPL(Atlas)
     Rectanglei rectWithoutBorder(Id const &id) const
     {
         Rectanglei rect;
-        allocator->rect(id, rect);
+        if (relocation && relocation->oldRects.contains(id))
+        {
+            // The move has not been published yet.
+            rect = relocation->oldRects[id];
+        }
+        else
+        {
+            allocator->rect(id, rect);
+        }
         return rect.shrunk(border);
     }
 
@@ -296,6 +505,12 @@ DENG2_PIMPL(Atlas)
 DENG2_AUDIENCE_METHOD(Atlas, Reposition)
 DENG2_AUDIENCE_METHOD(Atlas, OutOfSpace)
 
+bool Atlas::IAllocator::relocate(Id const &, Rectanglei &)
+{
+    // Allocations cannot be moved individually.
+    return false;
+}
+
 Atlas::Atlas(Flags const &flags, Size const &totalSize)
     : d(new Impl(this, flags, totalSize))
 {}
@@ -352,6 +567,9 @@ void Atlas::clear()
         d->markFullyChanged();
     }
     d->mayDefrag = false;
+    d->checkFragmentation = false;
+    d->relocateRequested = false;
+    d->relocation.reset();
 }
 
 void Atlas::setTotalSize(Size const &totalSize)
@@ -409,6 +627,12 @@ Id Atlas::alloc(Image const &image, Id const &chosenId)
         // Defragmenting may again be helpful.
         d->mayDefrag = true;
 
+        if (d->overlapsUnpublished(rect.expanded(d->margin)))
+        {
+            // The old places of moved allocations are about to be overwritten.
+            d->publishMoves();
+        }
+
         if (!d->usingDeferredMode())
         {
             // Submit the image to the backing store (or commit).
@@ -430,6 +654,9 @@ Id Atlas::alloc(Image const &image, Id const &chosenId)
             d->fullReportedAt = Time::currentHighPerformanceTime();
         }
 
+        // Gradually gather the free space for the next attempt.
+        d->relocateRequested = true;
+
         DENG2_FOR_AUDIENCE2(OutOfSpace, i)
         {
             i->atlasOutOfSpace(*this);
@@ -449,6 +676,31 @@ void Atlas::release(Id const &id)
 
     // Defragmenting may help us again.
     d->mayDefrag = true;
+    d->checkFragmentation = true;
+
+    if (d->relocation)
+    {
+        d->relocation->released.insert(id);
+        d->relocation->oldRects.remove(id);
+    }
+}
+
+int Atlas::defragmentStep(int maxRelocations, TimeDelta const &timeBudget)
+{
+    DENG2_GUARD(this);
+
+    if (!d->hasBacking() || !d->flags.testFlag(AllowDefragment) || !d->allocator)
+    {
+        return 0;
+    }
+
+    return d->relocateSome(maxRelocations, timeBudget);
+}
+
+duint64 Atlas::movedBytes() const
+{
+    DENG2_GUARD(this);
+    return d->movedBytes;
 }
 
 bool Atlas::contains(Id const &id) const
@@ -19,6 +19,7 @@
 #include "de/AtlasTexture"
 #include "de/RowAtlasAllocator"
 #include "de/KdTreeAtlasAllocator"
+#include "de/SkylineAtlasAllocator"
 
 namespace de {
 
@@ -43,6 +44,13 @@ AtlasTexture *AtlasTexture::newWithKdTreeAllocator(Atlas::Flags const &flags, At
     return atlas;
 }
 
+AtlasTexture *AtlasTexture::newWithSkylineAllocator(Atlas::Flags const &flags, Atlas::Size const &totalSize)
+{
+    AtlasTexture *atlas = new AtlasTexture(flags, totalSize);
+    atlas->setAllocator(new SkylineAtlasAllocator);
+    return atlas;
+}
+
 void AtlasTexture::clear()
 {
     Atlas::clear();
@@ -40,6 +40,9 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <QVarLengthArray>
+
+#include <algorithm>
 #include <array>
 
 namespace de {
@@ -227,6 +230,69 @@ static Matrix4f convertMatrix(aiMatrix4x4 const &aiMat)
     return Matrix4f(&aiMat.a1).transpose();
 }
 
+/**
+ * Multiplies two matrices. Equivalent to Matrix4f::operator *, but each column of the
+ * result is computed as a linear combination of the columns of @a a, which the
+ * compiler is able to vectorize.
+ */
+static inline Matrix4f multiplyMatrix(Matrix4f const &a, Matrix4f const &b)
+{
+    Matrix4f result(Matrix4f::Uninitialized);
+    dfloat *out = result.values();
+    dfloat const *av = a.values();
+    dfloat const *bv = b.values();
+    for (int col = 0; col < 4; ++col)
+    {
+        dfloat const *bc = bv + 4 * col;
+        for (int row = 0; row < 4; ++row)
+        {
+            out[4 * col + row] = av[row]      * bc[0] +
+                                 av[4 + row]  * bc[1] +
+                                 av[8 + row]  * bc[2] +
+                                 av[12 + row] * bc[3];
+        }
+    }
+    return result;
+}
+
+/**
+ * Composes a node transformation (translation * rotation * scaling) directly, without
+ * multiplying the component matrices.
+ *
+ * @param axisAngle  Additional rotation applied after the node rotation (xyz: axis,
+ *                   w: angle in degrees).
+ */
+static Matrix4f composeTransform(Vector3f const &translation, aiQuaternion const &rotation,
+                                 Vector3f const &scaling, Vector4f const &axisAngle)
+{
+    aiMatrix3x3 rot = rotation.GetMatrix();
+
+    Matrix4f m(Matrix4f::Uninitialized);
+    dfloat *v = m.values();
+    for (int col = 0; col < 3; ++col)
+    {
+        for (int row = 0; row < 3; ++row)
+        {
+            v[4 * col + row] = rot[row][col] * scaling[col];
+        }
+        v[4 * col + 3] = 0;
+    }
+    v[12] = v[13] = v[14] = 0;
+    v[15] = 1;
+
+    if (!fequal(axisAngle.w, 0))
+    {
+        // Include the custom extra rotation.
+        m = multiplyMatrix(Matrix4f::rotate(axisAngle.w, axisAngle), m);
+        v = m.values();
+    }
+
+    v[12] = translation.x;
+    v[13] = translation.y;
+    v[14] = translation.z;
+    return m;
+}
+
 static ddouble secondsToTicks(ddouble seconds, aiAnimation const &anim)
 {
     ddouble const ticksPerSec = anim.mTicksPerSecond? anim.mTicksPerSecond : 25.0;
@@ -732,6 +798,8 @@ DENG2_PIMPL(ModelDrawable)
         nodeNameToPtr.insert("", scene->mRootNode);
         buildNodeLookup(*scene->mRootNode);
 
+        bakeNodes();
+
         glData.initMaterials();
 
         // Default rendering passes to use if none specified.
@@ -765,6 +833,7 @@ DENG2_PIMPL(ModelDrawable)
 
         sourcePath.clear();
         defaultPasses.clear();
+        clearBakedNodes();
         importer.FreeScene();
         scene = glData.scene = nullptr;
     }
@@ -1060,115 +1129,251 @@ DENG2_PIMPL(ModelDrawable)
 
 //- Animation ---------------------------------------------------------------------------
 
-    struct AccumData
+    /**
+     * Scene node with everything needed for evaluating its transformation resolved
+     * in advance.
+     */
+    struct BakedNode
+    {
+        String name;            ///< For Animator::extraRotationForNode().
+        int parent;             ///< Index of the parent node (-1 for the root).
+        int subtreeEnd;         ///< Index after the last node of the subtree.
+        int bone;               ///< Bone index, or -1.
+        Matrix4f transform;     ///< Default transformation.
+        Matrix4f boneOffset;
+    };
+
+    typedef QVector<Matrix4f> Pose;                 ///< Final bone transformations.
+    typedef QHash<int, QVector<duint>> KeyCursors;  ///< Per animation, three per channel.
+
+    /// Nodes in depth-first order: parents come before their children and each
+    /// subtree is a contiguous range.
+    QVector<BakedNode> bakedNodes;
+    QHash<aiNode const *, int> bakedNodeIndex;
+    QVector<QVector<int>> bakedChannels; ///< [animation][node] => channel, or -1.
+    int bakedBoneCount = 0;
+
+    void clearBakedNodes()
     {
-        Animator const &animator;
-        ddouble time = 0.0;
-        aiAnimation const *anim = nullptr;
-        QVector<Matrix4f> finalTransforms;
+        bakedNodes.clear();
+        bakedNodeIndex.clear();
+        bakedChannels.clear();
+        bakedBoneCount = 0;
+    }
+
+    /**
+     * Flattens the node hierarchy and resolves the bones and animation channels of
+     * the nodes, so that evaluating a pose needs no lookups by name.
+     */
+    void bakeNodes()
+    {
+        clearBakedNodes();
 
-        AccumData(Animator const &animator, int boneCount)
-            : animator(animator)
-            , finalTransforms(boneCount)
-        {}
+        bakedBoneCount = boneCount();
+        bakeNode(*scene->mRootNode, -1);
 
-        aiNodeAnim const *findNodeAnim(aiNode const &node) const
+        bakedChannels.resize(scene->mNumAnimations);
+        for (duint a = 0; a < scene->mNumAnimations; ++a)
         {
-            if (!anim) return nullptr;
-            for (duint i = 0; i < anim->mNumChannels; ++i)
+            aiAnimation const &anim = *scene->mAnimations[a];
+
+            // If there are several channels for a node, the first one is used.
+            QHash<String, int> channelForName;
+            for (duint c = 0; c < anim.mNumChannels; ++c)
             {
-                aiNodeAnim const *na = anim->mChannels[i];
-                if (na->mNodeName == node.mName)
+                String const name = anim.mChannels[c]->mNodeName.C_Str();
+                if (!channelForName.contains(name))
                 {
-                    return na;
+                    channelForName.insert(name, c);
                 }
             }
-            return nullptr;
+
+            QVector<int> &channels = bakedChannels[a];
+            channels.resize(bakedNodes.size());
+            for (int i = 0; i < bakedNodes.size(); ++i)
+            {
+                channels[i] = channelForName.value(bakedNodes.at(i).name, -1);
+            }
         }
-    };
+    }
 
-    void accumulateAnimationTransforms(Animator const &animator,
-                                       ddouble time,
-                                       aiAnimation const *animSeq,
-                                       aiNode const &rootNode) const
+    void bakeNode(aiNode const &node, int parent)
     {
-        AccumData data(animator, boneCount());
-        data.anim = animSeq;
-        // Wrap animation time.
-        data.time = animSeq? std::fmod(secondsToTicks(time, *animSeq), animSeq->mDuration) : time;
+        int const index = bakedNodes.size();
 
-        accumulateTransforms(rootNode, data);
+        BakedNode baked;
+        baked.name       = node.mName.C_Str();
+        baked.parent     = parent;
+        baked.subtreeEnd = index + 1;
+        baked.bone       = findBone(baked.name);
+        baked.transform  = convertMatrix(node.mTransformation);
+        if (baked.bone >= 0)
+        {
+            baked.boneOffset = bones.at(baked.bone).offset;
+        }
+        bakedNodes.append(baked);
+        bakedNodeIndex.insert(&node, index);
 
-        // Update the resulting matrices in the uniform.
-        for (int i = 0; i < boneCount(); ++i)
+        for (duint i = 0; i < node.mNumChildren; ++i)
         {
-            uBoneMatrices.set(i, data.finalTransforms.at(i));
+            bakeNode(*node.mChildren[i], index);
         }
+        bakedNodes[index].subtreeEnd = bakedNodes.size();
     }
 
-    void accumulateTransforms(aiNode const &node, AccumData &data,
-                              Matrix4f const &parentTransform = Matrix4f()) const
+    /**
+     * Evaluates the bone transformations of the animation sequences of @a animator.
+     * Only reads the model's data, so this may be called in any thread.
+     *
+     * @param animator  Animation state.
+     * @param pose      The transformations are written here.
+     * @param cursors   Key positions of the previous evaluation (updated).
+     *
+     * @return @c true, if there were transformations to evaluate.
+     */
+    bool evaluatePose(Animator const &animator, Pose &pose, KeyCursors &cursors) const
     {
-        Matrix4f nodeTransform = convertMatrix(node.mTransformation);
-
-        // Additional rotation?
-        Vector4f const axisAngle = data.animator.extraRotationForNode(node.mName.C_Str());
+        if (!scene || bakedNodes.isEmpty()) return false;
 
-        // Transform according to the animation sequence.
-        if (aiNodeAnim const *anim = data.findNodeAnim(node))
+        if (!scene->HasAnimations() || !animator.count())
         {
-            // Interpolate for this point in time.
-            Matrix4f const translation = Matrix4f::translate(interpolatePosition(data.time, *anim));
-            Matrix4f const scaling     = Matrix4f::scale(interpolateScaling(data.time, *anim));
-            Matrix4f       rotation    = convertMatrix(aiMatrix4x4(interpolateRotation(data.time, *anim).GetMatrix()));
-
-            if (!fequal(axisAngle.w, 0))
+            // If requested, run through the bone transformations even when
+            // no animations are active.
+            if (animator.flags().testFlag(Animator::AlwaysTransformNodes))
             {
-                // Include the custom extra rotation.
-                rotation = Matrix4f::rotate(axisAngle.w, axisAngle) * rotation;
+                accumulateAnimationTransforms(animator, 0, -1, 0, pose, cursors);
+                return true;
             }
-
-            nodeTransform = translation * rotation * scaling;
         }
-        else
+
+        if (!animator.count()) return false;
+
+        // Each sequence replaces all of the bone transformations, so only the last
+        // one has an effect.
+        int const last = animator.count() - 1;
+        auto const &animSeq = animator.at(last);
+
+        // The animation has been validated earlier.
+        DENG2_ASSERT(duint(animSeq.animId) < scene->mNumAnimations);
+        DENG2_ASSERT(nodeNameToPtr.contains(animSeq.node));
+
+        accumulateAnimationTransforms(animator,
+                                      animator.currentTime(last),
+                                      animSeq.animId,
+                                      bakedNodeIndex.value(nodeNameToPtr[animSeq.node]),
+                                      pose, cursors);
+        return true;
+    }
+
+    void accumulateAnimationTransforms(Animator const &animator,
+                                       ddouble time,
+                                       int animId,
+                                       int rootIndex,
+                                       Pose &pose,
+                                       KeyCursors &cursors) const
+    {
+        aiAnimation const *animSeq = (animId >= 0? scene->mAnimations[animId] : nullptr);
+        QVector<int> const *channels = (animId >= 0? &bakedChannels.at(animId) : nullptr);
+
+        // Wrap animation time.
+        if (animSeq) time = std::fmod(secondsToTicks(time, *animSeq), animSeq->mDuration);
+
+        duint *keyCursor = nullptr;
+        if (animSeq)
         {
-            // Model does not specify animation information for this node.
-            // Only apply the possible additional rotation.
-            if (!fequal(axisAngle.w, 0))
+            QVector<duint> &animCursors = cursors[animId];
+            if (animCursors.size() != int(animSeq->mNumChannels) * 3)
             {
-                nodeTransform = Matrix4f::rotate(axisAngle.w, axisAngle) * nodeTransform;
+                animCursors.fill(0, animSeq->mNumChannels * 3);
             }
+            keyCursor = animCursors.data();
         }
 
-        Matrix4f globalTransform = parentTransform * nodeTransform;
+        pose.fill(Matrix4f(), bakedBoneCount);
 
-        int boneIndex = findBone(String(node.mName.C_Str()));
-        if (boneIndex >= 0)
-        {
-            data.finalTransforms[boneIndex] =
-                    globalInverse * globalTransform * bones.at(boneIndex).offset;
-        }
+        int const end = bakedNodes.at(rootIndex).subtreeEnd;
+        QVarLengthArray<Matrix4f, 128> globalTransforms(end - rootIndex);
 
-        // Descend to child nodes.
-        for (duint i = 0; i < node.mNumChildren; ++i)
+        for (int i = rootIndex; i < end; ++i)
         {
-            accumulateTransforms(*node.mChildren[i], data, globalTransform);
+            BakedNode const &node = bakedNodes.at(i);
+
+            // Additional rotation?
+            Vector4f const axisAngle = animator.extraRotationForNode(node.name);
+
+            Matrix4f nodeTransform;
+            int const channel = (channels? channels->at(i) : -1);
+            if (channel >= 0)
+            {
+                // Transform according to the animation sequence.
+                aiNodeAnim const &anim = *animSeq->mChannels[channel];
+                duint *cursor = keyCursor + 3 * channel;
+
+                // Interpolate for this point in time.
+                nodeTransform = composeTransform(interpolatePosition(time, anim, cursor[0]),
+                                                 interpolateRotation(time, anim, cursor[1]),
+                                                 interpolateScaling (time, anim, cursor[2]),
+                                                 axisAngle);
+            }
+            else if (!fequal(axisAngle.w, 0))
+            {
+                // Model does not specify animation information for this node.
+                // Only apply the possible additional rotation.
+                nodeTransform = multiplyMatrix(Matrix4f::rotate(axisAngle.w, axisAngle),
+                                               node.transform);
+            }
+            else
+            {
+                nodeTransform = node.transform;
+            }
+
+            Matrix4f &globalTransform = globalTransforms[i - rootIndex];
+            if (i == rootIndex)
+            {
+                globalTransform = nodeTransform;
+            }
+            else
+            {
+                globalTransform = multiplyMatrix(globalTransforms[node.parent - rootIndex],
+                                                 nodeTransform);
+            }
+
+            if (node.bone >= 0)
+            {
+                pose[node.bone] = multiplyMatrix(multiplyMatrix(globalInverse, globalTransform),
+                                                 node.boneOffset);
+            }
         }
     }
 
+    /**
+     * Finds the key preceding @a time. Time usually advances only a little between
+     * evaluations, so the key found previously and the one after it are checked
+     * first. Otherwise, a binary search is done.
+     *
+     * @param cursor  Previously found key. Updated to the key found.
+     */
     template <typename Type>
-    static duint findAnimKey(ddouble time, Type const *keys, duint count)
+    static duint findAnimKey(ddouble time, Type const *keys, duint count, duint &cursor)
     {
         DENG2_ASSERT(count > 0);
-        for (duint i = 0; i < count - 1; ++i)
+        for (duint i = cursor; i < cursor + 2 && i + 1 < count; ++i)
         {
-            if (time < keys[i + 1].mTime)
+            if (keys[i].mTime <= time && time < keys[i + 1].mTime)
             {
-                return i;
+                return cursor = i;
             }
         }
-        DENG2_ASSERT(!"Failed to find animation key (invalid time?)");
-        return 0;
+        Type const *next = std::upper_bound(keys + 1, keys + count, time,
+                                            [] (ddouble t, Type const &key) {
+            return t < key.mTime;
+        });
+        if (next == keys + count)
+        {
+            DENG2_ASSERT(!"Failed to find animation key (invalid time?)");
+            return cursor = 0;
+        }
+        return cursor = duint(next - keys) - 1;
     }
 
     static Vector3f interpolateVectorKey(ddouble time, aiVectorKey const *keys, duint at)
@@ -1180,14 +1385,15 @@ DENG2_PIMPL(ModelDrawable)
                float((time - keys[at].mTime) / (keys[at + 1].mTime - keys[at].mTime));
     }
 
-    static aiQuaternion interpolateRotation(ddouble time, aiNodeAnim const &anim)
+    static aiQuaternion interpolateRotation(ddouble time, aiNodeAnim const &anim, duint &cursor)
     {
         if (anim.mNumRotationKeys == 1)
         {
             return anim.mRotationKeys[0].mValue;
         }
 
-        aiQuatKey const *key = anim.mRotationKeys + findAnimKey(time, anim.mRotationKeys, anim.mNumRotationKeys);
+        aiQuatKey const *key = anim.mRotationKeys +
+                findAnimKey(time, anim.mRotationKeys, anim.mNumRotationKeys, cursor);
 
         aiQuaternion interp;
         aiQuaternion::Interpolate(interp, key[0].mValue, key[1].mValue,
@@ -1196,7 +1402,7 @@ DENG2_PIMPL(ModelDrawable)
         return interp;
     }
 
-    static Vector3f interpolateScaling(ddouble time, aiNodeAnim const &anim)
+    static Vector3f interpolateScaling(ddouble time, aiNodeAnim const &anim, duint &cursor)
     {
         if (anim.mNumScalingKeys == 1)
         {
@@ -1204,10 +1410,10 @@ DENG2_PIMPL(ModelDrawable)
         }
         return interpolateVectorKey(time, anim.mScalingKeys,
                                     findAnimKey(time, anim.mScalingKeys,
-                                                anim.mNumScalingKeys));
+                                                anim.mNumScalingKeys, cursor));
     }
 
-    static Vector3f interpolatePosition(ddouble time, aiNodeAnim const &anim)
+    static Vector3f interpolatePosition(ddouble time, aiNodeAnim const &anim, duint &cursor)
     {
         if (anim.mNumPositionKeys == 1)
         {
@@ -1215,40 +1421,10 @@ DENG2_PIMPL(ModelDrawable)
         }
         return interpolateVectorKey(time, anim.mPositionKeys,
                                     findAnimKey(time, anim.mPositionKeys,
-                                                anim.mNumPositionKeys));
+                                                anim.mNumPositionKeys, cursor));
     }
 
-    void updateMatricesFromAnimation(Animator const *animator) const
-    {
-        // Cannot do anything without an Animator.
-        if (!animator) return;
-
-        if (!scene->HasAnimations() || !animator->count())
-        {
-            // If requested, run through the bone transformations even when
-            // no animations are active.
-            if (animator->flags().testFlag(Animator::AlwaysTransformNodes))
-            {
-                accumulateAnimationTransforms(*animator, 0, nullptr, *scene->mRootNode);
-                return;
-            }
-        }
-
-        // Apply all current animations.
-        for (int i = 0; i < animator->count(); ++i)
-        {
-            auto const &animSeq = animator->at(i);
-
-            // The animation has been validated earlier.
-            DENG2_ASSERT(duint(animSeq.animId) < scene->mNumAnimations);
-            DENG2_ASSERT(nodeNameToPtr.contains(animSeq.node));
-
-            accumulateAnimationTransforms(*animator,
-                                          animator->currentTime(i),
-                                          scene->mAnimations[animSeq.animId],
-                                          *nodeNameToPtr[animSeq.node]);
-        }
-    }
+    void updateMatricesFromAnimation(Animator const *animator) const;
 
 //- Drawing -----------------------------------------------------------------------------
 
@@ -1729,6 +1905,12 @@ DENG2_PIMPL_NOREF(ModelDrawable::Animator)
         if (model == &a) model = nullptr;
     }
 
+    // Pose evaluation state.
+    ModelDrawable::Impl::Pose pose;
+    ModelDrawable::Impl::KeyCursors keyCursors;
+    bool poseIsPrepared = false;
+    bool poseIsValid = false;
+
     OngoingSequence &add(OngoingSequence *seq)
     {
         DENG2_ASSERT(seq != nullptr);
@@ -1790,6 +1972,27 @@ DENG2_PIMPL_NOREF(ModelDrawable::Animator)
     }
 };
 
+void ModelDrawable::Impl::updateMatricesFromAnimation(Animator const *animator) const
+{
+    // Cannot do anything without an Animator.
+    if (!animator) return;
+
+    auto &anim = *animator->d;
+    if (!anim.poseIsPrepared)
+    {
+        anim.poseIsValid = evaluatePose(*animator, anim.pose, anim.keyCursors);
+    }
+    anim.poseIsPrepared = false; // Consumed.
+
+    if (!anim.poseIsValid) return;
+
+    // Update the resulting matrices in the uniform.
+    for (int i = 0; i < anim.pose.size(); ++i)
+    {
+        uBoneMatrices.set(i, anim.pose.at(i));
+    }
+}
+
 ModelDrawable::Animator::Animator(Constructor constructor)
     : d(new Impl(constructor))
 {}
@@ -1918,6 +2121,13 @@ Vector4f ModelDrawable::Animator::extraRotationForNode(String const &) const
     return Vector4f();
 }
 
+void ModelDrawable::Animator::preparePose() const
+{
+    DENG2_ASSERT(d->model != nullptr);
+    d->poseIsValid = d->model->d->evaluatePose(*this, d->pose, d->keyCursors);
+    d->poseIsPrepared = true;
+}
+
 void ModelDrawable::Animator::operator >> (Writer &to) const
 {
     to.writeObjects(d->anims);
@@ -0,0 +1,468 @@
+/** @file skylineatlasallocator.cpp  Skyline-based atlas allocator.
+ *
+ * The skyline allocator works according to the following principles:
+ *
+ * - The skyline is a sequence of horizontal segments that spans the width of the
+ *   atlas. Everything below a segment is empty space. In the beginning, there is a
+ *   single segment at the top edge of the atlas.
+ * - A new allocation is placed either on the skyline or into a vacant rectangle left
+ *   below the skyline, picking the position where the bottom edge of the allocation
+ *   is highest (ties are resolved by picking the leftmost position).
+ * - When an allocation is placed on the skyline over segments that are higher than
+ *   others, the gaps left beneath the allocation become vacant rectangles.
+ * - Released allocations become vacant rectangles. Vacant rectangles that share a
+ *   full edge are merged together. If a vacant rectangle lies directly on the
+ *   skyline, the skyline is lowered to its top edge.
+ * - An allocation can be relocated if there is room for it higher up in the atlas.
+ *   This allows defragmenting the atlas a few allocations at a time.
+ *
+ * Margins are reserved on the top/left edges of the atlas, and on the right/bottom
+ * edges of each allocation.
+ *
+ * @authors Copyright (c) 2026 agent <agent@local>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/SkylineAtlasAllocator"
+
+#include <QList>
+#include <vector>
+
+namespace de {
+
+DENG2_PIMPL(SkylineAtlasAllocator)
+{
+    struct Segment
+    {
+        int x;
+        int y;      ///< Top edge of the empty space below the segment.
+        int width;
+
+        int right() const { return x + width; }
+    };
+    typedef std::vector<Segment> Skyline;
+
+    /**
+     * Candidate position for an allocation.
+     */
+    struct Placement
+    {
+        bool isValid = false;
+        Vector2i pos;
+        int vacantIndex = -1; ///< Index of the vacant rectangle, or -1 for the skyline.
+
+        bool isBetterThan(Placement const &other) const
+        {
+            if (!other.isValid) return true;
+            if (pos.y == other.pos.y) return pos.x < other.pos.x;
+            return pos.y < other.pos.y;
+        }
+    };
+
+    Atlas::Size size;
+    int margin { 0 };
+    Allocations allocs;       ///< Allocated rectangles (without margins).
+    Skyline skyline;
+    QList<Rectanglei> vacant; ///< Empty rectangles above the skyline (with margins).
+
+    Impl(Public *i) : Base(i)
+    {
+        initLayout();
+    }
+
+    void initLayout()
+    {
+        allocs.clear();
+        vacant.clear();
+        skyline.clear();
+        skyline.push_back(Segment { margin, margin, de::max(0, int(size.x) - margin) });
+    }
+
+    inline Atlas::Size withMargin(Atlas::Size const &allocSize) const
+    {
+        return allocSize + Atlas::Size(margin, margin);
+    }
+
+    /**
+     * Determines if an area of @a needed size fits on the skyline starting at
+     * segment @a index.
+     *
+     * @param index   Index of the leftmost segment.
+     * @param needed  Size of the area (with margins).
+     * @param top     Top edge of the area is returned here.
+     */
+    bool fitsOnSkyline(dsize index, Atlas::Size const &needed, int &top) const
+    {
+        int const left = skyline[index].x;
+        if (left + int(needed.x) > int(size.x)) return false;
+
+        top = 0;
+        for (int remaining = int(needed.x); remaining > 0; ++index)
+        {
+            if (index == skyline.size()) return false;
+
+            top = de::max(top, skyline[index].y);
+            if (top + int(needed.y) > int(size.y)) return false;
+
+            remaining -= skyline[index].width;
+        }
+        return true;
+    }
+
+    /**
+     * Finds the best position for an area of @a needed size (with margins).
+     */
+    Placement findPlacement(Atlas::Size const &needed) const
+    {
+        Placement best;
+        for (int i = 0; i < vacant.size(); ++i)
+        {
+            Rectanglei const &rect = vacant.at(i);
+            if (rect.width() < needed.x || rect.height() < needed.y) continue;
+
+            Placement cand;
+            cand.isValid     = true;
+            cand.pos         = rect.topLeft;
+            cand.vacantIndex = i;
+            if (cand.isBetterThan(best)) best = cand;
+        }
+        for (dsize i = 0; i < skyline.size(); ++i)
+        {
+            int top;
+            if (!fitsOnSkyline(i, needed, top)) continue;
+
+            Placement cand;
+            cand.isValid = true;
+            cand.pos     = Vector2i(skyline[i].x, top);
+            if (cand.isBetterThan(best)) best = cand;
+        }
+        return best;
+    }
+
+    /**
+     * Changes the height of the skyline between @a left and @a right.
+     */
+    void setSkyline(int left, int right, int y)
+    {
+        Segment const changed { left, y, right - left };
+        Skyline revised;
+        bool inserted = false;
+        for (Segment const &seg : skyline)
+        {
+            if (seg.right() <= left || seg.x >= right)
+            {
+                if (!inserted && seg.x >= right)
+                {
+                    revised.push_back(changed);
+                    inserted = true;
+                }
+                revised.push_back(seg);
+                continue;
+            }
+            if (seg.x < left)
+            {
+                revised.push_back(Segment { seg.x, seg.y, left - seg.x });
+            }
+            if (!inserted)
+            {
+                revised.push_back(changed);
+                inserted = true;
+            }
+            if (seg.right() > right)
+            {
+                revised.push_back(Segment { right, seg.y, seg.right() - right });
+            }
+        }
+        if (!inserted) revised.push_back(changed);
+
+        // Neighbors at the same height are joined.
+        skyline.clear();
+        for (Segment const &seg : revised)
+        {
+            if (!skyline.empty() && skyline.back().y == seg.y)
+            {
+                skyline.back().width += seg.width;
+            }
+            else
+            {
+                skyline.push_back(seg);
+            }
+        }
+    }
+
+    bool isOnSkyline(Rectanglei const &rect) const
+    {
+        for (Segment const &seg : skyline)
+        {
+            if (seg.right() <= rect.left()) continue;
+            if (seg.x >= rect.right()) break;
+            if (seg.y != rect.bottom()) return false;
+        }
+        return true;
+    }
+
+    static bool canMerge(Rectanglei const &a, Rectanglei const &b)
+    {
+        if (a.top() == b.top() && a.bottom() == b.bottom())
+        {
+            return a.right() == b.left() || b.right() == a.left();
+        }
+        if (a.left() == b.left() && a.right() == b.right())
+        {
+            return a.bottom() == b.top() || b.bottom() == a.top();
+        }
+        return false;
+    }
+
+    /**
+     * Marks an area as empty. The area is merged with neighboring vacant rectangles,
+     * and the skyline is lowered if possible.
+     */
+    void addVacant(Rectanglei rect)
+    {
+        if (!rect.width() || !rect.height()) return;
+
+        for (bool merged = true; merged; )
+        {
+            merged = false;
+            for (int i = 0; i < vacant.size(); ++i)
+            {
+                if (canMerge(rect, vacant.at(i)))
+                {
+                    rect |= vacant.takeAt(i);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        vacant.append(rect);
+        lowerSkyline();
+    }
+
+    void lowerSkyline()
+    {
+        for (int i = 0; i < vacant.size(); )
+        {
+            if (isOnSkyline(vacant.at(i)))
+            {
+                Rectanglei const rect = vacant.takeAt(i);
+                setSkyline(rect.left(), rect.right(), rect.top());
+                i = 0; // Others may now be on the skyline, too.
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    /**
+     * Takes an area into use.
+     *
+     * @param placement  Position of the area, determined with findPlacement().
+     * @param needed     Size of the area (with margins).
+     */
+    void place(Placement const &placement, Atlas::Size const &needed)
+    {
+        DENG2_ASSERT(placement.isValid);
+
+        Rectanglei const area = Rectanglei::fromSize(placement.pos, needed);
+
+        if (placement.vacantIndex >= 0)
+        {
+            // The rest of the vacant rectangle is split along the longer leftover.
+            Rectanglei const space = vacant.takeAt(placement.vacantIndex);
+            if (space.right() - area.right() > space.bottom() - area.bottom())
+            {
+                addVacant(Rectanglei(area.topRight(), space.bottomRight));
+                addVacant(Rectanglei(area.bottomLeft(), Vector2i(area.right(), space.bottom())));
+            }
+            else
+            {
+                addVacant(Rectanglei(area.topRight(), Vector2i(space.right(), area.bottom())));
+                addVacant(Rectanglei(area.bottomLeft(), space.bottomRight));
+            }
+        }
+        else
+        {
+            // Gaps left beneath the area become vacant.
+            QList<Rectanglei> gaps;
+            for (Segment const &seg : skyline)
+            {
+                if (seg.right() <= area.left()) continue;
+                if (seg.x >= area.right()) break;
+                if (seg.y < area.top())
+                {
+                    gaps << Rectanglei(Vector2i(de::max(seg.x, area.left()), seg.y),
+                                       Vector2i(de::min(seg.right(), area.right()), area.top()));
+                }
+            }
+            setSkyline(area.left(), area.right(), area.bottom());
+            for (Rectanglei const &gap : gaps)
+            {
+                addVacant(gap);
+            }
+        }
+    }
+
+    Id allocate(Atlas::Size const &allocSize, Rectanglei &rect, Id const &knownId)
+    {
+        Placement const placement = findPlacement(withMargin(allocSize));
+        if (!placement.isValid) return Id::None;
+
+        place(placement, withMargin(allocSize));
+
+        Id const id = (knownId.isNone()? Id() : knownId);
+        rect = Rectanglei::fromSize(placement.pos, allocSize);
+        allocs[id] = rect;
+        return id;
+    }
+
+    void releaseArea(Rectanglei const &rect)
+    {
+        addVacant(Rectanglei::fromSize(rect.topLeft, withMargin(rect.size())));
+    }
+
+    bool relocate(Id const &id, Rectanglei &rect)
+    {
+        Rectanglei const current = allocs[id];
+
+        // Only worth moving if the allocation ends up higher.
+        Placement const placement = findPlacement(withMargin(current.size()));
+        if (!placement.isValid || placement.pos.y >= current.top()) return false;
+
+        place(placement, withMargin(current.size()));
+        releaseArea(current);
+
+        rect = Rectanglei::fromSize(placement.pos, current.size());
+        allocs[id] = rect;
+        return true;
+    }
+
+    struct ContentSize {
+        Id::Type id;
+        Atlas::Size size;
+
+        ContentSize(Id const &allocId, Vector2ui const &sz) : id(allocId), size(sz) {}
+        bool operator < (ContentSize const &other) const {
+            if (size.y == other.size.y) {
+                // Secondary sorting by descending width.
+                return size.x > other.size.x;
+            }
+            return size.y > other.size.y;
+        }
+    };
+
+    bool optimize()
+    {
+        // Place the tallest allocations first.
+        QList<ContentSize> descending;
+        DENG2_FOR_EACH(Allocations, i, allocs)
+        {
+            descending.append(ContentSize(i.key(), i.value().size()));
+        }
+        qSort(descending);
+
+        Allocations const oldAllocs  = allocs;
+        Skyline const oldSkyline     = skyline;
+        QList<Rectanglei> const oldVacant = vacant;
+
+        initLayout();
+        for (ContentSize const &ct : descending)
+        {
+            Rectanglei optRect;
+            if (allocate(ct.size, optRect, ct.id).isNone())
+            {
+                // Can't fit these; keep the old layout.
+                allocs  = oldAllocs;
+                skyline = oldSkyline;
+                vacant  = oldVacant;
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+SkylineAtlasAllocator::SkylineAtlasAllocator() : d(new Impl(this))
+{}
+
+void SkylineAtlasAllocator::setMetrics(Atlas::Size const &totalSize, int margin)
+{
+    DENG2_ASSERT(d->allocs.isEmpty());
+
+    d->size   = totalSize;
+    d->margin = margin;
+
+    d->initLayout();
+}
+
+void SkylineAtlasAllocator::clear()
+{
+    d->initLayout();
+}
+
+Id SkylineAtlasAllocator::allocate(Atlas::Size const &size, Rectanglei &rect,
+                                   Id const &knownId)
+{
+    return d->allocate(size, rect, knownId);
+}
+
+void SkylineAtlasAllocator::release(Id const &id)
+{
+    DENG2_ASSERT(d->allocs.contains(id));
+
+    d->releaseArea(d->allocs.take(id));
+}
+
+bool SkylineAtlasAllocator::relocate(Id const &id, Rectanglei &rect)
+{
+    DENG2_ASSERT(d->allocs.contains(id));
+
+    return d->relocate(id, rect);
+}
+
+int SkylineAtlasAllocator::count() const
+{
+    return d->allocs.size();
+}
+
+Atlas::Ids SkylineAtlasAllocator::ids() const
+{
+    Atlas::Ids ids;
+    foreach (Id const &id, d->allocs.keys())
+    {
+        ids.insert(id);
+    }
+    return ids;
+}
+
+void SkylineAtlasAllocator::rect(Id const &id, Rectanglei &rect) const
+{
+    DENG2_ASSERT(d->allocs.contains(id));
+    rect = d->allocs[id];
+}
+
+SkylineAtlasAllocator::Allocations SkylineAtlasAllocator::allocs() const
+{
+    return d->allocs;
+}
+
+bool SkylineAtlasAllocator::optimize()
+{
+    return d->optimize();
+}
+
+} // namespace de
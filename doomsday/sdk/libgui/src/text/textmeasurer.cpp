@@ -0,0 +1,126 @@
+/** @file textmeasurer.cpp  Incremental text measurement.
+ *
+ * @authors Copyright (c) 2026 agent <agent@local>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/TextMeasurer"
+
+#include <QHash>
+#include <QVector>
+#include <algorithm>
+
+namespace de {
+
+namespace internal {
+
+/**
+ * Character with the rich format parameters that affect its advance width.
+ */
+struct MeasuredGlyph
+{
+    QChar ch;
+    float sizeFactor;
+    int weight;
+    int style;
+
+    MeasuredGlyph(QChar ch, Font::RichFormat::Iterator const &iter)
+        : ch(ch)
+        , sizeFactor(iter.sizeFactor())
+        , weight(iter.weight())
+        , style(iter.style())
+    {}
+
+    bool operator == (MeasuredGlyph const &other) const
+    {
+        return ch == other.ch && fequal(sizeFactor, other.sizeFactor) &&
+               weight == other.weight && style == other.style;
+    }
+};
+
+inline uint qHash(MeasuredGlyph const &glyph)
+{
+    return (uint(glyph.ch.unicode()) << 8) ^ (uint(glyph.weight + 1) << 4) ^
+           uint(glyph.style + 1) ^ (uint(glyph.sizeFactor * 16) << 24);
+}
+
+} // namespace internal
+
+DENG2_PIMPL_NOREF(TextMeasurer)
+{
+    QVector<int> offsets; ///< Running total of advance widths (size + 1 elements).
+};
+
+TextMeasurer::TextMeasurer(Font const &font, String const &text, Font::RichFormatRef const &format)
+    : d(new Impl)
+{
+    QVector<int> advances(text.size(), 0);
+    QHash<internal::MeasuredGlyph, int> measured;
+
+    Font::RichFormat::Iterator iter(format);
+    while (iter.hasNext())
+    {
+        iter.next();
+        Rangei const range = iter.range();
+        for (int i = de::max(0, range.start); i < de::min(range.end, text.size()); ++i)
+        {
+            internal::MeasuredGlyph const glyph(text.at(i), iter);
+            auto found = measured.constFind(glyph);
+            if (found == measured.constEnd())
+            {
+                found = measured.insert(glyph, font.advanceWidth(text.substr(i, 1),
+                                                                 format.subRef(Rangei(i, i + 1))));
+            }
+            advances[i] = found.value();
+        }
+    }
+
+    d->offsets.resize(text.size() + 1);
+    d->offsets[0] = 0;
+    for (int i = 0; i < advances.size(); ++i)
+    {
+        d->offsets[i + 1] = d->offsets[i] + advances[i];
+    }
+}
+
+int TextMeasurer::size() const
+{
+    return d->offsets.size() - 1;
+}
+
+int TextMeasurer::offset(int pos) const
+{
+    DENG2_ASSERT(pos >= 0 && pos < d->offsets.size());
+    return d->offsets[pos];
+}
+
+int TextMeasurer::advanceWidth(Rangei const &range) const
+{
+    return offset(range.end) - offset(range.start);
+}
+
+int TextMeasurer::findFit(int begin, int maxEnd, int availableWidth) const
+{
+    DENG2_ASSERT(begin <= maxEnd);
+
+    // The running totals never decrease, so the first position that exceeds
+    // the available width can be found with a binary search.
+    auto const start = d->offsets.constBegin();
+    auto const exceeds = std::upper_bound(start + begin + 1, start + maxEnd + 1,
+                                          d->offsets[begin] + availableWidth);
+    return int(exceeds - start) - 1;
+}
+
+} // namespace de
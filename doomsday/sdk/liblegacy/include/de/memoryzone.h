@@ -178,6 +178,15 @@ DENG_PUBLIC void *ZBlockSet_Allocate(zblockset_t *set);
 
 DENG_PUBLIC void Z_PrintStatus(void);
 
+/**
+ * Returns the current usage of the memory zone. This is cheap enough to be
+ * called periodically, as the blocks are not traversed.
+ *
+ * @param allocated  Total number of allocated bytes is written here.
+ * @param total      Total size of all volumes is written here.
+ */
+DENG_PUBLIC void Z_GetMemoryStatus(size_t *allocated, size_t *total);
+
 /**
  * Puts a region of memory allocated with Z_Malloc() or malloc() up for garbage
  * collection.
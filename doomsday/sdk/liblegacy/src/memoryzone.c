@@ -1048,6 +1048,23 @@ void Z_PrintStatus(void)
             Z_VolumeCount(), (uint)allocated, (uint)wasted, (float)allocated/(float)(allocated+wasted)*100.f);
 }
 
+void Z_GetMemoryStatus(size_t *allocated, size_t *total)
+{
+    memvolume_t *volume;
+    size_t used = 0, size = 0;
+
+    lockZone();
+    for (volume = volumeRoot; volume; volume = volume->next)
+    {
+        used += volume->allocatedBytes;
+        size += volume->size;
+    }
+    unlockZone();
+
+    if (allocated) *allocated = used;
+    if (total)     *total     = size;
+}
+
 void Garbage_Trash(void *ptr)
 {
     Garbage_TrashInstance(ptr, Z_Contains(ptr)? Z_Free : free);
@@ -25,6 +25,7 @@
 #include <de/RecordPacket>
 #include <de/Vector>
 #include <QList>
+#include <QStringList>
 
 namespace de {
 namespace shell {
@@ -177,6 +178,76 @@ private:
     DENG2_PRIVATE(d)
 };
 
+/**
+ * Packet with performance metrics of the server. @ingroup shell
+ *
+ * The server samples its counters every tic and sends the accumulated values
+ * periodically. Rates are averaged over the sampling interval.
+ */
+class LIBSHELL_PUBLIC MetricsPacket : public Packet
+{
+public:
+    struct Server
+    {
+        dfloat interval       = 0; ///< Length of the sampling interval (seconds).
+        duint32 tics          = 0; ///< Number of tics run during the interval.
+        dfloat ticTime        = 0; ///< Average time spent running tics (ms).
+        dfloat maxTicTime     = 0; ///< Longest time spent running tics (ms).
+        dfloat transmitTime   = 0; ///< Average time spent transmitting frames (ms).
+        duint32 unackedDeltas = 0; ///< Total size of the clients' delta pools.
+        duint64 zoneUsed      = 0; ///< Allocated memory zone bytes.
+        duint64 zoneTotal     = 0; ///< Total size of the memory zone volumes.
+    };
+
+    struct Client
+    {
+        int number               = 0;
+        String name;
+        duint32 bytesPerSecond   = 0; ///< Outgoing frame data.
+        duint32 resendsPerSecond = 0; ///< Deltas resent because they were not acknowledged.
+        duint32 unackedDeltas    = 0;
+        dfloat encodeTime        = 0; ///< Average time spent encoding a frame (ms).
+    };
+
+    typedef QList<Client> Clients;
+
+public:
+    MetricsPacket();
+
+    void clear();
+
+    void setServer(Server const &server);
+
+    Server const &server() const;
+
+    void addClient(Client const &client);
+
+    Clients const &clients() const;
+
+    /**
+     * Returns the column names of the rows produced by csvRows().
+     */
+    static String csvHeader();
+
+    /**
+     * Formats the metrics as comma-separated values. The first row contains the
+     * server totals (client column is empty) and it is followed by one row per
+     * client.
+     *
+     * @param timestamp  Value for the first column of each row.
+     */
+    QStringList csvRows(String const &timestamp) const;
+
+    // Implements ISerializable.
+    void operator >> (Writer &to) const;
+    void operator << (Reader &from);
+
+    static Packet *fromBlock(Block const &block);
+
+private:
+    DENG2_PRIVATE(d)
+};
+
 /**
  * Network protocol for communicating with a server. @ingroup shell
  */
@@ -196,7 +267,8 @@ public:
         GameState,      ///< Current state of the game (mode, map).
         Leaderboard,    ///< Frags leaderboard.
         MapOutline,     ///< Sectors of the map for visual overview.
-        PlayerInfo      ///< Current player names, colors, positions.
+        PlayerInfo,     ///< Current player names, colors, positions.
+        Metrics         ///< Server performance metrics.
     };
 
 public:
@@ -243,6 +243,165 @@ Packet *MapOutlinePacket::fromBlock(Block const &block)
     return constructFromBlock<MapOutlinePacket>(block, MAP_OUTLINE_PACKET_TYPE);
 }
 
+// MetricsPacket -------------------------------------------------------------
+
+static char const *METRICS_PACKET_TYPE = "Mtrc";
+static dbyte const METRICS_PACKET_VERSION = 1;
+
+DENG2_PIMPL_NOREF(MetricsPacket)
+{
+    Server server;
+    Clients clients;
+};
+
+MetricsPacket::MetricsPacket()
+    : Packet(METRICS_PACKET_TYPE), d(new Impl)
+{}
+
+void MetricsPacket::clear()
+{
+    d->server = Server();
+    d->clients.clear();
+}
+
+void MetricsPacket::setServer(Server const &server)
+{
+    d->server = server;
+}
+
+MetricsPacket::Server const &MetricsPacket::server() const
+{
+    return d->server;
+}
+
+void MetricsPacket::addClient(Client const &client)
+{
+    d->clients.append(client);
+}
+
+MetricsPacket::Clients const &MetricsPacket::clients() const
+{
+    return d->clients;
+}
+
+String MetricsPacket::csvHeader()
+{
+    return "time,client,name,tics,tic_ms,tic_max_ms,transmit_ms,unacked_deltas,"
+           "bytes_per_sec,resends_per_sec,encode_ms,zone_used,zone_total";
+}
+
+QStringList MetricsPacket::csvRows(String const &timestamp) const
+{
+    QStringList rows;
+
+    Server const &sv = d->server;
+    duint32 totalBytes = 0;
+    duint32 totalResends = 0;
+    foreach (Client const &cl, d->clients)
+    {
+        totalBytes   += cl.bytesPerSecond;
+        totalResends += cl.resendsPerSecond;
+    }
+    rows << String("%1,,,%2,%3,%4,%5,%6,%7,%8,,%9,%10")
+            .arg(timestamp)
+            .arg(sv.tics)
+            .arg(sv.ticTime, 0, 'f', 3)
+            .arg(sv.maxTicTime, 0, 'f', 3)
+            .arg(sv.transmitTime, 0, 'f', 3)
+            .arg(sv.unackedDeltas)
+            .arg(totalBytes)
+            .arg(totalResends)
+            .arg(sv.zoneUsed)
+            .arg(sv.zoneTotal);
+
+    foreach (Client const &cl, d->clients)
+    {
+        // Names are quoted because they may contain commas.
+        String name = cl.name;
+        name.replace("\"", "\"\"");
+        rows << String("%1,%2,\"%3\",,,,,%4,%5,%6,%7,,")
+                .arg(timestamp)
+                .arg(cl.number)
+                .arg(name)
+                .arg(cl.unackedDeltas)
+                .arg(cl.bytesPerSecond)
+                .arg(cl.resendsPerSecond)
+                .arg(cl.encodeTime, 0, 'f', 3);
+    }
+    return rows;
+}
+
+void MetricsPacket::operator >> (Writer &to) const
+{
+    Packet::operator >> (to);
+
+    Server const &sv = d->server;
+    to << METRICS_PACKET_VERSION
+       << sv.interval
+       << sv.tics
+       << sv.ticTime
+       << sv.maxTicTime
+       << sv.transmitTime
+       << sv.unackedDeltas
+       << sv.zoneUsed
+       << sv.zoneTotal;
+
+    to << duint32(d->clients.size());
+    foreach (Client const &cl, d->clients)
+    {
+        to << dbyte(cl.number)
+           << cl.name
+           << cl.bytesPerSecond
+           << cl.resendsPerSecond
+           << cl.unackedDeltas
+           << cl.encodeTime;
+    }
+}
+
+void MetricsPacket::operator << (Reader &from)
+{
+    clear();
+
+    Packet::operator << (from);
+
+    dbyte version;
+    from >> version;
+    if (version != METRICS_PACKET_VERSION)
+    {
+        // Unknown format; the metrics are ignored.
+        return;
+    }
+
+    Server &sv = d->server;
+    from >> sv.interval
+         >> sv.tics
+         >> sv.ticTime
+         >> sv.maxTicTime
+         >> sv.transmitTime
+         >> sv.unackedDeltas
+         >> sv.zoneUsed
+         >> sv.zoneTotal;
+
+    duint32 count;
+    from >> count;
+    while (count-- > 0)
+    {
+        Client cl;
+        from.readAs<dbyte>(cl.number)
+             >> cl.name
+             >> cl.bytesPerSecond
+             >> cl.resendsPerSecond
+             >> cl.unackedDeltas
+             >> cl.encodeTime;
+        d->clients.append(cl);
+    }
+}
+
+Packet *MetricsPacket::fromBlock(Block const &block)
+{
+    return constructFromBlock<MetricsPacket>(block, METRICS_PACKET_TYPE);
+}
+
 // Protocol ------------------------------------------------------------------
 
 Protocol::Protocol()
@@ -251,6 +410,7 @@ Protocol::Protocol()
     define(LogEntryPacket::fromBlock);
     define(MapOutlinePacket::fromBlock);
     define(PlayerInfoPacket::fromBlock);
+    define(MetricsPacket::fromBlock);
 }
 
 Protocol::PacketType Protocol::recognize(Packet const *packet)
@@ -279,6 +439,12 @@ Protocol::PacketType Protocol::recognize(Packet const *packet)
         return PlayerInfo;
     }
 
+    if (packet->type() == METRICS_PACKET_TYPE)
+    {
+        DENG2_ASSERT(dynamic_cast<MetricsPacket const *>(packet) != 0);
+        return Metrics;
+    }
+
     // One of the generic-format packets?
     RecordPacket const *rec = dynamic_cast<RecordPacket const *>(packet);
     if (rec)
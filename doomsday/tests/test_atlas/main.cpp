@@ -0,0 +1,175 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <de/Atlas>
+#include <de/KdTreeAtlasAllocator>
+#include <de/RowAtlasAllocator>
+#include <de/SkylineAtlasAllocator>
+#include <de/TextApp>
+
+#include <QDebug>
+#include <QHash>
+#include <QList>
+
+using namespace de;
+
+/**
+ * Atlas that only has the backing store.
+ */
+class TestAtlas : public Atlas
+{
+public:
+    TestAtlas() : Atlas(BackingStore | AllowDefragment, Size(512, 512)) {}
+
+protected:
+    void commitFull(Image const &) const override {}
+    void commit(Image const &, Vector2i const &) const override {}
+    void commit(Image const &, Rectanglei const &) const override {}
+};
+
+/// Counts the Reposition notifications.
+struct RepositionCounter : public Atlas::IRepositionObserver
+{
+    int count = 0;
+
+    void atlasContentRepositioned(Atlas &) override
+    {
+        ++count;
+    }
+};
+
+/// Deterministic pseudo-random numbers, so that each allocator gets the same work.
+struct Random
+{
+    duint32 state = 1;
+
+    int next(int range)
+    {
+        state = state * 1664525u + 1013904223u;
+        return int((state >> 8) % duint32(range));
+    }
+};
+
+static Image::Color colorOf(int serial)
+{
+    return Image::Color(serial & 0xff, (serial >> 8) & 0xff, 0x80, 0xff);
+}
+
+/// Checks that the allocations do not overlap and their content is intact.
+static void verify(TestAtlas const &atlas, QHash<Id, int> const &contents)
+{
+    QList<Rectanglei> rects;
+    for (auto i = contents.constBegin(); i != contents.constEnd(); ++i)
+    {
+        Rectanglei const rect = atlas.imageRect(i.key());
+        for (Rectanglei const &other : rects)
+        {
+            if (rect.overlaps(other))
+            {
+                throw Error("verify", "Overlapping allocations " + rect.asText() +
+                            " and " + other.asText());
+            }
+        }
+        rects << rect;
+
+        Image::Color const color = colorOf(i.value());
+        QRgb const pixel = atlas.image(i.key()).toQImage().pixel(0, 0);
+        if (pixel != qRgba(color.x, color.y, color.z, color.w))
+        {
+            throw Error("verify", "Content of " + rect.asText() + " is not intact");
+        }
+    }
+}
+
+/**
+ * Repeatedly fills the atlas, releases half of the content at random, and fills
+ * it again. Prints the occupancy at the time the atlas became full, the amount of
+ * data moved by defragmentation, and the number of Reposition notifications.
+ */
+static void runWorkload(String const &name, Atlas::IAllocator *allocator)
+{
+    TestAtlas atlas;
+    atlas.setAllocator(allocator);
+
+    RepositionCounter repositions;
+    atlas.audienceForReposition() += repositions;
+
+    Random rnd;
+    QHash<Id, int> contents;
+    int serial = 0;
+    float occupancySum = 0;
+    int const rounds = 20;
+
+    for (int round = 0; round < rounds; ++round)
+    {
+        // Fill until full, defragmenting a little after each allocation (i.e., frame).
+        forever
+        {
+            Image::Size const size(4 + rnd.next(60), 8 + rnd.next(16));
+            Id const id = atlas.alloc(Image::solidColor(colorOf(++serial), size));
+            if (id.isNone()) break;
+            contents.insert(id, serial);
+            atlas.defragmentStep(4, 1.0);
+        }
+
+        duint usedPx = 0;
+        for (Id const &id : contents.keys())
+        {
+            usedPx += atlas.imageRect(id).size().x * atlas.imageRect(id).size().y;
+        }
+        occupancySum += float(usedPx) / (512 * 512);
+
+        verify(atlas, contents);
+
+        // Release half of the images.
+        for (Id const &id : contents.keys())
+        {
+            if (rnd.next(2))
+            {
+                atlas.release(id);
+                contents.remove(id);
+            }
+        }
+    }
+
+    qDebug() << name.toLatin1().constData()
+             << "average occupancy when full:" << occupancySum / rounds * 100 << "%"
+             << "bytes moved:" << atlas.movedBytes()
+             << "repositions:" << repositions.count;
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        TextApp app(argc, argv);
+        app.initSubsystems(App::DisablePlugins);
+
+        runWorkload("Row    ", new RowAtlasAllocator);
+        runWorkload("KdTree ", new KdTreeAtlasAllocator);
+        runWorkload("Skyline", new SkylineAtlasAllocator);
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+    }
+
+    qDebug() << "Exiting main()...";
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <de/DirectoryFeed>
+#include <de/FS>
+#include <de/Folder>
+#include <de/Log>
+#include <de/NativePath>
+#include <de/TextApp>
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+
+using namespace de;
+
+static void writeNativeFile(NativePath const &path, QByteArray const &content)
+{
+    QFile file(path.toString());
+    file.open(QFile::WriteOnly | QFile::Truncate);
+    file.write(content);
+}
+
+/// Describes the files in a folder tree, for comparing trees.
+static String describeTree(Folder const &folder, String const &prefix = "")
+{
+    String desc;
+    folder.forContents([&desc, &prefix] (String name, File &file)
+    {
+        desc += String("%1%2 (%3 bytes)\n").arg(prefix).arg(name).arg(file.size());
+        if (Folder const *sub = maybeAs<Folder>(&file))
+        {
+            desc += describeTree(*sub, prefix + name + "/");
+        }
+        return LoopContinue;
+    });
+    return desc;
+}
+
+/// Checks that the watched folder has the same contents as a fresh full scan.
+static void checkTree(Folder const &watched, NativePath const &nativePath)
+{
+    static int counter = 0;
+    Folder &scanned = FS::get().makeFolder(String("/test/scanned%1").arg(++counter),
+                                           FS::DontInheritFeeds);
+    scanned.attach(new DirectoryFeed(nativePath));
+    scanned.populate();
+
+    String const expected = describeTree(scanned);
+    String const actual   = describeTree(watched);
+    LOG_MSG("Watched tree:\n%s") << actual;
+    if (actual != expected)
+    {
+        throw Error("checkTree", "Watched folder differs from the native directory:\n" + expected);
+    }
+}
+
+/// Checks that the file at @a path is still the same File object.
+static void checkKept(Folder const &watched, String const &path, File const *original)
+{
+    if (&watched.locate<File const>(path) != original)
+    {
+        throw Error("checkKept", "\"" + path + "\" was repopulated although it did not change");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    NativePath const root = NativePath(QDir::tempPath()) /
+            String("test_directoryfeed-%1").arg(QCoreApplication::applicationPid());
+    try
+    {
+        TextApp app(argc, argv);
+        app.initSubsystems(App::DisablePlugins);
+
+        QDir(root.toString()).removeRecursively();
+        NativePath::createPath(root / "sub");
+        writeNativeFile(root / "unchanged.txt", "same");
+        writeNativeFile(root / "modified.txt", "short");
+        writeNativeFile(root / "deleted.txt", "gone soon");
+        writeNativeFile(root / "sub/nested.txt", "nested");
+
+        Folder &watched = FS::get().makeFolder("/test/watched", FS::DontInheritFeeds);
+        watched.attach(new DirectoryFeed(root, DirectoryFeed::DefaultFlags |
+                                               DirectoryFeed::WatchChanges));
+        watched.populate();
+        checkTree(watched, root);
+
+        File const *unchanged = &watched.locate<File const>("unchanged.txt");
+        File const *nested    = &watched.locate<File const>("sub/nested.txt");
+
+        // Files are created, modified, and deleted.
+        writeNativeFile(root / "modified.txt", "a bit longer");
+        writeNativeFile(root / "created.txt", "new");
+        QFile::remove((root / "deleted.txt").toString());
+        watched.populate();
+        checkTree(watched, root);
+
+        // Untouched files remain as they were.
+        checkKept(watched, "unchanged.txt", unchanged);
+        checkKept(watched, "sub/nested.txt", nested);
+
+        // Subfolders are created and deleted.
+        NativePath::createPath(root / "newsub/deeper");
+        writeNativeFile(root / "newsub/deeper/file.txt", "deep");
+        writeNativeFile(root / "sub/another.txt", "another");
+        watched.populate();
+        checkTree(watched, root);
+
+        QDir((root / "newsub").toString()).removeRecursively();
+        QFile::remove((root / "sub/nested.txt").toString());
+        watched.populate();
+        checkTree(watched, root);
+
+        checkKept(watched, "unchanged.txt", unchanged);
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText() << "\n";
+    }
+
+    QDir(root.toString()).removeRecursively();
+
+    qDebug() << "Exiting main()...";
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <de/BaseGuiApp>
+#include <de/Font>
+#include <de/FontLineWrapping>
+#include <de/Time>
+
+#include <QDebug>
+#include <QFont>
+#include <QList>
+
+using namespace de;
+
+/// Size of the generated text corpus in bytes. Can be changed with "-size".
+static int const DEFAULT_CORPUS_SIZE = 1024 * 1024;
+
+static int const WRAP_WIDTH = 600;
+
+/**
+ * Generates plain text with words of varying length, paths that can be broken
+ * after slashes, runs of spaces, and paragraphs of varying length.
+ */
+static String makeCorpus(int size)
+{
+    static char const *words[] = {
+        "a", "of", "the", "wall", "sector", "texture", "doomsday", "engine",
+        "renderer", "line-of-sight", "WWWWWWWW", "iiiiiiii", "AVAVAVAV", "Ty.",
+        "/home/user/.doomsday/runtime/", "supercalifragilisticexpialidocious"
+    };
+    int const wordCount = int(sizeof(words) / sizeof(words[0]));
+
+    QString text;
+    text.reserve(size + 64);
+    duint32 state = 1;
+    while (text.size() < size)
+    {
+        state = state * 1664525u + 1013904223u;
+        int const r = int(state >> 8);
+        text += words[r % wordCount];
+        switch ((r >> 8) % 29)
+        {
+        case 0:  text += "\n";   break;
+        case 1:  text += "\n\n"; break;
+        case 2:  text += "   ";  break;
+        case 3:  text += ", ";   break;
+        default: text += " ";    break;
+        }
+    }
+    return text;
+}
+
+static bool isWrappable(String const &text, int at)
+{
+    if (at >= text.size()) return true;
+    if (text.at(at).isSpace()) return true;
+    if (at > 0)
+    {
+        QChar const prev = text.at(at - 1);
+        if (prev == '/' || prev == '\\') return true;
+    }
+    return false;
+}
+
+/**
+ * Wraps @a text following the rules of FontLineWrapping for plain text, measuring
+ * every candidate line exactly with the font.
+ */
+static QList<Rangei> referenceWrap(Font const &font, String const &text, int maxWidth)
+{
+    auto const fits = [&font, &text, maxWidth] (int begin, int end) {
+        return font.advanceWidth(text.substr(Rangei(begin, end))) <= maxWidth;
+    };
+
+    QList<Rangei> lines;
+    int begin = 0;
+    while (begin < text.size())
+    {
+        // Longest range that fits, ending at a newline.
+        int limit = text.indexOf('\n', begin);
+        if (limit < 0) limit = text.size();
+        int fit = begin;
+        int tooLong = limit + 1;
+        while (tooLong - fit > 1)
+        {
+            int const mid = (fit + tooLong) / 2;
+            if (fits(begin, mid)) fit = mid; else tooLong = mid;
+        }
+
+        if (fit == text.size())
+        {
+            lines << Rangei(begin, fit);
+            break;
+        }
+        if (text.at(fit) == '\n')
+        {
+            lines << Rangei(begin, fit);
+            begin = fit + 1;
+            continue;
+        }
+        if (fit <= begin) break;
+
+        int end = fit;
+        while (!isWrappable(text, end))
+        {
+            if (--end == begin)
+            {
+                end = fit;
+                break;
+            }
+        }
+        if (text.substr(Rangei(begin, end)).trimmed().isEmpty())
+        {
+            end = fit;
+        }
+        while (end < text.size() && text.at(end).isSpace()) ++end;
+        lines << Rangei(begin, end);
+        begin = end;
+    }
+    return lines;
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        BaseGuiApp app(argc, argv);
+        app.initSubsystems(App::DisablePlugins);
+
+        int corpusSize = DEFAULT_CORPUS_SIZE;
+        if (auto arg = app.commandLine().check("-size", 1))
+        {
+            corpusSize = arg.params.at(0).toInt();
+        }
+
+        Font const font(QFont("Sans Serif", 12));
+        String const text = makeCorpus(corpusSize);
+
+        Time const wrapStarted;
+        FontLineWrapping wrapping;
+        wrapping.setFont(font);
+        wrapping.wrapTextToWidth(text, WRAP_WIDTH);
+        ddouble const wrapTime = wrapStarted.since();
+
+        Time const referenceStarted;
+        QList<Rangei> const expected = referenceWrap(font, text, WRAP_WIDTH);
+        ddouble const referenceTime = referenceStarted.since();
+
+        qDebug() << "Wrapped" << text.size() << "characters into" << wrapping.height()
+                 << "lines in" << wrapTime << "seconds (exact reference:"
+                 << referenceTime << "seconds)";
+
+        // Compare line by line.
+        for (int i = 0; i < de::min(wrapping.height(), expected.size()); ++i)
+        {
+            Rangei const range = wrapping.line(i).range;
+            if (range != expected.at(i))
+            {
+                throw Error("main", QString("Line %1 is %2 \"%3\", expected %4 \"%5\"")
+                            .arg(i)
+                            .arg(range.asText()).arg(text.substr(range))
+                            .arg(expected.at(i).asText()).arg(text.substr(expected.at(i))));
+            }
+        }
+        if (wrapping.height() != expected.size())
+        {
+            throw Error("main", QString("Wrapped into %1 lines, expected %2")
+                        .arg(wrapping.height()).arg(expected.size()));
+        }
+        qDebug() << "All lines match the reference";
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+    }
+
+    qDebug() << "Exiting main()...";
+    return 0;
+}
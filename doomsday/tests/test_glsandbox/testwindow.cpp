@@ -34,6 +34,7 @@
 #include <de/GLTexture>
 #include <de/GuiApp>
 #include <de/ImageBank>
+#include <de/Log>
 #include <de/ModelDrawable>
 
 using namespace de;
@@ -428,6 +429,31 @@ DENG2_OBSERVES(Bank, Load)
         modelAnim.start(0);
     }
 
+    /**
+     * Measures how many poses of the loaded model can be evaluated per second. The
+     * animation time advances one frame at 60 Hz between poses.
+     */
+    void benchmarkPoses()
+    {
+        if (!model.isReady() || modelAnim.isEmpty()) return;
+
+        int const poseCount = 10000;
+        ddouble const originalTime = modelAnim.at(0).time;
+
+        Time const benchmarkStarted;
+        for (int i = 0; i < poseCount; ++i)
+        {
+            modelAnim.at(0).time = i / 60.0;
+            modelAnim.preparePose();
+        }
+        ddouble const elapsed = benchmarkStarted.since();
+        modelAnim.at(0).time = originalTime;
+
+        LOG_MSG("Evaluated %i poses in %.3f seconds: %.0f poses/sec")
+                << poseCount << elapsed
+                << poseCount / de::max(elapsed, .000001);
+    }
+
     void drawModel()
     {
         GLState::current().target().clear(GLFramebuffer::ColorDepth);
@@ -576,6 +602,10 @@ void TestWindow::keyPressEvent(QKeyEvent *ev)
         case Qt::Key_5:
             loadMD5Model();
             break;
+
+        case Qt::Key_6:
+            benchmarkPoses();
+            break;
         }
         return;
     }
@@ -606,6 +636,11 @@ void TestWindow::loadMD2Model()
     glDone();
 }
 
+void TestWindow::benchmarkPoses()
+{
+    d->benchmarkPoses();
+}
+
 void TestWindow::loadMD5Model()
 {
     glActivate();
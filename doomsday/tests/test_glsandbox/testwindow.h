@@ -38,6 +38,7 @@ public slots:
     void testModel();
     void loadMD2Model();
     void loadMD5Model();
+    void benchmarkPoses();
 
 private:
     DENG2_PRIVATE(d)
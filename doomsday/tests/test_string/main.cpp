@@ -18,6 +18,7 @@
  */
 
 #include <de/TextApp>
+#include <de/Utf8String>
 #include <de/math.h>
 #include <QDebug>
 
@@ -56,6 +57,36 @@ int main(int argc, char **argv)
         LOG_MSG("Double precision floating point: %f") << PI;
         LOG_MSG("Decimal places .4: %.4f") << PI;
         LOG_MSG("Decimal places .10: %.10f") << PI;
+
+        // UTF-8 strings.
+        {
+            Utf8String const hello("Hello");
+            DENG2_ASSERT(hello.isInline());
+            DENG2_ASSERT(hello.size() == 5);
+            DENG2_ASSERT(!qstrcmp(hello.c_str(), "Hello"));
+
+            String const text = QString::fromUtf8("Ääkköset \xf0\x9f\x98\x80");
+            Utf8String const utf8(text);
+            DENG2_ASSERT(utf8.size() == 16);
+            DENG2_ASSERT(utf8.toString() == text);
+            DENG2_ASSERT(utf8.isInline());
+
+            Utf8String longer(hello);
+            for (int i = 0; i < 5; ++i) longer += hello;
+            DENG2_ASSERT(!longer.isInline());
+            DENG2_ASSERT(longer.size() == 30);
+            DENG2_ASSERT(Utf8String(std::move(longer)).size() == 30);
+            DENG2_ASSERT(longer.isEmpty());
+
+            String const upper = text.toUpper();
+            DENG2_ASSERT(Utf8String::caseFolded(QStringRef(&text)) ==
+                         Utf8String::caseFolded(QStringRef(&upper)));
+            DENG2_UNUSED(upper);
+            DENG2_ASSERT(Utf8String("abc") < Utf8String("abd"));
+            DENG2_ASSERT(Utf8String("ab")  < Utf8String("abc"));
+
+            LOG_MSG("UTF-8 string: '%s' (%i bytes)") << utf8.toString() << utf8.size();
+        }
     }
     catch (Error const &err)
     {
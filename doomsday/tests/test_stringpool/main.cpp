@@ -23,6 +23,8 @@
 
 #include <de/StringPool>
 #include <de/Reader>
+#include <de/Time>
+#include <de/Utf8String>
 #include <de/Writer>
 #include <QDebug>
 
@@ -103,6 +105,30 @@ int main(int, char **)
 
         p.clear();
         DENG2_ASSERT(p.empty());
+
+        // Benchmark: look up path segments like a file system being populated.
+        {
+            QStringList paths;
+            for (int i = 0; i < 20000; ++i)
+            {
+                paths << String("/home/Packages/Doom Data %1/Textures/TEXTURE%2.lmp")
+                         .arg(i % 17).arg(i % 2000);
+            }
+            duint64 const allocsBefore = Utf8String::heapAllocationCount();
+            Time const startedAt;
+            int found = 0;
+            for (QString const &path : paths)
+            {
+                for (QStringRef const &segment : path.splitRef('/', QString::SkipEmptyParts))
+                {
+                    if (p.isInterned(segment)) found++;
+                    else p.intern(segment.toString());
+                }
+            }
+            qDebug() << "Looked up" << paths.size() << "paths in" << startedAt.since() * 1000
+                     << "ms;" << p.size() << "unique segments," << found << "found,"
+                     << Utf8String::heapAllocationCount() - allocsBefore << "key allocations.";
+        }
     }
     catch (Error const &err)
     {
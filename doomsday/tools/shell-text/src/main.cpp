@@ -19,10 +19,18 @@
 #include <de/libcore.h>
 #include <de/Counted>
 #include "shellapp.h"
+#include "metricsdumpapp.h"
 
 int main(int argc, char *argv[])
 {
     int result;
+    if (MetricsDumpApp::isRequested(argc, argv))
+    {
+        // Non-interactive mode.
+        MetricsDumpApp a(argc, argv);
+        result = a.exec();
+    }
+    else
     {
         ShellApp a(argc, argv);
         result = a.exec();
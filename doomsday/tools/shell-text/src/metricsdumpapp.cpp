@@ -0,0 +1,152 @@
+/** @file metricsdumpapp.cpp  Command line mode for dumping server metrics.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "metricsdumpapp.h"
+#include <de/shell/Link>
+#include <de/shell/Protocol>
+#include <de/Clock>
+#include <de/LogBuffer>
+#include <de/Time>
+#include <QDateTime>
+#include <QStringList>
+#include <QTextStream>
+#include <QTimer>
+#include <cstring>
+
+using namespace de;
+using namespace de::shell;
+
+static char const *METRICS_CSV_OPTION = "--metrics-csv";
+
+DENG2_PIMPL(MetricsDumpApp)
+{
+    LogBuffer logBuffer;
+    Clock clock;
+    QTextStream out;
+    QTextStream err;
+    Link *link = nullptr;
+    String password;
+
+    Impl(Public *i)
+        : Base(i)
+        , out(stdout)
+        , err(stderr)
+    {
+        logBuffer.enableStandardOutput(false);
+        LogBuffer::setAppBuffer(logBuffer);
+        Clock::setAppClock(&clock);
+    }
+
+    ~Impl()
+    {
+        delete link;
+        Clock::setAppClock(0);
+    }
+
+    void fail(String const &message)
+    {
+        err << message << "\n";
+        err.flush();
+        QTimer::singleShot(0, [] () { qApp->exit(1); });
+    }
+};
+
+MetricsDumpApp::MetricsDumpApp(int &argc, char **argv)
+    : QCoreApplication(argc, argv), d(new Impl(this))
+{
+    setOrganizationDomain ("dengine.net");
+    setOrganizationName   ("Deng Team");
+    setApplicationName    ("doomsday-shell-text");
+    setApplicationVersion (SHELL_VERSION);
+
+    QStringList const args = arguments();
+    int const pos = args.indexOf(METRICS_CSV_OPTION);
+    if (pos < 0 || pos + 1 >= args.size())
+    {
+        d->fail(String("Usage: %1 %2 (address) [--password (text)]")
+                .arg(args.first()).arg(METRICS_CSV_OPTION));
+        return;
+    }
+    int const pwPos = args.indexOf("--password");
+    if (pwPos >= 0 && pwPos + 1 < args.size())
+    {
+        d->password = args.at(pwPos + 1);
+    }
+
+    d->out << MetricsPacket::csvHeader() << "\n";
+    d->out.flush();
+
+    // Keep trying to connect to 30 seconds.
+    d->link = new Link(args.at(pos + 1), 30);
+    connect(d->link, SIGNAL(packetsReady()), this, SLOT(handleIncomingPackets()));
+    connect(d->link, SIGNAL(disconnected()), this, SLOT(disconnected()));
+    d->link->connectLink();
+}
+
+bool MetricsDumpApp::isRequested(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], METRICS_CSV_OPTION)) return true;
+    }
+    return false;
+}
+
+void MetricsDumpApp::handleIncomingPackets()
+{
+    forever
+    {
+        DENG2_ASSERT(d->link != 0);
+
+        QScopedPointer<Packet> packet(d->link->nextPacket());
+        if (packet.isNull()) break;
+
+        shell::Protocol &protocol = d->link->protocol();
+        switch (protocol.recognize(packet.data()))
+        {
+        case shell::Protocol::PasswordChallenge:
+            if (d->password.isEmpty())
+            {
+                d->fail("The server requires a password (use --password).");
+                return;
+            }
+            *d->link << protocol.passwordResponse(d->password);
+            break;
+
+        case shell::Protocol::Metrics: {
+            String const timestamp = QDateTime::currentDateTime().toString(Qt::ISODate);
+            foreach (QString const &row,
+                     static_cast<MetricsPacket *>(packet.data())->csvRows(timestamp))
+            {
+                d->out << row << "\n";
+            }
+            d->out.flush();
+            break; }
+
+        default:
+            break;
+        }
+    }
+}
+
+void MetricsDumpApp::disconnected()
+{
+    d->err << "Disconnected from server.\n";
+    d->err.flush();
+    exit(0);
+}
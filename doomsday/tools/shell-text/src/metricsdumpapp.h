@@ -0,0 +1,51 @@
+/** @file metricsdumpapp.h  Command line mode for dumping server metrics.
+ *
+ * @authors Copyright © 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef METRICSDUMPAPP_H
+#define METRICSDUMPAPP_H
+
+#include <QCoreApplication>
+#include <de/libcore.h>
+
+/**
+ * Non-interactive mode that connects to a server and writes the received
+ * performance metrics to standard output as comma-separated values.
+ *
+ * Usage: doomsday-shell-text --metrics-csv (address) [--password (text)]
+ */
+class MetricsDumpApp : public QCoreApplication
+{
+    Q_OBJECT
+
+public:
+    MetricsDumpApp(int &argc, char **argv);
+
+    /**
+     * Determines if the command line arguments request the metrics dump mode.
+     */
+    static bool isRequested(int argc, char **argv);
+
+public slots:
+    void handleIncomingPackets();
+    void disconnected();
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+#endif // METRICSDUMPAPP_H
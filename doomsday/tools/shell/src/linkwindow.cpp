@@ -23,6 +23,7 @@
 #include "guishellapp.h"
 #include "optionspage.h"
 #include "consolepage.h"
+#include "metricspage.h"
 #include "preferences.h"
 #include "errorlogdialog.h"
 #include "utils.h"
@@ -75,11 +76,13 @@ DENG2_PIMPL(LinkWindow)
     QToolButton *statusButton;
     QToolButton *optionsButton;
     QToolButton *consoleButton;
+    QToolButton *metricsButton;
     QStackedWidget *stack;
     QWidget *newLocalServerPage;
     StatusWidget *status;
     OptionsPage *options;
     ConsolePage *console;
+    MetricsPage *metrics;
     QLabel *gameStatus;
     QLabel *timeCounter;
     QLabel *currentHost;
@@ -94,6 +97,7 @@ DENG2_PIMPL(LinkWindow)
           tools(0),
           statusButton(0),
           consoleButton(0),
+          metricsButton(0),
           stack(0),
           status(0),
           gameStatus(0),
@@ -160,6 +164,7 @@ DENG2_PIMPL(LinkWindow)
 
         gameStatus->clear();
         status->linkDisconnected();
+        metrics->clear();
         updateCurrentHost();
         updateStyle();
 
@@ -309,6 +314,10 @@ LinkWindow::LinkWindow(QWidget *parent)
     d->logBuffer.addSink(d->console->log().logSink());
     connect(&d->console->cli(), SIGNAL(commandEntered(de::String)), this, SLOT(sendCommandToServer(de::String)));
 
+    // Performance metrics page.
+    d->metrics = new MetricsPage;
+    d->stack->addWidget(d->metrics);
+
     d->updateStyle();
 
     d->stack->setCurrentIndex(0); // status
@@ -358,6 +367,10 @@ LinkWindow::LinkWindow(QWidget *parent)
     d->consoleButton->setShortcut(QKeySequence(tr("Ctrl+3")));
     connect(d->consoleButton, SIGNAL(pressed()), this, SLOT(switchToConsole()));
 
+    d->metricsButton = d->addToolButton(tr("Metrics"), QIcon(imageResourcePath(":/images/toolbar_placeholder.png")));
+    d->metricsButton->setShortcut(QKeySequence(tr("Ctrl+4")));
+    connect(d->metricsButton, SIGNAL(pressed()), this, SLOT(switchToMetrics()));
+
     // Initial state for the window.
     resize(QSize(640, 480));
 
@@ -506,6 +519,7 @@ void LinkWindow::switchToStatus()
 {
     d->optionsButton->setChecked(false);
     d->consoleButton->setChecked(false);
+    d->metricsButton->setChecked(false);
     d->stack->setCurrentWidget(d->link? d->status : d->newLocalServerPage);
 }
 
@@ -513,6 +527,7 @@ void LinkWindow::switchToOptions()
 {
     d->statusButton->setChecked(false);
     d->consoleButton->setChecked(false);
+    d->metricsButton->setChecked(false);
     d->stack->setCurrentWidget(d->options);
 }
 
@@ -520,10 +535,19 @@ void LinkWindow::switchToConsole()
 {
     d->statusButton->setChecked(false);
     d->optionsButton->setChecked(false);
+    d->metricsButton->setChecked(false);
     d->stack->setCurrentWidget(d->console);
     d->console->root().setFocus();
 }
 
+void LinkWindow::switchToMetrics()
+{
+    d->statusButton->setChecked(false);
+    d->optionsButton->setChecked(false);
+    d->consoleButton->setChecked(false);
+    d->stack->setCurrentWidget(d->metrics);
+}
+
 void LinkWindow::updateWhenConnected()
 {
     if (d->link)
@@ -599,6 +623,10 @@ void LinkWindow::handleIncomingPackets()
             d->status->setPlayerInfo(*static_cast<PlayerInfoPacket *>(packet.data()));
             break;
 
+        case shell::Protocol::Metrics:
+            d->metrics->addMetrics(*static_cast<MetricsPacket *>(packet.data()));
+            break;
+
         default:
             break;
         }
@@ -57,6 +57,7 @@ public slots:
     void switchToStatus();
     void switchToOptions();
     void switchToConsole();
+    void switchToMetrics();
     void updateWhenConnected();
     void updateConsoleFontFromPreferences();
 
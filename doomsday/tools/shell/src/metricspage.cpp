@@ -0,0 +1,232 @@
+/** @file metricspage.cpp  Page for server performance metrics.
+ *
+ * @authors Copyright (c) 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "metricspage.h"
+
+#include <QGridLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPainter>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+using namespace de;
+
+static int const HISTORY_LENGTH = 120; // samples
+
+/**
+ * Small line chart of the recent values of one metric.
+ */
+class Sparkline : public QWidget
+{
+public:
+    Sparkline(QWidget *parent = 0) : QWidget(parent)
+    {
+        setMinimumSize(160, 28);
+        setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+    }
+
+    void add(qreal value)
+    {
+        _values.append(value);
+        while (_values.size() > HISTORY_LENGTH) _values.removeFirst();
+        update();
+    }
+
+    void clear()
+    {
+        _values.clear();
+        update();
+    }
+
+    void paintEvent(QPaintEvent *)
+    {
+        QPainter painter(this);
+        painter.fillRect(rect(), palette().base());
+
+        if (_values.size() < 2) return;
+
+        qreal peak = 0;
+        foreach (qreal v, _values) peak = qMax(peak, v);
+        if (peak <= 0) peak = 1;
+
+        QRectF const area = QRectF(rect()).adjusted(1, 2, -1, -2);
+        qreal const step = area.width() / (HISTORY_LENGTH - 1);
+        qreal x = area.right() - step * (_values.size() - 1);
+
+        QPolygonF line;
+        foreach (qreal v, _values)
+        {
+            line << QPointF(x, area.bottom() - area.height() * v / peak);
+            x += step;
+        }
+
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(palette().highlight(), 1.5));
+        painter.drawPolyline(line);
+    }
+
+private:
+    QList<qreal> _values;
+};
+
+DENG2_PIMPL(MetricsPage)
+{
+    enum Metric {
+        TicTime,
+        MaxTicTime,
+        TransmitTime,
+        Bandwidth,
+        Resends,
+        UnackedDeltas,
+        ZoneUsage,
+        MetricCount
+    };
+
+    QLabel *values[MetricCount];
+    Sparkline *sparklines[MetricCount];
+    QTableWidget *clients;
+
+    Impl(Public *i) : Base(i)
+    {
+        char const *names[MetricCount] = {
+            QT_TR_NOOP("Tic time:"),
+            QT_TR_NOOP("Longest tic:"),
+            QT_TR_NOOP("Transmit time:"),
+            QT_TR_NOOP("Bandwidth:"),
+            QT_TR_NOOP("Resent deltas:"),
+            QT_TR_NOOP("Unacked deltas:"),
+            QT_TR_NOOP("Memory zone:")
+        };
+
+        QGridLayout *grid = new QGridLayout;
+        grid->setColumnStretch(2, 1);
+        for (int i = 0; i < MetricCount; ++i)
+        {
+            values[i] = new QLabel;
+            values[i]->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            values[i]->setMinimumWidth(100);
+            sparklines[i] = new Sparkline;
+
+            grid->addWidget(new QLabel(tr(names[i])), i, 0);
+            grid->addWidget(values[i], i, 1);
+            grid->addWidget(sparklines[i], i, 2);
+        }
+
+        clients = new QTableWidget(0, 6);
+        clients->setHorizontalHeaderLabels(QStringList()
+                                           << tr("#") << tr("Name") << tr("Bytes/s")
+                                           << tr("Resends/s") << tr("Unacked")
+                                           << tr("Encode (ms)"));
+        clients->verticalHeader()->hide();
+        clients->horizontalHeader()->setStretchLastSection(true);
+        clients->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        clients->setSelectionMode(QAbstractItemView::NoSelection);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addLayout(grid);
+        layout->addWidget(clients, 1);
+        self().setLayout(layout);
+    }
+
+    static QString formatBytes(duint64 bytes)
+    {
+        if (bytes >= 10 * 1024 * 1024)
+        {
+            return tr("%1 MB").arg(bytes / (1024 * 1024));
+        }
+        if (bytes >= 10 * 1024)
+        {
+            return tr("%1 KB").arg(bytes / 1024);
+        }
+        return tr("%1 B").arg(bytes);
+    }
+
+    void setClientItem(int row, int column, QString const &text)
+    {
+        QTableWidgetItem *item = new QTableWidgetItem(text);
+        if (column != 1) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        clients->setItem(row, column, item);
+    }
+
+    void update(shell::MetricsPacket const &metrics)
+    {
+        auto const &sv = metrics.server();
+
+        duint32 bandwidth = 0;
+        duint32 resends = 0;
+        foreach (auto const &cl, metrics.clients())
+        {
+            bandwidth += cl.bytesPerSecond;
+            resends   += cl.resendsPerSecond;
+        }
+
+        values[TicTime]      ->setText(tr("%1 ms").arg(sv.ticTime, 0, 'f', 2));
+        values[MaxTicTime]   ->setText(tr("%1 ms").arg(sv.maxTicTime, 0, 'f', 2));
+        values[TransmitTime] ->setText(tr("%1 ms").arg(sv.transmitTime, 0, 'f', 2));
+        values[Bandwidth]    ->setText(formatBytes(bandwidth) + tr("/s"));
+        values[Resends]      ->setText(tr("%1/s").arg(resends));
+        values[UnackedDeltas]->setText(QString::number(sv.unackedDeltas));
+        values[ZoneUsage]    ->setText(formatBytes(sv.zoneUsed) + " / " + formatBytes(sv.zoneTotal));
+
+        sparklines[TicTime]      ->add(sv.ticTime);
+        sparklines[MaxTicTime]   ->add(sv.maxTicTime);
+        sparklines[TransmitTime] ->add(sv.transmitTime);
+        sparklines[Bandwidth]    ->add(bandwidth);
+        sparklines[Resends]      ->add(resends);
+        sparklines[UnackedDeltas]->add(sv.unackedDeltas);
+        sparklines[ZoneUsage]    ->add(sv.zoneUsed);
+
+        clients->setRowCount(metrics.clients().size());
+        int row = 0;
+        foreach (auto const &cl, metrics.clients())
+        {
+            setClientItem(row, 0, QString::number(cl.number));
+            setClientItem(row, 1, cl.name);
+            setClientItem(row, 2, QString::number(cl.bytesPerSecond));
+            setClientItem(row, 3, QString::number(cl.resendsPerSecond));
+            setClientItem(row, 4, QString::number(cl.unackedDeltas));
+            setClientItem(row, 5, QString::number(cl.encodeTime, 'f', 2));
+            ++row;
+        }
+    }
+
+    void clear()
+    {
+        for (int i = 0; i < MetricCount; ++i)
+        {
+            values[i]->clear();
+            sparklines[i]->clear();
+        }
+        clients->setRowCount(0);
+    }
+};
+
+MetricsPage::MetricsPage(QWidget *parent)
+    : QWidget(parent), d(new Impl(this))
+{}
+
+void MetricsPage::addMetrics(shell::MetricsPacket const &metrics)
+{
+    d->update(metrics);
+}
+
+void MetricsPage::clear()
+{
+    d->clear();
+}
@@ -0,0 +1,45 @@
+/** @file metricspage.h  Page for server performance metrics.
+ *
+ * @authors Copyright (c) 2026 agent <agent@local>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef METRICSPAGE_H
+#define METRICSPAGE_H
+
+#include <QWidget>
+#include <de/shell/Protocol>
+
+/**
+ * Page that shows the performance metrics sent by the server as live tables
+ * and sparklines of the recent history.
+ */
+class MetricsPage : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsPage(QWidget *parent = 0);
+
+    void addMetrics(de::shell::MetricsPacket const &metrics);
+
+public slots:
+    void clear();
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+#endif // METRICSPAGE_H